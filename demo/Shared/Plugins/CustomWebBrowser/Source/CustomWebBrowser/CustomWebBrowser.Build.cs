@@ -10,6 +10,10 @@ public class CustomWebBrowser : ModuleRules
 			{ "Engine", "Core", "CoreUObject", "UMG", "Slate", "SlateCore", "WebBrowser" }
 		);
 
+		PrivateDependencyModuleNames.AddRange(new string[]
+			{ "InputCore", "Json" }
+		);
+
 		var pluginPath = Utils.MakePathRelativeTo(ModuleDirectory, Target.RelativeEnginePath);
 
 		if (Target.Platform == UnrealTargetPlatform.Android)
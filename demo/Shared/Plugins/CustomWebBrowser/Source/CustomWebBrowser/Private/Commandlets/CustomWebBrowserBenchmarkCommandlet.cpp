@@ -0,0 +1,1069 @@
+#include "Commandlets/CustomWebBrowserBenchmarkCommandlet.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "InputCoreTypes.h"
+#include "IWebBrowserResourceLoader.h"
+#include "IWebBrowserSchemeHandler.h"
+#include "IWebBrowserSingleton.h"
+#include "IWebBrowserWindow.h"
+#include "Layout/Geometry.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "WebBrowserBenchmark.h"
+#include "WebBrowserModule.h"
+
+#include <atomic>
+
+#define TAG			TEXT("CustomWebBrowserBenchmark")
+
+namespace
+{
+	/** Name the bridge object is bound under */
+	const TCHAR* const BridgeBindingName = TEXT("benchmark");
+
+	const TCHAR* const ScrollFixture = TEXT(R"(<!DOCTYPE html>
+<html><head><style>
+body { margin: 0; font: 16px sans-serif; background: #f4f4f4; }
+.card { margin: 12px; padding: 16px; background: #fff; border-radius: 8px; box-shadow: 0 2px 6px rgba(0,0,0,0.2); }
+.card img { width: 100%; height: 160px; background: linear-gradient(135deg, #4a90d9, #d94a8c); display: block; }
+</style></head><body><div id="list"></div>
+<script>
+var List = document.getElementById('list');
+for (var Index = 0; Index < 400; ++Index) {
+	var Card = document.createElement('div');
+	Card.className = 'card';
+	Card.innerHTML = '<img><h3>Item ' + Index + '</h3><p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>';
+	List.appendChild(Card);
+}
+</script></body></html>)");
+
+	const TCHAR* const AnimationFixture = TEXT(R"(<!DOCTYPE html>
+<html><head><style>
+body { margin: 0; background: #202020; overflow: hidden; }
+.box { position: absolute; width: 48px; height: 48px; border-radius: 6px; animation: spin 2s linear infinite, drift 3s ease-in-out infinite alternate; }
+@keyframes spin { from { transform: rotate(0deg); } to { transform: rotate(360deg); } }
+@keyframes drift { from { opacity: 0.3; margin-left: 0; } to { opacity: 1; margin-left: 64px; } }
+</style></head><body>
+<script>
+for (var Index = 0; Index < 120; ++Index) {
+	var Box = document.createElement('div');
+	Box.className = 'box';
+	Box.style.left = ((Index % 15) * 80 + 8) + 'px';
+	Box.style.top = (Math.floor(Index / 15) * 80 + 8) + 'px';
+	Box.style.background = 'hsl(' + (Index * 3) + ', 70%, 55%)';
+	Box.style.animationDelay = (Index * 0.05) + 's';
+	document.body.appendChild(Box);
+}
+</script></body></html>)");
+
+	const TCHAR* const BridgeFixture = TEXT(R"(<!DOCTYPE html>
+<html><body><p id="status">JS bridge benchmark</p></body></html>)");
+
+	struct FBenchmarkScenario
+	{
+		FString Name;
+		FString Html;
+		bool bScroll = false;
+		bool bBridge = false;
+		bool bResize = false;
+	};
+
+	/** Rate at which the benchmark ticks the browsers, and at which scroll input is sent */
+	constexpr double TickSeconds = 1.0 / 60.0;
+	constexpr double ScrollInputSeconds = 1.0 / 30.0;
+	constexpr int32 ScrollEventsPerDirection = 60;
+
+	/** The resize scenario animates the viewport width like a drawer panel opening and closing */
+	constexpr double ResizeCycleSeconds = 1.0;
+
+	/** A ping that got no answer in this time is sent again */
+	constexpr double BridgeTimeoutSeconds = 1.0;
+
+	/** Ticks the browsers the way the engine loop does, returning the time it took */
+	double TickBrowsers(float DeltaTime)
+	{
+		const double Start = FPlatformTime::Seconds();
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		return FPlatformTime::Seconds() - Start;
+	}
+
+	/** Ticks the browsers until the condition is met, returning false on timeout */
+	bool TickUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds)
+	{
+		const double Start = FPlatformTime::Seconds();
+		while (!Condition())
+		{
+			if (FPlatformTime::Seconds() - Start > TimeoutSeconds)
+			{
+				return false;
+			}
+			TickBrowsers(TickSeconds);
+			FPlatformProcess::Sleep(TickSeconds);
+		}
+		return true;
+	}
+
+	/** Summarizes samples, in seconds, as a JSON object in milliseconds */
+	TSharedRef<FJsonObject> MakeDistribution(TArray<double> Samples)
+	{
+		TSharedRef<FJsonObject> Distribution = MakeShared<FJsonObject>();
+		Distribution->SetNumberField(TEXT("Count"), Samples.Num());
+		if (Samples.Num() > 0)
+		{
+			Samples.Sort();
+			double Sum = 0.0;
+			for (double Sample : Samples)
+			{
+				Sum += Sample;
+			}
+			auto Percentile = [&Samples](double Fraction)
+			{
+				return Samples[FMath::Clamp(FMath::CeilToInt(Fraction * Samples.Num()) - 1, 0, Samples.Num() - 1)] * 1000.0;
+			};
+			Distribution->SetNumberField(TEXT("AverageMs"), Sum / Samples.Num() * 1000.0);
+			Distribution->SetNumberField(TEXT("P50Ms"), Percentile(0.5));
+			Distribution->SetNumberField(TEXT("P95Ms"), Percentile(0.95));
+			Distribution->SetNumberField(TEXT("MaxMs"), Samples.Last() * 1000.0);
+		}
+		return Distribution;
+	}
+
+	/** Serves the same small icon for every request */
+	class FBenchmarkIconHandler : public IWebBrowserSchemeHandler
+	{
+	public:
+		virtual bool ProcessRequest(const FString& Verb, const FString& Url, const FSimpleDelegate& OnHeadersReady) override
+		{
+			OnHeadersReady.Execute();
+			return true;
+		}
+
+		virtual void GetResponseHeaders(IHeaders& OutHeaders) override
+		{
+			OutHeaders.SetMimeType(TEXT("image/svg+xml"));
+			OutHeaders.SetStatusCode(200);
+			OutHeaders.SetContentLength(Icon.Len());
+		}
+
+		virtual bool ReadResponse(uint8* OutBytes, int32 BytesToRead, int32& BytesRead, const FSimpleDelegate& OnMoreDataReady) override
+		{
+			BytesRead = FMath::Min(BytesToRead, Icon.Len() - Position);
+			FMemory::Memcpy(OutBytes, Icon.GetData() + Position, BytesRead);
+			Position += BytesRead;
+			return BytesRead > 0;
+		}
+
+		virtual void Cancel() override
+		{
+		}
+
+		void Reset()
+		{
+			Position = 0;
+		}
+
+	private:
+		const FAnsiStringView Icon = "<svg xmlns='http://www.w3.org/2000/svg' width='16' height='16'><rect width='16' height='16' fill='#4a90d9'/></svg>";
+		int32 Position = 0;
+	};
+
+	/** Recycles its handlers, the way a factory serving many small files would */
+	class FBenchmarkIconHandlerFactory : public IWebBrowserSchemeHandlerFactory
+	{
+	public:
+		virtual TUniquePtr<IWebBrowserSchemeHandler> Create(FString Verb, FString Url) override
+		{
+			NumCreated++;
+			{
+				FScopeLock Lock(&FreeHandlersCS);
+				if (FreeHandlers.Num() > 0)
+				{
+					NumReused++;
+					return FreeHandlers.Pop(EAllowShrinking::No);
+				}
+			}
+			return MakeUnique<FBenchmarkIconHandler>();
+		}
+
+		virtual void RecycleHandler(TUniquePtr<IWebBrowserSchemeHandler>&& Handler) override
+		{
+			static_cast<FBenchmarkIconHandler*>(Handler.Get())->Reset();
+			FScopeLock Lock(&FreeHandlersCS);
+			FreeHandlers.Add(MoveTemp(Handler));
+		}
+
+		std::atomic<int32> NumCreated = 0;
+		std::atomic<int32> NumReused = 0;
+
+	private:
+		TArray<TUniquePtr<IWebBrowserSchemeHandler>> FreeHandlers;
+		FCriticalSection FreeHandlersCS;
+	};
+
+	/**
+	 * Registers a scheme handler for many domains, the way content packs each get their own, loads a page requesting an icon from a
+	 * sample of them and unregisters the handler again, timing each step.
+	 */
+	TSharedPtr<FJsonObject> RunSchemeScenario(IWebBrowserSingleton& Singleton, int32 NumDomains)
+	{
+		TArray<FString> Domains;
+		Domains.Reserve(NumDomains);
+		for (int32 Index = 0; Index < NumDomains; ++Index)
+		{
+			Domains.Add(FString::Printf(TEXT("pack%04d.benchmark.local"), Index));
+		}
+
+		// Every tenth domain is requested, so lookups have to find the domain among all the others
+		FString Html = TEXT("<!DOCTYPE html><html><body>");
+		int32 NumIcons = 0;
+		for (int32 Index = 0; Index < NumDomains; Index += 10)
+		{
+			Html += FString::Printf(TEXT("<img src=\"https://%s/icon.svg\">"), *Domains[Index]);
+			NumIcons++;
+		}
+		Html += TEXT("</body></html>");
+
+		FBenchmarkIconHandlerFactory Factory;
+		double Start = FPlatformTime::Seconds();
+		Singleton.RegisterSchemeHandlerFactories(TEXT("https"), Domains, &Factory);
+		const double RegisterSeconds = FPlatformTime::Seconds() - Start;
+
+		FCreateBrowserWindowSettings Settings;
+		Settings.InitialURL = TEXT("http://benchmark/Schemes.html");
+		Settings.ContentsToLoad = Html;
+		TSharedPtr<IWebBrowserWindow> Window = Singleton.CreateBrowserWindow(Settings);
+		bool bLoaded = false;
+		double LoadSeconds = 0.0;
+		if (Window.IsValid())
+		{
+			Start = FPlatformTime::Seconds();
+			bLoaded = TickUntil([&Window]()
+			{
+				const EWebBrowserDocumentState State = Window->GetDocumentLoadingState();
+				return State == EWebBrowserDocumentState::Completed || State == EWebBrowserDocumentState::Error;
+			}, 30.0) && Window->GetDocumentLoadingState() == EWebBrowserDocumentState::Completed;
+			LoadSeconds = FPlatformTime::Seconds() - Start;
+			Window->CloseBrowser(true, false);
+			Window.Reset();
+		}
+
+		Start = FPlatformTime::Seconds();
+		Singleton.UnregisterSchemeHandlerFactory(&Factory);
+		const double UnregisterSeconds = FPlatformTime::Seconds() - Start;
+		TickUntil([]() { return false; }, 0.5);
+
+		if (!bLoaded)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to load Schemes"), TAG);
+		}
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("Schemes"));
+		Result->SetBoolField(TEXT("Loaded"), bLoaded);
+		Result->SetNumberField(TEXT("Domains"), NumDomains);
+		Result->SetNumberField(TEXT("Icons"), NumIcons);
+		Result->SetNumberField(TEXT("HandlersCreated"), Factory.NumCreated.load());
+		Result->SetNumberField(TEXT("HandlersReused"), Factory.NumReused.load());
+		Result->SetNumberField(TEXT("RegisterMs"), RegisterSeconds * 1000.0);
+		Result->SetNumberField(TEXT("LoadMs"), LoadSeconds * 1000.0);
+		Result->SetNumberField(TEXT("UnregisterMs"), UnregisterSeconds * 1000.0);
+		return Result;
+	}
+
+	/** Sizes of the bodies served by the SchemeBodies scenario, in megabytes */
+	const int32 SchemeBodySizesMB[] = { 1, 10, 100 };
+
+	/**
+	 * Serves large bodies the two ways the browser holds them in memory: a page loaded with LoadString, padded to the body size,
+	 * and a file served by a Respond resource rule, which a page fetches whole and by range. Times how long each takes to reach the page.
+	 */
+	TSharedPtr<FJsonObject> RunSchemeBodiesScenario(IWebBrowserSingleton& Singleton)
+	{
+		const FString BodiesUrl = TEXT("http://bodies.benchmark.local/");
+		const FString BodiesDir = FPaths::ProjectSavedDir() / TEXT("Benchmarks");
+
+		FCreateBrowserWindowSettings Settings;
+		Settings.InitialURL = TEXT("about:blank");
+		TSharedPtr<IWebBrowserWindow> Window = Singleton.CreateBrowserWindow(Settings);
+		if (!Window.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to create a browser for SchemeBodies"), TAG);
+			return nullptr;
+		}
+		auto IsLoaded = [&Window]()
+		{
+			const EWebBrowserDocumentState State = Window->GetDocumentLoadingState();
+			return State == EWebBrowserDocumentState::Completed || State == EWebBrowserDocumentState::Error;
+		};
+		TickUntil(IsLoaded, 30.0);
+
+		bool bCompleted = true;
+		TArray<FString> BodyFiles;
+		TArray<TSharedPtr<FJsonValue>> Bodies;
+		for (int32 SizeMB : SchemeBodySizesMB)
+		{
+			const int64 NumBytes = static_cast<int64>(SizeMB) * 1024 * 1024;
+
+			// The padding is a comment, so the time goes to serving the body rather than laying it out
+			FString Html = TEXT("<!DOCTYPE html><html><body><!--");
+			Html += FString::ChrN(static_cast<int32>(NumBytes), TEXT('x'));
+			Html += TEXT("--></body></html>");
+			double Start = FPlatformTime::Seconds();
+			Window->LoadString(MoveTemp(Html), BodiesUrl + TEXT("page.html"));
+			const bool bPageLoaded = TickUntil(IsLoaded, 60.0) && Window->GetDocumentLoadingState() == EWebBrowserDocumentState::Completed;
+			const double LoadStringSeconds = FPlatformTime::Seconds() - Start;
+
+			// Each size gets its own file, as the previous one may still be mapped by the rule it was served with
+			const FString BodyFile = BodiesDir / FString::Printf(TEXT("SchemeBody%dMB.bin"), SizeMB);
+			TArray<uint8> Body;
+			Body.SetNumUninitialized(static_cast<int32>(NumBytes));
+			FMemory::Memset(Body.GetData(), 'x', NumBytes);
+			bool bFileServed = FFileHelper::SaveArrayToFile(Body, *BodyFile);
+			Body.Empty();
+			BodyFiles.Add(BodyFile);
+
+			double ResponseFileSeconds = 0.0;
+			if (bFileServed)
+			{
+				FWebBrowserResourceRules Rules;
+				FWebBrowserResourceRule& Rule = Rules.Rules.AddDefaulted_GetRef();
+				Rule.UrlPrefix = BodiesUrl + TEXT("body.bin");
+				Rule.Action = EWebBrowserResourceRuleAction::Respond;
+				Rule.ResponseMimeType = TEXT("application/octet-stream");
+				Rule.ResponseFile = BodyFile;
+				Window->SetResourceRules(Rules);
+
+				const FString ExpectedTitle = FString::Printf(TEXT("Bodies:%lld:1024"), NumBytes);
+				const FString FetchHtml = FString::Printf(TEXT(R"(<!DOCTYPE html><html><body><script>
+var Url = 'body.bin?size=%d';
+Promise.all([
+	fetch(Url).then(Response => Response.arrayBuffer()),
+	fetch(Url, { headers: { Range: 'bytes=-1024' } }).then(Response => Response.arrayBuffer())
+]).then(Buffers => { document.title = 'Bodies:' + Buffers[0].byteLength + ':' + Buffers[1].byteLength; },
+	() => { document.title = 'Bodies:Error'; });
+</script></body></html>)"), SizeMB);
+				Start = FPlatformTime::Seconds();
+				Window->LoadString(FetchHtml, BodiesUrl + TEXT("fetch.html"));
+				bFileServed = TickUntil([&Window]() { return Window->GetTitle().StartsWith(TEXT("Bodies:")); }, 60.0) && Window->GetTitle() == ExpectedTitle;
+				ResponseFileSeconds = FPlatformTime::Seconds() - Start;
+				Window->SetResourceRules(FWebBrowserResourceRules());
+			}
+
+			if (!bPageLoaded || !bFileServed)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] SchemeBodies: failed to serve %d MB, page %s, file %s"), TAG, SizeMB, bPageLoaded ? TEXT("loaded") : TEXT("failed"), bFileServed ? TEXT("served") : TEXT("failed"));
+				bCompleted = false;
+			}
+
+			TSharedRef<FJsonObject> BodyResult = MakeShared<FJsonObject>();
+			BodyResult->SetNumberField(TEXT("SizeMB"), SizeMB);
+			BodyResult->SetBoolField(TEXT("PageLoaded"), bPageLoaded);
+			BodyResult->SetBoolField(TEXT("FileServed"), bFileServed);
+			BodyResult->SetNumberField(TEXT("LoadStringMs"), LoadStringSeconds * 1000.0);
+			BodyResult->SetNumberField(TEXT("ResponseFileMs"), ResponseFileSeconds * 1000.0);
+			Bodies.Add(MakeShared<FJsonValueObject>(BodyResult));
+		}
+
+		Window->CloseBrowser(true, false);
+		Window.Reset();
+		TickUntil([]() { return false; }, 0.5);
+		for (const FString& BodyFile : BodyFiles)
+		{
+			IFileManager::Get().Delete(*BodyFile, false, false, true);
+		}
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("SchemeBodies"));
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+		Result->SetArrayField(TEXT("Bodies"), Bodies);
+		return Result;
+	}
+
+	/**
+	 * Creates many browsers in a request context while the authorization header allowlist holds many domains, then has one of them
+	 * request images from allowlisted and other hosts, timing how fast the requests reach the context's request delegate, which
+	 * gets the credential check result.
+	 */
+	TSharedPtr<FJsonObject> RunCredentialsScenario(IWebBrowserSingleton& Singleton, int32 NumWindows, int32 NumDomains)
+	{
+		constexpr int32 NumRequests = 1000;
+		const TCHAR* const ContextId = TEXT("CredentialsBenchmark");
+
+		TArray<FString> OriginalAllowList;
+		GConfig->GetArray(TEXT("Browser"), TEXT("AuthorizationHeaderAllowListURLS"), OriginalAllowList, GEngineIni);
+		TArray<FString> AllowList;
+		for (int32 Index = 0; Index < NumDomains; ++Index)
+		{
+			AllowList.Add(FString::Printf(TEXT("allow%03d.benchmark.local"), Index));
+		}
+		GConfig->SetArray(TEXT("Browser"), TEXT("AuthorizationHeaderAllowListURLS"), AllowList, GEngineIni);
+
+		struct FCredentialsCounters
+		{
+			int32 NumRequests = 0;
+			int32 NumAllowed = 0;
+			double FirstRequestTime = 0.0;
+			double LastRequestTime = 0.0;
+		};
+		TSharedRef<FCredentialsCounters> Counters = MakeShared<FCredentialsCounters>();
+
+		FBrowserContextSettings ContextSettings(ContextId);
+		ContextSettings.OnBeforeContextResourceRequest.BindLambda([Counters](const IWebBrowserResourceRequest& Request, FContextRequestHeaders& AdditionalHeaders)
+		{
+			if (Request.GetUrl().Contains(TEXT(".benchmark.local/")))
+			{
+				const double Now = FPlatformTime::Seconds();
+				if (Counters->NumRequests++ == 0)
+				{
+					Counters->FirstRequestTime = Now;
+				}
+				Counters->LastRequestTime = Now;
+				Counters->NumAllowed += Request.AllowsUserCredentials() ? 1 : 0;
+			}
+		});
+		Singleton.RegisterContext(ContextSettings);
+
+		// Requests go through the request context handler rather than the browser's
+		FCreateBrowserWindowSettings Settings;
+		Settings.InitialURL = TEXT("about:blank");
+		Settings.bInterceptLoadRequests = false;
+		Settings.Context = ContextSettings;
+		TArray<TSharedPtr<IWebBrowserWindow>> Windows;
+		for (int32 Index = 0; Index < NumWindows; ++Index)
+		{
+			if (TSharedPtr<IWebBrowserWindow> Window = Singleton.CreateBrowserWindow(Settings))
+			{
+				Windows.Add(Window);
+			}
+		}
+
+		bool bCompleted = false;
+		if (Windows.Num() > 0)
+		{
+			TickUntil([&Windows]()
+			{
+				return Windows.Last()->GetDocumentLoadingState() == EWebBrowserDocumentState::Completed;
+			}, 30.0);
+
+			// Half the images come from subdomains of allowlisted domains, the other half from hosts that only look similar
+			Windows.Last()->ExecuteJavascript(FString::Printf(TEXT(
+				"for (var Index = 0; Index < %d; ++Index) {"
+				"	var Image = new Image();"
+				"	var Domain = ('00' + (Index %% %d)).slice(-3);"
+				"	Image.src = (Index %% 2 == 0 ? 'http://cdn.allow' : 'http://notallow') + Domain + '.benchmark.local/' + Index + '.png';"
+				"}"), NumRequests, FMath::Max(NumDomains, 1)));
+			bCompleted = TickUntil([&Counters]() { return Counters->NumRequests >= NumRequests; }, 30.0);
+		}
+
+		for (const TSharedPtr<IWebBrowserWindow>& Window : Windows)
+		{
+			Window->CloseBrowser(true, false);
+		}
+		Windows.Reset();
+		TickUntil([]() { return false; }, 0.5);
+		Singleton.UnregisterContext(ContextId);
+		GConfig->SetArray(TEXT("Browser"), TEXT("AuthorizationHeaderAllowListURLS"), OriginalAllowList, GEngineIni);
+
+		if (!bCompleted)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Credentials: only %d of %d requests were seen"), TAG, Counters->NumRequests, NumRequests);
+		}
+
+		const double RequestSeconds = Counters->LastRequestTime - Counters->FirstRequestTime;
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("Credentials"));
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+		Result->SetNumberField(TEXT("Windows"), NumWindows);
+		Result->SetNumberField(TEXT("Domains"), NumDomains);
+		Result->SetNumberField(TEXT("Requests"), Counters->NumRequests);
+		Result->SetNumberField(TEXT("AllowedRequests"), Counters->NumAllowed);
+		Result->SetNumberField(TEXT("RequestMs"), RequestSeconds * 1000.0);
+		Result->SetNumberField(TEXT("RequestsPerSecond"), RequestSeconds > 0.0 ? Counters->NumRequests / RequestSeconds : 0.0);
+		return Result;
+	}
+
+	/**
+	 * Makes the same calls to the bridge object with a message per call and with the batched transport, without a render process,
+	 * comparing the cost of the browser side of both transports.
+	 */
+	TSharedPtr<FJsonObject> RunBridgeTransportScenario(int32 NumCalls, int32 CallsPerBatch)
+	{
+		UCustomWebBrowserBenchmarkBridge* Bridge = NewObject<UCustomWebBrowserBenchmarkBridge>();
+		Bridge->AddToRoot();
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("BridgeTransport"));
+		Result->SetNumberField(TEXT("Calls"), NumCalls);
+		Result->SetNumberField(TEXT("CallsPerBatch"), CallsPerBatch);
+
+		bool bCompleted = true;
+		for (const bool bBatched : { false, true })
+		{
+			const TCHAR* const TransportName = bBatched ? TEXT("Batched") : TEXT("Legacy");
+			FWebBrowserJSBridgeTransportStats Stats;
+			if (!FWebBrowserBenchmark::RunJSBridgeTransport(Bridge, TEXT("Pong"), NumCalls, bBatched, CallsPerBatch, Stats) || Stats.NumCompletedCalls != NumCalls)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] BridgeTransport: %d of %d %s calls completed"), TAG, Stats.NumCompletedCalls, NumCalls, TransportName);
+				bCompleted = false;
+			}
+
+			TSharedRef<FJsonObject> Transport = MakeShared<FJsonObject>();
+			Transport->SetNumberField(TEXT("CompletedCalls"), Stats.NumCompletedCalls);
+			Transport->SetNumberField(TEXT("MessagesSent"), Stats.NumMessagesSent);
+			Transport->SetNumberField(TEXT("MessagesReceived"), Stats.NumMessagesReceived);
+			Transport->SetNumberField(TEXT("Ms"), Stats.Seconds * 1000.0);
+			Transport->SetNumberField(TEXT("CallsPerSecond"), Stats.Seconds > 0.0 ? Stats.NumCompletedCalls / Stats.Seconds : 0.0);
+			Result->SetObjectField(TransportName, Transport);
+		}
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+
+		Bridge->RemoveFromRoot();
+		return Result;
+	}
+
+	/** Serializes structs of 10, 100 and 1000 fields the way the bridge passes them to the page */
+	TSharedPtr<FJsonObject> RunBridgeStructsScenario(int32 NumSerializations)
+	{
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("BridgeStructs"));
+		Result->SetNumberField(TEXT("Serializations"), NumSerializations);
+
+		bool bCompleted = true;
+		TArray<TSharedPtr<FJsonValue>> Structs;
+		for (const int32 NumFields : { 10, 100, 1000 })
+		{
+			FWebBrowserJSStructSerializationStats Stats;
+			if (!FWebBrowserBenchmark::RunJSStructSerialization(NumFields, NumSerializations, Stats))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] BridgeStructs: failed to serialize a struct of %d fields"), TAG, NumFields);
+				bCompleted = false;
+				continue;
+			}
+
+			TSharedRef<FJsonObject> Struct = MakeShared<FJsonObject>();
+			Struct->SetNumberField(TEXT("Fields"), NumFields);
+			Struct->SetNumberField(TEXT("FirstUs"), Stats.FirstSeconds * 1000000.0);
+			Struct->SetNumberField(TEXT("AverageUs"), Stats.NumSerializations > 0 ? Stats.Seconds / Stats.NumSerializations * 1000000.0 : 0.0);
+			Struct->SetNumberField(TEXT("FieldsPerSecond"), Stats.Seconds > 0.0 ? static_cast<double>(NumFields) * Stats.NumSerializations / Stats.Seconds : 0.0);
+			Struct->SetNumberField(TEXT("FirstAllocations"), static_cast<double>(Stats.FirstAllocations));
+			Struct->SetNumberField(TEXT("AllocationsPerSerialization"), Stats.NumSerializations > 0 ? static_cast<double>(Stats.NumAllocations) / Stats.NumSerializations : 0.0);
+			Structs.Add(MakeShared<FJsonValueObject>(Struct));
+		}
+		Result->SetArrayField(TEXT("Structs"), Structs);
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+		return Result;
+	}
+
+	/** Checks the accelerated paint backend selection and copies frames from a shared memory buffer with the null backend */
+	TSharedPtr<FJsonObject> RunAcceleratedPaintScenario(const FIntPoint& ViewportSize, int32 NumFrames)
+	{
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("AcceleratedPaint"));
+
+		FWebBrowserAcceleratedPaintStats Stats;
+		bool bCompleted = FWebBrowserBenchmark::RunAcceleratedPaintBackends(ViewportSize.X, ViewportSize.Y, NumFrames, Stats);
+		if (!bCompleted)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] AcceleratedPaint: accelerated paint is not available"), TAG);
+		}
+		if (Stats.NumSelectionMismatches > 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] AcceleratedPaint: %d of %d backend selections were unexpected"), TAG, Stats.NumSelectionMismatches, Stats.NumSelectionCases);
+			bCompleted = false;
+		}
+
+		const uint64 FrameBytes = static_cast<uint64>(ViewportSize.X) * ViewportSize.Y * 4;
+		if (Stats.bCanMapBuffers && (Stats.NumFramesCopied != NumFrames || Stats.BytesCopied != FrameBytes * NumFrames))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] AcceleratedPaint: copied %d of %d frames, %llu bytes"), TAG, Stats.NumFramesCopied, NumFrames, Stats.BytesCopied);
+			bCompleted = false;
+		}
+
+		Result->SetNumberField(TEXT("SelectionCases"), Stats.NumSelectionCases);
+		Result->SetNumberField(TEXT("SelectionMismatches"), Stats.NumSelectionMismatches);
+		Result->SetBoolField(TEXT("CanMapBuffers"), Stats.bCanMapBuffers);
+		Result->SetNumberField(TEXT("FramesCopied"), Stats.NumFramesCopied);
+		Result->SetNumberField(TEXT("BytesCopied"), static_cast<double>(Stats.BytesCopied));
+		Result->SetNumberField(TEXT("AverageCopyMs"), Stats.NumFramesCopied > 0 ? Stats.Seconds / Stats.NumFramesCopied * 1000.0 : 0.0);
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+		return Result;
+	}
+
+	/** Paints several HUDs through the upload budget, with a spike where every HUD repaints its whole view at once */
+	TSharedPtr<FJsonObject> RunUploadSpikeScenario(const FIntPoint& ViewportSize, int32 NumHuds, int32 NumFrames, int32 BudgetBytesPerFrame)
+	{
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), TEXT("UploadSpike"));
+		Result->SetNumberField(TEXT("Huds"), NumHuds);
+		Result->SetNumberField(TEXT("BudgetBytesPerFrame"), BudgetBytesPerFrame);
+
+		const int32 NumSpikeFrames = 5;
+		FWebBrowserUploadBudgetStats Stats;
+		bool bCompleted = FWebBrowserBenchmark::RunUploadBudget(NumHuds, ViewportSize.X, ViewportSize.Y, NumFrames, NumSpikeFrames, BudgetBytesPerFrame, Stats);
+		if (!bCompleted)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] UploadSpike: the upload scheduler is not available"), TAG);
+		}
+
+		// A deferred paint is forced once it waited more than webbrowser.Upload.MaxDeferFrames frames
+		if (Stats.MaxDeferredFrames > Stats.MaxDeferFrames + 1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] UploadSpike: a paint waited %d frames, the limit is %d"), TAG, Stats.MaxDeferredFrames, Stats.MaxDeferFrames + 1);
+			bCompleted = false;
+		}
+		if (Stats.NumDrainFrames > Stats.MaxDeferFrames + 1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] UploadSpike: deferred uploads were still queued %d frames after the last paint"), TAG, Stats.NumDrainFrames);
+			bCompleted = false;
+		}
+
+		Result->SetNumberField(TEXT("Paints"), Stats.NumPaints);
+		Result->SetNumberField(TEXT("PaintsDeferred"), Stats.NumPaintsDeferred);
+		Result->SetNumberField(TEXT("DeferredUploads"), Stats.NumDeferredUploads);
+		Result->SetNumberField(TEXT("BytesUploaded"), static_cast<double>(Stats.BytesUploaded));
+		Result->SetNumberField(TEXT("MaxFrameBytes"), static_cast<double>(Stats.MaxFrameBytes));
+		Result->SetNumberField(TEXT("FramesOverBudget"), Stats.NumFramesOverBudget);
+		Result->SetNumberField(TEXT("MaxQueued"), Stats.MaxQueued);
+		Result->SetNumberField(TEXT("MaxDeferredFrames"), Stats.MaxDeferredFrames);
+		Result->SetNumberField(TEXT("DrainFrames"), Stats.NumDrainFrames);
+		Result->SetNumberField(TEXT("AverageFrameUs"), NumFrames > 0 ? Stats.Seconds / NumFrames * 1000000.0 : 0.0);
+		Result->SetBoolField(TEXT("Completed"), bCompleted);
+		return Result;
+	}
+
+	/** Loads the scenario, drives it for the given time and returns its measurements, or nullptr on failure */
+	TSharedPtr<FJsonObject> RunScenario(IWebBrowserSingleton& Singleton, const FBenchmarkScenario& Scenario, double Seconds, const FIntPoint& ViewportSize)
+	{
+		FCreateBrowserWindowSettings Settings;
+		Settings.InitialURL = FString::Printf(TEXT("http://benchmark/%s.html"), *Scenario.Name);
+		Settings.ContentsToLoad = Scenario.Html;
+		Settings.BrowserFrameRate = 60;
+
+		TSharedPtr<IWebBrowserWindow> Window = Singleton.CreateBrowserWindow(Settings);
+		if (!Window.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to create a browser for %s"), TAG, *Scenario.Name);
+			return nullptr;
+		}
+		Window->SetViewportSize(ViewportSize);
+
+		UCustomWebBrowserBenchmarkBridge* Bridge = NewObject<UCustomWebBrowserBenchmarkBridge>();
+		Bridge->AddToRoot();
+		Window->BindUObject(BridgeBindingName, Bridge, true);
+
+		const bool bLoaded = TickUntil([&Window]()
+		{
+			const EWebBrowserDocumentState State = Window->GetDocumentLoadingState();
+			return State == EWebBrowserDocumentState::Completed || State == EWebBrowserDocumentState::Error;
+		}, 30.0) && Window->GetDocumentLoadingState() == EWebBrowserDocumentState::Completed;
+		if (!bLoaded)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to load %s"), TAG, *Scenario.Name);
+		}
+
+		const FWebBrowserWindowPerfStats Baseline = Window->GetPerfStats();
+		TArray<double> PumpTickSeconds;
+		PumpTickSeconds.Reserve(FMath::CeilToInt(Seconds / TickSeconds) + 1);
+
+		const FVector2D WheelPosition(ViewportSize.X * 0.5, ViewportSize.Y * 0.5);
+		int32 NumScrollEvents = 0;
+		int32 NextPingSequence = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		double LastTickTime = StartTime;
+		double NextScrollTime = StartTime;
+		double Now = StartTime;
+		while (Now - StartTime < Seconds)
+		{
+			PumpTickSeconds.Add(TickBrowsers(static_cast<float>(Now - LastTickTime)));
+			LastTickTime = Now;
+
+			// Requesting the texture is what the widget does when it draws
+			Window->GetTexture(false);
+
+			if (Scenario.bScroll && Now >= NextScrollTime)
+			{
+				const float WheelDelta = (NumScrollEvents / ScrollEventsPerDirection) % 2 == 0 ? -1.0f : 1.0f;
+				FPointerEvent WheelEvent(0, WheelPosition, WheelPosition, TSet<FKey>(), EKeys::MouseWheelAxis, WheelDelta, FModifierKeysState());
+				Window->OnMouseWheel(FGeometry(), WheelEvent, false);
+				NumScrollEvents++;
+				NextScrollTime += ScrollInputSeconds;
+			}
+
+			if (Scenario.bResize)
+			{
+				const double Phase = FMath::Fmod(Now - StartTime, ResizeCycleSeconds) / ResizeCycleSeconds;
+				const double WidthScale = 0.5 + 0.5 * FMath::Abs(FMath::Sin(Phase * UE_PI));
+				Window->SetViewportSize(FIntPoint(FMath::RoundToInt(ViewportSize.X * WidthScale), ViewportSize.Y));
+			}
+
+			if (Scenario.bBridge && (Bridge->PendingSequence == INDEX_NONE || Now - Bridge->PendingSendTime > BridgeTimeoutSeconds))
+			{
+				Bridge->PendingSequence = NextPingSequence++;
+				Bridge->PendingSendTime = FPlatformTime::Seconds();
+				Window->ExecuteJavascript(FString::Printf(TEXT("(function(b){(b.pong||b.Pong).call(b,%d);})(window.ue.benchmark);"), Bridge->PendingSequence));
+			}
+
+			const double FrameEnd = LastTickTime + TickSeconds;
+			Now = FPlatformTime::Seconds();
+			if (Now < FrameEnd)
+			{
+				FPlatformProcess::Sleep(static_cast<float>(FrameEnd - Now));
+				Now = FPlatformTime::Seconds();
+			}
+		}
+		const double ElapsedSeconds = Now - StartTime;
+		const FWebBrowserWindowPerfStats Stats = Window->GetPerfStats();
+
+		Window->UnbindUObject(BridgeBindingName, Bridge, true);
+		Window->CloseBrowser(true, false);
+		Window.Reset();
+		TickUntil([]() { return false; }, 0.5);
+
+		const uint64 NumPaints = Stats.NumPaints - Baseline.NumPaints;
+		const uint64 NumPresentedPaints = Stats.NumPresentedPaints - Baseline.NumPresentedPaints;
+		const double PaintToPresentSeconds = Stats.TotalPaintToPresentSeconds - Baseline.TotalPaintToPresentSeconds;
+
+		TSharedRef<FJsonObject> PaintToPresent = MakeShared<FJsonObject>();
+		PaintToPresent->SetNumberField(TEXT("Count"), static_cast<double>(NumPresentedPaints));
+		PaintToPresent->SetNumberField(TEXT("AverageMs"), NumPresentedPaints > 0 ? PaintToPresentSeconds / NumPresentedPaints * 1000.0 : 0.0);
+		// The window only tracks the largest delay since it was created, which includes the initial load
+		PaintToPresent->SetNumberField(TEXT("MaxMsSinceCreation"), Stats.MaxPaintToPresentSeconds * 1000.0);
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Name"), Scenario.Name);
+		Result->SetBoolField(TEXT("Loaded"), bLoaded);
+		Result->SetNumberField(TEXT("Seconds"), ElapsedSeconds);
+		Result->SetNumberField(TEXT("Paints"), static_cast<double>(NumPaints));
+		Result->SetNumberField(TEXT("PaintsPerSecond"), NumPaints / ElapsedSeconds);
+		Result->SetNumberField(TEXT("DirtyBytes"), static_cast<double>(Stats.DirtyBytes - Baseline.DirtyBytes));
+		Result->SetNumberField(TEXT("UploadedBytes"), static_cast<double>(Stats.UploadedBytes - Baseline.UploadedBytes));
+		Result->SetNumberField(TEXT("UploadedBytesPerSecond"), (Stats.UploadedBytes - Baseline.UploadedBytes) / ElapsedSeconds);
+		Result->SetNumberField(TEXT("AppliedResizes"), static_cast<double>(Stats.NumAppliedResizes - Baseline.NumAppliedResizes));
+		Result->SetNumberField(TEXT("SuppressedResizes"), static_cast<double>(Stats.NumSuppressedResizes - Baseline.NumSuppressedResizes));
+		Result->SetObjectField(TEXT("PaintToPresent"), PaintToPresent);
+		if (Scenario.bScroll)
+		{
+			// Coalesced dirty regions never add up to more than a full frame per paint, and stay below that when the paints were partial
+			const uint64 UploadedBytes = Stats.UploadedBytes - Baseline.UploadedBytes;
+			const uint64 DirtyBytes = Stats.DirtyBytes - Baseline.DirtyBytes;
+			const uint64 FullFrameBytes = NumPaints * ViewportSize.X * ViewportSize.Y * 4;
+			bool bUploadsCoalesced = UploadedBytes <= FullFrameBytes && (UploadedBytes == 0 || DirtyBytes >= FullFrameBytes || UploadedBytes < FullFrameBytes);
+			if (!bUploadsCoalesced)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] %s: uploaded %llu bytes for %llu dirty bytes, full frames would be %llu bytes"), TAG, *Scenario.Name, UploadedBytes, DirtyBytes, FullFrameBytes);
+			}
+
+			// Nothing is uploaded without a renderer, so the coalescing is also checked on fixed rect sets
+			FWebBrowserPaintCoalescingStats CoalescingStats;
+			const bool bCheckedCoalescing = FWebBrowserBenchmark::RunPaintRegionCoalescing(CoalescingStats);
+			const bool bCoalescingMatches = bCheckedCoalescing && CoalescingStats.NumRegionMismatches == 0 && CoalescingStats.NumByteMismatches == 0 && CoalescingStats.NumEstimateMismatches == 0;
+			if (!bCoalescingMatches)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] %s: of %d rect sets, %d coalesced into unexpected regions, %d into unexpected bytes and %d had unexpected estimates"), TAG, *Scenario.Name,
+					CoalescingStats.NumCases, CoalescingStats.NumRegionMismatches, CoalescingStats.NumByteMismatches, CoalescingStats.NumEstimateMismatches);
+			}
+			bUploadsCoalesced &= bCoalescingMatches;
+
+			TSharedRef<FJsonObject> Coalescing = MakeShared<FJsonObject>();
+			Coalescing->SetNumberField(TEXT("Cases"), CoalescingStats.NumCases);
+			Coalescing->SetNumberField(TEXT("RegionMismatches"), CoalescingStats.NumRegionMismatches);
+			Coalescing->SetNumberField(TEXT("ByteMismatches"), CoalescingStats.NumByteMismatches);
+			Coalescing->SetNumberField(TEXT("EstimateMismatches"), CoalescingStats.NumEstimateMismatches);
+			Result->SetObjectField(TEXT("Coalescing"), Coalescing);
+			Result->SetBoolField(TEXT("UploadsCoalesced"), bUploadsCoalesced);
+		}
+		if (!Stats.AcceleratedPaintBackend.IsNone())
+		{
+			const uint64 NumCopies = Stats.NumAcceleratedPaintCopies - Baseline.NumAcceleratedPaintCopies;
+			const double CopySeconds = Stats.TotalAcceleratedPaintCopySeconds - Baseline.TotalAcceleratedPaintCopySeconds;
+
+			TSharedRef<FJsonObject> AcceleratedPaint = MakeShared<FJsonObject>();
+			AcceleratedPaint->SetStringField(TEXT("Backend"), Stats.AcceleratedPaintBackend.ToString());
+			AcceleratedPaint->SetNumberField(TEXT("Copies"), static_cast<double>(NumCopies));
+			AcceleratedPaint->SetNumberField(TEXT("FailedCopies"), static_cast<double>(Stats.NumFailedAcceleratedPaintCopies - Baseline.NumFailedAcceleratedPaintCopies));
+			AcceleratedPaint->SetNumberField(TEXT("AverageCopyMs"), NumCopies > 0 ? CopySeconds / NumCopies * 1000.0 : 0.0);
+			AcceleratedPaint->SetNumberField(TEXT("MaxCopyMsSinceCreation"), Stats.MaxAcceleratedPaintCopySeconds * 1000.0);
+			Result->SetObjectField(TEXT("AcceleratedPaint"), AcceleratedPaint);
+		}
+		Result->SetObjectField(TEXT("PumpTick"), MakeDistribution(MoveTemp(PumpTickSeconds)));
+		Result->SetObjectField(TEXT("BridgeRoundTrip"), MakeDistribution(Bridge->RoundTripSeconds));
+
+		Bridge->RemoveFromRoot();
+		return Result;
+	}
+}
+
+/////////////////////////////////////////////////////
+/// UCustomWebBrowserBenchmarkBridge
+
+void UCustomWebBrowserBenchmarkBridge::Pong(int32 Sequence)
+{
+	if (Sequence == PendingSequence)
+	{
+		RoundTripSeconds.Add(FPlatformTime::Seconds() - PendingSendTime);
+		PendingSequence = INDEX_NONE;
+	}
+}
+
+/////////////////////////////////////////////////////
+/// UCustomWebBrowserBenchmarkCommandlet
+
+UCustomWebBrowserBenchmarkCommandlet::UCustomWebBrowserBenchmarkCommandlet()
+{
+	IsClient = true;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCustomWebBrowserBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString ScenarioNames = TEXT("Scroll,Animation,Bridge");
+	FParse::Value(*Params, TEXT("Scenarios="), ScenarioNames);
+	float Seconds = 10.0f;
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FIntPoint ViewportSize(1280, 720);
+	FParse::Value(*Params, TEXT("Width="), ViewportSize.X);
+	FParse::Value(*Params, TEXT("Height="), ViewportSize.Y);
+	FString FixturePath;
+	FParse::Value(*Params, TEXT("Fixture="), FixturePath);
+	int32 NumSchemeDomains = 1000;
+	FParse::Value(*Params, TEXT("SchemeDomains="), NumSchemeDomains);
+	int32 NumCredentialWindows = 50;
+	FParse::Value(*Params, TEXT("CredentialWindows="), NumCredentialWindows);
+	int32 NumCredentialDomains = 100;
+	FParse::Value(*Params, TEXT("CredentialDomains="), NumCredentialDomains);
+	int32 NumBridgeCalls = 10000;
+	FParse::Value(*Params, TEXT("BridgeCalls="), NumBridgeCalls);
+	int32 BridgeCallsPerBatch = 64;
+	FParse::Value(*Params, TEXT("BridgeCallsPerBatch="), BridgeCallsPerBatch);
+	int32 NumStructSerializations = 1000;
+	FParse::Value(*Params, TEXT("StructSerializations="), NumStructSerializations);
+	int32 NumAcceleratedPaintFrames = 600;
+	FParse::Value(*Params, TEXT("AcceleratedPaintFrames="), NumAcceleratedPaintFrames);
+	int32 NumUploadHuds = 8;
+	FParse::Value(*Params, TEXT("UploadHuds="), NumUploadHuds);
+	int32 NumUploadFrames = 600;
+	FParse::Value(*Params, TEXT("UploadFrames="), NumUploadFrames);
+	int32 UploadBudgetBytesPerFrame = 4 * 1024 * 1024;
+	FParse::Value(*Params, TEXT("UploadBudget="), UploadBudgetBytesPerFrame);
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("CustomWebBrowserBenchmark.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	IWebBrowserSingleton* Singleton = IWebBrowserModule::IsAvailable() && IWebBrowserModule::Get().IsWebModuleAvailable() ? IWebBrowserModule::Get().GetSingleton() : nullptr;
+	if (Singleton == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[%s] The web browser is not available, pass -AllowCommandletRendering"), TAG);
+		return 1;
+	}
+
+	TArray<FBenchmarkScenario> Scenarios;
+	bool bRunSchemes = false;
+	bool bRunSchemeBodies = false;
+	bool bRunCredentials = false;
+	bool bRunBridgeTransport = false;
+	bool bRunBridgeStructs = false;
+	bool bRunAcceleratedPaint = false;
+	bool bRunUploadSpike = false;
+	TArray<FString> Names;
+	ScenarioNames.ParseIntoArray(Names, TEXT(","));
+	for (const FString& Name : Names)
+	{
+		if (Name == TEXT("Scroll"))
+		{
+			Scenarios.Add({ Name, ScrollFixture, true, false });
+		}
+		else if (Name == TEXT("Animation"))
+		{
+			Scenarios.Add({ Name, AnimationFixture, false, false });
+		}
+		else if (Name == TEXT("Bridge"))
+		{
+			Scenarios.Add({ Name, BridgeFixture, false, true });
+		}
+		else if (Name == TEXT("Resize"))
+		{
+			Scenarios.Add({ Name, AnimationFixture, false, false, true });
+		}
+		else if (Name == TEXT("Schemes"))
+		{
+			bRunSchemes = true;
+		}
+		else if (Name == TEXT("SchemeBodies"))
+		{
+			bRunSchemeBodies = true;
+		}
+		else if (Name == TEXT("Credentials"))
+		{
+			bRunCredentials = true;
+		}
+		else if (Name == TEXT("BridgeTransport"))
+		{
+			bRunBridgeTransport = true;
+		}
+		else if (Name == TEXT("BridgeStructs"))
+		{
+			bRunBridgeStructs = true;
+		}
+		else if (Name == TEXT("AcceleratedPaint"))
+		{
+			bRunAcceleratedPaint = true;
+		}
+		else if (Name == TEXT("UploadSpike"))
+		{
+			bRunUploadSpike = true;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[%s] Unknown scenario %s"), TAG, *Name);
+		}
+	}
+	if (!FixturePath.IsEmpty())
+	{
+		FBenchmarkScenario& Fixture = Scenarios.AddDefaulted_GetRef();
+		Fixture.Name = FPaths::GetBaseFilename(FixturePath);
+		Fixture.bScroll = true;
+		if (!FFileHelper::LoadFileToString(Fixture.Html, *FixturePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to read fixture %s"), TAG, *FixturePath);
+			return 1;
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	bool bSucceeded = true;
+	for (const FBenchmarkScenario& Scenario : Scenarios)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running %s for %.1f seconds"), TAG, *Scenario.Name, Seconds);
+		if (TSharedPtr<FJsonObject> Result = RunScenario(*Singleton, Scenario, Seconds, ViewportSize))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] %s: %.1f paints/s"), TAG, *Scenario.Name, Result->GetNumberField(TEXT("PaintsPerSecond")));
+			bool bUploadsCoalesced = true;
+			Result->TryGetBoolField(TEXT("UploadsCoalesced"), bUploadsCoalesced);
+			bSucceeded &= Result->GetBoolField(TEXT("Loaded")) && bUploadsCoalesced;
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+		else
+		{
+			bSucceeded = false;
+		}
+	}
+
+	if (bRunSchemes)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running Schemes with %d domains"), TAG, NumSchemeDomains);
+		if (TSharedPtr<FJsonObject> Result = RunSchemeScenario(*Singleton, NumSchemeDomains))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] Schemes: registered in %.2f ms, loaded in %.1f ms"), TAG, Result->GetNumberField(TEXT("RegisterMs")), Result->GetNumberField(TEXT("LoadMs")));
+			bSucceeded &= Result->GetBoolField(TEXT("Loaded"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	if (bRunSchemeBodies)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running SchemeBodies"), TAG);
+		if (TSharedPtr<FJsonObject> Result = RunSchemeBodiesScenario(*Singleton))
+		{
+			for (const TSharedPtr<FJsonValue>& Body : Result->GetArrayField(TEXT("Bodies")))
+			{
+				UE_LOG(LogTemp, Display, TEXT("[%s] SchemeBodies: %d MB loaded in %.1f ms with LoadString, fetched in %.1f ms from a file"), TAG, (int32)Body->AsObject()->GetNumberField(TEXT("SizeMB")),
+					Body->AsObject()->GetNumberField(TEXT("LoadStringMs")), Body->AsObject()->GetNumberField(TEXT("ResponseFileMs")));
+			}
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+		else
+		{
+			bSucceeded = false;
+		}
+	}
+
+	if (bRunCredentials)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running Credentials with %d windows and %d domains"), TAG, NumCredentialWindows, NumCredentialDomains);
+		if (TSharedPtr<FJsonObject> Result = RunCredentialsScenario(*Singleton, NumCredentialWindows, NumCredentialDomains))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] Credentials: %.0f requests/s, %d of %d allowed"), TAG, Result->GetNumberField(TEXT("RequestsPerSecond")), (int32)Result->GetNumberField(TEXT("AllowedRequests")), (int32)Result->GetNumberField(TEXT("Requests")));
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	if (bRunBridgeTransport)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running BridgeTransport with %d calls"), TAG, NumBridgeCalls);
+		if (TSharedPtr<FJsonObject> Result = RunBridgeTransportScenario(NumBridgeCalls, BridgeCallsPerBatch))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] BridgeTransport: %.0f calls/s legacy, %.0f calls/s batched"), TAG,
+				Result->GetObjectField(TEXT("Legacy"))->GetNumberField(TEXT("CallsPerSecond")), Result->GetObjectField(TEXT("Batched"))->GetNumberField(TEXT("CallsPerSecond")));
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	if (bRunBridgeStructs)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running BridgeStructs with %d serializations per struct"), TAG, NumStructSerializations);
+		if (TSharedPtr<FJsonObject> Result = RunBridgeStructsScenario(NumStructSerializations))
+		{
+			for (const TSharedPtr<FJsonValue>& Struct : Result->GetArrayField(TEXT("Structs")))
+			{
+				UE_LOG(LogTemp, Display, TEXT("[%s] BridgeStructs: %d fields in %.1f us, %.1f allocations"), TAG, (int32)Struct->AsObject()->GetNumberField(TEXT("Fields")), Struct->AsObject()->GetNumberField(TEXT("AverageUs")), Struct->AsObject()->GetNumberField(TEXT("AllocationsPerSerialization")));
+			}
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	if (bRunAcceleratedPaint)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running AcceleratedPaint with %d frames"), TAG, NumAcceleratedPaintFrames);
+		if (TSharedPtr<FJsonObject> Result = RunAcceleratedPaintScenario(ViewportSize, NumAcceleratedPaintFrames))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] AcceleratedPaint: %d selections checked, %.2f ms per copy"), TAG, (int32)Result->GetNumberField(TEXT("SelectionCases")), Result->GetNumberField(TEXT("AverageCopyMs")));
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	if (bRunUploadSpike)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[%s] Running UploadSpike with %d HUDs and a budget of %d bytes per frame"), TAG, NumUploadHuds, UploadBudgetBytesPerFrame);
+		if (TSharedPtr<FJsonObject> Result = RunUploadSpikeScenario(ViewportSize, NumUploadHuds, NumUploadFrames, UploadBudgetBytesPerFrame))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[%s] UploadSpike: %d of %d paints deferred, %.0f bytes in the busiest frame, waited at most %d frames"), TAG,
+				(int32)Result->GetNumberField(TEXT("PaintsDeferred")), (int32)Result->GetNumberField(TEXT("Paints")), Result->GetNumberField(TEXT("MaxFrameBytes")), (int32)Result->GetNumberField(TEXT("MaxDeferredFrames")));
+			bSucceeded &= Result->GetBoolField(TEXT("Completed"));
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("Version"), 1);
+	Report->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	Report->SetNumberField(TEXT("Width"), ViewportSize.X);
+	Report->SetNumberField(TEXT("Height"), ViewportSize.Y);
+	Report->SetArrayField(TEXT("Scenarios"), Results);
+
+	FString ReportText;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(ReportText, *ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[%s] Failed to write %s"), TAG, *ReportPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("[%s] Wrote %s"), TAG, *ReportPath);
+
+	return bSucceeded ? 0 : 1;
+}
+
+#undef TAG
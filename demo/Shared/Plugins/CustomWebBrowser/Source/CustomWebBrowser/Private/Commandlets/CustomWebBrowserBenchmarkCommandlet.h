@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "CustomWebBrowserBenchmarkCommandlet.generated.h"
+
+/**
+ * Answers the JS bridge pings of the benchmark pages
+ */
+UCLASS()
+class UCustomWebBrowserBenchmarkBridge : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called from the page in reply to a ping
+	 *
+	 * @param Sequence Sequence number of the ping
+	 */
+	UFUNCTION()
+	void Pong(int32 Sequence);
+
+	/** Sequence number of the ping in flight, INDEX_NONE when there is none */
+	int32 PendingSequence = INDEX_NONE;
+
+	/** Time the ping in flight was sent */
+	double PendingSendTime = 0.0;
+
+	/** Measured round trips, in seconds */
+	TArray<double> RoundTripSeconds;
+};
+
+/**
+ * Headless benchmark of the off-screen web browser
+ *
+ * Loads LoadString fixtures into browser windows created the same way SWebBrowser creates them, drives scripted
+ * scrolling, CSS animations and JS bridge traffic, and writes OnPaint frequency, upload bytes, paint-to-present
+ * latency, message pump tick cost and bridge round-trip times to a JSON report. The Schemes scenario times registering a
+ * scheme handler for many domains, loading a page served by it and unregistering it. The SchemeBodies scenario times serving
+ * bodies of 1, 10 and 100 MB with LoadString and from a resource rule's ResponseFile. The Credentials scenario measures the
+ * rate of resource requests, each checked against the authorization header allowlist, with many browsers and domains.
+ * The Resize scenario animates the viewport width every tick and reports how many sizes reached the browser. A page
+ * scenario fails when its page or fixture doesn't finish loading. Scrolling scenarios fail when the uploaded bytes show the dirty regions were not coalesced, or when fixed sets of dirty rects, checked
+ * without a renderer, don't coalesce into the expected regions. The BridgeTransport scenario makes the same
+ * calls to a bound object with a message per call and with the batched transport, without a render process, and compares them.
+ * The BridgeStructs scenario times serializing structs of 10, 100 and 1000 fields for the page, and counts the allocations.
+ * Browsers using accelerated paint also report the frame copy counts and times of their backend. On Linux, passing
+ * -dpcvars=webbrowser.AcceleratedPaint.Backend=3 runs the null backend, which maps and copies frames without creating textures.
+ * The AcceleratedPaint scenario checks which backend is selected in every configuration and copies frames from a shared memory
+ * buffer with the null backend, without a browser or a GPU. The UploadSpike scenario paints several simulated HUDs through
+ * the texture upload budget, all repainting their whole view at once for a few frames, and reports how long paints waited.
+ *
+ * UnrealEditor-Cmd <Project> -run=CustomWebBrowserBenchmark -nullrhi -AllowCommandletRendering
+ *     [-Scenarios=Scroll,Animation,Bridge,BridgeTransport,BridgeStructs,Resize,Schemes,SchemeBodies,Credentials,AcceleratedPaint,UploadSpike]
+ *     [-Seconds=10] [-SchemeDomains=1000] [-CredentialWindows=50] [-CredentialDomains=100] [-BridgeCalls=10000]
+ *     [-BridgeCallsPerBatch=64] [-StructSerializations=1000] [-AcceleratedPaintFrames=600]
+ *     [-UploadHuds=8] [-UploadFrames=600] [-UploadBudget=4194304]
+ *     [-Width=1280] [-Height=720] [-Fixture=<html file>] [-Report=<json file>]
+ *
+ * CEF is disabled in commandlets unless -AllowCommandletRendering is passed. Without a Slate renderer nothing is
+ * uploaded, so upload bytes stay at zero under -nullrhi, and a paint counts as presented on the next benchmark tick.
+ */
+UCLASS()
+class UCustomWebBrowserBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCustomWebBrowserBenchmarkCommandlet();
+
+	//~ UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,6 +1,8 @@
 #include "Widget/CustomWebBrowser.h"
 
+#include "IWebBrowserSingleton.h"
 #include "SWebBrowser.h"
+#include "WebBrowserModule.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 
@@ -14,6 +16,19 @@
 
 #define LOCTEXT_NAMESPACE "CustomWebBrowser"
 
+namespace
+{
+	/** Arguments of the SWebBrowser the widget is built with. PrewarmBrowsers derives its settings from them, so the pool keys match. */
+	SWebBrowser::FArguments MakeWebBrowserArguments(bool bInSupportsTransparency)
+	{
+		SWebBrowser::FArguments Arguments;
+		Arguments
+			.ShowControls(false)
+			.SupportsTransparency(bInSupportsTransparency);
+		return Arguments;
+	}
+}
+
 /////////////////////////////////////////////////////
 /// UCustomWebBrowser
 
@@ -21,6 +36,8 @@ UCustomWebBrowser::UCustomWebBrowser(const FObjectInitializer& ObjectInitializer
 	: Super(ObjectInitializer)
 {
 	bIsVariable = true;
+	FrameRate = 0;
+	IdleFrameRate = 0;
 }
 
 void UCustomWebBrowser::LoadURL(FString NewURL)
@@ -67,6 +84,44 @@ FString UCustomWebBrowser::GetUrl() const
 	return FString();
 }
 
+void UCustomWebBrowser::PrewarmBrowsers(int32 NumBrowsers, bool bInSupportsTransparency)
+{
+	if (IWebBrowserModule::IsAvailable() && IWebBrowserModule::Get().IsWebModuleAvailable())
+	{
+		// The settings SWebBrowser creates its browser with, so RebuildWidget checks one of these out
+		const FCreateBrowserWindowSettings Settings = SWebBrowser::MakeBrowserWindowSettings(MakeWebBrowserArguments(bInSupportsTransparency));
+		IWebBrowserModule::Get().GetSingleton()->PrewarmBrowserWindows(Settings, NumBrowsers);
+	}
+}
+
+void UCustomWebBrowser::SetFrameRate(int32 InFrameRate)
+{
+	FrameRate = InFrameRate;
+	if (WebBrowserWidget.IsValid() && FrameRate > 0)
+	{
+		WebBrowserWidget->SetFrameRate(FrameRate);
+	}
+}
+
+int32 UCustomWebBrowser::GetFrameRate() const
+{
+	if (WebBrowserWidget.IsValid())
+	{
+		return WebBrowserWidget->GetFrameRate();
+	}
+
+	return FrameRate;
+}
+
+void UCustomWebBrowser::SetIdleFrameRate(int32 InIdleFrameRate)
+{
+	IdleFrameRate = InIdleFrameRate;
+	if (WebBrowserWidget.IsValid())
+	{
+		WebBrowserWidget->SetIdleFrameRate(IdleFrameRate);
+	}
+}
+
 void UCustomWebBrowser::ReleaseSlateResources(bool bReleaseChildren)
 {
 	Super::ReleaseSlateResources(bReleaseChildren);
@@ -88,16 +143,16 @@ TSharedRef<SWidget> UCustomWebBrowser::RebuildWidget()
 	}
 	else
 	{
-		WebBrowserWidget = SNew(SWebBrowser)
+		SWebBrowser::FArguments Arguments = MakeWebBrowserArguments(bSupportsTransparency);
+		Arguments
 			.InitialURL(InitialURL)
-			.ShowControls(false)
-			.SupportsTransparency(bSupportsTransparency)
 			.OnUrlChanged(BIND_UOBJECT_DELEGATE(FOnTextChanged, HandleOnUrlChanged))
 			.OnBeforePopup(BIND_UOBJECT_DELEGATE(FOnBeforePopupDelegate, HandleOnBeforePopup))
 			.OnLoadUrl(BIND_UOBJECT_DELEGATE(FOnLoadUrl, HandleOnLoadUrl))
 			.OnLoadStarted(BIND_UOBJECT_DELEGATE(FSimpleDelegate, HandleOnLoadStarted))
 			.OnLoadCompleted(BIND_UOBJECT_DELEGATE(FSimpleDelegate, HandleOnLoadCompleted))
 			.OnBeforeNavigation(BIND_UOBJECT_DELEGATE(FOnBeforeBrowse, HandleOnBeforeBrowse));
+		WebBrowserWidget = SArgumentNew(Arguments, SWebBrowser);
 
 		// https://dev.epicgames.com/documentation/en-us/unreal-engine/API/Runtime/WebBrowser/SWebBrowser/BindUObject?application_version=5.3
 		WebBrowserWidget->BindUObject(BIND_UOBJECT_NAME, this, true);
@@ -112,6 +167,11 @@ void UCustomWebBrowser::SynchronizeProperties()
 
 	if (WebBrowserWidget.IsValid())
 	{
+		if (FrameRate > 0)
+		{
+			WebBrowserWidget->SetFrameRate(FrameRate);
+		}
+		WebBrowserWidget->SetIdleFrameRate(IdleFrameRate);
 	}
 }
 
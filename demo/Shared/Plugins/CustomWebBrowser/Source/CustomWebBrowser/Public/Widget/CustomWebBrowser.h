@@ -66,6 +66,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Custom Web Browser")
 	FString GetUrl() const;
 
+	/**
+	 * Creates browsers in the background, so that the next Custom Web Browser widgets are constructed
+	 * from a warm browser instead of blocking while one starts up. Removed widgets return their browser to the pool.
+	 *
+	 * @param NumBrowsers Number of idle browsers to keep ready
+	 * @param bInSupportsTransparency Whether the widgets that will use them support transparency
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Custom Web Browser")
+	static void PrewarmBrowsers(int32 NumBrowsers, bool bInSupportsTransparency);
+
+	/**
+	 * Sets the rate the page renders at while it is visible and in use.
+	 *
+	 * @param InFrameRate Frame rate, from 1 to 60
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Custom Web Browser")
+	void SetFrameRate(int32 InFrameRate);
+
+	/**
+	 * Gets the rate the page renders at while it is visible and in use.
+	 *
+	 * @return The frame rate, or 0 if the platform can't change it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Custom Web Browser")
+	int32 GetFrameRate() const;
+
+	/**
+	 * Sets the rate the page drops to while it is hidden, the application is in the background,
+	 * or the widget is unfocused and hasn't received input for a while.
+	 *
+	 * @param InIdleFrameRate Idle frame rate, or 0 to always render at the active rate
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Custom Web Browser")
+	void SetIdleFrameRate(int32 InIdleFrameRate);
+
 	/** Called when the Url changes. */
 	UPROPERTY(BlueprintAssignable, Category = "Custom Web Browser|Event")
 	FOnUrlChanged OnUrlChanged;
@@ -94,6 +129,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category=Appearance)
 	bool bSupportsTransparency;
 
+	/** Rate the page renders at while in use, or 0 to keep the browser default. */
+	UPROPERTY(EditAnywhere, Category=Performance, meta=(ClampMin=0, ClampMax=60))
+	int32 FrameRate;
+
+	/** Rate the page drops to while hidden or idle, or 0 to always render at the active rate. */
+	UPROPERTY(EditAnywhere, Category=Performance, meta=(ClampMin=0, ClampMax=60))
+	int32 IdleFrameRate;
+
 protected:
 	// https://dev.epicgames.com/documentation/en-us/unreal-engine/API/Runtime/WebBrowser/SWebBrowser
 	TSharedPtr<class SWebBrowser> WebBrowserWidget;
@@ -257,6 +257,16 @@ public:
 		return ResourceLoadCompleteDelegate;
 	}
 
+	virtual FOnBeforeResourceRequestDelegate& OnBeforeResourceRequest() override
+	{
+		return BeforeResourceRequestDelegate;
+	}
+
+	virtual FOnResourceRequestCompleteDelegate& OnResourceRequestComplete() override
+	{
+		return ResourceRequestCompleteDelegate;
+	}
+
 	virtual FOnConsoleMessageDelegate& OnConsoleMessage() override
 	{
 		return ConsoleMessageDelegate;
@@ -409,6 +419,10 @@ private:
 	/** Delegate that allows for responses to resource loads */
 	FOnResourceLoadCompleteDelegate ResourceLoadCompleteDelegate;
 
+	/** Delegates for the same, passing the request details unconverted. Not executed on this platform. */
+	FOnBeforeResourceRequestDelegate BeforeResourceRequestDelegate;
+	FOnResourceRequestCompleteDelegate ResourceRequestCompleteDelegate;
+
 	/** Delegate that allows for response to console logs.  Typically used to capture and mirror web logs in client application logs. */
 	FOnConsoleMessageDelegate ConsoleMessageDelegate;
 
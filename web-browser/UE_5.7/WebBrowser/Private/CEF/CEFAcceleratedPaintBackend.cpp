@@ -0,0 +1,203 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFAcceleratedPaintBackend.h"
+
+#if WITH_CEF3
+
+#include "CEF/CEFPaintRegionUploader.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "Textures/SlateUpdatableTexture.h"
+#include "WebBrowserLog.h"
+
+#if WITH_ENGINE
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "Slate/SlateTextures.h"
+#endif
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/dma-buf.h>
+#endif
+
+namespace
+{
+	constexpr int32 BytesPerPixel = 4; // PF_B8G8R8A8
+
+	/** Enough for the frame being uploaded, the one queued behind it and the one being copied. */
+	constexpr int32 NumStagingBuffers = 3;
+
+#if PLATFORM_LINUX
+	/** Brackets CPU access to a dmabuf so the exporter can flush caches. Fails harmlessly on other kinds of buffers. */
+	void SyncDmaBuf(int32 Fd, uint64 Flags)
+	{
+		dma_buf_sync Sync = {};
+		Sync.flags = Flags | DMA_BUF_SYNC_READ;
+		while (ioctl(Fd, DMA_BUF_IOCTL_SYNC, &Sync) == -1 && (errno == EINTR || errno == EAGAIN))
+		{
+		}
+	}
+#endif
+}
+
+FCEFMappedPaintBackend::FCEFMappedPaintBackend(ECEFAcceleratedPaintBackend InType, FCEFStagingBufferPool& InStagingPool)
+	: Type(InType)
+	, StagingPool(InStagingPool)
+{
+	check(Type == ECEFAcceleratedPaintBackend::SharedMemory || Type == ECEFAcceleratedPaintBackend::Null);
+}
+
+ECEFAcceleratedPaintBackend FCEFMappedPaintBackend::GetType() const
+{
+	return Type;
+}
+
+bool FCEFMappedPaintBackend::CanMapBuffers()
+{
+#if PLATFORM_LINUX
+	return true;
+#else
+	return false;
+#endif
+}
+
+FSlateUpdatableTexture* FCEFMappedPaintBackend::CreateTexture(const FUintPoint& TextureSize)
+{
+	if (Type == ECEFAcceleratedPaintBackend::Null || !FSlateApplication::IsInitialized())
+	{
+		return nullptr;
+	}
+
+	FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+	if (Renderer == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Render a transparent texture until the first frame is uploaded
+	TArray<uint8> RawData;
+	RawData.AddZeroed(TextureSize.X * TextureSize.Y * BytesPerPixel);
+	FSlateUpdatableTexture* Texture = Renderer->CreateUpdatableTexture(TextureSize.X, TextureSize.Y);
+	if (Texture != nullptr)
+	{
+		Texture->UpdateTextureThreadSafeRaw(TextureSize.X, TextureSize.Y, RawData.GetData());
+	}
+	return Texture;
+}
+
+void FCEFMappedPaintBackend::ReleaseTexture(FSlateUpdatableTexture* Texture)
+{
+	if (Texture == nullptr || !FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	if (FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer())
+	{
+		Renderer->ReleaseUpdatableTexture(Texture);
+	}
+}
+
+bool FCEFMappedPaintBackend::CopyPaint(FSlateUpdatableTexture* Texture, const FCEFAcceleratedPaintInfo& Paint, uint64& OutBytesCopied)
+{
+	OutBytesCopied = 0;
+
+	if (Type == ECEFAcceleratedPaintBackend::SharedMemory && Texture == nullptr)
+	{
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFMappedPaintBackend::CopyPaint() - Invalid texture"));
+		return false;
+	}
+
+	const FCEFAcceleratedPaintPlane& Plane = Paint.Plane;
+	const uint64 RowBytes = static_cast<uint64>(Paint.Size.X) * BytesPerPixel;
+	const uint64 FrameBytes = RowBytes * Paint.Size.Y;
+	if (Paint.Size.X <= 0 || Paint.Size.Y <= 0 || Plane.Fd < 0 || Plane.Stride < RowBytes
+		|| Plane.Size < static_cast<uint64>(Plane.Stride) * (Paint.Size.Y - 1) + RowBytes || FrameBytes > MAX_int32)
+	{
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFMappedPaintBackend::CopyPaint() - Invalid %dx%d frame, stride %u, size %llu"), Paint.Size.X, Paint.Size.Y, Plane.Stride, Plane.Size);
+		return false;
+	}
+
+	if (!Paint.bIsLinear)
+	{
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFMappedPaintBackend::CopyPaint() - The buffer is tiled and can't be read by the CPU"));
+		return false;
+	}
+
+#if PLATFORM_LINUX
+	const uint64 MappedBytes = Plane.Offset + Plane.Size;
+	void* Mapped = mmap(nullptr, MappedBytes, PROT_READ, MAP_SHARED, Plane.Fd, 0);
+	if (Mapped == MAP_FAILED)
+	{
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFMappedPaintBackend::CopyPaint() - mmap failed, errno %d"), errno);
+		return false;
+	}
+
+	SyncDmaBuf(Plane.Fd, DMA_BUF_SYNC_START);
+
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Staging = StagingPool.Acquire(static_cast<int32>(FrameBytes), NumStagingBuffers);
+	const uint8* Source = static_cast<const uint8*>(Mapped) + Plane.Offset;
+	uint8* Dest = Staging->GetData();
+	if (Plane.Stride == RowBytes)
+	{
+		FMemory::Memcpy(Dest, Source, FrameBytes);
+	}
+	else
+	{
+		for (int32 Row = 0; Row < Paint.Size.Y; ++Row)
+		{
+			FMemory::Memcpy(Dest + Row * RowBytes, Source + static_cast<uint64>(Row) * Plane.Stride, RowBytes);
+		}
+	}
+
+	SyncDmaBuf(Plane.Fd, DMA_BUF_SYNC_END);
+	munmap(Mapped, MappedBytes);
+
+	OutBytesCopied = FrameBytes;
+	if (Type == ECEFAcceleratedPaintBackend::SharedMemory)
+	{
+		UploadStaging(Texture, Staging, Paint.Size);
+	}
+	return true;
+#else
+	UE_LOG(LogWebBrowser, Error, TEXT("FCEFMappedPaintBackend::CopyPaint() - missing implementation"));
+	return false;
+#endif // PLATFORM_LINUX
+}
+
+void FCEFMappedPaintBackend::UploadStaging(FSlateUpdatableTexture* Texture, const TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>& Staging, const FIntPoint& Size)
+{
+#if WITH_ENGINE
+	FSlateTexture2DRHIRef* SlateTexture = FCEFPaintRegionUploader::GetRHITexture(Texture);
+	if (SlateTexture == nullptr)
+	{
+		Texture->UpdateTextureThreadSafeRaw(Size.X, Size.Y, Staging->GetData());
+		return;
+	}
+
+	if (Texture->GetSlateResource()->GetWidth() != Size.X || Texture->GetSlateResource()->GetHeight() != Size.Y)
+	{
+		Texture->ResizeTexture(Size.X, Size.Y);
+	}
+
+	ENQUEUE_RENDER_COMMAND(CEFUploadMappedPaint)(
+		[SlateTexture, Staging, Size](FRHICommandListImmediate& RHICmdList)
+		{
+			FTextureRHIRef TextureRHI = SlateTexture->GetRHIRef();
+			if (!TextureRHI.IsValid() || TextureRHI->GetSizeXY() != Size)
+			{
+				return;
+			}
+
+			const FUpdateTextureRegion2D UpdateRegion(0, 0, 0, 0, Size.X, Size.Y);
+			RHICmdList.UpdateTexture2D(TextureRHI, 0, UpdateRegion, Size.X * BytesPerPixel, Staging->GetData());
+		});
+#else
+	Texture->UpdateTextureThreadSafeRaw(Size.X, Size.Y, Staging->GetData());
+#endif
+}
+
+#endif
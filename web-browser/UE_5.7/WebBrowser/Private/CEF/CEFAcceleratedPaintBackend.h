@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+class FSlateUpdatableTexture;
+class FCEFStagingBufferPool;
+
+/**
+ * The ways a frame CEF painted on the GPU can reach a Slate texture. Selected with webbrowser.AcceleratedPaint.Backend.
+ */
+enum class ECEFAcceleratedPaintBackend : int32
+{
+	/** No accelerated paint, CEF paints into a CPU buffer passed to OnPaint. */
+	None = 0,
+
+	/** The shared D3D11 texture is copied into a shared Slate texture on the GPU. Windows with a D3D RHI only. */
+	D3DSharedTexture = 1,
+
+	/** The dmabuf CEF painted into is mapped and copied into a pooled staging buffer, which is then uploaded to the Slate texture. Linux only. */
+	SharedMemory = 2,
+
+	/** Frames are mapped and copied into the staging buffers like SharedMemory, but no texture is created or updated, for tests. */
+	Null = 3,
+};
+
+/**
+ * A plane of a CPU mappable buffer CEF painted into.
+ */
+struct FCEFAcceleratedPaintPlane
+{
+	/** File descriptor of the buffer, only valid during the paint callback. */
+	int32 Fd = -1;
+
+	/** Bytes between rows, and position and size of the plane in the buffer. */
+	uint32 Stride = 0;
+	uint64 Offset = 0;
+	uint64 Size = 0;
+};
+
+/**
+ * A frame CEF painted on the GPU, as received by OnAcceleratedPaint.
+ */
+struct FCEFAcceleratedPaintInfo
+{
+	/** Shared texture handle, for backends copying on the GPU. */
+	void* SharedHandle = nullptr;
+
+	/** The B8G8R8A8 plane, for backends mapping the buffer. */
+	FCEFAcceleratedPaintPlane Plane;
+
+	/** Whether the buffer layout is linear. Tiled buffers can't be read by the CPU. */
+	bool bIsLinear = true;
+
+	/** Size of the frame and the dirty part of it. CEF currently always reports the whole frame as dirty. */
+	FIntPoint Size = FIntPoint::ZeroValue;
+	FIntRect DirtyRect;
+};
+
+/**
+ * Counters of an accelerated paint backend, accumulated since it was created.
+ */
+struct FCEFAcceleratedPaintStats
+{
+	/** Number of frames copied into a texture, and number of frames that could not be copied. */
+	uint64 NumCopies = 0;
+	uint64 NumFailedCopies = 0;
+
+	/** Bytes copied by the CPU. Copies on the GPU are not counted. */
+	uint64 BytesCopied = 0;
+
+	/** Total and longest time spent copying a frame, in seconds. */
+	double TotalCopySeconds = 0.0;
+	double MaxCopySeconds = 0.0;
+};
+
+/**
+ * Copies frames painted by CEF on the GPU into Slate textures. Owned by FCEFWebBrowserWindowRHIHelper, which picks the
+ * backend and keeps the counters. All methods are called on the game thread.
+ */
+class ICEFAcceleratedPaintBackend
+{
+public:
+	virtual ~ICEFAcceleratedPaintBackend() = default;
+
+	/** @return which backend this is. */
+	virtual ECEFAcceleratedPaintBackend GetType() const = 0;
+
+	/** @return a new texture for the backend to copy frames into, or nullptr if the backend doesn't need any. */
+	virtual FSlateUpdatableTexture* CreateTexture(const FUintPoint& TextureSize) = 0;
+
+	/** Releases a texture returned by CreateTexture. */
+	virtual void ReleaseTexture(FSlateUpdatableTexture* Texture) = 0;
+
+	/**
+	 * Copies a frame into a texture returned by CreateTexture, resizing the texture if needed.
+	 *
+	 * @param Texture The texture to copy into.
+	 * @param Paint The frame to copy.
+	 * @param OutBytesCopied Bytes copied by the CPU.
+	 * @return whether the texture holds the frame.
+	 */
+	virtual bool CopyPaint(FSlateUpdatableTexture* Texture, const FCEFAcceleratedPaintInfo& Paint, uint64& OutBytesCopied) = 0;
+};
+
+/**
+ * Backend for buffers the CPU can map, implementing both SharedMemory and Null.
+ *
+ * CEF on Linux paints into a dmabuf, which is mapped for the duration of the copy into a staging buffer from a pool
+ * owned by the RHI helper. The staging buffer is then uploaded to the Slate texture on the render thread, which saves
+ * the copy CEF makes into its own shared memory for OnPaint and the copy UpdateTextureThreadSafeRaw makes of that.
+ * The Null backend stops after the staging copy, so the mapping and copy logic can run on machines without a GPU.
+ */
+class FCEFMappedPaintBackend : public ICEFAcceleratedPaintBackend
+{
+public:
+	/**
+	 * @param Type SharedMemory or Null.
+	 * @param StagingPool The pool frames are copied into, which must outlive the backend.
+	 */
+	FCEFMappedPaintBackend(ECEFAcceleratedPaintBackend Type, FCEFStagingBufferPool& StagingPool);
+
+	virtual ECEFAcceleratedPaintBackend GetType() const override;
+	virtual FSlateUpdatableTexture* CreateTexture(const FUintPoint& TextureSize) override;
+	virtual void ReleaseTexture(FSlateUpdatableTexture* Texture) override;
+	virtual bool CopyPaint(FSlateUpdatableTexture* Texture, const FCEFAcceleratedPaintInfo& Paint, uint64& OutBytesCopied) override;
+
+	/** @return whether buffers can be mapped on this platform. */
+	static bool CanMapBuffers();
+
+private:
+	/** Uploads the frame in the staging buffer into the texture. */
+	void UploadStaging(FSlateUpdatableTexture* Texture, const TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>& Staging, const FIntPoint& Size);
+
+	ECEFAcceleratedPaintBackend Type;
+	FCEFStagingBufferPool& StagingPool;
+};
+
+#endif
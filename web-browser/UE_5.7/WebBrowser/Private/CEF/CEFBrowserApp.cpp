@@ -6,6 +6,7 @@
 #if WITH_CEF3
 #include "WebBrowserLog.h"
 #include "CEF/CEFWebBrowserWindowRHIHelper.h"
+#include "WebBrowserStats.h"
 
 //#define DEBUG_CEFMESSAGELOOP_FRAMERATE 1 // uncomment this to have debug spew about the FPS we call the CefDoMessageLoopWork function
 
@@ -18,8 +19,9 @@ static FAutoConsoleVariableRef CVarCEFGPUAcceleration(
 	TEXT("Enables GPU acceleration in CEF\n"),
 	ECVF_Default);
 
+DECLARE_CYCLE_STAT(TEXT("CEF Message Loop Work"), STAT_CEFMessageLoopWork, STATGROUP_WebBrowser);
+
 FCEFBrowserApp::FCEFBrowserApp()
-	: MessagePumpCountdown(0)
 {
 }
 
@@ -85,61 +87,30 @@ void FCEFBrowserApp::OnScheduleMessagePumpWork(int64 delay_ms)
 void FCEFBrowserApp::OnScheduleMessagePumpWork(int64_t delay_ms)
 #endif
 {
-	FScopeLock Lock(&MessagePumpCountdownCS);
-
-	// As per CEF documentation, if delay_ms is <= 0, then the call to CefDoMessageLoopWork should happen reasonably soon.  If delay_ms is > 0, then the call
-	//  to CefDoMessageLoopWork should be scheduled to happen after the specified delay and any currently pending scheduled call should be canceled.
-	if(delay_ms < 0)
-	{
-		delay_ms = 0;
-	}
-	MessagePumpCountdown = delay_ms;
+	MessagePumpScheduler.ScheduleWork(delay_ms);
 }
 
-bool FCEFBrowserApp::TickMessagePump(float DeltaTime, bool bForce)
+bool FCEFBrowserApp::TickMessagePump(const FCEFMessagePumpActivity& Activity)
 {
-	bool bPump = false;
+	if (!MessagePumpScheduler.ShouldPump(Activity))
 	{
-		FScopeLock Lock(&MessagePumpCountdownCS);
-		
-		// count down in order to call message pump
-		if (MessagePumpCountdown >= 0)
-		{
-			MessagePumpCountdown -= (DeltaTime * 1000);
-			if (MessagePumpCountdown <= 0)
-			{
-				bPump = true;
-			}
-			
-			if (bPump || bForce)
-			{
-				// -1 indicates that no countdown is currently happening
-				MessagePumpCountdown = -1;
-			}
-		}
+		return false;
 	}
-	
+
 #ifdef  DEBUG_CEFMESSAGELOOP_FRAMERATE
-	static float SecondsFrameRate = 0;
-	static int NumFrames = 0;
-	SecondsFrameRate += DeltaTime;
-#endif
-	if (bPump || bForce)
+	const FCEFMessagePumpStats& Stats = MessagePumpScheduler.GetStats();
+	if ((Stats.NumScheduledPumps + Stats.NumForcedPumps) % 100 == 0)
 	{
-#ifdef DEBUG_CEFMESSAGELOOP_FRAMERATE
-		++NumFrames;
-		if (NumFrames % 100 == 0 || SecondsFrameRate > 5.0f)
-		{
-			UE_LOG(LogWebBrowser, Error, TEXT("CefDoMessageLoopWork call Frame Rate %0.2f"), NumFrames / SecondsFrameRate);
-			SecondsFrameRate = 0;
-			NumFrames = 0;
-		}
+		UE_LOG(LogWebBrowser, Error, TEXT("CefDoMessageLoopWork call Frame Rate %0.2f, work latency avg %0.2fms max %0.2fms"), Stats.PumpsPerSecond, Stats.AverageWorkLatencyMs, Stats.MaxWorkLatencyMs);
+	}
 #endif
 
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CEFMessageLoopWork);
 		CefDoMessageLoopWork();
-		return true;
 	}
-	return false;
+	MessagePumpScheduler.OnPumped();
+	return true;
 }
 
 #if CEF_VERSION_MAJOR >= 128
@@ -3,11 +3,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Misc/ScopeLock.h"
 
 #if WITH_CEF3
 
 #include "CEFLibCefIncludes.h"
+#include "CEF/CEFMessagePumpScheduler.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCEFBrowser, Log, All);
 
@@ -24,8 +24,16 @@ public:
 	 */
 	FCEFBrowserApp();
 
-	/** Used to pump the CEF message loop whenever OnScheduleMessagePumpWork is triggered */
-	bool TickMessagePump(float DeltaTime, bool bForce);
+	/**
+	 * Used to pump the CEF message loop whenever OnScheduleMessagePumpWork work is due, or at the rate the scheduler forces for the given activity.
+	 *
+	 * @param Activity The state of the browser windows.
+	 * @return true if CefDoMessageLoopWork was called.
+	 */
+	bool TickMessagePump(const FCEFMessagePumpActivity& Activity);
+
+	/** @return the scheduler that decides when the message loop is pumped. */
+	const FCEFMessagePumpScheduler& GetMessagePumpScheduler() const { return MessagePumpScheduler; }
 
 private:
 	// CefApp methods.
@@ -43,9 +51,7 @@ private:
 	// Include the default reference counting implementation.
 	IMPLEMENT_REFCOUNTING(FCEFBrowserApp);
 
-	// Lock for access MessagePumpCountdown
-	FCriticalSection MessagePumpCountdownCS;
-	// Countdown in milliseconds until CefDoMessageLoopWork is called.  Updated by OnScheduleMessagePumpWork
-	int64 MessagePumpCountdown;
+	// Decides when CefDoMessageLoopWork is called.  Updated by OnScheduleMessagePumpWork
+	FCEFMessagePumpScheduler MessagePumpScheduler;
 };
 #endif
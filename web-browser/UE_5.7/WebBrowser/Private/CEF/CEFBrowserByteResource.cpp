@@ -4,22 +4,85 @@
 
 #if WITH_CEF3
 
-FCEFBrowserByteResource::FCEFBrowserByteResource(const CefRefPtr<CefPostDataElement>& PostData, const FString& InMimeType)
-	: Position(0)
-	, Buffer(nullptr)
-	, MimeType(InMimeType)
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "WebBrowserLog.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resource Bytes Served"), STAT_CEFResourceBytesServed, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resource Range Requests"), STAT_CEFResourceRangeRequests, STATGROUP_WebBrowser);
+DECLARE_MEMORY_STAT(TEXT("CEF Mapped Resource Bytes"), STAT_CEFMappedResourceBytes, STATGROUP_WebBrowser);
+
+FCEFResourceBody::FCEFResourceBody()
+	: Data(nullptr)
+	, Size(0)
+{
+}
+
+FCEFResourceBody::~FCEFResourceBody()
+{
+	if (MappedRegion.IsValid())
+	{
+		DEC_MEMORY_STAT_BY(STAT_CEFMappedResourceBytes, Size);
+	}
+}
+
+TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe> FCEFResourceBody::FromBytes(TArray64<uint8>&& InBytes)
+{
+	TSharedRef<FCEFResourceBody, ESPMode::ThreadSafe> Body = MakeShareable(new FCEFResourceBody());
+	Body->Bytes = MoveTemp(InBytes);
+	Body->Data = Body->Bytes.GetData();
+	Body->Size = Body->Bytes.Num();
+	return Body;
+}
+
+TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe> FCEFResourceBody::FromString(const FString& Contents)
+{
+	// Convert straight into the body, rather than into a temporary that would then be copied
+	TArray64<uint8> UTF8Bytes;
+	const int32 UTF8Length = FPlatformString::ConvertedLength<UTF8CHAR>(*Contents, Contents.Len());
+	UTF8Bytes.SetNumUninitialized(UTF8Length);
+	FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(UTF8Bytes.GetData()), UTF8Length, *Contents, Contents.Len());
+	return FromBytes(MoveTemp(UTF8Bytes));
+}
+
+TSharedPtr<const FCEFResourceBody, ESPMode::ThreadSafe> FCEFResourceBody::FromFile(const FString& Filename)
 {
-	Size = PostData->GetBytesCount();
-	if (Size > 0)
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile.IsValid() && MappedFile->GetFileSize() > 0)
+	{
+		TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion());
+		if (MappedRegion.IsValid())
+		{
+			TSharedRef<FCEFResourceBody, ESPMode::ThreadSafe> Body = MakeShareable(new FCEFResourceBody());
+			Body->Data = MappedRegion->GetMappedPtr();
+			Body->Size = MappedRegion->GetMappedSize();
+			Body->MappedFile = MoveTemp(MappedFile);
+			Body->MappedRegion = MoveTemp(MappedRegion);
+			INC_MEMORY_STAT_BY(STAT_CEFMappedResourceBytes, Body->Size);
+			return Body;
+		}
+	}
+
+	// Mapping is not supported everywhere (and not for empty files), fall back to loading the file
+	TArray64<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *Filename))
 	{
-		Buffer = new unsigned char[Size];
-		PostData->GetBytes(Size, Buffer);
+		UE_LOG(LogWebBrowser, Warning, TEXT("Failed to read resource file %s."), *Filename);
+		return nullptr;
 	}
+	return FromBytes(MoveTemp(FileBytes));
 }
 
-FCEFBrowserByteResource::~FCEFBrowserByteResource()
+FCEFBrowserByteResource::FCEFBrowserByteResource(const TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe>& InBody, const FString& InMimeType)
+	: Body(InBody)
+	, MimeType(InMimeType)
+	, RangeStart(0)
+	, RangeEnd(InBody->Num())
+	, Position(0)
+	, Status(200)
 {
-	delete[] Buffer;
 }
 
 void FCEFBrowserByteResource::Cancel()
@@ -36,27 +99,137 @@ void FCEFBrowserByteResource::GetResponseHeaders(CefRefPtr<CefResponse> Response
 	CefString& RedirectUrl)
 {
 	Response->SetMimeType(TCHAR_TO_WCHAR(*MimeType));
-	Response->SetStatus(200);
-	Response->SetStatusText("OK");
-	ResponseLength = Size;
+
+	CefResponse::HeaderMap HeaderMap;
+	HeaderMap.insert(std::make_pair(CefString("Accept-Ranges"), CefString("bytes")));
+	if (Status == 206)
+	{
+		Response->SetStatus(206);
+		Response->SetStatusText("Partial Content");
+		HeaderMap.insert(std::make_pair(CefString("Content-Range"), CefString(TCHAR_TO_WCHAR(*FString::Printf(TEXT("bytes %lld-%lld/%lld"), RangeStart, RangeEnd - 1, Body->Num())))));
+	}
+	else if (Status == 416)
+	{
+		Response->SetStatus(416);
+		Response->SetStatusText("Range Not Satisfiable");
+		HeaderMap.insert(std::make_pair(CefString("Content-Range"), CefString(TCHAR_TO_WCHAR(*FString::Printf(TEXT("bytes */%lld"), Body->Num())))));
+	}
+	else
+	{
+		Response->SetStatus(200);
+		Response->SetStatusText("OK");
+	}
+	Response->SetHeaderMap(HeaderMap);
+	ResponseLength = RangeEnd - RangeStart;
 }
 
 bool FCEFBrowserByteResource::ProcessRequest(CefRefPtr<CefRequest> Request, CefRefPtr<CefCallback> Callback)
 {
+	const CefString RangeHeader = Request->GetHeaderByName("Range");
+	if (!RangeHeader.empty())
+	{
+		ParseRange(RangeHeader);
+	}
+	Position = RangeStart;
+
 	Callback->Continue();
 	return true;
 }
 
+void FCEFBrowserByteResource::ParseRange(const CefString& RangeHeader)
+{
+	// Only a single "bytes=" range is supported, anything else is answered with the whole body as allowed by RFC 9110
+	FString Range = WCHAR_TO_TCHAR(RangeHeader.ToWString().c_str());
+	Range.TrimStartAndEndInline();
+	if (!Range.RemoveFromStart(TEXT("bytes="), ESearchCase::IgnoreCase) || Range.Contains(TEXT(",")))
+	{
+		return;
+	}
+
+	FString First;
+	FString Last;
+	if (!Range.Split(TEXT("-"), &First, &Last))
+	{
+		return;
+	}
+	First.TrimStartAndEndInline();
+	Last.TrimStartAndEndInline();
+	if ((!First.IsEmpty() && !First.IsNumeric()) || (!Last.IsEmpty() && !Last.IsNumeric()) || (First.IsEmpty() && Last.IsEmpty()))
+	{
+		return;
+	}
+
+	const int64 BodySize = Body->Num();
+	int64 Start;
+	int64 End;
+	if (First.IsEmpty())
+	{
+		// Suffix range, the last N bytes. An empty suffix can't be satisfied.
+		const int64 SuffixLength = FCString::Atoi64(*Last);
+		Start = SuffixLength > 0 ? FMath::Max<int64>(BodySize - SuffixLength, 0) : BodySize;
+		End = BodySize;
+	}
+	else
+	{
+		Start = FCString::Atoi64(*First);
+		End = BodySize;
+		if (!Last.IsEmpty())
+		{
+			const int64 LastByte = FCString::Atoi64(*Last);
+			if (LastByte < Start)
+			{
+				// An invalid range is ignored
+				return;
+			}
+			End = FMath::Min<int64>(LastByte + 1, BodySize);
+		}
+	}
+
+	INC_DWORD_STAT(STAT_CEFResourceRangeRequests);
+	if (Start >= BodySize)
+	{
+		Status = 416;
+		RangeStart = 0;
+		RangeEnd = 0;
+		return;
+	}
+
+	Status = 206;
+	RangeStart = Start;
+	RangeEnd = End;
+}
+
 bool FCEFBrowserByteResource::ReadResponse(void* DataOut, int BytesToRead, int& BytesRead, CefRefPtr<CefCallback> Callback)
 {
-	int32 BytesLeft = Size - Position;
-	BytesRead = BytesLeft >= BytesToRead ? BytesToRead : BytesLeft;
+	// The body is immutable and fully available, so every read completes synchronously straight from it
+	const int64 BytesLeft = RangeEnd - Position;
+	BytesRead = static_cast<int>(FMath::Min<int64>(BytesLeft, BytesToRead));
 	if (BytesRead > 0)
 	{
-		FMemory::Memcpy(DataOut, Buffer + Position, BytesRead);
+		FMemory::Memcpy(DataOut, Body->GetData() + Position, BytesRead);
 		Position += BytesRead;
+		INC_DWORD_STAT_BY(STAT_CEFResourceBytesServed, BytesRead);
 		return true;
 	}
 	return false;
 }
+
+#if CEF_VERSION_MAJOR < 128
+bool FCEFBrowserByteResource::Skip(int64 BytesToSkip, int64& BytesSkipped, CefRefPtr<CefResourceSkipCallback> Callback)
+#else
+bool FCEFBrowserByteResource::Skip(int64_t BytesToSkip, int64_t& BytesSkipped, CefRefPtr<CefResourceSkipCallback> Callback)
+#endif
+{
+	const int64 NumBytes = FMath::Min<int64>(BytesToSkip, RangeEnd - Position);
+	if (NumBytes <= 0)
+	{
+		// Skipping past the end of the body is a failure, CEF would otherwise wait for bytes that never come
+		BytesSkipped = ERR_FAILED;
+		return false;
+	}
+
+	BytesSkipped = NumBytes;
+	Position += NumBytes;
+	return true;
+}
 #endif
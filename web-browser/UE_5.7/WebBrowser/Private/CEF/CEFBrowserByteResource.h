@@ -9,20 +9,72 @@
 
 #include "CEFLibCefIncludes.h"
 
+class IMappedFileHandle;
+class IMappedFileRegion;
 
+/**
+ * An immutable response body, shared between the resource handlers serving it.
+ *
+ * The bytes are either owned by the body or mapped from a file, and are never copied again once the body is created.
+ */
+class FCEFResourceBody
+{
+public:
+	~FCEFResourceBody();
+
+	/** Creates a body taking ownership of the bytes. */
+	static TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe> FromBytes(TArray64<uint8>&& InBytes);
+
+	/** Creates a body holding the UTF-8 encoding of the string, converted in place. */
+	static TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe> FromString(const FString& Contents);
+
+	/**
+	 * Creates a body serving the contents of a file. The file is memory mapped when the platform supports it, otherwise it is loaded.
+	 *
+	 * @param Filename The file to serve.
+	 * @return The body, or nullptr if the file could not be read.
+	 */
+	static TSharedPtr<const FCEFResourceBody, ESPMode::ThreadSafe> FromFile(const FString& Filename);
+
+	const uint8* GetData() const
+	{
+		return Data;
+	}
+
+	int64 Num() const
+	{
+		return Size;
+	}
+
+private:
+	FCEFResourceBody();
+
+	/** Owned bytes, when the body is not mapped. */
+	TArray64<uint8> Bytes;
+
+	/** The mapped file. The region is declared last so it is unmapped before the handle is closed. */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const uint8* Data;
+	int64 Size;
+};
 
 /**
- * Implements a resource handler that will return the contents of a string as the result.
+ * Implements a resource handler that streams a shared response body as the result.
+ *
+ * Single byte range requests are answered with 206 Partial Content, so media elements can seek in large bodies.
  */
 class FCEFBrowserByteResource
 	: public CefResourceHandler
 {
 public:
 	/**
+	 * @param InBody The body to serve. It is referenced, not copied.
+	 * @param InMimeType The mime type of the response.
 	 */
-	FCEFBrowserByteResource(const CefRefPtr<CefPostDataElement>& PostData, const FString& InMimeType);
-	~FCEFBrowserByteResource();
-	
+	FCEFBrowserByteResource(const TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe>& InBody, const FString& InMimeType);
+
 	// CefResourceHandler interface
 	virtual void Cancel() override;
 	virtual void GetResponseHeaders(CefRefPtr<CefResponse> Response,
@@ -34,13 +86,29 @@ public:
 		CefString& RedirectUrl) override;
 	virtual bool ProcessRequest(CefRefPtr<CefRequest> Request, CefRefPtr<CefCallback> Callback) override;
 	virtual bool ReadResponse(void* DataOut, int BytesToRead, int& BytesRead, CefRefPtr<CefCallback> Callback) override;
-	
+#if CEF_VERSION_MAJOR < 128
+	virtual bool Skip(int64 BytesToSkip, int64& BytesSkipped, CefRefPtr<CefResourceSkipCallback> Callback) override;
+#else
+	virtual bool Skip(int64_t BytesToSkip, int64_t& BytesSkipped, CefRefPtr<CefResourceSkipCallback> Callback) override;
+#endif
+
 private:
-	int32 Position;
-	int32 Size;
-	unsigned char* Buffer;
+	/** Parses the Range header of the request into RangeStart and RangeEnd. */
+	void ParseRange(const CefString& RangeHeader);
+
+	TSharedRef<const FCEFResourceBody, ESPMode::ThreadSafe> Body;
 	FString MimeType;
-	
+
+	/** The served range, end exclusive. */
+	int64 RangeStart;
+	int64 RangeEnd;
+
+	/** Next byte to serve. */
+	int64 Position;
+
+	/** Response status, 200, 206 or 416. */
+	int32 Status;
+
 	// Include the default reference counting implementation.
 	IMPLEMENT_REFCOUNTING(FCEFBrowserByteResource);
 };
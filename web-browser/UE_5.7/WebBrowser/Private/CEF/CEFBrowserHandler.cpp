@@ -19,6 +19,10 @@
 #include "HAL/ThreadingBase.h"
 #include "PlatformHttp.h"
 #include "Misc/CommandLine.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resource Loads Handled On IO Thread"), STAT_CEFResourceLoadsIOThread, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resource Loads Handled On Game Thread"), STAT_CEFResourceLoadsGameThread, STATGROUP_WebBrowser);
 
 #define LOCTEXT_NAMESPACE "WebBrowserHandler"
 
@@ -42,12 +46,12 @@ void LogCEFLoad(const FString &Msg, CefRefPtr<CefRequest> Request)
 // Used to force returning custom content instead of performing a request.
 const FString CustomContentMethod(TEXT("X-GET-CUSTOM-CONTENT"));
 
-FCEFBrowserHandler::FCEFBrowserHandler(bool InUseTransparency, bool InInterceptLoadRequests, const TArray<FString>& InAltRetryDomains, const TArray<FString>& InAuthorizationHeaderAllowListURLS)
+FCEFBrowserHandler::FCEFBrowserHandler(bool InUseTransparency, bool InInterceptLoadRequests, const TArray<FString>& InAltRetryDomains, const TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe>& InAuthorizationHeaderAllowList)
 : bUseTransparency(InUseTransparency), 
 bAllowAllCookies(false),
 bInterceptLoadRequests(InInterceptLoadRequests),
 AltRetryDomains(InAltRetryDomains),
-AuthorizationHeaderAllowListURLS(InAuthorizationHeaderAllowListURLS)
+AuthorizationHeaderAllowList(InAuthorizationHeaderAllowList)
 {
 	// should we forcefully allow all cookies to be set rather than filtering a couple store side ones
 	bAllowAllCookies = FParse::Param(FCommandLine::Get(), TEXT("CefAllowAllCookies"));
@@ -129,6 +133,12 @@ void FCEFBrowserHandler::OnAfterCreated(CefRefPtr<CefBrowser> Browser)
 			Browser->GetHost()->CloseBrowser(true);
 		}
 	}
+	else if (BrowserCreatedDelegate.IsBound())
+	{
+		FOnBrowserCreatedDelegate Delegate = BrowserCreatedDelegate;
+		BrowserCreatedDelegate.Unbind();
+		Delegate.Execute(Browser);
+	}
 }
 
 bool FCEFBrowserHandler::DoClose(CefRefPtr<CefBrowser> Browser)
@@ -206,6 +216,7 @@ bool FCEFBrowserHandler::OnBeforePopup( CefRefPtr<CefBrowser> Browser,
 
 		CefRefPtr<FCEFBrowserHandler> NewHandler(new FCEFBrowserHandler(shouldUseTransparency, true /*InterceptLoadRequests*/));
 		NewHandler->ParentHandler = this;
+		NewHandler->SetRequestHeaders(RequestHeaders);
 		NewHandler->SetPopupFeatures(NewBrowserPopupFeatures);
 		OutClient = NewHandler;
 
@@ -284,6 +295,12 @@ void FCEFBrowserHandler::OnLoadError(CefRefPtr<CefBrowser> Browser,
 
 void FCEFBrowserHandler::OnLoadStart(CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, TransitionType CefTransitionType)
 {
+	TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = BrowserWindowPtr.Pin();
+
+	if (BrowserWindow.IsValid() && Frame->IsMain())
+	{
+		BrowserWindow->OnMainFrameLoadStart();
+	}
 }
 
 void FCEFBrowserHandler::OnLoadingStateChange(CefRefPtr<CefBrowser> Browser, bool bIsLoading, bool bCanGoBack, bool bCanGoForward)
@@ -442,23 +459,54 @@ CefResourceRequestHandler::ReturnValue FCEFBrowserHandler::OnBeforeResourceLoad(
 		return RV_CONTINUE;
 	}
 
-	// Current thread is IO thread. We need to invoke BrowserWindow->GetResourceContent on the UI (aka Game) thread:
-	CefPostTask(TID_UI, new FCEFBrowserClosureTask(this, [=, this]()
+	// The static headers, Accept-Language included, are set here so the game thread doesn't have to
+	if (RequestHeaders.IsValid())
+	{
+		RequestHeaders->Apply(Request);
+	}
+
+	// Evaluate the resource rules, if any, here on the IO thread so requests that don't need a game delegate don't wait on the game thread
+	TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> Rules = GetResourceRules();
+	const FCEFResourceRuleSet::FRule* Rule = nullptr;
+	if (Rules.IsValid())
 	{
-		const FString LanguageHeaderText(TEXT("Accept-Language"));
-		const FString LocaleCode = FWebBrowserSingleton::GetCurrentLocaleCode();
-		CefRequest::HeaderMap HeaderMap;
-		Request->GetHeaderMap(HeaderMap);
-		auto LanguageHeader = HeaderMap.find(TCHAR_TO_WCHAR(*LanguageHeaderText));
-		if (LanguageHeader != HeaderMap.end())
+		const CefRequest::ResourceType Type = Request->GetResourceType();
+		Rule = Rules->Match(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()), Type);
+		const EWebBrowserResourceRuleAction Action = Rule != nullptr ? Rule->Action : Rules->GetUnmatchedAction();
+
+		// Frames always go to the game thread, as they may be served by LoadString or OnLoadUrl
+		const bool bIsFrame = Type == CefRequest::ResourceType::RT_MAIN_FRAME || Type == CefRequest::ResourceType::RT_SUB_FRAME;
+		if (Action == EWebBrowserResourceRuleAction::Block)
 		{
-			(*LanguageHeader).second = TCHAR_TO_WCHAR(*LocaleCode);
+			INC_DWORD_STAT(STAT_CEFResourceLoadsIOThread);
+			return RV_CANCEL;
 		}
-		else
+		else if (Action == EWebBrowserResourceRuleAction::Respond)
+		{
+			// GetResourceHandler serves the static response of the rule matched here
+			if (Rule != nullptr)
+			{
+				FScopeLock Lock(&PendingRuleResponsesCS);
+				PendingRuleResponses.Add(Request->GetIdentifier(), { Rules, Rule });
+			}
+			INC_DWORD_STAT(STAT_CEFResourceLoadsIOThread);
+			return RV_CONTINUE;
+		}
+		else if (Action == EWebBrowserResourceRuleAction::Continue && !bIsFrame)
 		{
-			HeaderMap.insert(std::pair<CefString, CefString>(TCHAR_TO_WCHAR(*LanguageHeaderText), TCHAR_TO_WCHAR(*LocaleCode)));
+			if (Rule != nullptr)
+			{
+				FCEFResourceRuleSet::ApplyHeaders(*Rule, Request);
+			}
+			INC_DWORD_STAT(STAT_CEFResourceLoadsIOThread);
+			return RV_CONTINUE;
 		}
-		
+	}
+	INC_DWORD_STAT(STAT_CEFResourceLoadsGameThread);
+
+	// Current thread is IO thread. We need to invoke BrowserWindow->GetResourceContent on the UI (aka Game) thread:
+	CefPostTask(TID_UI, new FCEFBrowserClosureTask(this, [=, this]()
+	{
 		LOG_CEF_LOAD("FCEFBrowserHandler::OnBeforeResourceLoad");
 
 		if (BeforeResourceLoadDelegate.IsBound())
@@ -466,17 +514,20 @@ CefResourceRequestHandler::ReturnValue FCEFBrowserHandler::OnBeforeResourceLoad(
 			// Allow appending the Authorization header if this was NOT  a RT_XHR type of page load
 			bool bAllowCredentials = URLRequestAllowsCredentials(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()));
 			FRequestHeaders AdditionalHeaders;
-			BeforeResourceLoadDelegate.Execute(Request->GetURL(), Request->GetResourceType(), AdditionalHeaders, bAllowCredentials);
+			BeforeResourceLoadDelegate.Execute(Request, Request->GetResourceType(), AdditionalHeaders, bAllowCredentials);
 
-			for (auto Iter = AdditionalHeaders.CreateConstIterator(); Iter; ++Iter)
+			for (const TPair<FString, FString>& Header : AdditionalHeaders)
 			{
-				const FString& Header = Iter.Key();
-				const FString& Value = Iter.Value();
-
-				HeaderMap.insert(std::pair<CefString, CefString>(TCHAR_TO_WCHAR(*Header), TCHAR_TO_WCHAR(*Value)));
+				Request->SetHeaderByName(TCHAR_TO_WCHAR(*Header.Key), TCHAR_TO_WCHAR(*Header.Value), true);
 			}
 		}
 
+		// Referencing Rules captures it, which keeps Rule alive
+		if (Rules.IsValid() && Rule != nullptr)
+		{
+			FCEFResourceRuleSet::ApplyHeaders(*Rule, Request);
+		}
+
 		TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = BrowserWindowPtr.Pin();
 
 		if (BrowserWindow.IsValid())
@@ -484,13 +535,11 @@ CefResourceRequestHandler::ReturnValue FCEFBrowserHandler::OnBeforeResourceLoad(
 			TOptional<FString> Contents = BrowserWindow->GetResourceContent(Frame, Request);
 			if(Contents.IsSet())
 			{
-				// pass the text we'd like to come back as a response to the request post data
-				CefRefPtr<CefPostData> PostData = CefPostData::Create();
-				CefRefPtr<CefPostDataElement> Element = CefPostDataElement::Create();
-				FTCHARToUTF8 UTF8String(*Contents.GetValue());
-				Element->SetToBytes(UTF8String.Length(), UTF8String.Get());
-				PostData->AddElement(Element);
-				Request->SetPostData(PostData);
+				// Hand the text we'd like to come back as a response to GetResourceHandler, which serves it without further copies
+				{
+					FScopeLock Lock(&PendingContentBodiesCS);
+					PendingContentBodies.Add(Request->GetIdentifier(), FCEFResourceBody::FromString(Contents.GetValue()));
+				}
 
 				// Set a custom request header, so we know the mime type if it was specified as a hash on the dummy URL
 				std::string Url = Request->GetURL().ToString();
@@ -498,7 +547,7 @@ CefResourceRequestHandler::ReturnValue FCEFBrowserHandler::OnBeforeResourceLoad(
 				if (HashPos != std::string::npos)
 				{
 					std::string MimeType = Url.substr(HashPos + 1);
-					HeaderMap.insert(std::pair<CefString, CefString>(TCHAR_TO_WCHAR(TEXT("Content-Type")), MimeType));
+					Request->SetHeaderByName(TCHAR_TO_WCHAR(TEXT("Content-Type")), MimeType, false);
 				}
 
 				// Change http method to tell GetResourceHandler to return the content
@@ -506,14 +555,6 @@ CefResourceRequestHandler::ReturnValue FCEFBrowserHandler::OnBeforeResourceLoad(
 			}
 		}
 
-		if (Request->IsReadOnly())
-		{
-			LOG_CEF_LOAD("FCEFBrowserHandler::OnBeforeResourceLoad - readonly");
-		}
-		else
-		{
-			Request->SetHeaderMap(HeaderMap);
-		}
 #if CEF_VERSION_MAJOR < 128
 		Callback->Continue(true);
 #else
@@ -539,20 +580,36 @@ void FCEFBrowserHandler::OnResourceLoadComplete(
 {
 	LOG_CEF_LOAD("FCEFBrowserHandler::OnResourceLoadComplete");
 
+	if (Request->GetMethod() == TCHAR_TO_WCHAR(*CustomContentMethod))
+	{
+		// Drop the content of a request that was canceled before reaching GetResourceHandler
+		FScopeLock Lock(&PendingContentBodiesCS);
+		PendingContentBodies.Remove(Request->GetIdentifier());
+	}
+	else
+	{
+		FScopeLock Lock(&PendingRuleResponsesCS);
+		PendingRuleResponses.Remove(Request->GetIdentifier());
+	}
+
 	// Current thread is IO thread. We need to invoke our delegates on the UI (aka Game) thread:
 	CefPostTask(TID_UI, new FCEFBrowserClosureTask(this, [=, this]()
 	{
 		auto resType = Request->GetResourceType();
-		const FString URL = WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str());
-		if (MainFrameLoadTypes.Contains(URL))
+		// Only convert the url when there are main frame loads to look it up in
+		const FString URL = MainFrameLoadTypes.Num() > 0 ? FString(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str())) : FString();
+		if (!URL.IsEmpty() && MainFrameLoadTypes.Contains(URL))
 		{
 			// CEF has a bug where it confuses a MAIN_FRAME load for a XHR one, so fix it up here if we detect it.
 			resType = CefRequest::ResourceType::RT_MAIN_FRAME;
 		}
-		ResourceLoadCompleteDelegate.ExecuteIfBound(Request->GetURL(), resType, Status, Received_content_length);
+		ResourceLoadCompleteDelegate.ExecuteIfBound(Request, resType, Status, Received_content_length);
 
 		// this load is done, clear the request from our map
-		MainFrameLoadTypes.Remove(URL);
+		if (!URL.IsEmpty())
+		{
+			MainFrameLoadTypes.Remove(URL);
+		}
 	}));
 }
 
@@ -623,7 +680,12 @@ CefRefPtr<CefResourceHandler> FCEFBrowserHandler::GetResourceHandler( CefRefPtr<
 	if (Request->GetMethod() == TCHAR_TO_WCHAR(*CustomContentMethod))
 	{
 		// Content override header will be set by OnBeforeResourceLoad before passing the request on to this.
-		if (Request->GetPostData() && Request->GetPostData()->GetElementCount() > 0)
+		TSharedPtr<const FCEFResourceBody, ESPMode::ThreadSafe> Body;
+		{
+			FScopeLock Lock(&PendingContentBodiesCS);
+			PendingContentBodies.RemoveAndCopyValue(Request->GetIdentifier(), Body);
+		}
+		if (Body.IsValid())
 		{
 			// get the mime type from Content-Type header (default to text/html to support old behavior)
 			FString MimeType = TEXT("text/html"); // default if not specified
@@ -635,15 +697,35 @@ CefRefPtr<CefResourceHandler> FCEFBrowserHandler::GetResourceHandler( CefRefPtr<
 				MimeType = WCHAR_TO_TCHAR(ContentOverride->second.ToWString().c_str());
 			}
 
-			// reply with the post data
-			CefPostData::ElementVector Elements;
-			Request->GetPostData()->GetElements(Elements);
-			return new FCEFBrowserByteResource(Elements[0], MimeType);
+			// reply with the content
+			return new FCEFBrowserByteResource(Body.ToSharedRef(), MimeType);
 		}
 	}
+
+	FPendingRuleResponse RuleResponse;
+	{
+		FScopeLock Lock(&PendingRuleResponsesCS);
+		PendingRuleResponses.RemoveAndCopyValue(Request->GetIdentifier(), RuleResponse);
+	}
+	if (RuleResponse.Rule != nullptr)
+	{
+		return FCEFResourceRuleSet::CreateResponse(*RuleResponse.Rule);
+	}
 	return nullptr;
 }
 
+void FCEFBrowserHandler::SetResourceRules(TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> InRules)
+{
+	FScopeLock Lock(&ResourceRulesCS);
+	ResourceRules = InRules;
+}
+
+TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> FCEFBrowserHandler::GetResourceRules() const
+{
+	FScopeLock Lock(&ResourceRulesCS);
+	return ResourceRules;
+}
+
 CefRefPtr<CefResourceRequestHandler> FCEFBrowserHandler::GetResourceRequestHandler( CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame,
 	CefRefPtr<CefRequest> Request, bool is_navigation, bool is_download, const CefString& request_initiator, bool& disable_default_handling) 
 {
@@ -977,14 +1059,7 @@ bool FCEFBrowserHandler::URLRequestAllowsCredentials(const FString& URL) const
 		return true;
 
 	// check the explicit allowlist also
-	for (const FString& AuthorizationHeaderAllowListURL : AuthorizationHeaderAllowListURLS)
-	{
-		if (URL.Contains(AuthorizationHeaderAllowListURL))
-		{
-			return true;
-		}
-	}
-	return false;
+	return AuthorizationHeaderAllowList.IsValid() && AuthorizationHeaderAllowList->Matches(URL);
 }
 
 
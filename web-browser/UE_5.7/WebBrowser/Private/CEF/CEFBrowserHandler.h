@@ -11,6 +11,9 @@
 
 
 #include "IWebBrowserWindow.h"
+#include "CEFResourceRuleSet.h"
+#include "CEFRequestHeaders.h"
+#include "CEFDomainMatcher.h"
 
 #endif
 
@@ -18,6 +21,7 @@ class IWebBrowserWindow;
 struct Rect;
 class FCEFWebBrowserWindow;
 class FCEFBrowserPopupFeatures;
+class FCEFResourceBody;
 
 #if WITH_CEF3
 
@@ -43,7 +47,7 @@ class FCEFBrowserHandler
 public:
 
 	/** Default constructor. */
-	FCEFBrowserHandler(bool InUseTransparency, bool InInterceptLoadRequests, const TArray<FString>& AltRetryDomains = TArray<FString>(), const TArray<FString>& AuthorizationHeaderAllowListURLS = TArray<FString>());
+	FCEFBrowserHandler(bool InUseTransparency, bool InInterceptLoadRequests, const TArray<FString>& AltRetryDomains = TArray<FString>(), const TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe>& AuthorizationHeaderAllowList = nullptr);
 
 public:
 
@@ -375,18 +379,24 @@ public:
 	}
 
 	typedef TMap<FString, FString> FRequestHeaders;
-	DECLARE_DELEGATE_FourParams(FOnBeforeResourceLoadDelegate, const CefString& /*URL*/, CefRequest::ResourceType /*Type*/, FRequestHeaders& /*AdditionalHeaders*/, const bool /*AllowUserCredentials*/);
+	DECLARE_DELEGATE_FourParams(FOnBeforeResourceLoadDelegate, CefRefPtr<CefRequest> /*Request*/, CefRequest::ResourceType /*Type*/, FRequestHeaders& /*AdditionalHeaders*/, const bool /*AllowUserCredentials*/);
 	FOnBeforeResourceLoadDelegate& OnBeforeResourceLoad()
 	{
 		return BeforeResourceLoadDelegate;
 	}
 
-	DECLARE_DELEGATE_FourParams(FOnResourceLoadCompleteDelegate, const CefString& /*URL*/, CefRequest::ResourceType /*Type*/, CefResourceRequestHandler::URLRequestStatus /*Status*/, int64 /*ContentLength*/);
+	DECLARE_DELEGATE_FourParams(FOnResourceLoadCompleteDelegate, CefRefPtr<CefRequest> /*Request*/, CefRequest::ResourceType /*Type*/, CefResourceRequestHandler::URLRequestStatus /*Status*/, int64 /*ContentLength*/);
 	FOnResourceLoadCompleteDelegate& OnResourceLoadComplete()
 	{
 		return ResourceLoadCompleteDelegate;
 	}
 
+	DECLARE_DELEGATE_OneParam(FOnBrowserCreatedDelegate, CefRefPtr<CefBrowser> /*Browser*/);
+	FOnBrowserCreatedDelegate& OnBrowserCreated()
+	{
+		return BrowserCreatedDelegate;
+	}
+
 	DECLARE_DELEGATE_FiveParams(FOnConsoleMessageDelegate, CefRefPtr<CefBrowser> /*Browser*/, cef_log_severity_t /*level*/, const CefString& /*Message*/, const CefString& /*Source*/, int32 /*Line*/);
 	FOnConsoleMessageDelegate& OnConsoleMessage()
 	{
@@ -395,8 +405,27 @@ public:
 
 	bool URLRequestAllowsCredentials(const FString& URL) const;
 
+	/**
+	 * Sets the rules evaluated on the IO thread before resources are loaded.
+	 *
+	 * @param InRules The compiled rules, or nullptr to pass every request to the game thread.
+	 */
+	void SetResourceRules(TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> InRules);
+
+	/**
+	 * Sets the static headers of the request context the browser is created in. Must be called before the browser is created.
+	 *
+	 * @param InRequestHeaders The headers set on every writable request, on the IO thread.
+	 */
+	void SetRequestHeaders(const TSharedPtr<const FCEFRequestHeaders, ESPMode::ThreadSafe>& InRequestHeaders)
+	{
+		RequestHeaders = InRequestHeaders;
+	}
+
 private:
 
+	TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> GetResourceRules() const;
+
 	bool ShowDevTools(const CefRefPtr<CefBrowser>& Browser);
 
 	bool bUseTransparency;
@@ -406,8 +435,8 @@ private:
 	TArray<FString> AltRetryDomains;
 	uint32 AltRetryDomainIdx = 0;
 
-	/** Domains we allow sending an authorization header too even if the request doesn't otherwise indicate support */
-	TArray<FString> AuthorizationHeaderAllowListURLS;
+	/** Domains we allow sending an authorization header too even if the request doesn't otherwise indicate support, shared by every browser */
+	TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe> AuthorizationHeaderAllowList;
 
 	/** Keep track of URLs we see being loaded and the type of load it is*/
 	TMap<FString, CefRequest::ResourceType> MainFrameLoadTypes;
@@ -421,9 +450,34 @@ private:
 	/** Delegate for handling adding additional headers to requests */
 	FOnBeforeResourceLoadDelegate BeforeResourceLoadDelegate;
 
+	/** Resource rules, read from the IO thread and replaced from the game thread. */
+	TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> ResourceRules;
+	mutable FCriticalSection ResourceRulesCS;
+
+	/** Static headers of the request context, shared with it and with popups opened from this browser. */
+	TSharedPtr<const FCEFRequestHeaders, ESPMode::ThreadSafe> RequestHeaders;
+
+	/** Bodies of LoadString requests by request identifier, handed from OnBeforeResourceLoad to GetResourceHandler. */
+	TMap<uint64, TSharedPtr<const FCEFResourceBody, ESPMode::ThreadSafe>> PendingContentBodies;
+	FCriticalSection PendingContentBodiesCS;
+
+	/** A Respond rule matched by OnBeforeResourceLoad, along with the rule set that owns it. */
+	struct FPendingRuleResponse
+	{
+		TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> Rules;
+		const FCEFResourceRuleSet::FRule* Rule = nullptr;
+	};
+
+	/** Rules whose static response GetResourceHandler serves, by request identifier, so the URL is only matched once. */
+	TMap<uint64, FPendingRuleResponse> PendingRuleResponses;
+	FCriticalSection PendingRuleResponsesCS;
+
 	/** Delegate that allows response to the status of resource loads */
 	FOnResourceLoadCompleteDelegate ResourceLoadCompleteDelegate;
 
+	/** Delegate for browsers created asynchronously, executed once from OnAfterCreated. */
+	FOnBrowserCreatedDelegate BrowserCreatedDelegate;
+
 	/** Delegate that allows for response to console logs.  Typically used to capture and mirror web logs in client application logs. */
 	FOnConsoleMessageDelegate ConsoleMessageDelegate;
 
@@ -5,21 +5,414 @@
 #if WITH_CEF3
 #include "IWebBrowserCookieManager.h"
 #include "WebBrowserSingleton.h"
+#include "CEFBrowserClosureTask.h"
+#include "HAL/IConsoleManager.h"
+#include "Containers/Queue.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
 
 #include "CEFLibCefIncludes.h"
 
+static float CookieCacheSeconds = 5.0f;
+static FAutoConsoleVariableRef CVarCookieCacheSeconds(
+	TEXT("webbrowser.CookieCacheSeconds"),
+	CookieCacheSeconds,
+	TEXT("How long cookies read through the cookie manager are answered from its cache. Cookies set through the cookie manager update the cache, cookies set by pages are picked up once it expires. 0 disables the cache\n"),
+	ECVF_Default);
+
+static float CookieFlushDelaySeconds = 1.0f;
+static FAutoConsoleVariableRef CVarCookieFlushDelaySeconds(
+	TEXT("webbrowser.CookieFlushDelaySeconds"),
+	CookieFlushDelaySeconds,
+	TEXT("Cookie writes made through the cookie manager are flushed to disk once no write happened for this long, coalescing bursts of writes into one flush. 0 leaves flushing to CEF\n"),
+	ECVF_Default);
+
+static float CookieFlushMaxDelaySeconds = 10.0f;
+static FAutoConsoleVariableRef CVarCookieFlushMaxDelaySeconds(
+	TEXT("webbrowser.CookieFlushMaxDelaySeconds"),
+	CookieFlushMaxDelaySeconds,
+	TEXT("Longest time cookie writes made through the cookie manager wait for a flush while writes keep coming\n"),
+	ECVF_Default);
+
 class FCefCookieManager
 	: public IWebBrowserCookieManager
+	, public TSharedFromThis<FCefCookieManager>
 {
 public:
 
 	virtual ~FCefCookieManager()
-	{ }
+	{
+		if (FirstUnflushedWriteTime >= 0.0)
+		{
+			CookieManager->FlushStore(nullptr);
+		}
+
+		// Later completions are posted by QueueCompletion, as the manager can't be pinned anymore
+		PostPendingCompletions();
+	}
+
+	/** Runs the completions queued since the last tick, and flushes the store once writes have settled. Called on the game thread. */
+	void Tick()
+	{
+		TFunction<void()> Completion;
+		while (PendingCompletions.Dequeue(Completion))
+		{
+			Completion();
+		}
+
+		if (FirstUnflushedWriteTime >= 0.0 && CookieFlushDelaySeconds > 0.0f)
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (Now - LastWriteTime >= CookieFlushDelaySeconds || Now - FirstUnflushedWriteTime >= CookieFlushMaxDelaySeconds)
+			{
+				CookieManager->FlushStore(nullptr);
+				FirstUnflushedWriteTime = -1.0;
+			}
+		}
+	}
+
+	/** Stops queuing completions for Tick, posting them to the UI thread instead. Called when the manager stops being ticked. */
+	void Detach()
+	{
+		FScopeLock Lock(&DetachCS);
+		bDetached = true;
+		PostPendingCompletions();
+	}
 
 	virtual void SetCookie(const FString& URL, const FCookie& Cookie, TFunction<void(bool)> Completed) override
 	{
-		CefRefPtr<FSetCookieFunctionCallback> Callback = Completed ? new FSetCookieFunctionCallback(Completed) : nullptr;
+		CacheCookie(URL, Cookie);
+		ScheduleFlush();
+
+		TWeakPtr<FCefCookieManager> WeakThis = AsShared();
+		CefRefPtr<FSetCookieFunctionCallback> Callback = new FSetCookieFunctionCallback(WeakThis, [WeakThis, Completed](bool bSuccess)
+		{
+			TSharedPtr<FCefCookieManager> This = WeakThis.Pin();
+			if (!bSuccess && This.IsValid())
+			{
+				// The cache was updated optimistically
+				This->InvalidateCache();
+			}
+			if (Completed)
+			{
+				Completed(bSuccess);
+			}
+		});
+
+		if (!CookieManager->SetCookie(TCHAR_TO_WCHAR(*URL), ToCefCookie(Cookie), Callback))
+		{
+			Callback->OnComplete(false);
+		}
+	}
+
+	virtual void SetCookies(const FString& URL, const TArray<FCookie>& Cookies, TFunction<void(int32)> Completed) override
+	{
+		if (Cookies.Num() == 0)
+		{
+			if (Completed)
+			{
+				Completed(0);
+			}
+			return;
+		}
+
+		ScheduleFlush();
+
+		// All the cookies share one callback, which reports back to the game thread once rather than once per cookie
+		TWeakPtr<FCefCookieManager> WeakThis = AsShared();
+		CefRefPtr<FSetCookiesBatchCallback> Callback = new FSetCookiesBatchCallback(WeakThis, Cookies.Num(), [WeakThis, Completed, NumCookies = Cookies.Num()](int32 NumSet)
+		{
+			TSharedPtr<FCefCookieManager> This = WeakThis.Pin();
+			if (NumSet != NumCookies && This.IsValid())
+			{
+				// The cache was updated optimistically
+				This->InvalidateCache();
+			}
+			if (Completed)
+			{
+				Completed(NumSet);
+			}
+		});
+
+		for (const FCookie& Cookie : Cookies)
+		{
+			const FString CookieURL = URL.IsEmpty() ? GetCookieURL(Cookie) : URL;
+			CacheCookie(CookieURL, Cookie);
+			if (!CookieManager->SetCookie(TCHAR_TO_WCHAR(*CookieURL), ToCefCookie(Cookie), Callback))
+			{
+				Callback->OnComplete(false);
+			}
+		}
+	}
+
+	virtual void DeleteCookies(const FString& URL, const FString& CookieName, TFunction<void(int)> Completed) override
+	{
+		// Deletions are rare, so rather than matching cookies the cache is simply dropped
+		InvalidateCache();
+
+		ScheduleFlush();
+
+		CefRefPtr<FDeleteCookiesFunctionCallback> Callback = Completed ? new FDeleteCookiesFunctionCallback(AsShared(), Completed) : nullptr;
+		if (!CookieManager->DeleteCookies(TCHAR_TO_WCHAR(*URL), TCHAR_TO_WCHAR(*CookieName), Callback) && Callback)
+		{
+			Callback->OnComplete(-1);
+		}
+	}
+
+	virtual void GetCookies(const FString& URL, bool bIncludeHttpOnly, TFunction<void(const TArray<FCookie>&)> Completed) override
+	{
+		VisitCookies(URL, bIncludeHttpOnly, MoveTemp(Completed));
+	}
+
+	virtual void VisitAllCookies(TFunction<void(const TArray<FCookie>&)> Completed) override
+	{
+		VisitCookies(FString(), true, MoveTemp(Completed));
+	}
+
+private:
+
+	FCefCookieManager(
+		const CefRefPtr<CefCookieManager>& InCookieManager)
+		: CookieManager(InCookieManager)
+		, WriteGeneration(0)
+		, bDetached(false)
+		, FirstUnflushedWriteTime(-1.0)
+		, LastWriteTime(-1.0)
+	{ }
+
+	/** Cookies read from the store for a URL, or for the whole store when the URL is empty. */
+	struct FCachedCookies
+	{
+		FString Host;
+		FString Path;
+		bool bIsSecure = false;
+		double ReadTime = 0.0;
+		TArray<FCookie> Cookies;
+	};
+
+	/** Reads of the store in flight for a URL, or for the whole store when the URL is empty. */
+	struct FPendingVisits
+	{
+		FString Host;
+		FString Path;
+		bool bIsSecure = false;
+		int32 NumVisits = 0;
+
+		/** Generation of the last write visible to the URL. Visits started before it don't get cached. */
+		uint64 LastWriteGeneration = 0;
+	};
+
+	/** Splits a URL into the parts cookies are matched against. */
+	static void ParseURL(const FString& URL, FString& OutHost, FString& OutPath, bool& bOutIsSecure)
+	{
+		FString Rest = URL;
+		bOutIsSecure = Rest.StartsWith(TEXT("https://"), ESearchCase::IgnoreCase) || Rest.StartsWith(TEXT("wss://"), ESearchCase::IgnoreCase);
+
+		int32 Index = Rest.Find(TEXT("://"));
+		if (Index != INDEX_NONE)
+		{
+			Rest.RightChopInline(Index + 3);
+		}
+		Index = Rest.Find(TEXT("?"));
+		if (Index != INDEX_NONE)
+		{
+			Rest.LeftInline(Index);
+		}
+		Index = Rest.Find(TEXT("#"));
+		if (Index != INDEX_NONE)
+		{
+			Rest.LeftInline(Index);
+		}
+
+		Index = Rest.Find(TEXT("/"));
+		OutHost = Index != INDEX_NONE ? Rest.Left(Index) : Rest;
+		OutPath = Index != INDEX_NONE ? Rest.RightChop(Index) : TEXT("/");
+
+		// Drop the user info and port
+		Index = OutHost.Find(TEXT("@"));
+		if (Index != INDEX_NONE)
+		{
+			OutHost.RightChopInline(Index + 1);
+		}
+		Index = OutHost.Find(TEXT(":"));
+		if (Index != INDEX_NONE)
+		{
+			OutHost.LeftInline(Index);
+		}
+		OutHost.ToLowerInline();
+	}
+
+	/** @return whether the cookie would be sent with a request to the host and path. */
+	static bool CookieMatches(const FCookie& Cookie, const FString& Host, const FString& Path, bool bIsSecure)
+	{
+		if (Cookie.bSecure && !bIsSecure)
+		{
+			return false;
+		}
+		if (Cookie.Domain.StartsWith(TEXT(".")))
+		{
+			if (!Host.Equals(Cookie.Domain.RightChop(1), ESearchCase::IgnoreCase) && !Host.EndsWith(Cookie.Domain, ESearchCase::IgnoreCase))
+			{
+				return false;
+			}
+		}
+		else if (!Host.Equals(Cookie.Domain, ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+		// The cookie path has to end at a path separator of the request path, so /foo doesn't match /foobar
+		if (!Path.StartsWith(Cookie.Path, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+		return Path.Len() == Cookie.Path.Len() || Cookie.Path.EndsWith(TEXT("/"), ESearchCase::CaseSensitive) || Path[Cookie.Path.Len()] == TEXT('/');
+	}
+
+	static bool IsExpired(const FCookie& Cookie, const FDateTime& Now)
+	{
+		return Cookie.bHasExpires && Cookie.Expires <= Now;
+	}
+
+	/** Applies a cookie being set to the cached reads it is visible to. */
+	void CacheCookie(const FString& URL, const FCookie& Cookie)
+	{
+		++WriteGeneration;
+		if (CookieCache.Num() == 0 && PendingVisits.Num() == 0)
+		{
+			return;
+		}
+
+		// Store the cookie the way the browser reports it: host cookies carry the host as their domain, domain cookies a leading dot
+		FString Host;
+		FString Path;
+		bool bIsSecure;
+		ParseURL(URL, Host, Path, bIsSecure);
+
+		FCookie StoredCookie = Cookie;
+		if (StoredCookie.Domain.IsEmpty())
+		{
+			StoredCookie.Domain = Host;
+		}
+		else if (!StoredCookie.Domain.StartsWith(TEXT(".")))
+		{
+			StoredCookie.Domain = TEXT(".") + StoredCookie.Domain;
+		}
+		if (StoredCookie.Path.IsEmpty())
+		{
+			StoredCookie.Path = TEXT("/");
+		}
+		const bool bIsExpired = IsExpired(StoredCookie, FDateTime::UtcNow());
+
+		for (TPair<FString, FCachedCookies>& Entry : CookieCache)
+		{
+			FCachedCookies& Cached = Entry.Value;
+			if (!Entry.Key.IsEmpty() && !CookieMatches(StoredCookie, Cached.Host, Cached.Path, Cached.bIsSecure))
+			{
+				continue;
+			}
+
+			Cached.Cookies.RemoveAll([&StoredCookie](const FCookie& CachedCookie)
+			{
+				return CachedCookie.Name == StoredCookie.Name && CachedCookie.Path == StoredCookie.Path && CachedCookie.Domain.Equals(StoredCookie.Domain, ESearchCase::IgnoreCase);
+			});
+			if (!bIsExpired)
+			{
+				Cached.Cookies.Add(StoredCookie);
+			}
+		}
+
+		// Visits in flight may have read the store before the write reached it
+		for (TPair<FString, FPendingVisits>& Entry : PendingVisits)
+		{
+			if (Entry.Key.IsEmpty() || CookieMatches(StoredCookie, Entry.Value.Host, Entry.Value.Path, Entry.Value.bIsSecure))
+			{
+				Entry.Value.LastWriteGeneration = WriteGeneration;
+			}
+		}
+	}
+
+	/** Drops the cached reads, and keeps the visits in flight from caching theirs. */
+	void InvalidateCache()
+	{
+		++WriteGeneration;
+		CookieCache.Empty();
+		for (TPair<FString, FPendingVisits>& Entry : PendingVisits)
+		{
+			Entry.Value.LastWriteGeneration = WriteGeneration;
+		}
+	}
+
+	/** Answers a read from the cache, or visits the store and caches the result. */
+	void VisitCookies(const FString& URL, bool bIncludeHttpOnly, TFunction<void(const TArray<FCookie>&)> Completed)
+	{
+		if (!Completed)
+		{
+			return;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (const FCachedCookies* Cached = CookieCache.Find(URL))
+		{
+			if (Now - Cached->ReadTime < CookieCacheSeconds)
+			{
+				Completed(FilterCookies(Cached->Cookies, bIncludeHttpOnly));
+				return;
+			}
+			CookieCache.Remove(URL);
+		}
+
+		FPendingVisits& Pending = PendingVisits.FindOrAdd(URL);
+		if (Pending.NumVisits++ == 0)
+		{
+			ParseURL(URL, Pending.Host, Pending.Path, Pending.bIsSecure);
+		}
+
+		TWeakPtr<FCefCookieManager> WeakThis = AsShared();
+		CefRefPtr<FCookieListVisitor> Visitor = new FCookieListVisitor(WeakThis, [WeakThis, URL, bIncludeHttpOnly, Completed, Now, StartGeneration = WriteGeneration](TArray<FCookie>& Cookies, bool bSucceeded)
+		{
+			TSharedPtr<FCefCookieManager> This = WeakThis.Pin();
+			bool bIsCurrent = false;
+			if (This.IsValid())
+			{
+				if (FPendingVisits* Pending = This->PendingVisits.Find(URL))
+				{
+					bIsCurrent = Pending->LastWriteGeneration <= StartGeneration;
+					if (--Pending->NumVisits == 0)
+					{
+						This->PendingVisits.Remove(URL);
+					}
+				}
+			}
+			if (bSucceeded && bIsCurrent && CookieCacheSeconds > 0.0f)
+			{
+				FCachedCookies& Cached = This->CookieCache.Add(URL);
+				ParseURL(URL, Cached.Host, Cached.Path, Cached.bIsSecure);
+				Cached.ReadTime = Now;
+				Cached.Cookies = Cookies;
+			}
+			Completed(FilterCookies(Cookies, bIncludeHttpOnly));
+		});
+
+		// HttpOnly cookies are always read, so the cached list can answer both kinds of request
+		const bool bVisiting = URL.IsEmpty() ? CookieManager->VisitAllCookies(Visitor) : CookieManager->VisitUrlCookies(TCHAR_TO_WCHAR(*URL), true, Visitor);
+		if (!bVisiting)
+		{
+			Visitor->MarkFailed();
+		}
+	}
+
+	static TArray<FCookie> FilterCookies(const TArray<FCookie>& Cookies, bool bIncludeHttpOnly)
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+		return Cookies.FilterByPredicate([bIncludeHttpOnly, &Now](const FCookie& Cookie)
+		{
+			return (bIncludeHttpOnly || !Cookie.bHttpOnly) && !IsExpired(Cookie, Now);
+		});
+	}
 
+	static CefCookie ToCefCookie(const FCookie& Cookie)
+	{
 		CefCookie CefCookie;
 		CefString(&CefCookie.name) = TCHAR_TO_WCHAR(*Cookie.Name);
 		CefString(&CefCookie.value) = TCHAR_TO_WCHAR(*Cookie.Value);
@@ -54,118 +447,238 @@ public:
 #else
 		cef_time_to_basetime(&CefTime, &CefCookie.expires);
 #endif
+		return CefCookie;
+	}
 
-		if (!CookieManager->SetCookie(TCHAR_TO_WCHAR(*URL), CefCookie, Callback))
+	static FCookie FromCefCookie(const CefCookie& InCookie)
+	{
+		FCookie Cookie;
+		Cookie.Name = WCHAR_TO_TCHAR(CefString(&InCookie.name).ToWString().c_str());
+		Cookie.Value = WCHAR_TO_TCHAR(CefString(&InCookie.value).ToWString().c_str());
+		Cookie.Domain = WCHAR_TO_TCHAR(CefString(&InCookie.domain).ToWString().c_str());
+		Cookie.Path = WCHAR_TO_TCHAR(CefString(&InCookie.path).ToWString().c_str());
+		Cookie.bSecure = InCookie.secure != 0;
+		Cookie.bHttpOnly = InCookie.httponly != 0;
+		Cookie.bHasExpires = false;
+
+		if (InCookie.has_expires)
 		{
-			Callback->OnComplete(false);
+#if CEF_VERSION_MAJOR < 128
+			const cef_time_t& CefTime = InCookie.expires;
+#else
+			cef_time_t CefTime;
+			cef_time_from_basetime(InCookie.expires, &CefTime);
+#endif
+			if (FDateTime::Validate(CefTime.year, CefTime.month, CefTime.day_of_month, CefTime.hour, CefTime.minute, CefTime.second, CefTime.millisecond))
+			{
+				Cookie.bHasExpires = true;
+				Cookie.Expires = FDateTime(CefTime.year, CefTime.month, CefTime.day_of_month, CefTime.hour, CefTime.minute, CefTime.second, CefTime.millisecond);
+			}
 		}
+		return Cookie;
 	}
 
-	virtual void DeleteCookies(const FString& URL, const FString& CookieName, TFunction<void(int)> Completed) override
+	// Queues a completion to run in the next tick of the manager, or posts it to the UI thread if the manager is gone or no longer ticked.
+	static void QueueCompletion(const TWeakPtr<FCefCookieManager>& WeakManager, TFunction<void()>&& Completion)
 	{
-		CefRefPtr<FDeleteCookiesFunctionCallback> Callback = Completed ? new FDeleteCookiesFunctionCallback(Completed) : nullptr;
-		if (!CookieManager->DeleteCookies(TCHAR_TO_WCHAR(*URL), TCHAR_TO_WCHAR(*CookieName), Callback))
+		if (TSharedPtr<FCefCookieManager> Manager = WeakManager.Pin())
 		{
-			Callback->OnComplete(-1);
+			FScopeLock Lock(&Manager->DetachCS);
+			if (!Manager->bDetached)
+			{
+				Manager->PendingCompletions.Enqueue(MoveTemp(Completion));
+				return;
+			}
 		}
+		CefPostTask(TID_UI, new FCEFBrowserClosureTask(nullptr, MoveTemp(Completion)));
 	}
 
-private:
+	// Posts the queued completions to the UI thread, for when Tick won't run them.
+	void PostPendingCompletions()
+	{
+		TFunction<void()> Completion;
+		while (PendingCompletions.Dequeue(Completion))
+		{
+			CefPostTask(TID_UI, new FCEFBrowserClosureTask(nullptr, MoveTemp(Completion)));
+		}
+	}
 
-	FCefCookieManager(
-		const CefRefPtr<CefCookieManager>& InCookieManager)
-		: CookieManager(InCookieManager)
-	{ }
+	// Notes a write, so the store gets flushed once writes settle.
+	void ScheduleFlush()
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (FirstUnflushedWriteTime < 0.0)
+		{
+			FirstUnflushedWriteTime = Now;
+		}
+		LastWriteTime = Now;
+	}
 
-	// Callback that will invoke the callback with the result on the UI thread.
-	class FDeleteCookiesFunctionCallback
-		: public CefDeleteCookiesCallback
+	// Visitor collecting cookies, which passes them to the manager once CEF releases it.
+	class FCookieListVisitor
+		: public CefCookieVisitor
 	{
-		TFunction<void(int)> Callback;
+		TWeakPtr<FCefCookieManager> Manager;
+		TFunction<void(TArray<FCookie>&, bool)> Callback;
+		TArray<FCookie> Cookies;
+		bool bSucceeded;
 	public:
-		FDeleteCookiesFunctionCallback(const TFunction<void(int)>& InCallback)
-			: Callback(InCallback)
+		FCookieListVisitor(const TWeakPtr<FCefCookieManager>& InManager, TFunction<void(TArray<FCookie>&, bool)>&& InCallback)
+			: Manager(InManager)
+			, Callback(MoveTemp(InCallback))
+			, bSucceeded(true)
 		{}
 
-		virtual void OnComplete(int NumDeleted) override
+		// CEF releases the visitor after the last cookie, or right away when there are none
+		virtual ~FCookieListVisitor()
 		{
-			// We're on the IO thread, so we'll have to schedule the callback on the main thread
-			CefPostTask(TID_UI, new FDeleteCookiesNotificationTask(Callback, NumDeleted));
+			QueueCompletion(Manager, [Callback = MoveTemp(Callback), Cookies = MoveTemp(Cookies), bSucceeded = bSucceeded]() mutable
+			{
+				Callback(Cookies, bSucceeded);
+			});
 		}
 
-		IMPLEMENT_REFCOUNTING(FDeleteCookiesFunctionCallback);
+		void MarkFailed()
+		{
+			bSucceeded = false;
+		}
+
+		virtual bool Visit(const CefCookie& Cookie, int Count, int Total, bool& bDeleteCookie) override
+		{
+			if (Cookies.Num() == 0)
+			{
+				Cookies.Reserve(Total);
+			}
+			Cookies.Add(FromCefCookie(Cookie));
+			return true;
+		}
+
+		IMPLEMENT_REFCOUNTING(FCookieListVisitor);
 	};
 
-	// Callback that will invoke the callback with the result on the UI thread.
-	class FSetCookieFunctionCallback
+	// Callback shared by a batch of cookies, that passes the number of cookies set to the manager once all are done.
+	class FSetCookiesBatchCallback
 		: public CefSetCookieCallback
 	{
-		TFunction<void(bool)> Callback;
+		TWeakPtr<FCefCookieManager> Manager;
+		TFunction<void(int32)> Callback;
+		std::atomic<int32> NumRemaining;
+		std::atomic<int32> NumSet;
 	public:
-		FSetCookieFunctionCallback(const TFunction<void(bool)>& InCallback)
-			: Callback(InCallback)
+		FSetCookiesBatchCallback(const TWeakPtr<FCefCookieManager>& InManager, int32 NumCookies, TFunction<void(int32)>&& InCallback)
+			: Manager(InManager)
+			, Callback(MoveTemp(InCallback))
+			, NumRemaining(NumCookies)
+			, NumSet(0)
 		{}
 
 		virtual void OnComplete(bool bSuccess) override
 		{
-			// We're on the IO thread, so we'll have to schedule the callback on the main thread
-			CefPostTask(TID_UI, new FSetCookieNotificationTask(Callback, bSuccess));
+			if (bSuccess)
+			{
+				++NumSet;
+			}
+			if (--NumRemaining == 0)
+			{
+				QueueCompletion(Manager, [Callback = Callback, NumSet = NumSet.load()]()
+				{
+					Callback(NumSet);
+				});
+			}
 		}
 
-		IMPLEMENT_REFCOUNTING(FSetCookieFunctionCallback);
+		IMPLEMENT_REFCOUNTING(FSetCookiesBatchCallback);
 	};
 
-	// Task for executing a callback on a given thread.
-	class FDeleteCookiesNotificationTask
-		: public CefTask
+	// Callback that passes the number of deleted cookies to the manager.
+	class FDeleteCookiesFunctionCallback
+		: public CefDeleteCookiesCallback
 	{
+		TWeakPtr<FCefCookieManager> Manager;
 		TFunction<void(int)> Callback;
-		int Value;
-
 	public:
-
-		FDeleteCookiesNotificationTask(const TFunction<void(int)>& InCallback, int InValue)
-			: Callback(InCallback)
-			, Value(InValue)
+		FDeleteCookiesFunctionCallback(const TWeakPtr<FCefCookieManager>& InManager, const TFunction<void(int)>& InCallback)
+			: Manager(InManager)
+			, Callback(InCallback)
 		{}
 
-		virtual void Execute() override
+		virtual void OnComplete(int NumDeleted) override
 		{
-			Callback(Value);
+			QueueCompletion(Manager, [Callback = Callback, NumDeleted]()
+			{
+				Callback(NumDeleted);
+			});
 		}
 
-		IMPLEMENT_REFCOUNTING(FDeleteCookiesNotificationTask);
+		IMPLEMENT_REFCOUNTING(FDeleteCookiesFunctionCallback);
 	};
 
-	// Task for executing a callback on a given thread.
-	class FSetCookieNotificationTask
-		: public CefTask
+	// Callback that passes the result of setting a cookie to the manager.
+	class FSetCookieFunctionCallback
+		: public CefSetCookieCallback
 	{
+		TWeakPtr<FCefCookieManager> Manager;
 		TFunction<void(bool)> Callback;
-		bool bSuccess;
-
 	public:
-
-		FSetCookieNotificationTask(const TFunction<void(bool)>& InCallback, bool InSuccess)
-			: Callback(InCallback)
-			, bSuccess(InSuccess)
+		FSetCookieFunctionCallback(const TWeakPtr<FCefCookieManager>& InManager, const TFunction<void(bool)>& InCallback)
+			: Manager(InManager)
+			, Callback(InCallback)
 		{}
 
-		virtual void Execute() override
+		virtual void OnComplete(bool bSuccess) override
 		{
-			Callback(bSuccess);
+			QueueCompletion(Manager, [Callback = Callback, bSuccess]()
+			{
+				Callback(bSuccess);
+			});
 		}
 
-		IMPLEMENT_REFCOUNTING(FSetCookieNotificationTask);
+		IMPLEMENT_REFCOUNTING(FSetCookieFunctionCallback);
 	};
 
 private:
 
 	const CefRefPtr<CefCookieManager> CookieManager;
 
+	/** Cached reads by URL, the whole store under an empty URL. Only accessed on the game thread. */
+	TMap<FString, FCachedCookies> CookieCache;
+
+	/** Visits in flight by URL. Only accessed on the game thread. */
+	TMap<FString, FPendingVisits> PendingVisits;
+
+	/** Incremented by every write made through the manager. */
+	uint64 WriteGeneration;
+
+	/** Completions reported by CEF, run together on the game thread by Tick. */
+	TQueue<TFunction<void()>, EQueueMode::Mpsc> PendingCompletions;
+
+	/** Whether completions are posted to the UI thread rather than queued, set once the manager is no longer ticked. */
+	bool bDetached;
+	FCriticalSection DetachCS;
+
+	/** Times of the first and last write since the store was last flushed, negative when there is nothing to flush. */
+	double FirstUnflushedWriteTime;
+	double LastWriteTime;
+
 	friend FCefWebBrowserCookieManagerFactory;
 };
 
+void FCefWebBrowserCookieManagerFactory::Tick(const TSharedPtr<IWebBrowserCookieManager>& CookieManager)
+{
+	if (CookieManager.IsValid())
+	{
+		StaticCastSharedPtr<FCefCookieManager>(CookieManager)->Tick();
+	}
+}
+
+void FCefWebBrowserCookieManagerFactory::Detach(const TSharedPtr<IWebBrowserCookieManager>& CookieManager)
+{
+	if (CookieManager.IsValid())
+	{
+		StaticCastSharedPtr<FCefCookieManager>(CookieManager)->Detach();
+	}
+}
+
 TSharedRef<IWebBrowserCookieManager> FCefWebBrowserCookieManagerFactory::Create(
 	const CefRefPtr<CefCookieManager>& CookieManager)
 {
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFDomainMatcher.h"
+
+#if WITH_CEF3
+
+#include "WebBrowserStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CEF Domain Match"), STAT_CEFDomainMatch, STATGROUP_WebBrowser);
+
+FCEFDomainMatcher::FCEFDomainMatcher(const TArray<FString>& InPatterns)
+	: Patterns(InPatterns)
+{
+	for (const FString& Pattern : Patterns)
+	{
+		FString Domain = Pattern.TrimStartAndEnd();
+		if (Domain.Contains(TEXT(":")) || Domain.Contains(TEXT("/")) || Domain.Contains(TEXT("?")) || Domain.Contains(TEXT("#")) || Domain.Contains(TEXT("@")))
+		{
+			UrlFragments.Add(MoveTemp(Domain));
+			continue;
+		}
+
+		// "*.example.com" and ".example.com" mean the same as "example.com"
+		Domain.RemoveFromStart(TEXT("*"));
+		Domain.RemoveFromStart(TEXT("."));
+		Domain.RemoveFromEnd(TEXT("."));
+		if (Domain.IsEmpty())
+		{
+			continue;
+		}
+
+		Domain.ToLowerInline();
+		uint64 Hash = HashSeed;
+		for (int32 Index = Domain.Len() - 1; Index >= 0; --Index)
+		{
+			Hash = HashReversed(Hash, Domain[Index]);
+		}
+		Domains.AddUnique(Hash, MoveTemp(Domain));
+	}
+}
+
+bool FCEFDomainMatcher::Matches(const FString& URL) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CEFDomainMatch);
+
+	if (Domains.Num() > 0)
+	{
+		const FStringView Host = GetHost(URL);
+
+		// Hash the host from its end, looking up each suffix that starts at a label boundary
+		uint64 Hash = HashSeed;
+		for (int32 Index = Host.Len() - 1; Index >= 0; --Index)
+		{
+			Hash = HashReversed(Hash, Host[Index]);
+			if (Index == 0 || Host[Index - 1] == TEXT('.'))
+			{
+				const FStringView Suffix = Host.RightChop(Index);
+				for (TMultiMap<uint64, FString>::TConstKeyIterator It = Domains.CreateConstKeyIterator(Hash); It; ++It)
+				{
+					if (Suffix.Equals(It.Value(), ESearchCase::IgnoreCase))
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	for (const FString& UrlFragment : UrlFragments)
+	{
+		if (URL.Contains(UrlFragment))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FStringView FCEFDomainMatcher::GetHost(FStringView URL)
+{
+	const int32 SchemeEnd = URL.Find(TEXT("://"));
+	if (SchemeEnd == INDEX_NONE)
+	{
+		return FStringView();
+	}
+
+	FStringView Authority = URL.RightChop(SchemeEnd + 3);
+	int32 AuthorityEnd = 0;
+	while (AuthorityEnd < Authority.Len() && Authority[AuthorityEnd] != TEXT('/') && Authority[AuthorityEnd] != TEXT('?') && Authority[AuthorityEnd] != TEXT('#') && Authority[AuthorityEnd] != TEXT('\\'))
+	{
+		++AuthorityEnd;
+	}
+	Authority.LeftInline(AuthorityEnd);
+
+	int32 UserInfoEnd;
+	if (Authority.FindLastChar(TEXT('@'), UserInfoEnd))
+	{
+		Authority.RightChopInline(UserInfoEnd + 1);
+	}
+
+	if (Authority.StartsWith(TEXT('[')))
+	{
+		// IPv6 literal
+		int32 LiteralEnd;
+		return Authority.FindChar(TEXT(']'), LiteralEnd) ? Authority.Mid(1, LiteralEnd - 1) : FStringView();
+	}
+
+	int32 PortStart;
+	if (Authority.FindChar(TEXT(':'), PortStart))
+	{
+		Authority.LeftInline(PortStart);
+	}
+	if (Authority.EndsWith(TEXT('.')))
+	{
+		Authority.LeftChopInline(1);
+	}
+	return Authority;
+}
+
+uint64 FCEFDomainMatcher::HashReversed(uint64 Hash, TCHAR Character)
+{
+	// FNV-1a
+	return (Hash ^ static_cast<uint64>(FChar::ToLower(Character))) * 0x100000001b3ull;
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+/**
+ * Matches URLs against a list of domains, compiled once so a check costs one pass over the host of the URL.
+ *
+ * A domain matches its own host and every subdomain of it, so "example.com" matches "https://www.example.com/path" but
+ * not "https://notexample.com". Patterns containing a scheme, port or path are matched anywhere in the URL instead.
+ * The matcher is immutable once built and can be shared between threads.
+ */
+class FCEFDomainMatcher
+{
+public:
+	/** @param Patterns Domains, or URL fragments, to match. */
+	explicit FCEFDomainMatcher(const TArray<FString>& Patterns);
+
+	/** @return true if the host of the URL is, or is a subdomain of, one of the domains. */
+	bool Matches(const FString& URL) const;
+
+	/** @return the patterns the matcher was built from. */
+	const TArray<FString>& GetPatterns() const
+	{
+		return Patterns;
+	}
+
+	/** @return the host of a URL, without user info or port, or an empty view if it has none. */
+	static FStringView GetHost(FStringView URL);
+
+private:
+	/** Hash of a lowercased string, computed from its last character to its first so the suffixes of a host hash incrementally. */
+	static uint64 HashReversed(uint64 Hash, TCHAR Character);
+
+	static constexpr uint64 HashSeed = 0xcbf29ce484222325ull;
+
+	TArray<FString> Patterns;
+
+	/** Domains by the hash of their reversed lowercase text. Colliding domains are all kept and compared. */
+	TMultiMap<uint64, FString> Domains;
+
+	/** Patterns that are not plain domains, matched as substrings of the URL. */
+	TArray<FString> UrlFragments;
+};
+
+#endif
@@ -0,0 +1,333 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+#include "CEFLibCefIncludes.h"
+#include "CEFBrowserClosureTask.h"
+
+/**
+ * Wire format of the batched JS bridge transport, shared by FCEFJSScripting in the browser process and FCEFJSBatchedCallQueue
+ * in the render process. Everything here is inline, so UnrealCEFSubProcess can compile it without linking this module.
+ *
+ * UE::ExecuteUObjectMethodBatch (renderer -> browser)
+ *   0: binary, a header followed by one call record per call
+ *   1: list, one argument list per call
+ *
+ * UE::ExecuteJSFunctionBatch (browser -> renderer)
+ *   0: binary, a header followed by one result record per result
+ *   1: list, one argument list per result
+ *
+ * Bound objects carry an integer "$handle", and "$methodHandles" parallel to "$methods", when the process info sent with
+ * CEF::STARTUP sets "batchedTransport". Callback ids are sent as the four raw components of the GUID.
+ */
+class FCEFJSBatchedTransport
+{
+public:
+	/** A UObject method call made by the page. */
+	struct FCall
+	{
+		int32 ObjectHandle;
+		int32 MethodHandle;
+		FGuid CallbackId;
+		CefRefPtr<CefListValue> Arguments;
+	};
+
+	/** The result of a call, or of a JS function passed to a UObject method. */
+	struct FResult
+	{
+		FGuid CallbackId;
+		CefRefPtr<CefListValue> Arguments;
+		bool bIsError;
+	};
+
+	static constexpr const TCHAR* CallsMessageName = TEXT("UE::ExecuteUObjectMethodBatch");
+	static constexpr const TCHAR* ResultsMessageName = TEXT("UE::ExecuteJSFunctionBatch");
+
+	static CefRefPtr<CefProcessMessage> EncodeCalls(const TArray<FCall>& Calls)
+	{
+		return Encode<FCallRecord>(CallsMessageName, Calls, [](const FCall& Call, FCallRecord& Record)
+		{
+			Record.ObjectHandle = Call.ObjectHandle;
+			Record.MethodHandle = Call.MethodHandle;
+			WriteGuid(Call.CallbackId, Record.CallbackId);
+		});
+	}
+
+	/** @return false if the message is not a well formed batch of calls, in which case OutCalls is left empty. */
+	static bool DecodeCalls(CefRefPtr<CefListValue> MessageArguments, TArray<FCall>& OutCalls)
+	{
+		return Decode<FCallRecord>(MessageArguments, OutCalls, [](const FCallRecord& Record, FCall& Call)
+		{
+			Call.ObjectHandle = Record.ObjectHandle;
+			Call.MethodHandle = Record.MethodHandle;
+			Call.CallbackId = ReadGuid(Record.CallbackId);
+		});
+	}
+
+	static CefRefPtr<CefProcessMessage> EncodeResults(const TArray<FResult>& Results)
+	{
+		return Encode<FResultRecord>(ResultsMessageName, Results, [](const FResult& Result, FResultRecord& Record)
+		{
+			WriteGuid(Result.CallbackId, Record.CallbackId);
+			Record.bIsError = Result.bIsError ? 1 : 0;
+		});
+	}
+
+	/** @return false if the message is not a well formed batch of results, in which case OutResults is left empty. */
+	static bool DecodeResults(CefRefPtr<CefListValue> MessageArguments, TArray<FResult>& OutResults)
+	{
+		return Decode<FResultRecord>(MessageArguments, OutResults, [](const FResultRecord& Record, FResult& Result)
+		{
+			Result.CallbackId = ReadGuid(Record.CallbackId);
+			Result.bIsError = Record.bIsError != 0;
+		});
+	}
+
+private:
+	static constexpr uint32 Magic = 0x31424555; // "UEB1"
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 NumRecords;
+	};
+
+	struct FCallRecord
+	{
+		int32 ObjectHandle;
+		int32 MethodHandle;
+		uint32 CallbackId[4];
+	};
+
+	struct FResultRecord
+	{
+		uint32 CallbackId[4];
+		uint32 bIsError;
+	};
+
+	static_assert(sizeof(FHeader) == 8 && sizeof(FCallRecord) == 24 && sizeof(FResultRecord) == 20, "Batched transport records are part of the IPC protocol and must not change size");
+
+	static void WriteGuid(const FGuid& Guid, uint32 (&OutComponents)[4])
+	{
+		for (int32 Component = 0; Component < 4; ++Component)
+		{
+			OutComponents[Component] = Guid[Component];
+		}
+	}
+
+	static FGuid ReadGuid(const uint32 (&Components)[4])
+	{
+		return FGuid(Components[0], Components[1], Components[2], Components[3]);
+	}
+
+	template<typename RecordType, typename ItemType, typename WriteRecordType>
+	static CefRefPtr<CefProcessMessage> Encode(const TCHAR* MessageName, const TArray<ItemType>& Items, WriteRecordType WriteRecord)
+	{
+		TArray<uint8> Records;
+		Records.SetNumUninitialized(sizeof(FHeader) + Items.Num() * sizeof(RecordType));
+		FHeader* Header = reinterpret_cast<FHeader*>(Records.GetData());
+		Header->Magic = Magic;
+		Header->NumRecords = Items.Num();
+		RecordType* Record = reinterpret_cast<RecordType*>(Records.GetData() + sizeof(FHeader));
+
+		CefRefPtr<CefListValue> ItemArguments = CefListValue::Create();
+		ItemArguments->SetSize(Items.Num());
+		for (int32 Index = 0; Index < Items.Num(); ++Index, ++Record)
+		{
+			WriteRecord(Items[Index], *Record);
+			ItemArguments->SetList(Index, Items[Index].Arguments);
+		}
+
+		CefRefPtr<CefProcessMessage> Message = CefProcessMessage::Create(TCHAR_TO_WCHAR(MessageName));
+		CefRefPtr<CefListValue> MessageArguments = Message->GetArgumentList();
+		MessageArguments->SetBinary(0, CefBinaryValue::Create(Records.GetData(), Records.Num()));
+		MessageArguments->SetList(1, ItemArguments);
+		return Message;
+	}
+
+	template<typename RecordType, typename ItemType, typename ReadRecordType>
+	static bool Decode(CefRefPtr<CefListValue> MessageArguments, TArray<ItemType>& OutItems, ReadRecordType ReadRecord)
+	{
+		OutItems.Reset();
+
+		// Message arguments are the binary records and the list of argument lists
+		if (MessageArguments->GetSize() != 2
+			|| MessageArguments->GetType(0) != VTYPE_BINARY
+			|| MessageArguments->GetType(1) != VTYPE_LIST
+			)
+		{
+			// Wrong message argument types or count
+			return false;
+		}
+
+		CefRefPtr<CefBinaryValue> Records = MessageArguments->GetBinary(0);
+		CefRefPtr<CefListValue> ItemArguments = MessageArguments->GetList(1);
+
+		FHeader Header;
+		const size_t RecordsSize = Records->GetSize();
+		if (RecordsSize < sizeof(FHeader) || Records->GetData(&Header, sizeof(FHeader), 0) != sizeof(FHeader))
+		{
+			return false;
+		}
+		if (Header.Magic != Magic
+			|| RecordsSize != sizeof(FHeader) + static_cast<size_t>(Header.NumRecords) * sizeof(RecordType)
+			|| ItemArguments->GetSize() != Header.NumRecords)
+		{
+			// Corrupt batch or unknown protocol version
+			return false;
+		}
+
+		TArray<RecordType> RecordData;
+		RecordData.SetNumUninitialized(Header.NumRecords);
+		Records->GetData(RecordData.GetData(), Header.NumRecords * sizeof(RecordType), sizeof(FHeader));
+
+		OutItems.SetNum(Header.NumRecords);
+		for (int32 Index = 0; Index < RecordData.Num(); ++Index)
+		{
+			ReadRecord(RecordData[Index], OutItems[Index]);
+			// A malformed argument list is passed on as null, the receiver reports the call as failed
+			OutItems[Index].Arguments = ItemArguments->GetType(Index) == VTYPE_LIST ? ItemArguments->GetList(Index) : nullptr;
+		}
+		return true;
+	}
+};
+
+/**
+ * Render process side of the batched transport, one per frame that exposes window.ue.
+ *
+ * When the CEF::STARTUP process info enables the transport, the method functions UnrealCEFSubProcess adds to bound objects that
+ * carry handles call Enqueue instead of sending a UE::ExecuteUObjectMethod message per call. Calls made during the same renderer
+ * task are sent together in one UE::ExecuteUObjectMethodBatch message, by a task posted when the first of them is queued.
+ * UE::ExecuteJSFunctionBatch messages are unpacked by DispatchResults into the callbacks UE::ExecuteJSFunction would have run.
+ * All methods are called on the renderer main thread.
+ */
+class FCEFJSBatchedCallQueue
+	: public TSharedFromThis<FCEFJSBatchedCallQueue, ESPMode::ThreadSafe>
+{
+public:
+	explicit FCEFJSBatchedCallQueue(CefRefPtr<CefFrame> InFrame)
+		: Frame(InFrame)
+		, bFlushPosted(false)
+	{ }
+
+	/** @return whether the browser process enabled the batched transport in the process info sent with CEF::STARTUP. */
+	static bool IsEnabled(CefRefPtr<CefDictionaryValue> ProcessInfo)
+	{
+		return ProcessInfo.get() != nullptr && ProcessInfo->GetType("batchedTransport") == VTYPE_BOOL && ProcessInfo->GetBool("batchedTransport");
+	}
+
+	/**
+	 * Gets the handles to batch calls to a method of a bound object with. Called once per method when the object is exposed
+	 * to the page, the handles are kept with the method function.
+	 *
+	 * @param Object The converted object, with a "$type" of "uobject".
+	 * @param MethodIndex The index of the method in "$methods".
+	 * @return false if the object was converted without handles, in which case calls are sent with UE::ExecuteUObjectMethod.
+	 */
+	static bool GetHandles(CefRefPtr<CefDictionaryValue> Object, size_t MethodIndex, int32& OutObjectHandle, int32& OutMethodHandle)
+	{
+		if (Object.get() == nullptr || Object->GetType("$handle") != VTYPE_INT || Object->GetType("$methodHandles") != VTYPE_LIST)
+		{
+			return false;
+		}
+
+		CefRefPtr<CefListValue> MethodHandles = Object->GetList("$methodHandles");
+		if (MethodIndex >= MethodHandles->GetSize() || MethodHandles->GetType(MethodIndex) != VTYPE_INT)
+		{
+			return false;
+		}
+
+		OutObjectHandle = Object->GetInt("$handle");
+		OutMethodHandle = MethodHandles->GetInt(MethodIndex);
+		return true;
+	}
+
+	/**
+	 * Queues a call, to be sent with the other calls made before control returns to the renderer message loop.
+	 * A queue created without a frame only hands its calls out through TakeMessage.
+	 */
+	void Enqueue(int32 ObjectHandle, int32 MethodHandle, const FGuid& CallbackId, CefRefPtr<CefListValue> Arguments)
+	{
+		Calls.Add({ ObjectHandle, MethodHandle, CallbackId, Arguments });
+		if (!bFlushPosted && Frame.get() != nullptr)
+		{
+			bFlushPosted = true;
+			TWeakPtr<FCEFJSBatchedCallQueue, ESPMode::ThreadSafe> WeakThis = AsShared();
+			CefPostTask(TID_RENDERER, new FCEFBrowserClosureTask(nullptr, [WeakThis]()
+			{
+				if (TSharedPtr<FCEFJSBatchedCallQueue, ESPMode::ThreadSafe> This = WeakThis.Pin())
+				{
+					This->Flush();
+				}
+			}));
+		}
+	}
+
+	/** Sends the queued calls to the browser process. */
+	void Flush()
+	{
+		bFlushPosted = false;
+		CefRefPtr<CefProcessMessage> Message = TakeMessage();
+		if (Message.get() != nullptr && Frame.get() != nullptr && Frame->IsValid())
+		{
+			Frame->SendProcessMessage(PID_BROWSER, Message);
+		}
+	}
+
+	/** @return the queued calls as a UE::ExecuteUObjectMethodBatch message, or nullptr if there are none. The queue is emptied. */
+	CefRefPtr<CefProcessMessage> TakeMessage()
+	{
+		if (Calls.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		CefRefPtr<CefProcessMessage> Message = FCEFJSBatchedTransport::EncodeCalls(Calls);
+		Calls.Reset();
+		return Message;
+	}
+
+	/** @return the number of calls waiting to be sent. */
+	int32 GetNumQueued() const
+	{
+		return Calls.Num();
+	}
+
+	/**
+	 * Runs the callbacks of a UE::ExecuteJSFunctionBatch message, in the order the browser process completed them.
+	 *
+	 * @param Message The message received from the browser process.
+	 * @param InvokeCallback Runs a callback, as the handler of UE::ExecuteJSFunction does.
+	 * @return false if the message is not a well formed batch.
+	 */
+	static bool DispatchResults(CefRefPtr<CefProcessMessage> Message, TFunctionRef<void(const FGuid& CallbackId, CefRefPtr<CefListValue> Arguments, bool bIsError)> InvokeCallback)
+	{
+		TArray<FCEFJSBatchedTransport::FResult> Results;
+		if (!FCEFJSBatchedTransport::DecodeResults(Message->GetArgumentList(), Results))
+		{
+			return false;
+		}
+
+		for (const FCEFJSBatchedTransport::FResult& Result : Results)
+		{
+			InvokeCallback(Result.CallbackId, Result.Arguments.get() != nullptr ? Result.Arguments : CefListValue::Create(), Result.bIsError);
+		}
+		return true;
+	}
+
+private:
+	/** The frame the calls are made from, and sent through. */
+	CefRefPtr<CefFrame> Frame;
+
+	/** Calls made since the last flush. */
+	TArray<FCEFJSBatchedTransport::FCall> Calls;
+
+	/** Whether a task to flush the queued calls has been posted and not run yet. */
+	bool bFlushPosted;
+};
+
+#endif
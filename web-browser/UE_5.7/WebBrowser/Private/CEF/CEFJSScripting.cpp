@@ -11,6 +11,24 @@
 #include "CEFJSStructDeserializerBackend.h"
 #include "StructSerializer.h"
 #include "StructDeserializer.h"
+#include "HAL/IConsoleManager.h"
+#include "WebBrowserStats.h"
+
+static bool bJSBatchedTransport = false;
+static FAutoConsoleVariableRef CVarJSBatchedTransport(
+	TEXT("webbrowser.JSBatchedTransport"),
+	bJSBatchedTransport,
+	TEXT("Exposes integer object and method handles to the renderer process so UObject method calls and their results can be batched in binary messages\n"),
+	ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("CEF JS Execute UObject Method"), STAT_CEFJSExecuteUObjectMethod, STATGROUP_WebBrowser);
+DECLARE_CYCLE_STAT(TEXT("CEF JS Execute UObject Method Batch"), STAT_CEFJSExecuteUObjectMethodBatch, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Method Calls"), STAT_CEFJSMethodCalls, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Method Calls Batched"), STAT_CEFJSMethodCallsBatched, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Results Batched"), STAT_CEFJSResultsBatched, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Process Messages Received"), STAT_CEFJSMessagesReceived, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Process Messages Sent"), STAT_CEFJSMessagesSent, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF JS Reflection Cache Misses"), STAT_CEFJSReflectionCacheMisses, STATGROUP_WebBrowser);
 
 
 // Internal utility function(s)
@@ -46,6 +64,196 @@ namespace
 	}
 }
 
+FCEFJSScripting::FCEFJSScripting(CefRefPtr<CefBrowser> Browser, bool bInJSBindingToLoweringEnabled)
+	: FWebJSScripting(bInJSBindingToLoweringEnabled)
+	, InternalCefBrowser(Browser)
+	, NextObjectHandle(1)
+	, bRendererUsesBatchedTransport(false)
+{
+	// Cached properties and functions are stale once their class has been reloaded
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FCEFJSScripting::OnReloadComplete);
+#if WITH_EDITOR
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FCEFJSScripting::OnObjectsReinstanced);
+#endif
+}
+
+FCEFJSScripting::~FCEFJSScripting()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+#endif
+}
+
+bool FCEFJSScripting::IsBatchedTransportEnabled()
+{
+	return bJSBatchedTransport;
+}
+
+void FCEFJSScripting::OnReloadComplete(EReloadCompleteReason Reason)
+{
+	InvalidateReflectionCache();
+}
+
+void FCEFJSScripting::OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+	InvalidateReflectionCache();
+}
+
+void FCEFJSScripting::InvalidateReflectionCache()
+{
+	ClassDescriptors.Reset();
+	StructBindings.Reset();
+	UnownedBindings = FCEFJSStructBindings();
+}
+
+uint32 FCEFJSStructBindings::HashKey(const CefString& Key)
+{
+	return FCrc::MemCrc32(Key.c_str(), Key.length() * sizeof(CefString::char_type));
+}
+
+const FCEFJSStructBindings::FEntry* FCEFJSStructBindings::FindByKey(const CefString& Key) const
+{
+	const int32* Index = EntriesByKeyHash.Find(HashKey(Key));
+	// A hash collision falls back to the caller converting the key
+	return (Index != nullptr && Entries[*Index].Key == Key) ? &Entries[*Index] : nullptr;
+}
+
+const FCEFJSStructBindings* FCEFJSScripting::GetStructBindings(const UStruct* Struct)
+{
+	return Struct != nullptr ? &FindOrAddStructBindings(Struct) : nullptr;
+}
+
+FCEFJSStructBindings& FCEFJSScripting::FindOrAddStructBindings(const UStruct* Struct)
+{
+	if (TUniquePtr<FCEFJSStructBindings>* Existing = StructBindings.Find(Struct))
+	{
+		return **Existing;
+	}
+
+	INC_DWORD_STAT(STAT_CEFJSReflectionCacheMisses);
+
+	TUniquePtr<FCEFJSStructBindings> Bindings = MakeUnique<FCEFJSStructBindings>();
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		FProperty* Property = *It;
+		const int32 Index = Bindings->Entries.Add(new FCEFJSStructBindings::FEntry{ Property, TCHAR_TO_WCHAR(*GetBindingName(Property)), Property->GetName() });
+		Bindings->EntriesByProperty.Add(Property, Index);
+		Bindings->EntriesByKeyHash.FindOrAdd(FCEFJSStructBindings::HashKey(Bindings->Entries[Index].Key), Index);
+	}
+
+	// Drop entries for structs that have been garbage collected since
+	for (auto It = StructBindings.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return *StructBindings.Add(Struct, MoveTemp(Bindings));
+}
+
+const CefString& FCEFJSScripting::GetBindingKey(const FProperty* Property)
+{
+	const UStruct* OwnerStruct = Property->GetOwnerStruct();
+	FCEFJSStructBindings& Bindings = OwnerStruct != nullptr ? FindOrAddStructBindings(OwnerStruct) : UnownedBindings;
+	if (const int32* Index = Bindings.EntriesByProperty.Find(Property))
+	{
+		return Bindings.Entries[*Index].Key;
+	}
+
+	// Nested properties, such as array inners, and properties without a struct are only added to the forward lookup
+	const int32 Index = Bindings.Entries.Add(new FCEFJSStructBindings::FEntry{ const_cast<FProperty*>(Property), TCHAR_TO_WCHAR(*GetBindingName(Property)), Property->GetName() });
+	Bindings.EntriesByProperty.Add(Property, Index);
+	return Bindings.Entries[Index].Key;
+}
+
+FCEFJSClassDescriptor& FCEFJSScripting::GetClassDescriptor(UClass* Class)
+{
+	if (TUniquePtr<FCEFJSClassDescriptor>* Existing = ClassDescriptors.Find(Class))
+	{
+		return **Existing;
+	}
+
+	INC_DWORD_STAT(STAT_CEFJSReflectionCacheMisses);
+
+	TUniquePtr<FCEFJSClassDescriptor> Descriptor = MakeUnique<FCEFJSClassDescriptor>();
+	Descriptor->MethodNames = CefListValue::Create();
+	Descriptor->MethodHandles = CefListValue::Create();
+	int32 MethodIndex = 0;
+	for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::IncludeSuper); FunctionIt; ++FunctionIt)
+	{
+		UFunction* Function = *FunctionIt;
+		const FString BindingName = GetBindingName(Function);
+		Descriptor->MethodHandles->SetInt(MethodIndex, GetMethodHandle(*BindingName));
+		Descriptor->MethodNames->SetString(MethodIndex++, TCHAR_TO_WCHAR(*BindingName));
+	}
+
+	// Drop entries for classes that have been garbage collected since
+	for (auto It = ClassDescriptors.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return *ClassDescriptors.Add(Class, MoveTemp(Descriptor));
+}
+
+TSharedPtr<const FCEFJSFunctionDescriptor> FCEFJSScripting::GetFunctionDescriptor(UObject* Object, FName MethodName)
+{
+	FCEFJSClassDescriptor& ClassDescriptor = GetClassDescriptor(Object->GetClass());
+	if (const TSharedRef<const FCEFJSFunctionDescriptor>* Existing = ClassDescriptor.Functions.Find(MethodName))
+	{
+		return *Existing;
+	}
+
+	UFunction* Function = Object->FindFunction(MethodName);
+	if (!Function)
+	{
+		return nullptr;
+	}
+
+	INC_DWORD_STAT(STAT_CEFJSReflectionCacheMisses);
+
+	TSharedRef<FCEFJSFunctionDescriptor> Descriptor = MakeShared<FCEFJSFunctionDescriptor>();
+	Descriptor->Function = Function;
+	if (Function->ParmsSize > 0)
+	{
+		Descriptor->ParamsStructSize = Function->GetStructureSize();
+		for (TFieldIterator<FProperty> It(Function); It; ++It)
+		{
+			FProperty* Param = *It;
+			if (Param->PropertyFlags & CPF_Parm)
+			{
+				if (Param->PropertyFlags & CPF_ReturnParm)
+				{
+					Descriptor->ReturnParam = Param;
+					Descriptor->ReturnBindingName = TCHAR_TO_WCHAR(*GetBindingName(Param));
+				}
+				else
+				{
+					FStructProperty *StructProperty = CastField<FStructProperty>(Param);
+					if (StructProperty && StructProperty->Struct->IsChildOf(FWebJSResponse::StaticStruct()))
+					{
+						Descriptor->PromiseParam = Param;
+					}
+					else
+					{
+						Descriptor->ArgParams.Add(Param);
+						Descriptor->ArgBindingNames.Add(TCHAR_TO_WCHAR(*GetBindingName(Param)));
+					}
+				}
+			}
+		}
+	}
+
+	ClassDescriptor.Functions.Add(MethodName, Descriptor);
+	return Descriptor;
+}
+
 CefRefPtr<CefDictionaryValue> FCEFJSScripting::ConvertStruct(UStruct* TypeInfo, const void* StructPtr)
 {
 	FCEFJSStructSerializerBackend Backend (SharedThis(this));
@@ -63,18 +271,17 @@ CefRefPtr<CefDictionaryValue> FCEFJSScripting::ConvertObject(UObject* Object)
 	CefRefPtr<CefDictionaryValue> Result = CefDictionaryValue::Create();
 	RetainBinding(Object);
 
-	UClass* Class = Object->GetClass();
-	CefRefPtr<CefListValue> MethodNames = CefListValue::Create();
-	int32 MethodIndex = 0;
-	for (TFieldIterator<UFunction> FunctionIt(Class, EFieldIteratorFlags::IncludeSuper); FunctionIt; ++FunctionIt)
-	{
-		UFunction* Function = *FunctionIt;
-		MethodNames->SetString(MethodIndex++, TCHAR_TO_WCHAR(*GetBindingName(Function)));
-	}
+	const FCEFJSClassDescriptor& ClassDescriptor = GetClassDescriptor(Object->GetClass());
 
 	Result->SetString("$type", "uobject");
 	Result->SetString("$id", TCHAR_TO_WCHAR(*PtrToGuid(Object).ToString(EGuidFormats::Digits)));
-	Result->SetList("$methods", MethodNames);
+	// The cached lists are copied, as CEF takes ownership of values added to a container
+	Result->SetList("$methods", ClassDescriptor.MethodNames->Copy());
+	if (IsBatchedTransportEnabled())
+	{
+		Result->SetInt("$handle", GetObjectHandle(Object));
+		Result->SetList("$methodHandles", ClassDescriptor.MethodHandles->Copy());
+	}
 	return Result;
 }
 
@@ -87,6 +294,10 @@ bool FCEFJSScripting::OnProcessMessageReceived(CefRefPtr<CefBrowser> Browser, Ce
 	{
 		Result = HandleExecuteUObjectMethodMessage(Message->GetArgumentList());
 	}
+	else if (MessageName == FCEFJSBatchedTransport::CallsMessageName)
+	{
+		Result = HandleExecuteUObjectMethodBatchMessage(Message->GetArgumentList());
+	}
 	else if (MessageName == TEXT("UE::ReleaseUObject"))
 	{
 		Result = HandleReleaseUObjectMessage(Message->GetArgumentList());
@@ -96,9 +307,14 @@ bool FCEFJSScripting::OnProcessMessageReceived(CefRefPtr<CefBrowser> Browser, Ce
 
 void FCEFJSScripting::SendProcessMessage(CefRefPtr<CefProcessMessage> Message)
 {
-	if (IsValid() && InternalCefBrowser->GetMainFrame())
+	if (MessageSink)
+	{
+		MessageSink(Message);
+	}
+	else if (IsValid() && InternalCefBrowser->GetMainFrame())
 	{
 		InternalCefBrowser->GetMainFrame()->SendProcessMessage(PID_RENDERER, Message);
+		INC_DWORD_STAT(STAT_CEFJSMessagesSent);
 	}
 }
 
@@ -158,6 +374,7 @@ void FCEFJSScripting::UnbindUObject(const FString& Name, UObject* Object, bool b
 		{
 			Object = PermanentUObjectsByName.FindAndRemoveChecked(ExposedName);
 			BoundObjects.Remove(Object);
+			ForgetObjectHandle(Object);
 			return;
 		}
 		else
@@ -200,11 +417,18 @@ bool FCEFJSScripting::HandleReleaseUObjectMessage(CefRefPtr<CefListValue> Messag
 		return false;
 	}
 	ReleaseBinding(Object);
+	if (!BoundObjects.Contains(Object))
+	{
+		ForgetObjectHandle(Object);
+	}
 	return true;
 }
 
 bool FCEFJSScripting::HandleExecuteUObjectMethodMessage(CefRefPtr<CefListValue> MessageArguments)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CEFJSExecuteUObjectMethod);
+	INC_DWORD_STAT(STAT_CEFJSMessagesReceived);
+
 	FGuid ObjectKey;
 	// Message arguments are Name, Value, bGlobal
 	if (MessageArguments->GetSize() != 4
@@ -241,54 +465,85 @@ bool FCEFJSScripting::HandleExecuteUObjectMethodMessage(CefRefPtr<CefListValue>
 	}
 
 	FName MethodName = WCHAR_TO_TCHAR(MessageArguments->GetString(1).ToWString().c_str());
-	UFunction* Function = Object->FindFunction(MethodName);
-	if (!Function)
+	ExecuteUObjectMethod(Object, MethodName, ResultCallbackId, MessageArguments->GetList(3));
+	return true;
+}
+
+bool FCEFJSScripting::HandleExecuteUObjectMethodBatchMessage(CefRefPtr<CefListValue> MessageArguments)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CEFJSExecuteUObjectMethodBatch);
+	INC_DWORD_STAT(STAT_CEFJSMessagesReceived);
+
+	TArray<FCEFJSBatchedTransport::FCall> Calls;
+	if (!FCEFJSBatchedTransport::DecodeCalls(MessageArguments, Calls))
+	{
+		// Wrong message arguments, corrupt batch or unknown protocol version
+		return false;
+	}
+
+	{
+		// The renderer is able to decode batched results from now on
+		FScopeLock Lock(&PendingResultsCS);
+		bRendererUsesBatchedTransport = true;
+	}
+
+	INC_DWORD_STAT_BY(STAT_CEFJSMethodCallsBatched, Calls.Num());
+	for (const FCEFJSBatchedTransport::FCall& Call : Calls)
+	{
+		UObject* Object = HandleToPtr(Call.ObjectHandle);
+		if (Object == nullptr)
+		{
+			// Unknown uobject handle
+			InvokeJSErrorResult(Call.CallbackId, TEXT("Unknown UObject ID"));
+			continue;
+		}
+
+		if (!MethodNames.IsValidIndex(Call.MethodHandle) || Call.Arguments.get() == nullptr)
+		{
+			InvokeJSErrorResult(Call.CallbackId, TEXT("Unknown UObject Function"));
+			continue;
+		}
+
+		ExecuteUObjectMethod(Object, MethodNames[Call.MethodHandle], Call.CallbackId, Call.Arguments);
+	}
+
+	// Send the results of synchronous calls back in the same round trip
+	FlushBatchedResults();
+	return true;
+}
+
+void FCEFJSScripting::ExecuteUObjectMethod(UObject* Object, FName MethodName, const FGuid& ResultCallbackId, CefRefPtr<CefListValue> CefArgs)
+{
+	INC_DWORD_STAT(STAT_CEFJSMethodCalls);
+
+	// Hold on to the descriptor, the cache may be invalidated while the function runs
+	TSharedPtr<const FCEFJSFunctionDescriptor> Descriptor = GetFunctionDescriptor(Object, MethodName);
+	if (!Descriptor.IsValid())
 	{
 		InvokeJSErrorResult(ResultCallbackId, TEXT("Unknown UObject Function"));
-		return true;
+		return;
 	}
+	UFunction* Function = Descriptor->Function;
+
 	// Coerce arguments to function arguments.
-	uint16 ParamsSize = Function->ParmsSize;
 	uint8* Params  = nullptr;
-	FProperty* ReturnParam = nullptr;
-	FProperty* PromiseParam = nullptr;
+	FProperty* ReturnParam = Descriptor->ReturnParam;
+	FProperty* PromiseParam = Descriptor->PromiseParam;
 
-	if (ParamsSize > 0)
+	if (Descriptor->ParamsStructSize > 0)
 	{
 		// Convert cef argument list to a dictionary, so we can use FStructDeserializer to convert it for us
 		CefRefPtr<CefDictionaryValue> NamedArgs = CefDictionaryValue::Create();
-		int32 CurrentArg = 0;
-		CefRefPtr<CefListValue> CefArgs = MessageArguments->GetList(3);
-		for ( TFieldIterator<FProperty> It(Function); It; ++It )
+		for (int32 ArgIndex = 0; ArgIndex < Descriptor->ArgBindingNames.Num(); ++ArgIndex)
 		{
-			FProperty* Param = *It;
-			if (Param->PropertyFlags & CPF_Parm)
-			{
-				if (Param->PropertyFlags & CPF_ReturnParm)
-				{
-					ReturnParam = Param;
-				}
-				else
-				{
-					FStructProperty *StructProperty = CastField<FStructProperty>(Param);
-					if (StructProperty && StructProperty->Struct->IsChildOf(FWebJSResponse::StaticStruct()))
-					{
-						PromiseParam = Param;
-					}
-					else
-					{
-						CopyContainerValue(NamedArgs, CefArgs, CefString(TCHAR_TO_WCHAR(*GetBindingName(Param))), CurrentArg);
-						CurrentArg++;
-					}
-				}
-			}
+			CopyContainerValue(NamedArgs, CefArgs, Descriptor->ArgBindingNames[ArgIndex], ArgIndex);
 		}
 
 		// UFunction is a subclass of UStruct, so we can treat the arguments as a struct for deserialization
 		check(nullptr == Params);
-		Params = (uint8*)FMemory::Malloc(Function->GetStructureSize());
+		Params = (uint8*)FMemory::Malloc(Descriptor->ParamsStructSize);
 		Function->InitializeStruct(Params);
-		FCEFJSStructDeserializerBackend Backend = FCEFJSStructDeserializerBackend(SharedThis(this), NamedArgs);
+		FCEFJSStructDeserializerBackend Backend = FCEFJSStructDeserializerBackend(SharedThis(this), NamedArgs, Function);
 		FStructDeserializer::Deserialize(Params, *Function, Backend);
 	}
 
@@ -318,7 +573,7 @@ bool FCEFJSScripting::HandleExecuteUObjectMethodMessage(CefRefPtr<CefListValue>
 			CefRefPtr<CefDictionaryValue> ResultDict = ReturnBackend.GetResult();
 
 			// Extract the single return value from the serialized dictionary to an array
-			CopyContainerValue(Results, ResultDict, 0, TCHAR_TO_WCHAR(*GetBindingName(ReturnParam)));
+			CopyContainerValue(Results, ResultDict, 0, Descriptor->ReturnBindingName);
 		}
 		InvokeJSFunction(ResultCallbackId, Results, false);
 	}
@@ -329,8 +584,6 @@ bool FCEFJSScripting::HandleExecuteUObjectMethodMessage(CefRefPtr<CefListValue>
 		FMemory::Free(Params);
 		Params = nullptr;
 	}
-
-	return true;
 }
 
 void FCEFJSScripting::UnbindCefBrowser()
@@ -338,6 +591,17 @@ void FCEFJSScripting::UnbindCefBrowser()
 	InternalCefBrowser = nullptr;
 }
 
+void FCEFJSScripting::UnbindAll()
+{
+	PermanentUObjectsByName.Empty();
+	BoundObjects.Empty();
+	ObjectHandles.Empty();
+	ObjectsByHandle.Empty();
+
+	FScopeLock Lock(&PendingResultsCS);
+	PendingResults.Empty();
+}
+
 void FCEFJSScripting::InvokeJSErrorResult(FGuid FunctionId, const FString& Error)
 {
 	CefRefPtr<CefListValue> FunctionArguments = CefListValue::Create();
@@ -357,6 +621,15 @@ void FCEFJSScripting::InvokeJSFunction(FGuid FunctionId, int32 ArgCount, FWebJSP
 
 void FCEFJSScripting::InvokeJSFunction(FGuid FunctionId, const CefRefPtr<CefListValue>& FunctionArguments, bool bIsError)
 {
+	{
+		FScopeLock Lock(&PendingResultsCS);
+		if (bRendererUsesBatchedTransport)
+		{
+			PendingResults.Add({ FunctionId, FunctionArguments, bIsError });
+			return;
+		}
+	}
+
 	CefRefPtr<CefProcessMessage> Message = CefProcessMessage::Create(TCHAR_TO_WCHAR(TEXT("UE::ExecuteJSFunction")));
 	CefRefPtr<CefListValue> MessageArguments = Message->GetArgumentList();
 	MessageArguments->SetString(0, TCHAR_TO_WCHAR(*FunctionId.ToString(EGuidFormats::Digits)));
@@ -365,4 +638,73 @@ void FCEFJSScripting::InvokeJSFunction(FGuid FunctionId, const CefRefPtr<CefList
 	SendProcessMessage(Message);
 }
 
+void FCEFJSScripting::FlushBatchedResults()
+{
+	TArray<FCEFJSBatchedTransport::FResult> Results;
+	{
+		FScopeLock Lock(&PendingResultsCS);
+		if (PendingResults.Num() == 0)
+		{
+			return;
+		}
+		Results = MoveTemp(PendingResults);
+	}
+
+	INC_DWORD_STAT_BY(STAT_CEFJSResultsBatched, Results.Num());
+	SendProcessMessage(FCEFJSBatchedTransport::EncodeResults(Results));
+}
+
+void FCEFJSScripting::ResetBatchedTransport()
+{
+	FScopeLock Lock(&PendingResultsCS);
+	bRendererUsesBatchedTransport = false;
+	PendingResults.Empty();
+}
+
+void FCEFJSScripting::SetMessageSink(TFunction<void(CefRefPtr<CefProcessMessage>)> InMessageSink)
+{
+	MessageSink = MoveTemp(InMessageSink);
+}
+
+int32 FCEFJSScripting::GetObjectHandle(UObject* Object)
+{
+	if (int32* Existing = ObjectHandles.Find(Object))
+	{
+		return *Existing;
+	}
+
+	const int32 Handle = NextObjectHandle++;
+	ObjectHandles.Add(Object, Handle);
+	ObjectsByHandle.Add(Handle, Object);
+	return Handle;
+}
+
+UObject* FCEFJSScripting::HandleToPtr(int32 Handle) const
+{
+	UObject* const* Object = ObjectsByHandle.Find(Handle);
+	// Like GuidToPtr, only resolve objects we are still holding on to
+	return (Object != nullptr && BoundObjects.Contains(*Object)) ? *Object : nullptr;
+}
+
+void FCEFJSScripting::ForgetObjectHandle(UObject* Object)
+{
+	int32 Handle;
+	if (ObjectHandles.RemoveAndCopyValue(Object, Handle))
+	{
+		ObjectsByHandle.Remove(Handle);
+	}
+}
+
+int32 FCEFJSScripting::GetMethodHandle(FName MethodName)
+{
+	if (int32* Existing = MethodHandles.Find(MethodName))
+	{
+		return *Existing;
+	}
+
+	const int32 Handle = MethodNames.Add(MethodName);
+	MethodHandles.Add(MethodName, Handle);
+	return Handle;
+}
+
 #endif
\ No newline at end of file
@@ -7,6 +7,10 @@
 #if WITH_CEF3
 #include "WebJSFunction.h"
 #include "WebJSScripting.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "UObject/UObjectGlobals.h"
+#include "Containers/IndirectArray.h"
+#include "CEFJSBatchedTransport.h"
 
 #if PLATFORM_WINDOWS
 #include "Windows/AllowWindowsPlatformTypes.h"
@@ -37,6 +41,77 @@ struct FWebJSParam;
 
 #if WITH_CEF3
 
+/**
+ * Cached reflection data for calling a UFunction from JavaScript.
+ */
+struct FCEFJSFunctionDescriptor
+{
+	/** The function to call. */
+	UFunction* Function = nullptr;
+
+	/** Parameters filled from the JS argument list, in call order. */
+	TArray<FProperty*> ArgParams;
+
+	/** Binding names of ArgParams, used as keys when deserializing the arguments. */
+	TArray<CefString> ArgBindingNames;
+
+	/** The return value parameter, if any. */
+	FProperty* ReturnParam = nullptr;
+
+	/** Binding name of ReturnParam. */
+	CefString ReturnBindingName;
+
+	/** The FWebJSResponse parameter used to complete the call asynchronously, if any. */
+	FProperty* PromiseParam = nullptr;
+
+	/** Size of the parameter struct to allocate, 0 if the function has no parameters. */
+	int32 ParamsStructSize = 0;
+};
+
+/**
+ * Cached reflection data for binding objects of a class to JavaScript.
+ */
+struct FCEFJSClassDescriptor
+{
+	/** Binding names of all functions of the class, ready to be copied into "$methods". */
+	CefRefPtr<CefListValue> MethodNames;
+
+	/** Method handles parallel to MethodNames, ready to be copied into "$methodHandles". */
+	CefRefPtr<CefListValue> MethodHandles;
+
+	/** Function descriptors, filled in the first time each function is called. */
+	TMap<FName, TSharedRef<const FCEFJSFunctionDescriptor>> Functions;
+};
+
+/**
+ * Precomputed binding names for the properties of a struct, with a reverse lookup from binding names to properties.
+ */
+struct FCEFJSStructBindings
+{
+	struct FEntry
+	{
+		/** The property. */
+		FProperty* Property;
+
+		/** Binding name of the property, as used for dictionary keys. */
+		CefString Key;
+
+		/** Name of the property, as expected by FStructDeserializer. */
+		FString Name;
+	};
+
+	/** Entries are allocated individually so references stay valid as properties are added. */
+	TIndirectArray<FEntry> Entries;
+	TMap<const FProperty*, int32> EntriesByProperty;
+	TMap<uint32, int32> EntriesByKeyHash;
+
+	/** @return the entry for the given dictionary key, or nullptr if no direct property of the struct has this binding name. */
+	const FEntry* FindByKey(const CefString& Key) const;
+
+	/** @return the hash used for the reverse lookup. */
+	static uint32 HashKey(const CefString& Key);
+};
+
 /**
  * Implements handling of bridging UObjects client side with JavaScript renderer side.
  */
@@ -45,13 +120,17 @@ class FCEFJSScripting
 	, public TSharedFromThis<FCEFJSScripting>
 {
 public:
-	FCEFJSScripting(CefRefPtr<CefBrowser> Browser, bool bJSBindingToLoweringEnabled)
-		: FWebJSScripting(bJSBindingToLoweringEnabled)
-		, InternalCefBrowser(Browser)
-	{}
+	FCEFJSScripting(CefRefPtr<CefBrowser> Browser, bool bJSBindingToLoweringEnabled);
+	virtual ~FCEFJSScripting();
 
 	void UnbindCefBrowser();
 
+	/**
+	 * Forgets every bound object, permanent or not, and drops any queued JS results.
+	 * Used when a browser is returned to the pool and the page that referenced the objects is being unloaded.
+	 */
+	void UnbindAll();
+
 	virtual void BindUObject(const FString& Name, UObject* Object, bool bIsPermanent = true) override;
 	virtual void UnbindUObject(const FString& Name, UObject* Object = nullptr, bool bIsPermanent = true) override;
 
@@ -73,6 +152,45 @@ public:
 	 */
 	void SendProcessMessage(CefRefPtr<CefProcessMessage> Message);
 
+	/**
+	 * Sends any JS function results queued by the batched transport to the renderer process in a single message.
+	 * Called once per message pump tick.
+	 */
+	void FlushBatchedResults();
+
+	/**
+	 * Goes back to sending JS function results one message each, dropping any queued results.
+	 * Called when the main frame starts loading a new document and when the render process is gone, as the page that sent
+	 * batches may be replaced by one that does not.
+	 */
+	void ResetBatchedTransport();
+
+	/**
+	 * Routes the messages meant for the render process to a function instead, to drive the bridge without one.
+	 *
+	 * @param InMessageSink Receives the messages, or null to send them to the render process again.
+	 */
+	void SetMessageSink(TFunction<void(CefRefPtr<CefProcessMessage>)> InMessageSink);
+
+	/** @return whether the batched binary transport is enabled, in which case converted objects carry integer handles. */
+	static bool IsBatchedTransportEnabled();
+
+	/**
+	 * Gets the binding name of a property as a CEF string, without allocating after the first call for the property.
+	 *
+	 * @param Property The property.
+	 * @return The binding name, interned per property. The reference stays valid until the reflection cache is invalidated.
+	 */
+	const CefString& GetBindingKey(const FProperty* Property);
+
+	/**
+	 * Gets the binding names of the direct properties of a struct.
+	 *
+	 * @param Struct The struct, or nullptr.
+	 * @return The bindings, or nullptr if Struct is null.
+	 */
+	const FCEFJSStructBindings* GetStructBindings(const UStruct* Struct);
+
 	CefRefPtr<CefDictionaryValue> ConvertStruct(UStruct* TypeInfo, const void* StructPtr);
 	CefRefPtr<CefDictionaryValue> ConvertObject(UObject* Object);
 
@@ -152,10 +270,62 @@ private:
 	/** Message handling helpers */
 
 	bool HandleExecuteUObjectMethodMessage(CefRefPtr<CefListValue> MessageArguments);
+	bool HandleExecuteUObjectMethodBatchMessage(CefRefPtr<CefListValue> MessageArguments);
 	bool HandleReleaseUObjectMessage(CefRefPtr<CefListValue> MessageArguments);
 
+	/** Reflection cache helpers */
+
+	FCEFJSClassDescriptor& GetClassDescriptor(UClass* Class);
+	TSharedPtr<const FCEFJSFunctionDescriptor> GetFunctionDescriptor(UObject* Object, FName MethodName);
+	void InvalidateReflectionCache();
+	FCEFJSStructBindings& FindOrAddStructBindings(const UStruct* Struct);
+	void OnReloadComplete(EReloadCompleteReason Reason);
+	void OnObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+
+	/** Calls a method on a bound object and reports the result, or the error, to the given JS callback. */
+	void ExecuteUObjectMethod(UObject* Object, FName MethodName, const FGuid& ResultCallbackId, CefRefPtr<CefListValue> CefArgs);
+
+	/** Integer handle helpers used by the batched transport */
+
+	int32 GetObjectHandle(UObject* Object);
+	UObject* HandleToPtr(int32 Handle) const;
+	void ForgetObjectHandle(UObject* Object);
+	int32 GetMethodHandle(FName MethodName);
+
 	/** Pointer to the CEF Browser for this window. */
 	CefRefPtr<CefBrowser> InternalCefBrowser;
+
+	/** Reflection data per class, so objects rebound on every page load only pay the reflection cost once. */
+	TMap<TWeakObjectPtr<UClass>, TUniquePtr<FCEFJSClassDescriptor>> ClassDescriptors;
+
+	/** Binding names per struct, so serializing large structs and arrays doesn't allocate a name per field. */
+	TMap<TWeakObjectPtr<const UStruct>, TUniquePtr<FCEFJSStructBindings>> StructBindings;
+
+	/** Binding names of the properties that don't belong to a UStruct. */
+	FCEFJSStructBindings UnownedBindings;
+
+	/** Handles of the delegates used to drop the reflection cache when classes are reloaded or reinstanced. */
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+
+	/** Integer handles of bound objects, sent along with their GUIDs when the batched transport is enabled. */
+	TMap<UObject*, int32> ObjectHandles;
+	TMap<int32, UObject*> ObjectsByHandle;
+	int32 NextObjectHandle;
+
+	/** Interned method names. A method handle is an index into this array. */
+	TArray<FName> MethodNames;
+	TMap<FName, int32> MethodHandles;
+
+	/** Results queued since the last flush, guarded by PendingResultsCS as responses may be completed from any thread. */
+	TArray<FCEFJSBatchedTransport::FResult> PendingResults;
+	FCriticalSection PendingResultsCS;
+
+	/** Set once the renderer process has sent a batch, meaning it is able to decode batched results. Guarded by PendingResultsCS. */
+	bool bRendererUsesBatchedTransport;
+
+	/** Receives the messages meant for the render process when set. */
+	TFunction<void(CefRefPtr<CefProcessMessage>)> MessageSink;
 };
 
 #endif
@@ -31,8 +31,24 @@ namespace {
 		}
 	}
 
+	/** @return the struct stored in the property, or in each element if it's an array or set. */
+	const UStruct* GetElementStruct(const FProperty* Property)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			Property = ArrayProperty->Inner;
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			Property = SetProperty->ElementProp;
+		}
+
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty != nullptr ? StructProperty->Struct : nullptr;
+	}
+
 	template<typename ContainerType, typename KeyType>
-	void AssignTokenFromContainer(ContainerType Container, KeyType Key,  EStructDeserializerBackendTokens& OutToken, FString& PropertyName, TSharedPtr<ICefContainerWalker>& Retval)
+	void AssignTokenFromContainer(ContainerType Container, KeyType Key,  EStructDeserializerBackendTokens& OutToken, FString& PropertyName, TSharedPtr<ICefContainerWalker>& Retval, FCEFJSScripting* Scripting, const FCEFJSStructBindings* ChildBindings)
 	{
 		switch (Container->GetType(Key))
 		{
@@ -52,14 +68,14 @@ namespace {
 				}
 				else
 				{
-					TSharedPtr<ICefContainerWalker> NewWalker(new FCefDictionaryValueWalker(Retval, Dictionary));
+					TSharedPtr<ICefContainerWalker> NewWalker(new FCefDictionaryValueWalker(Retval, Dictionary, Scripting, ChildBindings));
 					Retval = NewWalker->GetNextToken(OutToken, PropertyName);
 				}
 				break;
 			}
 			case VTYPE_LIST:
 			{
-				TSharedPtr<ICefContainerWalker> NewWalker(new FCefListValueWalker(Retval, Container->GetList(Key)));
+				TSharedPtr<ICefContainerWalker> NewWalker(new FCefListValueWalker(Retval, Container->GetList(Key), Scripting, ChildBindings));
 				Retval = NewWalker->GetNextToken(OutToken, PropertyName);
 				break;
 			}
@@ -266,7 +282,8 @@ TSharedPtr<ICefContainerWalker> FCefListValueWalker::GetNextToken(EStructDeseria
 	}
 	else if ( Index < List->GetSize() )
 	{
-		AssignTokenFromContainer(List, Index, OutToken, PropertyName, Retval);
+		// Nested arrays are not supported, so only elements that are structs have known bindings
+		AssignTokenFromContainer(List, Index, OutToken, PropertyName, Retval, Scripting, Bindings);
 		PropertyName = FString();
 	}
 	else
@@ -292,8 +309,18 @@ TSharedPtr<ICefContainerWalker> FCefDictionaryValueWalker::GetNextToken(EStructD
 	}
 	else if ( Index < Keys.size() )
 	{
-		AssignTokenFromContainer(Dictionary, Keys[Index], OutToken, PropertyName, Retval);
-		PropertyName = WCHAR_TO_TCHAR(Keys[Index].ToWString().c_str());
+		// Resolve the key against the struct's bindings, so neither the key nor the name needs converting
+		const FCEFJSStructBindings::FEntry* Entry = Bindings != nullptr ? Bindings->FindByKey(Keys[Index]) : nullptr;
+		const FCEFJSStructBindings* ChildBindings = Entry != nullptr ? Scripting->GetStructBindings(GetElementStruct(Entry->Property)) : nullptr;
+		AssignTokenFromContainer(Dictionary, Keys[Index], OutToken, PropertyName, Retval, Scripting, ChildBindings);
+		if (Entry != nullptr)
+		{
+			PropertyName = Entry->Name;
+		}
+		else
+		{
+			PropertyName = WCHAR_TO_TCHAR(Keys[Index].ToWString().c_str());
+		}
 	}
 	else
 	{
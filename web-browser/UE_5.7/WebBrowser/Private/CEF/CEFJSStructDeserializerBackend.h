@@ -46,8 +46,10 @@ class ICefContainerWalker
 	: public TSharedFromThis<ICefContainerWalker>
 {
 public:
-	ICefContainerWalker(TSharedPtr<ICefContainerWalker> InParent)
+	ICefContainerWalker(TSharedPtr<ICefContainerWalker> InParent, FCEFJSScripting* InScripting, const FCEFJSStructBindings* InBindings)
 		: Parent(InParent)
+		, Scripting(InScripting)
+		, Bindings(InBindings)
 	{}
 	virtual ~ICefContainerWalker() {}
 
@@ -55,14 +57,20 @@ public:
 	virtual bool ReadProperty(TSharedPtr<FCEFJSScripting> Scripting, FProperty* Property, FProperty* Outer, void* Data, int32 ArrayIndex) = 0;
 
 	TSharedPtr<ICefContainerWalker> Parent;
+
+	/** Used to look up the bindings of nested structs. */
+	FCEFJSScripting* Scripting;
+
+	/** Binding names of the struct being read (for lists, of the element struct), or nullptr if the type is unknown. */
+	const FCEFJSStructBindings* Bindings;
 };
 
 class FCefListValueWalker
 	: public ICefContainerWalker
 {
 public:
-	FCefListValueWalker(TSharedPtr<ICefContainerWalker> InParent, CefRefPtr<CefListValue> InList)
-		: ICefContainerWalker(InParent)
+	FCefListValueWalker(TSharedPtr<ICefContainerWalker> InParent, CefRefPtr<CefListValue> InList, FCEFJSScripting* InScripting, const FCEFJSStructBindings* InElementBindings)
+		: ICefContainerWalker(InParent, InScripting, InElementBindings)
 		, List(InList)
 		, Index(-2)
 	{}
@@ -78,8 +86,8 @@ class FCefDictionaryValueWalker
 	: public ICefContainerWalker
 {
 public:
-	FCefDictionaryValueWalker(TSharedPtr<ICefContainerWalker> InParent, CefRefPtr<CefDictionaryValue> InDictionary)
-		: ICefContainerWalker(InParent)
+	FCefDictionaryValueWalker(TSharedPtr<ICefContainerWalker> InParent, CefRefPtr<CefDictionaryValue> InDictionary, FCEFJSScripting* InScripting, const FCEFJSStructBindings* InBindings)
+		: ICefContainerWalker(InParent, InScripting, InBindings)
 		, Dictionary(InDictionary)
 		, Index(-2)
 	{
@@ -106,11 +114,13 @@ public:
 	/**
 	 * Creates and initializes a new instance.
 	 *
-	 * @param Archive The archive to deserialize from.
+	 * @param InScripting The scripting object the values belong to.
+	 * @param InDictionary The dictionary to deserialize from.
+	 * @param InTypeInfo The type being deserialized, if known. Used to map keys to property names without converting them.
 	 */
-	FCEFJSStructDeserializerBackend(TSharedPtr<FCEFJSScripting> InScripting, CefRefPtr<CefDictionaryValue> InDictionary)
+	FCEFJSStructDeserializerBackend(TSharedPtr<FCEFJSScripting> InScripting, CefRefPtr<CefDictionaryValue> InDictionary, const UStruct* InTypeInfo = nullptr)
 		: Scripting(InScripting)
-		, Walker(new FCefDictionaryValueWalker(nullptr, InDictionary))
+		, Walker(new FCefDictionaryValueWalker(nullptr, InDictionary, InScripting.Get(), InScripting->GetStructBindings(InTypeInfo)))
 		, CurrentPropertyName()
 	{ }
 
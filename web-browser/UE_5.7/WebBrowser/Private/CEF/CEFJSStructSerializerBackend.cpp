@@ -8,9 +8,9 @@
 #include "UObject/PropertyPortFlags.h"
 #include "Misc/CommandLine.h"
 
-static FString GetBindingName(const TSharedPtr<FCEFJSScripting>& Scripting, const FProperty* ValueProperty)
+static const CefString& GetBindingKey(const TSharedPtr<FCEFJSScripting>& Scripting, const FProperty* ValueProperty)
 {
-	return Scripting->GetBindingName(ValueProperty);
+	return Scripting->GetBindingKey(ValueProperty);
 }
 
 /* Private methods
@@ -21,7 +21,7 @@ void FCEFJSStructSerializerBackend::AddNull(const FStructSerializerState& State)
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetNull(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)));
+			Current.DictionaryValue->SetNull(GetBindingKey(Scripting, State.ValueProperty));
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetNull(Current.ListValue->GetSize());
@@ -35,7 +35,7 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, boo
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetBool(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)), Value);
+			Current.DictionaryValue->SetBool(GetBindingKey(Scripting, State.ValueProperty), Value);
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetBool(Current.ListValue->GetSize(), Value);
@@ -49,7 +49,7 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, int
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetInt(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)), Value);
+			Current.DictionaryValue->SetInt(GetBindingKey(Scripting, State.ValueProperty), Value);
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetInt(Current.ListValue->GetSize(), Value);
@@ -63,7 +63,7 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, dou
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetDouble(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)), Value);
+			Current.DictionaryValue->SetDouble(GetBindingKey(Scripting, State.ValueProperty), Value);
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetDouble(Current.ListValue->GetSize(), Value);
@@ -72,12 +72,12 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, dou
 }
 
 
-void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, FString Value)
+void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, const FString& Value)
 {
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetString(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)), TCHAR_TO_WCHAR(*Value));
+			Current.DictionaryValue->SetString(GetBindingKey(Scripting, State.ValueProperty), TCHAR_TO_WCHAR(*Value));
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetString(Current.ListValue->GetSize(), TCHAR_TO_WCHAR(*Value));
@@ -91,7 +91,7 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, UOb
 	StackItem& Current = Stack.Top();
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetDictionary(TCHAR_TO_WCHAR(*GetBindingName(Scripting, State.ValueProperty)), Scripting->ConvertObject(Value));
+			Current.DictionaryValue->SetDictionary(GetBindingKey(Scripting, State.ValueProperty), Scripting->ConvertObject(Value));
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetDictionary(Current.ListValue->GetSize(), Scripting->ConvertObject(Value));
@@ -106,7 +106,7 @@ void FCEFJSStructSerializerBackend::Add(const FStructSerializerState& State, UOb
 void FCEFJSStructSerializerBackend::BeginArray(const FStructSerializerState& State)
 {
 	CefRefPtr<CefListValue> ListValue = CefListValue::Create();
-	Stack.Push(StackItem(GetBindingName(Scripting, State.ValueProperty), ListValue));
+	Stack.Push(StackItem(&GetBindingKey(Scripting, State.ValueProperty), ListValue));
 }
 
 
@@ -118,17 +118,18 @@ void FCEFJSStructSerializerBackend::BeginStructure(const FStructSerializerState&
 		State.KeyProperty->ExportTextItem_Direct(KeyString, State.KeyData, nullptr, nullptr, PPF_None);
 
 		CefRefPtr<CefDictionaryValue> DictionaryValue = CefDictionaryValue::Create();
-		Stack.Push(StackItem(KeyString, DictionaryValue));
+		StackItem& Item = Stack.Emplace_GetRef(nullptr, DictionaryValue);
+		Item.MapKey = TCHAR_TO_WCHAR(*KeyString);
 	}
 	else if (State.ValueProperty != nullptr)
 	{
 		CefRefPtr<CefDictionaryValue> DictionaryValue = CefDictionaryValue::Create();
-		Stack.Push(StackItem(GetBindingName(Scripting, State.ValueProperty), DictionaryValue));
+		Stack.Push(StackItem(&GetBindingKey(Scripting, State.ValueProperty), DictionaryValue));
 	}
 	else
 	{
 		Result = CefDictionaryValue::Create();
-		Stack.Push(StackItem(FString(), Result));
+		Stack.Push(StackItem(nullptr, Result));
 	}
 }
 
@@ -142,7 +143,7 @@ void FCEFJSStructSerializerBackend::EndArray(const FStructSerializerState& /*Sta
 
 	switch (Current.Kind) {
 		case StackItem::STYPE_DICTIONARY:
-			Current.DictionaryValue->SetList(TCHAR_TO_WCHAR(*Previous.Name), Previous.ListValue);
+			Current.DictionaryValue->SetList(Previous.GetName(), Previous.ListValue);
 			break;
 		case StackItem::STYPE_LIST:
 			Current.ListValue->SetList(Current.ListValue->GetSize(), Previous.ListValue);
@@ -162,7 +163,7 @@ void FCEFJSStructSerializerBackend::EndStructure(const FStructSerializerState& /
 
 		switch (Current.Kind) {
 			case StackItem::STYPE_DICTIONARY:
-				Current.DictionaryValue->SetDictionary(TCHAR_TO_WCHAR(*Previous.Name), Previous.DictionaryValue);
+				Current.DictionaryValue->SetDictionary(Previous.GetName(), Previous.DictionaryValue);
 				break;
 			case StackItem::STYPE_LIST:
 				Current.ListValue->SetDictionary(Current.ListValue->GetSize(), Previous.DictionaryValue);
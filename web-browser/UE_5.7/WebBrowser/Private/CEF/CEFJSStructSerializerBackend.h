@@ -81,24 +81,34 @@ private:
 	struct StackItem
 	{
 		enum {STYPE_DICTIONARY, STYPE_LIST} Kind;
-		FString Name;
+
+		/** Key the value is added to its parent with, interned by the scripting object. Null for map values and the root. */
+		const CefString* Name;
+
+		/** Key of a map value, exported from the map key. */
+		CefString MapKey;
+
 		CefRefPtr<CefDictionaryValue> DictionaryValue;
 		CefRefPtr<CefListValue> ListValue;
 
-		StackItem(const FString& InName, CefRefPtr<CefDictionaryValue> InDictionary)
+		StackItem(const CefString* InName, CefRefPtr<CefDictionaryValue> InDictionary)
 			: Kind(STYPE_DICTIONARY)
 			, Name(InName)
 			, DictionaryValue(InDictionary)
 			, ListValue()
 		{}
 
-		StackItem(const FString& InName, CefRefPtr<CefListValue> InList)
+		StackItem(const CefString* InName, CefRefPtr<CefListValue> InList)
 			: Kind(STYPE_LIST)
 			, Name(InName)
 			, DictionaryValue()
 			, ListValue(InList)
 		{}
 
+		const CefString& GetName() const
+		{
+			return Name != nullptr ? *Name : MapKey;
+		}
 	};
 
 	TSharedPtr<FCEFJSScripting> Scripting;
@@ -109,7 +119,7 @@ private:
 	void Add(const FStructSerializerState& State, bool Value);
 	void Add(const FStructSerializerState& State, int32 Value);
 	void Add(const FStructSerializerState& State, double Value);
-	void Add(const FStructSerializerState& State, FString Value);
+	void Add(const FStructSerializerState& State, const FString& Value);
 	void Add(const FStructSerializerState& State, UObject* Value);
 };
 
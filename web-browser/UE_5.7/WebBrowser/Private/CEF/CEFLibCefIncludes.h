@@ -34,6 +34,7 @@ THIRD_PARTY_INCLUDES_START
 #		include "include/cef_jsdialog_handler.h"
 #		include "include/cef_scheme.h"
 #		include "include/cef_origin_whitelist.h"
+#		include "include/cef_parser.h"
 #		include "include/cef_version.h"
 #		include "include/internal/cef_ptr.h"
 
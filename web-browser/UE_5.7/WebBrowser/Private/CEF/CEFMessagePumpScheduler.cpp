@@ -0,0 +1,235 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFMessagePumpScheduler.h"
+
+#if WITH_CEF3
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopeLock.h"
+#include "WebBrowserStats.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("CEF Message Pump Rate (Hz)"), STAT_CEFMessagePumpRate, STATGROUP_WebBrowser);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("CEF Message Pump Forced Rate (Hz)"), STAT_CEFMessagePumpForcedRate, STATGROUP_WebBrowser);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("CEF Message Pump Avg Work Latency (ms)"), STAT_CEFMessagePumpAvgLatency, STATGROUP_WebBrowser);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("CEF Message Pump Max Work Latency (ms)"), STAT_CEFMessagePumpMaxLatency, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Message Pump Scheduled Pumps"), STAT_CEFMessagePumpScheduled, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Message Pump Forced Pumps"), STAT_CEFMessagePumpForced, STATGROUP_WebBrowser);
+
+static bool bCEFMessagePumpForceLoop = false;
+static FAutoConsoleVariableRef CVarCEFMessagePumpForceLoop(
+	TEXT("webbrowser.MessagePump.ForceLoop"),
+	bCEFMessagePumpForceLoop,
+	TEXT("Always pump the CEF message loop at MaxForcedHertz, even when every browser is hidden or idle. Defaults to [Browser] bForceMessageLoop\n"),
+	ECVF_Default);
+
+static int32 CEFMessagePumpMinHertz = 1;
+static FAutoConsoleVariableRef CVarCEFMessagePumpMinHertz(
+	TEXT("webbrowser.MessagePump.MinHertz"),
+	CEFMessagePumpMinHertz,
+	TEXT("Rate at which the CEF message loop is forced when every browser is hidden or idle. Defaults to [Browser] MinMessageLoopHertz\n"),
+	ECVF_Default);
+
+static int32 CEFMessagePumpMaxForcedHertz = 15;
+static FAutoConsoleVariableRef CVarCEFMessagePumpMaxForcedHertz(
+	TEXT("webbrowser.MessagePump.MaxForcedHertz"),
+	CEFMessagePumpMaxForcedHertz,
+	TEXT("Rate at which the CEF message loop is forced while a browser is visible. Defaults to [Browser] MaxForcedMessageLoopHertz\n"),
+	ECVF_Default);
+
+static int32 CEFMessagePumpBoostHertz = 60;
+static FAutoConsoleVariableRef CVarCEFMessagePumpBoostHertz(
+	TEXT("webbrowser.MessagePump.BoostHertz"),
+	CEFMessagePumpBoostHertz,
+	TEXT("Rate at which the CEF message loop is forced while a visible browser receives input or paints\n"),
+	ECVF_Default);
+
+static float CEFMessagePumpBoostSeconds = 0.5f;
+static FAutoConsoleVariableRef CVarCEFMessagePumpBoostSeconds(
+	TEXT("webbrowser.MessagePump.BoostSeconds"),
+	CEFMessagePumpBoostSeconds,
+	TEXT("How long the boosted rate is kept after the last input or paint\n"),
+	ECVF_Default);
+
+static float CEFMessagePumpIdleSeconds = 2.0f;
+static FAutoConsoleVariableRef CVarCEFMessagePumpIdleSeconds(
+	TEXT("webbrowser.MessagePump.IdleSeconds"),
+	CEFMessagePumpIdleSeconds,
+	TEXT("Visible browsers without input or paints for this long are pumped at MinHertz. 0 keeps visible browsers at MaxForcedHertz\n"),
+	ECVF_Default);
+
+namespace
+{
+	constexpr int32 MaxMessagePumpHertz = 60;
+	constexpr int32 MaxBoostMessagePumpHertz = 120;
+	constexpr double StatsWindowSeconds = 1.0;
+
+	/** Seeds the console variables from the [Browser] section of the engine ini. Console and ini cvar overrides take precedence. */
+	void LoadMessagePumpConfig()
+	{
+		static bool bLoaded = false;
+		if (bLoaded || GConfig == nullptr)
+		{
+			return;
+		}
+		bLoaded = true;
+
+		bool bForceMessageLoop = false;
+		if (GConfig->GetBool(TEXT("Browser"), TEXT("bForceMessageLoop"), bForceMessageLoop, GEngineIni))
+		{
+			CVarCEFMessagePumpForceLoop->Set(bForceMessageLoop, ECVF_SetByProjectSetting);
+		}
+
+		int32 MinMessageLoopHz = 1;
+		if (GConfig->GetInt(TEXT("Browser"), TEXT("MinMessageLoopHertz"), MinMessageLoopHz, GEngineIni))
+		{
+			CVarCEFMessagePumpMinHertz->Set(MinMessageLoopHz, ECVF_SetByProjectSetting);
+		}
+
+		int32 MaxForcedMessageLoopHz = 15;
+		if (GConfig->GetInt(TEXT("Browser"), TEXT("MaxForcedMessageLoopHertz"), MaxForcedMessageLoopHz, GEngineIni))
+		{
+			CVarCEFMessagePumpMaxForcedHertz->Set(MaxForcedMessageLoopHz, ECVF_SetByProjectSetting);
+		}
+	}
+}
+
+double FCEFMessagePumpScheduler::LastActivityTime = -DBL_MAX;
+
+FCEFMessagePumpScheduler::FCEFMessagePumpScheduler()
+	: ScheduledWorkTime(-1.0)
+	, bPumpIsScheduled(false)
+	, PumpDueTime(0.0)
+	, LastPumpTime(FPlatformTime::Seconds())
+	, DecisionTime(LastPumpTime)
+	, ForcedIntervalSeconds(1.0 / 15.0)
+	, StatsWindowStart(LastPumpTime)
+	, WindowPumps(0)
+	, WindowLatencySamples(0)
+	, WindowLatencySum(0.0)
+	, WindowLatencyMax(0.0)
+{
+	LoadMessagePumpConfig();
+}
+
+void FCEFMessagePumpScheduler::ScheduleWork(int64 DelayMs)
+{
+	// As per CEF documentation, if delay_ms is <= 0, then the call to CefDoMessageLoopWork should happen reasonably soon. If delay_ms is > 0, then the call
+	//  to CefDoMessageLoopWork should be scheduled to happen after the specified delay and any currently pending scheduled call should be canceled.
+	const double DueTime = FPlatformTime::Seconds() + FMath::Max<int64>(DelayMs, 0) / 1000.0;
+
+	FScopeLock Lock(&ScheduledWorkCS);
+	ScheduledWorkTime = DueTime;
+}
+
+bool FCEFMessagePumpScheduler::ShouldPump(const FCEFMessagePumpActivity& Activity)
+{
+	const double Now = FPlatformTime::Seconds();
+	DecisionTime = Now;
+	ForcedIntervalSeconds = ComputeForcedInterval(Activity, Now);
+	UpdateStats(Now);
+
+	{
+		FScopeLock Lock(&ScheduledWorkCS);
+		if (ScheduledWorkTime >= 0.0 && Now >= ScheduledWorkTime)
+		{
+			bPumpIsScheduled = true;
+			PumpDueTime = ScheduledWorkTime;
+			ScheduledWorkTime = -1.0;
+		}
+	}
+
+	if (bPumpIsScheduled)
+	{
+		const double Latency = Now - PumpDueTime;
+		++WindowLatencySamples;
+		WindowLatencySum += Latency;
+		WindowLatencyMax = FMath::Max(WindowLatencyMax, Latency);
+		return true;
+	}
+
+	// @todo: Hack: there appear to be some edge cases where we might not be getting a signal from OnScheduleMessagePumpWork(),
+	//  so keep forcing the loop at the current rate. Work scheduled in the future is left pending.
+	return Now - LastPumpTime >= ForcedIntervalSeconds;
+}
+
+void FCEFMessagePumpScheduler::OnPumped()
+{
+	if (bPumpIsScheduled)
+	{
+		++Stats.NumScheduledPumps;
+		INC_DWORD_STAT(STAT_CEFMessagePumpScheduled);
+	}
+	else
+	{
+		++Stats.NumForcedPumps;
+		INC_DWORD_STAT(STAT_CEFMessagePumpForced);
+	}
+	bPumpIsScheduled = false;
+	++WindowPumps;
+
+	// Measure the forced interval from the start of the pump, so the time spent in CefDoMessageLoopWork doesn't lower the rate
+	LastPumpTime = DecisionTime;
+}
+
+void FCEFMessagePumpScheduler::NotifyActivity()
+{
+	check(IsInGameThread());
+	LastActivityTime = FPlatformTime::Seconds();
+}
+
+double FCEFMessagePumpScheduler::GetVisibleForcedIntervalSeconds()
+{
+	const int32 MinHz = FMath::Clamp(CEFMessagePumpMinHertz, 1, MaxMessagePumpHertz);
+	return 1.0 / FMath::Clamp(CEFMessagePumpMaxForcedHertz, MinHz, MaxMessagePumpHertz);
+}
+
+double FCEFMessagePumpScheduler::ComputeForcedInterval(const FCEFMessagePumpActivity& Activity, double Now) const
+{
+	// Make sure the configured rates are within a reasonable range
+	const int32 MinHz = FMath::Clamp(CEFMessagePumpMinHertz, 1, MaxMessagePumpHertz);
+	const int32 MaxForcedHz = FMath::Clamp(CEFMessagePumpMaxForcedHertz, MinHz, MaxMessagePumpHertz);
+	const int32 BoostHz = FMath::Clamp(CEFMessagePumpBoostHertz, MaxForcedHz, MaxBoostMessagePumpHertz);
+
+	const bool bAnyVisible = Activity.NumWindows > 0 && Activity.NumVisibleWindows > 0 && Activity.bAppIsFocused;
+	const double SecondsSinceActivity = Now - LastActivityTime;
+
+	if (bAnyVisible && SecondsSinceActivity < CEFMessagePumpBoostSeconds)
+	{
+		return 1.0 / BoostHz;
+	}
+	if (bCEFMessagePumpForceLoop)
+	{
+		return 1.0 / MaxForcedHz;
+	}
+	if (bAnyVisible && (CEFMessagePumpIdleSeconds <= 0.0f || SecondsSinceActivity < CEFMessagePumpIdleSeconds))
+	{
+		return 1.0 / MaxForcedHz;
+	}
+	return 1.0 / MinHz;
+}
+
+void FCEFMessagePumpScheduler::UpdateStats(double Now)
+{
+	const double Elapsed = Now - StatsWindowStart;
+	if (Elapsed >= StatsWindowSeconds)
+	{
+		Stats.PumpsPerSecond = static_cast<float>(WindowPumps / Elapsed);
+		Stats.AverageWorkLatencyMs = WindowLatencySamples > 0 ? static_cast<float>(WindowLatencySum / WindowLatencySamples * 1000.0) : 0.0f;
+		Stats.MaxWorkLatencyMs = static_cast<float>(WindowLatencyMax * 1000.0);
+
+		StatsWindowStart = Now;
+		WindowPumps = 0;
+		WindowLatencySamples = 0;
+		WindowLatencySum = 0.0;
+		WindowLatencyMax = 0.0;
+	}
+
+	SET_FLOAT_STAT(STAT_CEFMessagePumpRate, Stats.PumpsPerSecond);
+	SET_FLOAT_STAT(STAT_CEFMessagePumpForcedRate, static_cast<float>(1.0 / ForcedIntervalSeconds));
+	SET_FLOAT_STAT(STAT_CEFMessagePumpAvgLatency, Stats.AverageWorkLatencyMs);
+	SET_FLOAT_STAT(STAT_CEFMessagePumpMaxLatency, Stats.MaxWorkLatencyMs);
+}
+
+#endif
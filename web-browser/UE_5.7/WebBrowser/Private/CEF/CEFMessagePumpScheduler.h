@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+#if WITH_CEF3
+
+/**
+ * Snapshot of the browser windows gathered by the singleton tick, used to pick the forced pump rate.
+ */
+struct FCEFMessagePumpActivity
+{
+	/** Number of live browser windows. */
+	int32 NumWindows = 0;
+
+	/** Number of browser windows that are not hidden and whose parent window is not minimized. */
+	int32 NumVisibleWindows = 0;
+
+	/** Whether the application is the foreground OS application. */
+	bool bAppIsFocused = false;
+};
+
+/**
+ * Counters reported by FCEFMessagePumpScheduler.
+ */
+struct FCEFMessagePumpStats
+{
+	/** Number of CefDoMessageLoopWork calls per second, measured over the last second. */
+	float PumpsPerSecond = 0.0f;
+
+	/** Average delay between scheduled work becoming due and the pump servicing it, in milliseconds. */
+	float AverageWorkLatencyMs = 0.0f;
+
+	/** Largest delay between scheduled work becoming due and the pump servicing it over the last second, in milliseconds. */
+	float MaxWorkLatencyMs = 0.0f;
+
+	/** Total number of pumps requested through OnScheduleMessagePumpWork. */
+	uint64 NumScheduledPumps = 0;
+
+	/** Total number of pumps forced by the scheduler without pending work. */
+	uint64 NumForcedPumps = 0;
+};
+
+/**
+ * Decides when the CEF message loop is pumped when CEF runs with an external message pump.
+ *
+ * Work requested through OnScheduleMessagePumpWork is serviced on the first tick after its due time. On top of
+ * that the loop is forced at a rate that depends on what the browsers are doing: boosted while the user interacts
+ * with a browser or a browser paints, the configured maximum while browsers are visible, and the configured
+ * minimum when every browser is hidden or idle.
+ *
+ * The [Browser] settings of the engine ini are read once, into console variables that can be changed at runtime.
+ */
+class FCEFMessagePumpScheduler
+{
+public:
+	FCEFMessagePumpScheduler();
+
+	/**
+	 * Schedules a call to CefDoMessageLoopWork, replacing any pending request. May be called from any thread.
+	 *
+	 * @param DelayMs Delay in milliseconds before the work is due. Values <= 0 request work as soon as possible.
+	 */
+	void ScheduleWork(int64 DelayMs);
+
+	/**
+	 * Called from the game thread tick to determine whether the message loop should be pumped now.
+	 *
+	 * @param Activity The state of the browser windows.
+	 * @return true if CefDoMessageLoopWork should be called. OnPumped must be called once it has.
+	 */
+	bool ShouldPump(const FCEFMessagePumpActivity& Activity);
+
+	/** Records that CefDoMessageLoopWork was called. */
+	void OnPumped();
+
+	/** @return the interval, in seconds, at which the message loop is currently forced. */
+	double GetForcedIntervalSeconds() const { return ForcedIntervalSeconds; }
+
+	/** @return the interval, in seconds, at which the message loop is forced while a browser is visible. */
+	static double GetVisibleForcedIntervalSeconds();
+
+	/** @return the scheduler counters. */
+	const FCEFMessagePumpStats& GetStats() const { return Stats; }
+
+	/**
+	 * Notes that a browser received input or painted, which boosts the forced pump rate for a short while.
+	 * Must be called on the game thread.
+	 */
+	static void NotifyActivity();
+
+private:
+	/** Computes the forced pump interval for the given activity. */
+	double ComputeForcedInterval(const FCEFMessagePumpActivity& Activity, double Now) const;
+
+	/** Updates the rate and latency counters once per second. */
+	void UpdateStats(double Now);
+
+	/** Guards ScheduledWorkTime, which is written by CEF from any thread. */
+	FCriticalSection ScheduledWorkCS;
+
+	/** Time at which the pending scheduled work is due, or a negative value when no work is pending. */
+	double ScheduledWorkTime;
+
+	/** Whether the pump about to happen services scheduled work, and when that work was due. */
+	bool bPumpIsScheduled;
+	double PumpDueTime;
+
+	/** Time of the last call to CefDoMessageLoopWork. */
+	double LastPumpTime;
+
+	/** Time of the last call to ShouldPump. */
+	double DecisionTime;
+
+	/** Interval at which the message loop is currently forced. */
+	double ForcedIntervalSeconds;
+
+	/** Counters accumulated over the current stats window. */
+	double StatsWindowStart;
+	int32 WindowPumps;
+	int32 WindowLatencySamples;
+	double WindowLatencySum;
+	double WindowLatencyMax;
+
+	FCEFMessagePumpStats Stats;
+
+	/** Time of the last input or paint of any browser. */
+	static double LastActivityTime;
+};
+
+#endif
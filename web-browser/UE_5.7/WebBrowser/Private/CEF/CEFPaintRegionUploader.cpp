@@ -0,0 +1,478 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFPaintRegionUploader.h"
+
+#if WITH_CEF3
+
+#include "HAL/IConsoleManager.h"
+#include "Textures/SlateUpdatableTexture.h"
+#include "WebBrowserStats.h"
+
+#if WITH_ENGINE
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "Slate/SlateTextures.h"
+#endif
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Paint Dirty Rects"), STAT_CEFPaintDirtyRects, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Paint Uploaded Regions"), STAT_CEFPaintUploadedRegions, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Paint Bytes Uploaded"), STAT_CEFPaintBytesUploaded, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Paint Bytes Skipped"), STAT_CEFPaintBytesSkipped, STATGROUP_WebBrowser);
+
+static bool bCEFMultiRectUpload = true;
+static FAutoConsoleVariableRef CVarCEFMultiRectUpload(
+	TEXT("r.CEFMultiRectUpload"),
+	bCEFMultiRectUpload,
+	TEXT("Upload only the dirty regions of CEF paints instead of the whole frame\n"),
+	ECVF_Default);
+
+static float CEFMultiRectMergeAreaRatio = 0.5f;
+static FAutoConsoleVariableRef CVarCEFMultiRectMergeAreaRatio(
+	TEXT("r.CEFMultiRectUpload.MergeAreaRatio"),
+	CEFMultiRectMergeAreaRatio,
+	TEXT("Two dirty rects are merged when their area covers at least this fraction of their bounding rect (0 always merges, 1 only merges overlapping rects)\n"),
+	ECVF_Default);
+
+static int32 CEFMultiRectMaxRegions = 8;
+static FAutoConsoleVariableRef CVarCEFMultiRectMaxRegions(
+	TEXT("r.CEFMultiRectUpload.MaxRegions"),
+	CEFMultiRectMaxRegions,
+	TEXT("Maximum number of texture regions uploaded per paint\n"),
+	ECVF_Default);
+
+static int32 CEFMultiRectStagingBuffers = 3;
+static FAutoConsoleVariableRef CVarCEFMultiRectStagingBuffers(
+	TEXT("r.CEFMultiRectUpload.StagingBuffers"),
+	CEFMultiRectStagingBuffers,
+	TEXT("Number of pooled staging buffers per browser texture\n"),
+	ECVF_Default);
+
+namespace
+{
+	constexpr int32 BytesPerPixel = 4; // PF_B8G8R8A8
+
+	/** Deferred paints with more dirty rects than this are merged into a full frame upload. */
+	constexpr int32 MaxDeferredRects = 32;
+
+	uint64 GetRectArea(const FIntRect& Rect)
+	{
+		return static_cast<uint64>(Rect.Width()) * static_cast<uint64>(Rect.Height());
+	}
+
+	/** @return the area covered by both rects, counting their intersection once. */
+	uint64 GetCoveredArea(const FIntRect& A, const FIntRect& B)
+	{
+		FIntRect Overlap = A;
+		Overlap.Clip(B);
+		const uint64 OverlapArea = Overlap.IsEmpty() ? 0 : GetRectArea(Overlap);
+		return GetRectArea(A) + GetRectArea(B) - OverlapArea;
+	}
+}
+
+FCEFStagingBufferPool::FCEFStagingBufferPool()
+	: NextBuffer(0)
+{
+}
+
+TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> FCEFStagingBufferPool::Acquire(int32 NumBytes, int32 RingSize)
+{
+	RingSize = FMath::Max(RingSize, 1);
+	if (Ring.Num() != RingSize)
+	{
+		// Buffers still referenced by pending render commands are kept alive by those commands
+		Ring.Reset();
+		for (int32 Index = 0; Index < RingSize; ++Index)
+		{
+			Ring.Add(MakeShared<TArray<uint8>, ESPMode::ThreadSafe>());
+		}
+		NextBuffer = 0;
+	}
+
+	// Take the first buffer the render thread has released, starting with the oldest one
+	int32 SlotIndex = NextBuffer;
+	for (int32 Attempt = 0; Attempt < RingSize; ++Attempt)
+	{
+		const int32 Candidate = (NextBuffer + Attempt) % RingSize;
+		if (Ring[Candidate].GetSharedReferenceCount() == 1)
+		{
+			SlotIndex = Candidate;
+			break;
+		}
+	}
+
+	if (Ring[SlotIndex].GetSharedReferenceCount() > 1)
+	{
+		// Every buffer is still in flight. Replace the oldest one rather than stalling the game thread,
+		// the pending render command keeps the old allocation alive until it has run.
+		Ring[SlotIndex] = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	}
+
+	NextBuffer = (SlotIndex + 1) % RingSize;
+
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Staging = Ring[SlotIndex];
+	Staging->SetNumUninitialized(NumBytes, EAllowShrinking::No);
+	return Staging;
+}
+
+FCEFPaintRegionUploader::FCEFPaintRegionUploader()
+	: UploadedSize(FIntPoint::ZeroValue)
+	, DeferredSize(FIntPoint::ZeroValue)
+	, bDeferredFullFrame(false)
+	, bHasDeferred(false)
+{
+}
+
+bool FCEFPaintRegionUploader::IsEnabled()
+{
+	return bCEFMultiRectUpload;
+}
+
+void FCEFPaintRegionUploader::Reset()
+{
+	UploadedSize = FIntPoint::ZeroValue;
+}
+
+void FCEFPaintRegionUploader::CoalesceRects(TArray<FIntRect>& InOutRects, const FIntPoint& FrameSize, float MergeAreaRatio, int32 MaxRegions)
+{
+	const FIntRect FrameRect(FIntPoint::ZeroValue, FrameSize);
+	for (int32 Index = InOutRects.Num() - 1; Index >= 0; --Index)
+	{
+		InOutRects[Index].Clip(FrameRect);
+		if (InOutRects[Index].IsEmpty())
+		{
+			InOutRects.RemoveAtSwap(Index, EAllowShrinking::No);
+		}
+	}
+
+	MergeAreaRatio = FMath::Clamp(MergeAreaRatio, 0.0f, 1.0f);
+	MaxRegions = FMath::Max(MaxRegions, 1);
+
+	// Repeatedly merge the pair that wastes the least area, as long as it satisfies the heuristic or we are above the region limit.
+	// CEF only reports a handful of rects per paint so the quadratic search is cheap.
+	while (InOutRects.Num() > 1)
+	{
+		int32 BestA = INDEX_NONE;
+		int32 BestB = INDEX_NONE;
+		uint64 BestWaste = MAX_uint64;
+		bool bBestSatisfiesRatio = false;
+
+		for (int32 IndexA = 0; IndexA < InOutRects.Num(); ++IndexA)
+		{
+			for (int32 IndexB = IndexA + 1; IndexB < InOutRects.Num(); ++IndexB)
+			{
+				FIntRect Union = InOutRects[IndexA];
+				Union.Union(InOutRects[IndexB]);
+
+				const uint64 UnionArea = GetRectArea(Union);
+				const uint64 CoveredArea = GetCoveredArea(InOutRects[IndexA], InOutRects[IndexB]);
+				const uint64 Waste = UnionArea - CoveredArea;
+				if (Waste < BestWaste)
+				{
+					BestA = IndexA;
+					BestB = IndexB;
+					BestWaste = Waste;
+					bBestSatisfiesRatio = static_cast<double>(CoveredArea) >= static_cast<double>(UnionArea) * MergeAreaRatio;
+				}
+			}
+		}
+
+		if (!bBestSatisfiesRatio && InOutRects.Num() <= MaxRegions)
+		{
+			break;
+		}
+
+		InOutRects[BestA].Union(InOutRects[BestB]);
+		InOutRects.RemoveAtSwap(BestB, EAllowShrinking::No);
+	}
+}
+
+bool FCEFPaintRegionUploader::Upload(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects)
+{
+	// The texture is now newer than the deferred frame, which no longer holds every paint
+	if (DeferredSize != FIntPoint::ZeroValue)
+	{
+		DiscardDeferred();
+	}
+
+	return UploadFrame(Texture, Buffer, Width, Height, DirtyRects);
+}
+
+uint64 FCEFPaintRegionUploader::EstimateUploadBytes(int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects) const
+{
+	const uint64 FrameBytes = static_cast<uint64>(FMath::Max(Width, 0)) * FMath::Max(Height, 0) * BytesPerPixel;
+	if (!IsEnabled() || UploadedSize != FIntPoint(Width, Height) || DirtyRects.empty())
+	{
+		return FrameBytes;
+	}
+
+	uint64 DirtyBytes = 0;
+	for (const CefRect& Rect : DirtyRects)
+	{
+		DirtyBytes += static_cast<uint64>(FMath::Max(Rect.width, 0)) * FMath::Max(Rect.height, 0) * BytesPerPixel;
+	}
+	return FMath::Min(DirtyBytes, FrameBytes);
+}
+
+void FCEFPaintRegionUploader::Defer(const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects)
+{
+	if (Buffer == nullptr || Width <= 0 || Height <= 0)
+	{
+		return;
+	}
+
+	const FIntPoint FrameSize(Width, Height);
+	const FIntRect FrameRect(FIntPoint::ZeroValue, FrameSize);
+	const int32 Pitch = Width * BytesPerPixel;
+	const uint8* Source = static_cast<const uint8*>(Buffer);
+
+	// Only the dirty parts need copying once the deferred frame holds the rest of the frame
+	if (DeferredSize != FrameSize || DirtyRects.empty() || DeferredRects.Num() + static_cast<int32>(DirtyRects.size()) > MaxDeferredRects)
+	{
+		DeferredPixels.SetNumUninitialized(Pitch * Height, EAllowShrinking::No);
+		FMemory::Memcpy(DeferredPixels.GetData(), Source, Pitch * Height);
+		DeferredSize = FrameSize;
+		DeferredRects.Reset();
+		bDeferredFullFrame = true;
+	}
+	else
+	{
+		uint8* Dest = DeferredPixels.GetData();
+		for (const CefRect& Rect : DirtyRects)
+		{
+			FIntRect Dirty(Rect.x, Rect.y, Rect.x + Rect.width, Rect.y + Rect.height);
+			Dirty.Clip(FrameRect);
+			if (Dirty.IsEmpty())
+			{
+				continue;
+			}
+
+			const int32 RowBytes = Dirty.Width() * BytesPerPixel;
+			for (int32 Row = Dirty.Min.Y; Row < Dirty.Max.Y; ++Row)
+			{
+				const int32 Offset = Row * Pitch + Dirty.Min.X * BytesPerPixel;
+				FMemory::Memcpy(Dest + Offset, Source + Offset, RowBytes);
+			}
+
+			if (!bDeferredFullFrame)
+			{
+				DeferredRects.Add(Dirty);
+			}
+		}
+	}
+
+	bHasDeferred = true;
+}
+
+bool FCEFPaintRegionUploader::FlushDeferred(FSlateUpdatableTexture* Texture)
+{
+	if (!bHasDeferred)
+	{
+		return false;
+	}
+
+	// An empty list uploads the whole frame
+	FlushRects.clear();
+	if (!bDeferredFullFrame)
+	{
+		for (const FIntRect& Rect : DeferredRects)
+		{
+			FlushRects.push_back(CefRect(Rect.Min.X, Rect.Min.Y, Rect.Width(), Rect.Height()));
+		}
+	}
+
+	bHasDeferred = false;
+	bDeferredFullFrame = false;
+	DeferredRects.Reset();
+
+	return UploadFrame(Texture, DeferredPixels.GetData(), DeferredSize.X, DeferredSize.Y, FlushRects);
+}
+
+void FCEFPaintRegionUploader::DiscardDeferred()
+{
+	// The frame is kept allocated for the next deferral, the zero size marks its contents invalid
+	DeferredPixels.Reset();
+	DeferredSize = FIntPoint::ZeroValue;
+	DeferredRects.Reset();
+	bDeferredFullFrame = false;
+	bHasDeferred = false;
+}
+
+uint64 FCEFPaintRegionUploader::GetDeferredBytes() const
+{
+	const uint64 FrameBytes = static_cast<uint64>(DeferredSize.X) * DeferredSize.Y * BytesPerPixel;
+	if (!bHasDeferred || bDeferredFullFrame || !IsEnabled() || UploadedSize != DeferredSize)
+	{
+		return bHasDeferred ? FrameBytes : 0;
+	}
+
+	uint64 DirtyBytes = 0;
+	for (const FIntRect& Rect : DeferredRects)
+	{
+		DirtyBytes += GetRectArea(Rect) * BytesPerPixel;
+	}
+	return FMath::Min(DirtyBytes, FrameBytes);
+}
+
+bool FCEFPaintRegionUploader::UploadFrame(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects)
+{
+	if (Texture == nullptr || Buffer == nullptr || Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	LastStats = FCEFPaintUploadStats();
+	LastStats.NumDirtyRects = static_cast<int32>(DirtyRects.size());
+
+	const uint64 FrameBytes = static_cast<uint64>(Width) * Height * BytesPerPixel;
+	const FIntRect SingleDirty = (DirtyRects.size() == 1) ? FIntRect(DirtyRects[0].x, DirtyRects[0].y, DirtyRects[0].x + DirtyRects[0].width, DirtyRects[0].y + DirtyRects[0].height) : FIntRect();
+
+	// Partial updates are only valid once the texture holds a complete frame of the current size
+	const FIntPoint FrameSize(Width, Height);
+	if (!IsEnabled() || UploadedSize != FrameSize || DirtyRects.empty())
+	{
+		UploadFullFrame(Texture, Buffer, Width, Height, SingleDirty);
+		UploadedSize = FrameSize;
+		return true;
+	}
+
+	Regions.Reset();
+	for (const CefRect& Rect : DirtyRects)
+	{
+		Regions.Emplace(Rect.x, Rect.y, Rect.x + Rect.width, Rect.y + Rect.height);
+	}
+	CoalesceRects(Regions, FrameSize, CEFMultiRectMergeAreaRatio, CEFMultiRectMaxRegions);
+
+	uint64 RegionBytes = 0;
+	for (const FIntRect& Region : Regions)
+	{
+		RegionBytes += GetRectArea(Region) * BytesPerPixel;
+	}
+
+	if (Regions.Num() == 0)
+	{
+		LastStats.BytesSkipped = FrameBytes;
+	}
+	else if (RegionBytes >= FrameBytes || !UploadRegions(Texture, Buffer, Width, Regions))
+	{
+		UploadFullFrame(Texture, Buffer, Width, Height, SingleDirty);
+	}
+	else
+	{
+		LastStats.NumUploadedRegions = Regions.Num();
+		LastStats.BytesUploaded = RegionBytes;
+		LastStats.BytesSkipped = FrameBytes - RegionBytes;
+	}
+
+	INC_DWORD_STAT_BY(STAT_CEFPaintDirtyRects, LastStats.NumDirtyRects);
+	INC_DWORD_STAT_BY(STAT_CEFPaintUploadedRegions, LastStats.NumUploadedRegions);
+	INC_DWORD_STAT_BY(STAT_CEFPaintBytesUploaded, LastStats.BytesUploaded);
+	INC_DWORD_STAT_BY(STAT_CEFPaintBytesSkipped, LastStats.BytesSkipped);
+	return true;
+}
+
+void FCEFPaintRegionUploader::UploadFullFrame(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const FIntRect& Dirty)
+{
+	Texture->UpdateTextureThreadSafeRaw(Width, Height, Buffer, Dirty);
+
+	const uint64 FrameBytes = static_cast<uint64>(Width) * Height * BytesPerPixel;
+	LastStats.bFullUpload = true;
+	LastStats.NumUploadedRegions = 1;
+	LastStats.BytesUploaded = FrameBytes;
+	LastStats.BytesSkipped = 0;
+}
+
+bool FCEFPaintRegionUploader::UploadOverlay(FSlateUpdatableTexture* Texture, const void* Buffer, const FIntRect& TargetRect)
+{
+	const FIntRect FrameRect(FIntPoint::ZeroValue, UploadedSize);
+	if (Texture == nullptr || Buffer == nullptr || TargetRect.IsEmpty() || !FrameRect.Contains(TargetRect.Min) || TargetRect.Max.X > FrameRect.Max.X || TargetRect.Max.Y > FrameRect.Max.Y)
+	{
+		return false;
+	}
+
+	Regions.Reset();
+	Regions.Emplace(FIntPoint::ZeroValue, TargetRect.Size());
+	if (!UploadRegions(Texture, Buffer, TargetRect.Width(), Regions, TargetRect.Min))
+	{
+		return false;
+	}
+
+	const uint64 OverlayBytes = GetRectArea(TargetRect) * BytesPerPixel;
+	LastStats.BytesUploaded += OverlayBytes;
+	INC_DWORD_STAT_BY(STAT_CEFPaintBytesUploaded, OverlayBytes);
+	return true;
+}
+
+FSlateTexture2DRHIRef* FCEFPaintRegionUploader::GetRHITexture(FSlateUpdatableTexture* Texture)
+{
+#if WITH_ENGINE
+	// FSlateTexture2DRHIRef, which the engine Slate renderer creates, is the updatable texture that is also a render resource
+	if (Texture != nullptr && Texture->GetRenderResource() != nullptr)
+	{
+		return static_cast<FSlateTexture2DRHIRef*>(Texture);
+	}
+#endif
+	return nullptr;
+}
+
+bool FCEFPaintRegionUploader::UploadRegions(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, const TArray<FIntRect>& InRegions, const FIntPoint& TargetOffset)
+{
+#if WITH_ENGINE
+	int32 TotalBytes = 0;
+	for (const FIntRect& Region : InRegions)
+	{
+		TotalBytes += Region.Width() * Region.Height() * BytesPerPixel;
+	}
+
+	FSlateTexture2DRHIRef* SlateTexture = GetRHITexture(Texture);
+	if (SlateTexture == nullptr)
+	{
+		// Only textures of the engine Slate renderer can be updated region by region
+		return false;
+	}
+
+	// Pack the regions tightly, one after the other, so that a single staging buffer serves the whole paint
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Staging = StagingPool.Acquire(TotalBytes, CEFMultiRectStagingBuffers);
+	uint8* Dest = Staging->GetData();
+	const uint8* Source = static_cast<const uint8*>(Buffer);
+	const int32 SourcePitch = Width * BytesPerPixel;
+	for (const FIntRect& Region : InRegions)
+	{
+		const int32 RowBytes = Region.Width() * BytesPerPixel;
+		for (int32 Row = Region.Min.Y; Row < Region.Max.Y; ++Row)
+		{
+			FMemory::Memcpy(Dest, Source + Row * SourcePitch + Region.Min.X * BytesPerPixel, RowBytes);
+			Dest += RowBytes;
+		}
+	}
+
+	ENQUEUE_RENDER_COMMAND(CEFUploadPaintRegions)(
+		[SlateTexture, Staging, Regions = TArray<FIntRect>(InRegions), TargetOffset](FRHICommandListImmediate& RHICmdList)
+		{
+			FTextureRHIRef TextureRHI = SlateTexture->GetRHIRef();
+			if (!TextureRHI.IsValid())
+			{
+				return;
+			}
+
+			const FIntPoint TextureSize = TextureRHI->GetSizeXY();
+			const uint8* RegionData = Staging->GetData();
+			for (const FIntRect& Region : Regions)
+			{
+				const uint32 RegionPitch = Region.Width() * BytesPerPixel;
+				if (Region.Max.X + TargetOffset.X <= TextureSize.X && Region.Max.Y + TargetOffset.Y <= TextureSize.Y)
+				{
+					const FUpdateTextureRegion2D UpdateRegion(Region.Min.X + TargetOffset.X, Region.Min.Y + TargetOffset.Y, 0, 0, Region.Width(), Region.Height());
+					RHICmdList.UpdateTexture2D(TextureRHI, 0, UpdateRegion, RegionPitch, RegionData);
+				}
+				RegionData += RegionPitch * Region.Height();
+			}
+		});
+
+	return true;
+#else
+	// Without the engine renderer we can only hand Slate a single dirty rect
+	return false;
+#endif
+}
+
+#endif
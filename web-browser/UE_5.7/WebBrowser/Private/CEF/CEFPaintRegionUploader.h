@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+#include "CEFLibCefIncludes.h"
+
+class FSlateUpdatableTexture;
+class FSlateTexture2DRHIRef;
+
+/**
+ * Per-paint counters reported by FCEFPaintRegionUploader.
+ */
+struct FCEFPaintUploadStats
+{
+	/** Number of dirty rects CEF reported for the paint. */
+	int32 NumDirtyRects = 0;
+
+	/** Number of regions left after coalescing, i.e. the number of texture updates issued. */
+	int32 NumUploadedRegions = 0;
+
+	/** Bytes actually copied to the texture. */
+	uint64 BytesUploaded = 0;
+
+	/** Bytes of the frame that did not need to be copied. */
+	uint64 BytesSkipped = 0;
+
+	/** Whether the paint fell back to uploading the whole frame. */
+	bool bFullUpload = false;
+};
+
+/**
+ * Ring of staging buffers whose contents are copied into textures by render commands.
+ * A buffer is in flight, and not handed out again, while a render command holds a reference to it.
+ */
+class FCEFStagingBufferPool
+{
+public:
+	FCEFStagingBufferPool();
+
+	/**
+	 * @param NumBytes The size the buffer must have.
+	 * @param RingSize The number of buffers to pool. Changing it discards the current buffers.
+	 * @return a staging buffer that is not referenced by a pending render command, holding NumBytes.
+	 */
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Acquire(int32 NumBytes, int32 RingSize);
+
+private:
+	TArray<TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>> Ring;
+	int32 NextBuffer;
+};
+
+/**
+ * Uploads only the dirty regions of an OSR paint buffer into a Slate updatable texture.
+ *
+ * CEF may report several small dirty rects per paint (a caret and a clock, for example). They are coalesced using
+ * an area-overlap heuristic and each remaining region is packed into a pooled staging buffer and copied into the
+ * texture on the render thread, instead of uploading the whole frame.
+ *
+ * Paints over the upload budget of FCEFTextureUploadScheduler are deferred: their dirty parts are copied into a frame kept by
+ * the uploader, and the dirty rects of successive deferred paints are accumulated until the frame is flushed to the texture.
+ */
+class FCEFPaintRegionUploader
+{
+public:
+	FCEFPaintRegionUploader();
+
+	/**
+	 * Updates the texture with the dirty parts of the buffer.
+	 *
+	 * @param Texture The texture to update.
+	 * @param Buffer The B8G8R8A8 paint buffer received from CEF.
+	 * @param Width Width of the paint buffer.
+	 * @param Height Height of the paint buffer.
+	 * @param DirtyRects The dirty rects reported by CEF.
+	 * @return true if the texture was updated.
+	 */
+	bool Upload(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects);
+
+	/**
+	 * Copies a smaller buffer over part of the frame last uploaded, like a popup composited into the view.
+	 *
+	 * @param Texture The texture to update, which must hold a frame uploaded with Upload.
+	 * @param Buffer The B8G8R8A8 pixels to copy.
+	 * @param TargetRect Where to copy the pixels in the texture, the size of the buffer.
+	 * @return true if the texture was updated, false if the rect doesn't fit in the uploaded frame.
+	 */
+	bool UploadOverlay(FSlateUpdatableTexture* Texture, const void* Buffer, const FIntRect& TargetRect);
+
+	/** Forgets the uploaded texture size, so the next upload will transfer the whole frame. Call when the texture is recreated. */
+	void Reset();
+
+	/**
+	 * @return the bytes Upload would transfer for the paint, an estimate made before coalescing the dirty rects.
+	 */
+	uint64 EstimateUploadBytes(int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects) const;
+
+	/**
+	 * Copies the dirty parts of the buffer into the deferred frame, merging them with the paints deferred since the last flush.
+	 * Takes the same parameters as Upload.
+	 */
+	void Defer(const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects);
+
+	/**
+	 * Uploads the parts of the deferred frame painted since the last flush.
+	 *
+	 * @param Texture The texture to update.
+	 * @return true if the texture was updated.
+	 */
+	bool FlushDeferred(FSlateUpdatableTexture* Texture);
+
+	/** Drops the pending deferred paints. The deferred frame keeps its allocation for the next paint deferred. */
+	void DiscardDeferred();
+
+	/** @return whether deferred paints are waiting to be flushed. */
+	bool HasDeferred() const { return bHasDeferred; }
+
+	/** @return the bytes FlushDeferred would transfer. */
+	uint64 GetDeferredBytes() const;
+
+	/** @return the counters for the most recent call to Upload. */
+	const FCEFPaintUploadStats& GetLastStats() const { return LastStats; }
+
+	/** @return whether the multi-rect upload path is enabled. */
+	static bool IsEnabled();
+
+	/**
+	 * Clips the rects to the frame and merges them until no pair satisfies the area-overlap heuristic.
+	 * Two rects are merged when their combined area covers at least MergeAreaRatio of their bounding rect.
+	 *
+	 * @param InOutRects The rects to coalesce.
+	 * @param FrameSize Size of the frame the rects belong to.
+	 * @param MergeAreaRatio Minimum ratio of covered area to bounding area for two rects to be merged.
+	 * @param MaxRegions Maximum number of regions to return. The cheapest pairs are merged until the limit is reached.
+	 */
+	static void CoalesceRects(TArray<FIntRect>& InOutRects, const FIntPoint& FrameSize, float MergeAreaRatio, int32 MaxRegions);
+
+	/**
+	 * @return the texture as created by the engine Slate renderer, whose RHI texture render commands can update directly,
+	 * or nullptr for textures of other renderers, which can only be updated through the FSlateUpdatableTexture methods.
+	 */
+	static FSlateTexture2DRHIRef* GetRHITexture(FSlateUpdatableTexture* Texture);
+
+private:
+	/** Uploads the dirty parts of the buffer, without touching the deferred frame. */
+	bool UploadFrame(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const CefRenderHandler::RectList& DirtyRects);
+
+	/** Uploads the whole frame using the regular Slate path. */
+	void UploadFullFrame(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, int32 Height, const FIntRect& Dirty);
+
+	/** Packs the regions into a staging buffer and copies them into the texture, moved by TargetOffset. */
+	bool UploadRegions(FSlateUpdatableTexture* Texture, const void* Buffer, int32 Width, const TArray<FIntRect>& Regions, const FIntPoint& TargetOffset = FIntPoint::ZeroValue);
+
+	/** Staging buffers the regions are packed into. */
+	FCEFStagingBufferPool StagingPool;
+
+	/** Size of the frame last uploaded in full. Partial uploads are only valid against a texture of this size. */
+	FIntPoint UploadedSize;
+
+	/** Scratch array reused between paints. */
+	TArray<FIntRect> Regions;
+
+	/** Copy of the last deferred frame, holding every paint since it was last copied in full. */
+	TArray<uint8> DeferredPixels;
+	FIntPoint DeferredSize;
+
+	/** Parts of the deferred frame painted since the last flush. Ignored when the whole frame is to be uploaded. */
+	TArray<FIntRect> DeferredRects;
+	bool bDeferredFullFrame;
+	bool bHasDeferred;
+
+	/** Scratch rect list the deferred rects are passed to UploadFrame in. */
+	CefRenderHandler::RectList FlushRects;
+
+	FCEFPaintUploadStats LastStats;
+};
+
+#endif
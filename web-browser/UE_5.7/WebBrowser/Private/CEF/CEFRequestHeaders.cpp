@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFRequestHeaders.h"
+
+#if WITH_CEF3
+
+#include "WebBrowserSingleton.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Request Header Rebuilds"), STAT_CEFRequestHeaderRebuilds, STATGROUP_WebBrowser);
+
+FCEFRequestHeaders::FCEFRequestHeaders(const TMap<FString, FString>& InHeaders)
+	: Headers(InHeaders)
+{
+	Rebuild();
+}
+
+void FCEFRequestHeaders::SetHeaders(const TMap<FString, FString>& InHeaders)
+{
+	Headers = InHeaders;
+	Rebuild();
+}
+
+void FCEFRequestHeaders::OnCultureChanged()
+{
+	// An overridden Accept-Language doesn't depend on the culture
+	if (!Headers.Contains(TEXT("Accept-Language")))
+	{
+		Rebuild();
+	}
+}
+
+void FCEFRequestHeaders::Apply(CefRefPtr<CefRequest> Request) const
+{
+	TSharedPtr<const CefRequest::HeaderMap, ESPMode::ThreadSafe> CurrentHeaderMap;
+	{
+		FScopeLock Lock(&HeaderMapCS);
+		CurrentHeaderMap = HeaderMap;
+	}
+
+	for (const std::pair<const CefString, CefString>& Header : *CurrentHeaderMap)
+	{
+		Request->SetHeaderByName(Header.first, Header.second, true);
+	}
+}
+
+void FCEFRequestHeaders::Rebuild()
+{
+	INC_DWORD_STAT(STAT_CEFRequestHeaderRebuilds);
+
+	TSharedRef<CefRequest::HeaderMap, ESPMode::ThreadSafe> NewHeaderMap = MakeShared<CefRequest::HeaderMap, ESPMode::ThreadSafe>();
+	if (!Headers.Contains(TEXT("Accept-Language")))
+	{
+		NewHeaderMap->insert(std::make_pair(CefString(TCHAR_TO_WCHAR(TEXT("Accept-Language"))), CefString(TCHAR_TO_WCHAR(*FWebBrowserSingleton::GetCurrentLocaleCode()))));
+	}
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		NewHeaderMap->insert(std::make_pair(CefString(TCHAR_TO_WCHAR(*Header.Key)), CefString(TCHAR_TO_WCHAR(*Header.Value))));
+	}
+
+	FScopeLock Lock(&HeaderMapCS);
+	HeaderMap = NewHeaderMap;
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+#include "CEFLibCefIncludes.h"
+
+/**
+ * The static headers set on every request of a request context.
+ *
+ * The headers are converted into a CEF header map once, whenever they or the current culture change, and the map is swapped in
+ * whole so the IO thread can set it on requests without waiting on the game thread. Accept-Language follows the current culture,
+ * unless the static headers override it.
+ */
+class FCEFRequestHeaders
+{
+public:
+	/** @param InHeaders Headers to set on every request, on top of Accept-Language. */
+	FCEFRequestHeaders(const TMap<FString, FString>& InHeaders);
+
+	/** Replaces the static headers. Game thread only. */
+	void SetHeaders(const TMap<FString, FString>& InHeaders);
+
+	/** Recomputes Accept-Language from the current culture. Game thread only. */
+	void OnCultureChanged();
+
+	/** Sets the headers on a writable request, replacing any previous values. Safe to call from any thread. */
+	void Apply(CefRefPtr<CefRequest> Request) const;
+
+private:
+	/** Converts the headers and the current locale into a new header map. */
+	void Rebuild();
+
+	/** The headers as given, kept to rebuild the map when the culture changes. */
+	TMap<FString, FString> Headers;
+
+	TSharedPtr<const CefRequest::HeaderMap, ESPMode::ThreadSafe> HeaderMap;
+	mutable FCriticalSection HeaderMapCS;
+};
+
+#endif
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFResizePolicy.h"
+
+#if WITH_CEF3
+
+#include "HAL/IConsoleManager.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resizes Applied"), STAT_CEFResizesApplied, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Resizes Suppressed"), STAT_CEFResizesSuppressed, STATGROUP_WebBrowser);
+
+static int32 CEFResizeMode = static_cast<int32>(ECEFResizeMode::Debounce);
+static FAutoConsoleVariableRef CVarCEFResizeMode(
+	TEXT("webbrowser.Resize.Mode"),
+	CEFResizeMode,
+	TEXT("How widget size changes are passed on to CEF. 0: immediately, 1: debounced, with quantized intermediate sizes, 2: once stable, stretching the last frame meanwhile\n"),
+	ECVF_Default);
+
+static float CEFResizeDebounceSeconds = 0.1f;
+static FAutoConsoleVariableRef CVarCEFResizeDebounceSeconds(
+	TEXT("webbrowser.Resize.DebounceSeconds"),
+	CEFResizeDebounceSeconds,
+	TEXT("How long a widget size must be stable before it is passed on to CEF\n"),
+	ECVF_Default);
+
+static float CEFResizeMaxIntervalSeconds = 0.25f;
+static FAutoConsoleVariableRef CVarCEFResizeMaxIntervalSeconds(
+	TEXT("webbrowser.Resize.MaxIntervalSeconds"),
+	CEFResizeMaxIntervalSeconds,
+	TEXT("In debounced mode, the shortest interval between intermediate resizes while the widget size keeps changing\n"),
+	ECVF_Default);
+
+static int32 CEFResizeQuantum = 32;
+static FAutoConsoleVariableRef CVarCEFResizeQuantum(
+	TEXT("webbrowser.Resize.Quantum"),
+	CEFResizeQuantum,
+	TEXT("In debounced mode, intermediate sizes are rounded to a multiple of this many pixels. The exact size is applied once stable\n"),
+	ECVF_Default);
+
+namespace
+{
+	int32 QuantizeExtent(int32 Extent)
+	{
+		const int32 Quantum = FMath::Max(CEFResizeQuantum, 1);
+		return FMath::Max(((Extent + Quantum / 2) / Quantum) * Quantum, Quantum);
+	}
+}
+
+FCEFResizePolicy::FCEFResizePolicy()
+	: PendingSize(FIntPoint::ZeroValue)
+	, PendingSinceTime(0.0)
+	, LastAppliedTime(0.0)
+{
+}
+
+TOptional<FIntPoint> FCEFResizePolicy::Update(const FIntPoint& RequestedSize, const FIntPoint& AppliedSize, double Now)
+{
+	if (RequestedSize == AppliedSize)
+	{
+		if (HasPendingResize())
+		{
+			// The widget went back to the size CEF already has
+			Stats.NumSuppressedResizes++;
+			INC_DWORD_STAT(STAT_CEFResizesSuppressed);
+			PendingSize = FIntPoint::ZeroValue;
+		}
+		return TOptional<FIntPoint>();
+	}
+
+	const ECEFResizeMode Mode = static_cast<ECEFResizeMode>(FMath::Clamp(CEFResizeMode, 0, 2));
+	if (AppliedSize == FIntPoint::ZeroValue || Mode == ECEFResizeMode::Immediate)
+	{
+		return Apply(RequestedSize, Now, true);
+	}
+
+	if (RequestedSize != PendingSize)
+	{
+		if (HasPendingResize())
+		{
+			Stats.NumSuppressedResizes++;
+			INC_DWORD_STAT(STAT_CEFResizesSuppressed);
+		}
+		PendingSize = RequestedSize;
+		PendingSinceTime = Now;
+	}
+
+	if (Now - PendingSinceTime >= CEFResizeDebounceSeconds)
+	{
+		return Apply(PendingSize, Now, true);
+	}
+
+	if (Mode == ECEFResizeMode::Debounce && Now - LastAppliedTime >= CEFResizeMaxIntervalSeconds)
+	{
+		// Let the layout follow a continuous resize in coarse steps, the exact size still goes through once stable
+		const FIntPoint QuantizedSize(QuantizeExtent(PendingSize.X), QuantizeExtent(PendingSize.Y));
+		if (QuantizedSize != AppliedSize)
+		{
+			return Apply(QuantizedSize, Now, QuantizedSize == PendingSize);
+		}
+	}
+
+	return TOptional<FIntPoint>();
+}
+
+void FCEFResizePolicy::Reset()
+{
+	PendingSize = FIntPoint::ZeroValue;
+}
+
+FIntPoint FCEFResizePolicy::Apply(const FIntPoint& Size, double Now, bool bIsSettled)
+{
+	if (bIsSettled)
+	{
+		PendingSize = FIntPoint::ZeroValue;
+	}
+	LastAppliedTime = Now;
+
+	Stats.NumAppliedResizes++;
+	INC_DWORD_STAT(STAT_CEFResizesApplied);
+	return Size;
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+/**
+ * How FCEFResizePolicy passes size changes on to CEF. Selected with webbrowser.Resize.Mode.
+ */
+enum class ECEFResizeMode : int32
+{
+	/** Every size change is passed on right away. */
+	Immediate = 0,
+
+	/** Sizes are passed on once stable. While the size keeps changing, a quantized size is passed on at a limited rate so the page layout follows along. */
+	Debounce = 1,
+
+	/** Sizes are only passed on once stable. The last frame is stretched to the widget in the meantime. */
+	ScaleLastFrame = 2,
+};
+
+/**
+ * Counters reported by FCEFResizePolicy.
+ */
+struct FCEFResizeStats
+{
+	/** Number of sizes passed on to CEF. */
+	uint64 NumAppliedResizes = 0;
+
+	/** Number of sizes that were replaced by a newer size before reaching CEF. */
+	uint64 NumSuppressedResizes = 0;
+};
+
+/**
+ * Decides when a change of the widget size is passed on to CEF.
+ *
+ * Every resize makes CEF re-rasterize the whole page, and on CEF 128+ also goes through the repaint workaround and a new
+ * captured buffer. A window drag or an animated panel changes the size every frame, so the policy holds sizes back until
+ * they have been stable for webbrowser.Resize.DebounceSeconds, only letting a size quantized to webbrowser.Resize.Quantum
+ * pixels through every webbrowser.Resize.MaxIntervalSeconds while the size keeps changing.
+ */
+class FCEFResizePolicy
+{
+public:
+	FCEFResizePolicy();
+
+	/**
+	 * Called with the size of the widget on every tick.
+	 *
+	 * @param RequestedSize The size of the widget, which must not be zero.
+	 * @param AppliedSize The size CEF currently renders at, zero before the first size.
+	 * @param Now The current time, in seconds.
+	 * @return the size to pass on to CEF now, if any.
+	 */
+	TOptional<FIntPoint> Update(const FIntPoint& RequestedSize, const FIntPoint& AppliedSize, double Now);
+
+	/** Forgets the pending size, for instance when CEF was resized for another reason. */
+	void Reset();
+
+	/** @return whether a size is being held back. */
+	bool HasPendingResize() const
+	{
+		return PendingSize != FIntPoint::ZeroValue;
+	}
+
+	/** @return the counters accumulated since the policy was created. */
+	const FCEFResizeStats& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	/** Records that a size is passed on to CEF. */
+	FIntPoint Apply(const FIntPoint& Size, double Now, bool bIsSettled);
+
+	/** The size being held back, zero if none, and the time it was first requested. */
+	FIntPoint PendingSize;
+	double PendingSinceTime;
+
+	/** Time a size was last passed on to CEF. */
+	double LastAppliedTime;
+
+	FCEFResizeStats Stats;
+};
+
+#endif
@@ -12,95 +12,144 @@
 
 #define LOCTEXT_NAMESPACE "WebBrowserHandler"
 
-FCEFResourceContextHandler::FCEFResourceContextHandler(FWebBrowserSingleton * InOwningSingleton) :
-	OwningSingleton(InOwningSingleton)
+FCEFResourceContextHandler::FCEFResourceContextHandler(FWebBrowserSingleton * InOwningSingleton, const FString& InContextId, const TMap<FString, FString>& InRequestHeaders) :
+	RequestHeaders(MakeShared<FCEFRequestHeaders, ESPMode::ThreadSafe>(InRequestHeaders)),
+	bHasBeforeLoadDelegates(false),
+	OwningSingleton(InOwningSingleton),
+	ContextId(InContextId)
 { }
 
+void FCEFResourceContextHandler::SetOnBeforeLoad(const FOnBeforeContextResourceLoadDelegate& InBeforeResourceLoadDelegate, const FOnBeforeContextResourceRequestDelegate& InBeforeResourceRequestDelegate)
+{
+	BeforeResourceLoadDelegate = InBeforeResourceLoadDelegate;
+	BeforeResourceRequestDelegate = InBeforeResourceRequestDelegate;
+	bHasBeforeLoadDelegates = BeforeResourceLoadDelegate.IsBound() || BeforeResourceRequestDelegate.IsBound();
+}
 
-FString ResourceTypeToString(const CefRequest::ResourceType& Type)
+void FCEFResourceContextHandler::UnbindOnBeforeLoad()
+{
+	bHasBeforeLoadDelegates = false;
+	BeforeResourceLoadDelegate.Unbind();
+	BeforeResourceRequestDelegate.Unbind();
+}
+
+
+FName ResourceTypeToName(const CefRequest::ResourceType& Type)
 {
-	const static FString ResourceType_MainFrame(TEXT("MAIN_FRAME"));
-	const static FString ResourceType_SubFrame(TEXT("SUB_FRAME"));
-	const static FString ResourceType_StyleSheet(TEXT("STYLESHEET"));
-	const static FString ResourceType_Script(TEXT("SCRIPT"));
-	const static FString ResourceType_Image(TEXT("IMAGE"));
-	const static FString ResourceType_FontResource(TEXT("FONT_RESOURCE"));
-	const static FString ResourceType_SubResource(TEXT("SUB_RESOURCE"));
-	const static FString ResourceType_Object(TEXT("OBJECT"));
-	const static FString ResourceType_Media(TEXT("MEDIA"));
-	const static FString ResourceType_Worker(TEXT("WORKER"));
-	const static FString ResourceType_SharedWorker(TEXT("SHARED_WORKER"));
-	const static FString ResourceType_Prefetch(TEXT("PREFETCH"));
-	const static FString ResourceType_Favicon(TEXT("FAVICON"));
-	const static FString ResourceType_XHR(TEXT("XHR"));
-	const static FString ResourceType_Ping(TEXT("PING"));
-	const static FString ResourceType_ServiceWorker(TEXT("SERVICE_WORKER"));
-	const static FString ResourceType_CspReport(TEXT("CSP_REPORT"));
-	const static FString ResourceType_PluginResource(TEXT("PLUGIN_RESOURCE"));
-	const static FString ResourceType_Unknown(TEXT("UNKNOWN"));
-
-	FString TypeStr;
+	// Names are interned once, so passing a type around never allocates
+	const static FName ResourceType_MainFrame(TEXT("MAIN_FRAME"));
+	const static FName ResourceType_SubFrame(TEXT("SUB_FRAME"));
+	const static FName ResourceType_StyleSheet(TEXT("STYLESHEET"));
+	const static FName ResourceType_Script(TEXT("SCRIPT"));
+	const static FName ResourceType_Image(TEXT("IMAGE"));
+	const static FName ResourceType_FontResource(TEXT("FONT_RESOURCE"));
+	const static FName ResourceType_SubResource(TEXT("SUB_RESOURCE"));
+	const static FName ResourceType_Object(TEXT("OBJECT"));
+	const static FName ResourceType_Media(TEXT("MEDIA"));
+	const static FName ResourceType_Worker(TEXT("WORKER"));
+	const static FName ResourceType_SharedWorker(TEXT("SHARED_WORKER"));
+	const static FName ResourceType_Prefetch(TEXT("PREFETCH"));
+	const static FName ResourceType_Favicon(TEXT("FAVICON"));
+	const static FName ResourceType_XHR(TEXT("XHR"));
+	const static FName ResourceType_Ping(TEXT("PING"));
+	const static FName ResourceType_ServiceWorker(TEXT("SERVICE_WORKER"));
+	const static FName ResourceType_CspReport(TEXT("CSP_REPORT"));
+	const static FName ResourceType_PluginResource(TEXT("PLUGIN_RESOURCE"));
+	const static FName ResourceType_Unknown(TEXT("UNKNOWN"));
+
 	switch (Type)
 	{
 	case CefRequest::ResourceType::RT_MAIN_FRAME:
-		TypeStr = ResourceType_MainFrame;
-		break;
+		return ResourceType_MainFrame;
 	case CefRequest::ResourceType::RT_SUB_FRAME:
-		TypeStr = ResourceType_SubFrame;
-		break;
+		return ResourceType_SubFrame;
 	case CefRequest::ResourceType::RT_STYLESHEET:
-		TypeStr = ResourceType_StyleSheet;
-		break;
+		return ResourceType_StyleSheet;
 	case CefRequest::ResourceType::RT_SCRIPT:
-		TypeStr = ResourceType_Script;
-		break;
+		return ResourceType_Script;
 	case CefRequest::ResourceType::RT_IMAGE:
-		TypeStr = ResourceType_Image;
-		break;
+		return ResourceType_Image;
 	case CefRequest::ResourceType::RT_FONT_RESOURCE:
-		TypeStr = ResourceType_FontResource;
-		break;
+		return ResourceType_FontResource;
 	case CefRequest::ResourceType::RT_SUB_RESOURCE:
-		TypeStr = ResourceType_SubResource;
-		break;
+		return ResourceType_SubResource;
 	case CefRequest::ResourceType::RT_OBJECT:
-		TypeStr = ResourceType_Object;
-		break;
+		return ResourceType_Object;
 	case CefRequest::ResourceType::RT_MEDIA:
-		TypeStr = ResourceType_Media;
-		break;
+		return ResourceType_Media;
 	case CefRequest::ResourceType::RT_WORKER:
-		TypeStr = ResourceType_Worker;
-		break;
+		return ResourceType_Worker;
 	case CefRequest::ResourceType::RT_SHARED_WORKER:
-		TypeStr = ResourceType_SharedWorker;
-		break;
+		return ResourceType_SharedWorker;
 	case CefRequest::ResourceType::RT_PREFETCH:
-		TypeStr = ResourceType_Prefetch;
-		break;
+		return ResourceType_Prefetch;
 	case CefRequest::ResourceType::RT_FAVICON:
-		TypeStr = ResourceType_Favicon;
-		break;
+		return ResourceType_Favicon;
 	case CefRequest::ResourceType::RT_XHR:
-		TypeStr = ResourceType_XHR;
-		break;
+		return ResourceType_XHR;
 	case CefRequest::ResourceType::RT_PING:
-		TypeStr = ResourceType_Ping;
-		break;
+		return ResourceType_Ping;
 	case CefRequest::ResourceType::RT_SERVICE_WORKER:
-		TypeStr = ResourceType_ServiceWorker;
-		break;
+		return ResourceType_ServiceWorker;
 	case CefRequest::ResourceType::RT_CSP_REPORT:
-		TypeStr = ResourceType_CspReport;
-		break;
+		return ResourceType_CspReport;
 	case CefRequest::ResourceType::RT_PLUGIN_RESOURCE:
-		TypeStr = ResourceType_PluginResource;
-		break;
+		return ResourceType_PluginResource;
 	default:
-		TypeStr = ResourceType_Unknown;
-		break;
+		return ResourceType_Unknown;
 	}
-	return TypeStr;
+}
+
+FString ResourceTypeToString(const CefRequest::ResourceType& Type)
+{
+	return ResourceTypeToName(Type).ToString();
+}
+
+FCEFResourceRequest::FCEFResourceRequest(CefRefPtr<CefRequest> InRequest, CefRequest::ResourceType InType, bool bInAllowUserCredentials)
+	: Request(InRequest)
+	, Type(InType)
+	, bAllowUserCredentials(bInAllowUserCredentials)
+{
+}
+
+const FString& FCEFResourceRequest::GetUrl() const
+{
+	if (!Url.IsSet())
+	{
+		Url.Emplace(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()));
+	}
+	return Url.GetValue();
+}
+
+FName FCEFResourceRequest::GetResourceType() const
+{
+	return ResourceTypeToName(Type);
+}
+
+bool FCEFResourceRequest::AllowsUserCredentials() const
+{
+	return bAllowUserCredentials;
+}
+
+FString FCEFResourceRequest::GetHeader(const FString& Name) const
+{
+	return WCHAR_TO_TCHAR(Request->GetHeaderByName(TCHAR_TO_WCHAR(*Name)).ToWString().c_str());
+}
+
+const TMap<FString, FString>& FCEFResourceRequest::GetHeaders() const
+{
+	if (!Headers.IsSet())
+	{
+		CefRequest::HeaderMap HeaderMap;
+		Request->GetHeaderMap(HeaderMap);
+		TMap<FString, FString>& HeadersValue = Headers.Emplace();
+		HeadersValue.Reserve(HeaderMap.size());
+		for (const std::pair<const CefString, CefString>& Header : HeaderMap)
+		{
+			HeadersValue.Add(WCHAR_TO_TCHAR(Header.first.ToWString().c_str()), WCHAR_TO_TCHAR(Header.second.ToWString().c_str()));
+		}
+	}
+	return Headers.GetValue();
 }
 
 CefResourceRequestHandler::ReturnValue FCEFResourceContextHandler::OnBeforeResourceLoad(
@@ -129,40 +178,38 @@ CefResourceRequestHandler::ReturnValue FCEFResourceContextHandler::OnBeforeResou
 		return RV_CONTINUE;
 	}
 
-	// Current thread is IO thread. We need to invoke BrowserWindow->GetResourceContent on the UI (aka Game) thread:
-	CefPostTask(TID_UI, new FCEFBrowserClosureTask(this, [=, this]()
+	// The static headers, Accept-Language included, don't need the game thread
+	RequestHeaders->Apply(Request);
+	if (!bHasBeforeLoadDelegates)
 	{
-		const FString LanguageHeaderText(TEXT("Accept-Language"));
-		const FString LocaleCode = FWebBrowserSingleton::GetCurrentLocaleCode();
-		CefRequest::HeaderMap HeaderMap;
-		Request->GetHeaderMap(HeaderMap);
-		auto LanguageHeader = HeaderMap.find(TCHAR_TO_WCHAR(*LanguageHeaderText));
-		if (LanguageHeader != HeaderMap.end())
-		{
-			(*LanguageHeader).second = TCHAR_TO_WCHAR(*LocaleCode);
-		}
-		else
-		{
-			HeaderMap.insert(std::pair<CefString, CefString>(TCHAR_TO_WCHAR(*LanguageHeaderText), TCHAR_TO_WCHAR(*LocaleCode)));
-		}
-
-		bool bAllowCredentials = false;
-		if (OwningSingleton != nullptr)
-		{
-			bAllowCredentials = OwningSingleton->URLRequestAllowsCredentials(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()));
-		}
-		FContextRequestHeaders AdditionalHeaders;
-		BeforeResourceLoadDelegate.ExecuteIfBound(WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()), ResourceTypeToString(Request->GetResourceType()), AdditionalHeaders, bAllowCredentials);
+		return RV_CONTINUE;
+	}
 
-		for (auto Iter = AdditionalHeaders.CreateConstIterator(); Iter; ++Iter)
+	// Current thread is IO thread. We need to invoke the delegates on the UI (aka Game) thread:
+	CefPostTask(TID_UI, new FCEFBrowserClosureTask(this, [=, this]()
+	{
+		// The delegates may have been unbound since the task was posted
+		if (BeforeResourceLoadDelegate.IsBound() || BeforeResourceRequestDelegate.IsBound())
 		{
-			const FString Header = Iter.Key();
-			const FString Value = Iter.Value();
-			HeaderMap.insert(std::pair<CefString, CefString>(TCHAR_TO_WCHAR(*Header), TCHAR_TO_WCHAR(*Value)));
+			FCEFResourceRequest ResourceRequest(Request, Request->GetResourceType(), false);
+			if (OwningSingleton != nullptr)
+			{
+				const int32 BrowserId = Browser != nullptr ? Browser->GetIdentifier() : INDEX_NONE;
+				ResourceRequest.SetAllowsUserCredentials(OwningSingleton->URLRequestAllowsCredentials(ResourceRequest.GetUrl(), BrowserId, ContextId));
+			}
+			FContextRequestHeaders AdditionalHeaders;
+			if (BeforeResourceLoadDelegate.IsBound())
+			{
+				BeforeResourceLoadDelegate.Execute(ResourceRequest.GetUrl(), ResourceRequest.GetResourceType().ToString(), AdditionalHeaders, ResourceRequest.AllowsUserCredentials());
+			}
+			BeforeResourceRequestDelegate.ExecuteIfBound(ResourceRequest, AdditionalHeaders);
+
+			for (const TPair<FString, FString>& Header : AdditionalHeaders)
+			{
+				Request->SetHeaderByName(TCHAR_TO_WCHAR(*Header.Key), TCHAR_TO_WCHAR(*Header.Value), true);
+			}
 		}
 
-		Request->SetHeaderMap(HeaderMap);
-
 #if CEF_VERSION_MAJOR < 128
 		Callback->Continue(true);
 #else
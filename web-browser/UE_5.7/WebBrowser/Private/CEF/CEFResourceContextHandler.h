@@ -9,10 +9,46 @@
 #include "IWebBrowserResourceLoader.h"
 
 #include "CEFLibCefIncludes.h"
+#include "CEF/CEFRequestHeaders.h"
 
+#include <atomic>
 
+
+/** Interned name of a resource type, e.g. "IMAGE". */
+FName ResourceTypeToName(const CefRequest::ResourceType& Type);
 FString ResourceTypeToString(const CefRequest::ResourceType& Type);
 
+/**
+ * Exposes a CEF request to the resource request delegates, reading the url and headers from it only when asked for.
+ */
+class FCEFResourceRequest
+	: public IWebBrowserResourceRequest
+{
+public:
+	FCEFResourceRequest(CefRefPtr<CefRequest> InRequest, CefRequest::ResourceType InType, bool bInAllowUserCredentials);
+
+	// IWebBrowserResourceRequest interface
+	virtual const FString& GetUrl() const override;
+	virtual FName GetResourceType() const override;
+	virtual bool AllowsUserCredentials() const override;
+	virtual FString GetHeader(const FString& Name) const override;
+	virtual const TMap<FString, FString>& GetHeaders() const override;
+
+	void SetAllowsUserCredentials(bool bInAllowUserCredentials)
+	{
+		bAllowUserCredentials = bInAllowUserCredentials;
+	}
+
+private:
+	CefRefPtr<CefRequest> Request;
+	CefRequest::ResourceType Type;
+	bool bAllowUserCredentials;
+
+	/** Converted on first use. */
+	mutable TOptional<FString> Url;
+	mutable TOptional<TMap<FString, FString>> Headers;
+};
+
 class FWebBrowserSingleton;
 
 /**
@@ -24,8 +60,12 @@ class FCEFResourceContextHandler :
 {
 public:
 
-	/** Default constructor. */
-	FCEFResourceContextHandler(FWebBrowserSingleton *InOwningSingleton);
+	/**
+	 * @param InOwningSingleton The singleton that owns this context handler.
+	 * @param InContextId The id of the request context.
+	 * @param InRequestHeaders The static headers of the context.
+	 */
+	FCEFResourceContextHandler(FWebBrowserSingleton *InOwningSingleton, const FString& InContextId, const TMap<FString, FString>& InRequestHeaders);
 
 public:
 
@@ -52,18 +92,37 @@ public:
 
 
 public:
-	FOnBeforeContextResourceLoadDelegate& OnBeforeLoad()
+	/** Sets the delegates called on the game thread before each resource load. Requests skip the game thread while neither is bound. */
+	void SetOnBeforeLoad(const FOnBeforeContextResourceLoadDelegate& InBeforeResourceLoadDelegate, const FOnBeforeContextResourceRequestDelegate& InBeforeResourceRequestDelegate);
+
+	/** Unbinds both before load delegates. */
+	void UnbindOnBeforeLoad();
+
+	/** The static headers of the context, shared with the browsers created in it. */
+	const TSharedRef<FCEFRequestHeaders, ESPMode::ThreadSafe>& GetRequestHeaders() const
 	{
-		return BeforeResourceLoadDelegate;
+		return RequestHeaders;
 	}
 
 private:
+	/** Static headers, set on the IO thread */
+	TSharedRef<FCEFRequestHeaders, ESPMode::ThreadSafe> RequestHeaders;
+
+	/** Whether either delegate is bound, read on the IO thread */
+	std::atomic<bool> bHasBeforeLoadDelegates;
+
 	/** Delegate for handling resource load requests */
 	FOnBeforeContextResourceLoadDelegate BeforeResourceLoadDelegate;
 
+	/** Delegate for handling resource load requests, without converting them to strings */
+	FOnBeforeContextResourceRequestDelegate BeforeResourceRequestDelegate;
+
 	/** Singleton that owns this context handler, so we can lookup browser objects from it */
 	FWebBrowserSingleton* OwningSingleton;
 
+	/** Id of the request context, to lookup the browsers created in it */
+	FString ContextId;
+
 	// Include the default reference counting implementation.
 	IMPLEMENT_REFCOUNTING(FCEFResourceContextHandler);
 };
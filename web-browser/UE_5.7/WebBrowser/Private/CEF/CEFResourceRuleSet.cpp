@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFResourceRuleSet.h"
+
+#if WITH_CEF3
+
+#include "CEFBrowserByteResource.h"
+#include "CEFResourceContextHandler.h"
+
+namespace
+{
+	/** CefRequest::ResourceType values are small and contiguous, so types are matched with a bit mask. */
+	constexpr int32 MaxResourceType = 64;
+
+	uint64 MakeResourceTypeMask(const TArray<FString>& ResourceTypes)
+	{
+		uint64 Mask = 0;
+		for (int32 Type = 0; Type < MaxResourceType; ++Type)
+		{
+			if (ResourceTypes.Contains(ResourceTypeToString(static_cast<CefRequest::ResourceType>(Type))))
+			{
+				Mask |= uint64(1) << Type;
+			}
+		}
+		return Mask;
+	}
+
+	/** Header names are case insensitive, but CefRequest::HeaderMap is not. */
+	void RemoveHeader(CefRequest::HeaderMap& HeaderMap, const CefString& Name)
+	{
+		const FString NameString = WCHAR_TO_TCHAR(Name.ToWString().c_str());
+		for (auto It = HeaderMap.begin(); It != HeaderMap.end();)
+		{
+			if (NameString.Equals(WCHAR_TO_TCHAR(It->first.ToWString().c_str()), ESearchCase::IgnoreCase))
+			{
+				It = HeaderMap.erase(It);
+			}
+			else
+			{
+				++It;
+			}
+		}
+	}
+}
+
+FCEFResourceRuleSet::FCEFResourceRuleSet(const FWebBrowserResourceRules& InRules)
+	// There is no response to serve for unmatched requests, so they are let through instead
+	: UnmatchedAction(InRules.UnmatchedAction == EWebBrowserResourceRuleAction::Respond ? EWebBrowserResourceRuleAction::Continue : InRules.UnmatchedAction)
+{
+	Rules.Reserve(InRules.Rules.Num());
+	for (const FWebBrowserResourceRule& InRule : InRules.Rules)
+	{
+		FRule& Rule = Rules.AddDefaulted_GetRef();
+		Rule.Action = InRule.Action;
+		Rule.UrlPrefix = InRule.UrlPrefix;
+		if (!InRule.UrlPattern.IsEmpty())
+		{
+			Rule.UrlPattern.Emplace(InRule.UrlPattern);
+		}
+		Rule.ResourceTypeMask = InRule.ResourceTypes.Num() > 0 ? MakeResourceTypeMask(InRule.ResourceTypes) : 0;
+		for (const TPair<FString, FString>& Header : InRule.SetHeaders)
+		{
+			Rule.SetHeaders.Emplace(TCHAR_TO_WCHAR(*Header.Key), TCHAR_TO_WCHAR(*Header.Value));
+		}
+		for (const FString& Header : InRule.RemoveHeaders)
+		{
+			Rule.RemoveHeaders.Emplace(TCHAR_TO_WCHAR(*Header));
+		}
+		Rule.ResponseMimeType = InRule.ResponseMimeType;
+		if (!InRule.ResponseFile.IsEmpty())
+		{
+			Rule.ResponseBody = FCEFResourceBody::FromFile(InRule.ResponseFile);
+		}
+		if (!Rule.ResponseBody.IsValid())
+		{
+			Rule.ResponseBody = FCEFResourceBody::FromString(InRule.ResponseBody);
+		}
+	}
+}
+
+const FCEFResourceRuleSet::FRule* FCEFResourceRuleSet::Match(const FString& Url, CefRequest::ResourceType Type) const
+{
+	const uint64 TypeBit = (Type >= 0 && Type < MaxResourceType) ? uint64(1) << Type : 0;
+	for (const FRule& Rule : Rules)
+	{
+		if (Rule.ResourceTypeMask != 0 && (Rule.ResourceTypeMask & TypeBit) == 0)
+		{
+			continue;
+		}
+		if (!Rule.UrlPrefix.IsEmpty() && !Url.StartsWith(Rule.UrlPrefix))
+		{
+			continue;
+		}
+		if (Rule.UrlPattern.IsSet())
+		{
+			FRegexMatcher Matcher(Rule.UrlPattern.GetValue(), Url);
+			if (!Matcher.FindNext())
+			{
+				continue;
+			}
+		}
+		return &Rule;
+	}
+	return nullptr;
+}
+
+void FCEFResourceRuleSet::ApplyHeaders(const FRule& Rule, CefRequest::HeaderMap& HeaderMap)
+{
+	for (const CefString& Header : Rule.RemoveHeaders)
+	{
+		RemoveHeader(HeaderMap, Header);
+	}
+	for (const TPair<CefString, CefString>& Header : Rule.SetHeaders)
+	{
+		RemoveHeader(HeaderMap, Header.Key);
+		HeaderMap.insert(std::pair<CefString, CefString>(Header.Key, Header.Value));
+	}
+}
+
+void FCEFResourceRuleSet::ApplyHeaders(const FRule& Rule, CefRefPtr<CefRequest> Request)
+{
+	if (Rule.RemoveHeaders.Num() > 0)
+	{
+		CefRequest::HeaderMap HeaderMap;
+		Request->GetHeaderMap(HeaderMap);
+		ApplyHeaders(Rule, HeaderMap);
+		Request->SetHeaderMap(HeaderMap);
+	}
+	else
+	{
+		for (const TPair<CefString, CefString>& Header : Rule.SetHeaders)
+		{
+			Request->SetHeaderByName(Header.Key, Header.Value, true);
+		}
+	}
+}
+
+CefRefPtr<CefResourceHandler> FCEFResourceRuleSet::CreateResponse(const FRule& Rule)
+{
+	return new FCEFBrowserByteResource(Rule.ResponseBody.ToSharedRef(), Rule.ResponseMimeType);
+}
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+#include "IWebBrowserResourceLoader.h"
+#include "Internationalization/Regex.h"
+
+#include "CEFLibCefIncludes.h"
+
+class FCEFResourceBody;
+
+/**
+ * A resource rule set compiled for evaluation on the CEF IO thread.
+ *
+ * Instances are immutable once built, so they can be shared between threads and swapped as a whole.
+ */
+class FCEFResourceRuleSet
+{
+public:
+
+	struct FRule
+	{
+		EWebBrowserResourceRuleAction Action;
+		FString UrlPrefix;
+		TOptional<FRegexPattern> UrlPattern;
+		/** Bit per CefRequest::ResourceType, 0 matches all types. */
+		uint64 ResourceTypeMask;
+		TArray<TPair<CefString, CefString>> SetHeaders;
+		TArray<CefString> RemoveHeaders;
+		FString ResponseMimeType;
+		/** Static response, shared by every request the rule answers. */
+		TSharedPtr<const FCEFResourceBody, ESPMode::ThreadSafe> ResponseBody;
+	};
+
+	FCEFResourceRuleSet(const FWebBrowserResourceRules& InRules);
+
+	/**
+	 * Finds the first rule matching the request.
+	 *
+	 * @param Url The request URL.
+	 * @param Type The request resource type.
+	 * @return The matching rule, or nullptr.
+	 */
+	const FRule* Match(const FString& Url, CefRequest::ResourceType Type) const;
+
+	/** @return what to do with requests matching no rule. */
+	EWebBrowserResourceRuleAction GetUnmatchedAction() const
+	{
+		return UnmatchedAction;
+	}
+
+	/** Applies the header rewrites of a rule. */
+	static void ApplyHeaders(const FRule& Rule, CefRequest::HeaderMap& HeaderMap);
+
+	/** Applies the header rewrites of a rule to a request, only copying its header map out when headers have to be removed. */
+	static void ApplyHeaders(const FRule& Rule, CefRefPtr<CefRequest> Request);
+
+	/** Creates the resource handler serving the static response of a rule. */
+	static CefRefPtr<CefResourceHandler> CreateResponse(const FRule& Rule);
+
+private:
+	TArray<FRule> Rules;
+	EWebBrowserResourceRuleAction UnmatchedAction;
+};
+
+#endif
@@ -4,9 +4,21 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "IWebBrowserSchemeHandler.h"
+#include "WebBrowserStats.h"
 
 #if WITH_CEF3
 
+DECLARE_CYCLE_STAT(TEXT("Scheme Handler Dispatch"), STAT_SchemeHandlerDispatch, STATGROUP_WebBrowser);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheme Handler Domains"), STAT_SchemeHandlerDomains, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheme Handlers Reused"), STAT_SchemeHandlersReused, STATGROUP_WebBrowser);
+
+static int32 SchemeHandlerPoolSize = 64;
+static FAutoConsoleVariableRef CVarSchemeHandlerPoolSize(
+	TEXT("webbrowser.SchemeHandlerPoolSize"),
+	SchemeHandlerPoolSize,
+	TEXT("Number of released scheme handler wrappers each factory keeps for reuse.\n"),
+	ECVF_Default);
+
 class FHandlerHeaderSetter
 	: public IWebBrowserSchemeHandler::IHeaders
 {
@@ -79,19 +91,51 @@ private:
 	int32 StatusCode;
 };
 
+class FCefSchemeHandlerFactory;
+
+/**
+ * Wraps a handler implementation for CEF. Instead of being deleted once CEF releases it, it goes back to the factory that
+ * created it to serve a later request.
+ */
 class FCefSchemeHandler
 	: public CefResourceHandler
 {
 public:
-	FCefSchemeHandler(TUniquePtr<IWebBrowserSchemeHandler>&& InHandlerImplementation)
-		: HandlerImplementation(MoveTemp(InHandlerImplementation))
+	FCefSchemeHandler();
+	virtual ~FCefSchemeHandler();
+
+	/** Prepares the handler to serve a request. */
+	void Init(CefRefPtr<FCefSchemeHandlerFactory> InFactory, TUniquePtr<IWebBrowserSchemeHandler>&& InHandlerImplementation);
+
+	/** Takes the implementation back from a handler that is done. */
+	TUniquePtr<IWebBrowserSchemeHandler> TakeImplementation()
 	{
+		if (HandlerImplementation.IsValid())
+		{
+			HandlerImplementation->InvalidatePendingRead();
+		}
+		return MoveTemp(HandlerImplementation);
 	}
 
-	virtual ~FCefSchemeHandler()
+	// Begin CefBaseRefCounted interface.
+	virtual void AddRef() const override
 	{
+		RefCount.AddRef();
 	}
 
+	virtual bool Release() const override;
+
+	virtual bool HasOneRef() const override
+	{
+		return RefCount.HasOneRef();
+	}
+
+	virtual bool HasAtLeastOneRef() const override
+	{
+		return RefCount.HasAtLeastOneRef();
+	}
+	// End CefBaseRefCounted interface.
+
 	// Begin CefResourceHandler interface.
 	virtual bool ProcessRequest(CefRefPtr<CefRequest> Request, CefRefPtr<CefCallback> Callback) override
 	{
@@ -121,16 +165,20 @@ public:
 		}
 	}
 
-	virtual bool ReadResponse(void* DataOut, int BytesToRead, int& BytesRead, CefRefPtr<CefCallback> Callback) override
+	virtual bool Read(void* DataOut, int BytesToRead, int& BytesRead, CefRefPtr<CefResourceReadCallback> Callback) override
 	{
+		// Reads may complete later, off the IO thread, so a handler streaming from disk never blocks it
 		if (ensure(HandlerImplementation.IsValid()))
 		{
-			return HandlerImplementation->ReadResponse(
-				(uint8*)DataOut, 
+			int32 ImplementationBytesRead = 0;
+			const bool bMoreData = HandlerImplementation->ReadResponseAsync(
+				(uint8*)DataOut,
 				BytesToRead,
-				BytesRead,
-				FSimpleDelegate::CreateLambda([Callback](){ Callback->Continue(); })
+				ImplementationBytesRead,
+				IWebBrowserSchemeHandler::FOnResponseRead::CreateLambda([Callback](int32 CompletedBytesRead){ Callback->Continue(CompletedBytesRead); })
 			);
+			BytesRead = bMoreData ? ImplementationBytesRead : 0;
+			return bMoreData;
 		}
 		BytesRead = 0;
 		return false;
@@ -140,16 +188,18 @@ public:
 	{
 		if (HandlerImplementation.IsValid())
 		{
+			HandlerImplementation->InvalidatePendingRead();
 			HandlerImplementation->Cancel();
 		}
 	}
 	// End CefResourceHandler interface.
 
 private:
+	CefRefPtr<FCefSchemeHandlerFactory> Factory;
 	TUniquePtr<IWebBrowserSchemeHandler> HandlerImplementation;
 
-	// Include CEF ref counting.
-	IMPLEMENT_REFCOUNTING(FCefSchemeHandler);
+	// Reference counting is implemented by hand, so the handler can be recycled instead of deleted.
+	CefRefCount RefCount;
 };
 
 
@@ -160,63 +210,400 @@ public:
 
 	FCefSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* InWebBrowserSchemeHandlerFactory)
 		: WebBrowserSchemeHandlerFactory(InWebBrowserSchemeHandlerFactory)
+		, bDetached(false)
 	{
 	}
 
+	virtual ~FCefSchemeHandlerFactory()
+	{
+		for (FCefSchemeHandler* Handler : FreeHandlers)
+		{
+			delete Handler;
+		}
+	}
+
 	// Begin CefSchemeHandlerFactory interface.
 	virtual CefRefPtr<CefResourceHandler> Create(CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, const CefString& Scheme, CefRefPtr<CefRequest> Request) override
 	{
-		return new FCefSchemeHandler(WebBrowserSchemeHandlerFactory->Create(
+		TUniquePtr<IWebBrowserSchemeHandler> HandlerImplementation = WebBrowserSchemeHandlerFactory->Create(
 			WCHAR_TO_TCHAR(Request->GetMethod().ToWString().c_str()),
-			WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str())));
+			WCHAR_TO_TCHAR(Request->GetURL().ToWString().c_str()));
+
+		FCefSchemeHandler* Handler = nullptr;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (FreeHandlers.Num() > 0)
+			{
+				Handler = FreeHandlers.Pop(EAllowShrinking::No);
+				INC_DWORD_STAT(STAT_SchemeHandlersReused);
+			}
+		}
+		if (Handler == nullptr)
+		{
+			Handler = new FCefSchemeHandler();
+		}
+		Handler->Init(this, MoveTemp(HandlerImplementation));
+		return Handler;
 	}
 	// End CefSchemeHandlerFactory interface.
 
-	bool IsUsing(IWebBrowserSchemeHandlerFactory* InWebBrowserSchemeHandlerFactory)
+	/** Stops handing finished handler implementations back to the factory, which may be destroyed once unregistered. */
+	void Detach()
 	{
-		return WebBrowserSchemeHandlerFactory == InWebBrowserSchemeHandlerFactory;
+		FScopeLock Lock(&CriticalSection);
+		bDetached = true;
+	}
+
+	/** Takes back a handler CEF released. */
+	void Recycle(FCefSchemeHandler* Handler)
+	{
+		TUniquePtr<IWebBrowserSchemeHandler> HandlerImplementation = Handler->TakeImplementation();
+		FScopeLock Lock(&CriticalSection);
+		if (HandlerImplementation.IsValid() && !bDetached)
+		{
+			WebBrowserSchemeHandlerFactory->RecycleHandler(MoveTemp(HandlerImplementation));
+		}
+		if (FreeHandlers.Num() < FMath::Max(SchemeHandlerPoolSize, 0))
+		{
+			FreeHandlers.Add(Handler);
+		}
+		else
+		{
+			delete Handler;
+		}
 	}
 
 private:
 	IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory;
 
+	/** Handlers ready to serve another request. */
+	TArray<FCefSchemeHandler*> FreeHandlers;
+
+	/** Set once the factory was unregistered. */
+	bool bDetached;
+
+	FCriticalSection CriticalSection;
+
 	// Include CEF ref counting.
 	IMPLEMENT_REFCOUNTING(FCefSchemeHandlerFactory);
 };
 
+FCefSchemeHandler::FCefSchemeHandler()
+{
+}
+
+FCefSchemeHandler::~FCefSchemeHandler()
+{
+}
+
+void FCefSchemeHandler::Init(CefRefPtr<FCefSchemeHandlerFactory> InFactory, TUniquePtr<IWebBrowserSchemeHandler>&& InHandlerImplementation)
+{
+	Factory = MoveTemp(InFactory);
+	HandlerImplementation = MoveTemp(InHandlerImplementation);
+}
+
+bool FCefSchemeHandler::Release() const
+{
+	if (RefCount.Release())
+	{
+		// The factory may go away along with the last handler referencing it, taking its free handlers (this one included) with it
+		FCefSchemeHandler* MutableThis = const_cast<FCefSchemeHandler*>(this);
+		CefRefPtr<FCefSchemeHandlerFactory> OwningFactory = MoveTemp(MutableThis->Factory);
+		OwningFactory->Recycle(MutableThis);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * The factory CEF sees for a scheme, forwarding each request to the factory registered for its domain.
+ */
+class FCefSchemeHandlerDispatcher
+	: public CefSchemeHandlerFactory
+{
+public:
+
+	FCefSchemeHandlerDispatcher(const TSharedRef<FCefSchemeHandlerFactories::FTable, ESPMode::ThreadSafe>& InTable, const FString& InScheme)
+		: Table(InTable)
+		, Scheme(InScheme)
+	{
+	}
+
+	// Begin CefSchemeHandlerFactory interface.
+	virtual CefRefPtr<CefResourceHandler> Create(CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, const CefString& SchemeName, CefRefPtr<CefRequest> Request) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SchemeHandlerDispatch);
+		return Table->Create(Scheme, Browser, Frame, SchemeName, Request);
+	}
+	// End CefSchemeHandlerFactory interface.
+
+private:
+	TSharedRef<FCefSchemeHandlerFactories::FTable, ESPMode::ThreadSafe> Table;
+	FString Scheme;
+
+	// Include CEF ref counting.
+	IMPLEMENT_REFCOUNTING(FCefSchemeHandlerDispatcher);
+};
+
+namespace
+{
+	/** Schemes for which CEF honours the domain of a registration. */
+	bool IsBuiltInScheme(const FString& Scheme)
+	{
+		static const TSet<FString> BuiltInSchemes = { TEXT("http"), TEXT("https"), TEXT("ws"), TEXT("wss"), TEXT("ftp"), TEXT("file"), TEXT("data"), TEXT("about"), TEXT("blob"), TEXT("filesystem") };
+		return BuiltInSchemes.Contains(Scheme);
+	}
+
+	/** Wildcard domains are stored as "*.domain", the scheme wide domain as "". */
+	FString MakeDomainKey(const FString& Domain)
+	{
+		FString DomainKey = Domain.ToLower();
+		if (DomainKey == TEXT("*"))
+		{
+			DomainKey.Reset();
+		}
+		return DomainKey;
+	}
+
+	bool IsWildcardDomain(const FString& DomainKey)
+	{
+		return DomainKey.StartsWith(TEXT("*."), ESearchCase::CaseSensitive);
+	}
+}
+
+FCefSchemeHandlerFactories::FCefSchemeHandlerFactories()
+	: Table(MakeShared<FTable, ESPMode::ThreadSafe>())
+{
+}
+
 void FCefSchemeHandlerFactories::AddSchemeHandlerFactory(FString Scheme, FString Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
+{
+	AddSchemeHandlerFactories(MoveTemp(Scheme), { MoveTemp(Domain) }, WebBrowserSchemeHandlerFactory);
+}
+
+void FCefSchemeHandlerFactories::AddSchemeHandlerFactories(FString Scheme, const TArray<FString>& Domains, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
 {
 	checkf(WebBrowserSchemeHandlerFactory != nullptr, TEXT("WebBrowserSchemeHandlerFactory must be provided."));
-	CefRefPtr<CefSchemeHandlerFactory> Factory = new FCefSchemeHandlerFactory(WebBrowserSchemeHandlerFactory);
-	CefRegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*Scheme), TCHAR_TO_WCHAR(*Domain), Factory);
-	SchemeHandlerFactories.Emplace(MoveTemp(Scheme), MoveTemp(Domain), MoveTemp(Factory));
+	const FString SchemeKey = Scheme.ToLower();
+	CefRefPtr<CefSchemeHandlerFactory> NewDispatcher;
+	{
+		FWriteScopeLock WriteLock(Table->Lock);
+		for (const FString& Domain : Domains)
+		{
+			CefRefPtr<CefSchemeHandlerFactory> Dispatcher = AddLocked(SchemeKey, MakeDomainKey(Domain), WebBrowserSchemeHandlerFactory);
+			if (Dispatcher)
+			{
+				NewDispatcher = Dispatcher;
+			}
+		}
+	}
+
+	// Only a scheme seen for the first time has to be handed to CEF, new domains are picked up by its dispatcher
+	if (NewDispatcher)
+	{
+		RegisterScheme(SchemeKey, NewDispatcher);
+	}
+}
+
+CefRefPtr<CefSchemeHandlerFactory> FCefSchemeHandlerFactories::AddLocked(const FString& Scheme, const FString& Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
+{
+	FTable::FRegistration& Registration = Table->Registrations.FindOrAdd(WebBrowserSchemeHandlerFactory);
+	if (!Registration.Factory)
+	{
+		Registration.Factory = new FCefSchemeHandlerFactory(WebBrowserSchemeHandlerFactory);
+	}
+	Registration.Keys.Emplace(Scheme, Domain);
+	const CefRefPtr<CefSchemeHandlerFactory>& Factory = Registration.Factory;
+
+	FTable::FScheme& SchemeEntry = Table->Schemes.FindOrAdd(Scheme);
+	CefRefPtr<CefSchemeHandlerFactory>* Existing = SchemeEntry.Domains.Find(Domain);
+	if (Existing)
+	{
+		// Like CEF, a later registration for the same scheme and domain replaces the earlier one
+		*Existing = Factory;
+	}
+	else
+	{
+		SchemeEntry.Domains.Add(Domain, Factory);
+		SchemeEntry.NumWildcards += IsWildcardDomain(Domain) ? 1 : 0;
+		INC_DWORD_STAT(STAT_SchemeHandlerDomains);
+	}
+	SchemeEntry.LastAdded = Factory;
+
+	if (!SchemeEntry.Dispatcher)
+	{
+		SchemeEntry.Dispatcher = new FCefSchemeHandlerDispatcher(Table, Scheme);
+		return SchemeEntry.Dispatcher;
+	}
+	return nullptr;
+}
+
+void FCefSchemeHandlerFactories::RegisterScheme(const FString& Scheme, CefRefPtr<CefSchemeHandlerFactory> Dispatcher)
+{
+	// The dispatcher resolves the domain itself, so it is registered for all of them
+	CefRegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*Scheme), CefString(), Dispatcher);
+	for (CefRefPtr<CefRequestContext>& Context : Contexts)
+	{
+		Context->RegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*Scheme), CefString(), Dispatcher);
+	}
 }
 
 void FCefSchemeHandlerFactories::RemoveSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
 {
 	checkf(WebBrowserSchemeHandlerFactory != nullptr, TEXT("WebBrowserSchemeHandlerFactory must be provided."));
-	SchemeHandlerFactories.RemoveAll([WebBrowserSchemeHandlerFactory](const FFactory& Element)
+	TArray<FString> EmptySchemes;
 	{
-		return ((FCefSchemeHandlerFactory*)Element.Factory.get())->IsUsing(WebBrowserSchemeHandlerFactory);
-	});
+		// Waits for any handler being created by the factory, so the caller may destroy it once this returns
+		FWriteScopeLock WriteLock(Table->Lock);
+		FTable::FRegistration Registration;
+		if (!Table->Registrations.RemoveAndCopyValue(WebBrowserSchemeHandlerFactory, Registration))
+		{
+			return;
+		}
+		static_cast<FCefSchemeHandlerFactory*>(Registration.Factory.get())->Detach();
+
+		for (const TPair<FString, FString>& Key : Registration.Keys)
+		{
+			FTable::FScheme* SchemeEntry = Table->Schemes.Find(Key.Key);
+			if (SchemeEntry == nullptr)
+			{
+				continue;
+			}
+
+			// The domain may have been taken over by a later registration of another factory
+			const CefRefPtr<CefSchemeHandlerFactory>* Factory = SchemeEntry->Domains.Find(Key.Value);
+			if (Factory && Factory->get() == Registration.Factory.get())
+			{
+				SchemeEntry->Domains.Remove(Key.Value);
+				SchemeEntry->NumWildcards -= IsWildcardDomain(Key.Value) ? 1 : 0;
+				DEC_DWORD_STAT(STAT_SchemeHandlerDomains);
+			}
+			if (SchemeEntry->LastAdded.get() == Registration.Factory.get())
+			{
+				SchemeEntry->LastAdded = nullptr;
+				for (const TPair<FString, CefRefPtr<CefSchemeHandlerFactory>>& Domain : SchemeEntry->Domains)
+				{
+					SchemeEntry->LastAdded = Domain.Value;
+					break;
+				}
+			}
+			if (SchemeEntry->Domains.IsEmpty())
+			{
+				Table->Schemes.Remove(Key.Key);
+				EmptySchemes.Add(Key.Key);
+			}
+		}
+	}
+
+	// Stop routing every request of a scheme nothing handles anymore through a dispatcher
+	for (const FString& Scheme : EmptySchemes)
+	{
+		CefRegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*Scheme), CefString(), nullptr);
+		for (CefRefPtr<CefRequestContext>& Context : Contexts)
+		{
+			Context->RegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*Scheme), CefString(), nullptr);
+		}
+	}
 }
 
 void FCefSchemeHandlerFactories::RegisterFactoriesWith(CefRefPtr<CefRequestContext>& Context)
 {
 	if (Context)
 	{
-		for (const FFactory& SchemeHandlerFactory : SchemeHandlerFactories)
+		const bool bRegistered = Contexts.ContainsByPredicate([&Context](const CefRefPtr<CefRequestContext>& Element)
+		{
+			return Element->IsSame(Context);
+		});
+		if (bRegistered)
 		{
-			Context->RegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*SchemeHandlerFactory.Scheme), TCHAR_TO_WCHAR(*SchemeHandlerFactory.Domain), SchemeHandlerFactory.Factory);
+			return;
 		}
+		Contexts.Add(Context);
+
+		// The table is only written on this thread, so it can be read without the lock
+		for (const TPair<FString, FTable::FScheme>& SchemeEntry : Table->Schemes)
+		{
+			Context->RegisterSchemeHandlerFactory(TCHAR_TO_WCHAR(*SchemeEntry.Key), CefString(), SchemeEntry.Value.Dispatcher);
+		}
+	}
+}
+
+void FCefSchemeHandlerFactories::UnregisterFactoriesWith(CefRefPtr<CefRequestContext>& Context)
+{
+	if (Context)
+	{
+		Contexts.RemoveAll([&Context](const CefRefPtr<CefRequestContext>& Element)
+		{
+			return Element->IsSame(Context);
+		});
+		Context->ClearSchemeHandlerFactories();
+	}
+}
+
+void FCefSchemeHandlerFactories::Reset()
+{
+	CefClearSchemeHandlerFactories();
+	for (CefRefPtr<CefRequestContext>& Context : Contexts)
+	{
+		Context->ClearSchemeHandlerFactories();
 	}
+	Contexts.Reset();
+
+	FWriteScopeLock WriteLock(Table->Lock);
+	for (const TPair<IWebBrowserSchemeHandlerFactory*, FTable::FRegistration>& Registration : Table->Registrations)
+	{
+		static_cast<FCefSchemeHandlerFactory*>(Registration.Value.Factory.get())->Detach();
+	}
+	Table->Schemes.Reset();
+	Table->Registrations.Reset();
+	SET_DWORD_STAT(STAT_SchemeHandlerDomains, 0);
 }
 
-FCefSchemeHandlerFactories::FFactory::FFactory(FString InScheme, FString InDomain, CefRefPtr<CefSchemeHandlerFactory> InFactory)
-	: Scheme(MoveTemp(InScheme))
-	, Domain(MoveTemp(InDomain))
-	, Factory(MoveTemp(InFactory))
+CefRefPtr<CefResourceHandler> FCefSchemeHandlerFactories::FTable::Create(const FString& Scheme, CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, const CefString& SchemeName, CefRefPtr<CefRequest> Request)
 {
+	FString Host;
+	CefURLParts UrlParts;
+	if (CefParseURL(Request->GetURL(), UrlParts))
+	{
+		Host = WCHAR_TO_TCHAR(CefString(&UrlParts.host).ToWString().c_str());
+		Host.ToLowerInline();
+	}
+
+	// The lock is held while the factory creates the handler, see RemoveSchemeHandlerFactory
+	FReadScopeLock ReadLock(Lock);
+	const FScheme* SchemeEntry = Schemes.Find(Scheme);
+	if (SchemeEntry == nullptr)
+	{
+		return nullptr;
+	}
+
+	const CefRefPtr<CefSchemeHandlerFactory>* Factory = nullptr;
+	if (!Host.IsEmpty())
+	{
+		Factory = SchemeEntry->Domains.Find(Host);
+		// Walk up the parent domains, "a.b.c" tries "*.b.c" then "*.c"
+		for (int32 DotIndex = Host.Find(TEXT("."), ESearchCase::CaseSensitive); Factory == nullptr && SchemeEntry->NumWildcards > 0 && DotIndex != INDEX_NONE;
+			DotIndex = Host.Find(TEXT("."), ESearchCase::CaseSensitive, ESearchDir::FromStart, DotIndex + 1))
+		{
+			Factory = SchemeEntry->Domains.Find(TEXT("*") + Host.RightChop(DotIndex));
+		}
+	}
+	if (Factory == nullptr)
+	{
+		Factory = SchemeEntry->Domains.Find(FString());
+	}
+	if (Factory == nullptr && !IsBuiltInScheme(Scheme))
+	{
+		// CEF ignores the domain of custom schemes, so any registration for the scheme handles the request
+		Factory = SchemeEntry->LastAdded ? &SchemeEntry->LastAdded : nullptr;
+	}
+
+	if (Factory == nullptr)
+	{
+		// Returning nothing lets CEF handle the request as if no factory was registered
+		return nullptr;
+	}
+	return (*Factory)->Create(Browser, Frame, SchemeName, Request);
 }
 
 #endif
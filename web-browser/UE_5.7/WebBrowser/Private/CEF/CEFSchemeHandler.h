@@ -4,52 +4,122 @@
 
 #include "CoreMinimal.h"
 #include "IWebBrowserSchemeHandler.h"
+#include "Misc/ScopeRWLock.h"
 
 #if WITH_CEF3
 #include "CEFLibCefIncludes.h"
 
 /**
  * Implementation for managing CEF custom scheme handlers.
+ *
+ * Factories are kept in a table indexed by scheme and domain. CEF only sees one dispatching factory per scheme, which
+ * resolves each request's host against the table, so adding or removing a domain never touches the request contexts.
  */
 class FCefSchemeHandlerFactories
 {
 public:
+	FCefSchemeHandlerFactories();
+
 	/**
 	 * Adds a custom scheme handler factory, for a given scheme and domain. The domain is ignored if the scheme is not a browser built in scheme,
 	 * and all requests will go through this factory.
 	 * @param Scheme                            The scheme name to handle.
 	 * @param Domain                            The domain name to handle on the scheme. Ignored if scheme is not a built in scheme.
+	 *                                          "*.example.com" matches every subdomain of example.com, empty or "*" matches every domain.
 	 * @param WebBrowserSchemeHandlerFactory    The factory implementation for creating request handlers for this scheme.
 	 */
 	void AddSchemeHandlerFactory(FString Scheme, FString Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory);
 
 	/**
-	 * Remove a custom scheme handler factory. The factory may still be used by existing open browser windows, but will no longer be provided for new ones.
+	 * Adds a custom scheme handler factory for many domains of a scheme at once.
+	 * @param Scheme                            The scheme name to handle.
+	 * @param Domains                           The domain names to handle on the scheme, see AddSchemeHandlerFactory.
+	 * @param WebBrowserSchemeHandlerFactory    The factory implementation for creating request handlers for this scheme.
+	 */
+	void AddSchemeHandlerFactories(FString Scheme, const TArray<FString>& Domains, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory);
+
+	/**
+	 * Remove a custom scheme handler factory. Requests that already created a handler complete, no new requests will use the factory once this returns.
 	 * @param WebBrowserSchemeHandlerFactory    The factory implementation to remove.
 	 */
 	void RemoveSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory);
 
 	/**
-	 * Register all scheme handler factories with the provided request context.
+	 * Register all scheme handler factories with the provided request context. Registering a context more than once does nothing.
 	 * @param Context   The context.
 	 */
 	void RegisterFactoriesWith(CefRefPtr<CefRequestContext>& Context);
 
+	/**
+	 * Remove all scheme handler factories from the provided request context.
+	 * @param Context   The context.
+	 */
+	void UnregisterFactoriesWith(CefRefPtr<CefRequestContext>& Context);
+
+	/**
+	 * Remove all scheme handler factories from CEF and from every registered request context.
+	 */
+	void Reset();
+
 private:
+	friend class FCefSchemeHandlerDispatcher;
+
 	/**
-	 * A struct to wrap storage of a factory with it's provided scheme and domain, inc ref counting for the cef representation.
+	 * The factory table, shared with the dispatching factories which read it on the CEF IO thread.
 	 */
-	struct FFactory
+	class FTable
 	{
 	public:
-		FFactory(FString Scheme, FString Domain, CefRefPtr<CefSchemeHandlerFactory> Factory);
-		FString Scheme;
-		FString Domain;
-		CefRefPtr<CefSchemeHandlerFactory> Factory;
+		/**
+		 * Creates a request handler using the factory registered for the scheme and the host of the url.
+		 * Exact domains take precedence over wildcard domains, the most specific wildcard wins.
+		 */
+		CefRefPtr<CefResourceHandler> Create(const FString& Scheme, CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, const CefString& SchemeName, CefRefPtr<CefRequest> Request);
+
+		struct FScheme
+		{
+			/** Factories indexed by domain, wildcard domains are stored as "*.domain" and the scheme wide factory as "". */
+			TMap<FString, CefRefPtr<CefSchemeHandlerFactory>> Domains;
+
+			/** The last factory added for the scheme, used for schemes where CEF ignores the domain. */
+			CefRefPtr<CefSchemeHandlerFactory> LastAdded;
+
+			/** The factory CEF knows about for this scheme. */
+			CefRefPtr<CefSchemeHandlerFactory> Dispatcher;
+
+			/** Number of wildcard domains, the host's parent domains are only looked up when there are some. */
+			int32 NumWildcards = 0;
+		};
+
+		/** Schemes indexed by their name. */
+		TMap<FString, FScheme> Schemes;
+
+		struct FRegistration
+		{
+			/** The CEF side of the factory, shared by all its domains along with its pool of handlers. */
+			CefRefPtr<CefSchemeHandlerFactory> Factory;
+
+			/** Scheme and domain pairs of the factory, so it can be removed without searching every scheme. */
+			TArray<TPair<FString, FString>> Keys;
+		};
+
+		/** Registrations indexed by factory. */
+		TMap<IWebBrowserSchemeHandlerFactory*, FRegistration> Registrations;
+
+		/** Taken for reading on the IO thread while a factory creates a handler, for writing on the game thread. */
+		FRWLock Lock;
 	};
 
-	// Array of registered handler factories.
-	TArray<FFactory> SchemeHandlerFactories;
+	/** Adds a factory under the table lock, returning the dispatcher of a scheme seen for the first time. */
+	CefRefPtr<CefSchemeHandlerFactory> AddLocked(const FString& Scheme, const FString& Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory);
+
+	/** Hands a newly added scheme to CEF, globally and for every registered request context. */
+	void RegisterScheme(const FString& Scheme, CefRefPtr<CefSchemeHandlerFactory> Dispatcher);
+
+	TSharedRef<FTable, ESPMode::ThreadSafe> Table;
+
+	// Request contexts the dispatchers are registered with.
+	TArray<CefRefPtr<CefRequestContext>> Contexts;
 };
 
 
@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFTextureUploadScheduler.h"
+
+#if WITH_CEF3
+
+#include "HAL/IConsoleManager.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Budgeted Bytes Uploaded"), STAT_CEFBudgetedBytesUploaded, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Uploads Deferred"), STAT_CEFUploadsDeferred, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Uploads Coalesced"), STAT_CEFUploadsCoalesced, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Deferred Uploads Drained"), STAT_CEFDeferredUploadsDrained, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Deferred Uploads Forced"), STAT_CEFDeferredUploadsForced, STATGROUP_WebBrowser);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CEF Upload Queue Length"), STAT_CEFUploadQueueLength, STATGROUP_WebBrowser);
+
+static int32 CEFUploadBudgetBytesPerFrame = 0;
+static FAutoConsoleVariableRef CVarCEFUploadBudgetBytesPerFrame(
+	TEXT("webbrowser.Upload.BudgetBytesPerFrame"),
+	CEFUploadBudgetBytesPerFrame,
+	TEXT("Maximum bytes uploaded to browser textures per frame across all browsers, paints over the budget are deferred to later frames (0 = unlimited)\n"),
+	ECVF_Default);
+
+static int32 CEFUploadMaxDeferFrames = 4;
+static FAutoConsoleVariableRef CVarCEFUploadMaxDeferFrames(
+	TEXT("webbrowser.Upload.MaxDeferFrames"),
+	CEFUploadMaxDeferFrames,
+	TEXT("Number of frames a deferred upload can wait for budget before it is uploaded regardless\n"),
+	ECVF_Default);
+
+FCEFTextureUploadScheduler::FCEFTextureUploadScheduler()
+	: FrameNumber(0)
+	, FrameBytes(0)
+{
+}
+
+bool FCEFTextureUploadScheduler::IsEnabled()
+{
+	return CEFUploadBudgetBytesPerFrame > 0;
+}
+
+bool FCEFTextureUploadScheduler::TryReserve(uint64 NumBytes)
+{
+	if (IsEnabled() && FrameBytes > 0 && FrameBytes + NumBytes > static_cast<uint64>(CEFUploadBudgetBytesPerFrame))
+	{
+		return false;
+	}
+
+	FrameBytes += NumBytes;
+	INC_DWORD_STAT_BY(STAT_CEFBudgetedBytesUploaded, NumBytes);
+	return true;
+}
+
+void FCEFTextureUploadScheduler::Submit(const TSharedRef<ICEFDeferredUploadTarget>& Target, CefRenderHandler::PaintElementType PaintType, ECEFUploadPriority Priority, uint64 NumBytes)
+{
+	for (FJob& Job : Jobs)
+	{
+		if (Job.PaintType == PaintType && Job.Target.HasSameObject(&Target.Get()))
+		{
+			// The window merged the paint into its deferred frame, a single upload still covers both
+			Job.Priority = FMath::Min(Job.Priority, Priority);
+			Job.NumBytes = NumBytes;
+			INC_DWORD_STAT(STAT_CEFUploadsCoalesced);
+			return;
+		}
+	}
+
+	Jobs.Add(FJob{ Target, PaintType, Priority, NumBytes, FrameNumber });
+	INC_DWORD_STAT(STAT_CEFUploadsDeferred);
+	SET_DWORD_STAT(STAT_CEFUploadQueueLength, Jobs.Num());
+}
+
+void FCEFTextureUploadScheduler::BeginFrame()
+{
+	++FrameNumber;
+	FrameBytes = 0;
+
+	if (Jobs.Num() == 0)
+	{
+		return;
+	}
+
+	// Most urgent first, then oldest first. The stable sort keeps submission order between equal jobs.
+	DrainJobs = MoveTemp(Jobs);
+	Jobs.Reset();
+	DrainJobs.StableSort([](const FJob& A, const FJob& B)
+	{
+		return A.Priority != B.Priority ? A.Priority < B.Priority : A.QueuedFrame < B.QueuedFrame;
+	});
+
+	const uint64 MaxDeferFrames = static_cast<uint64>(FMath::Max(CEFUploadMaxDeferFrames, 0));
+	for (const FJob& Job : DrainJobs)
+	{
+		TSharedPtr<ICEFDeferredUploadTarget> Target = Job.Target.Pin();
+		if (!Target.IsValid())
+		{
+			continue;
+		}
+
+		const bool bIsOverdue = FrameNumber - Job.QueuedFrame > MaxDeferFrames;
+		if (!bIsOverdue && !TryReserve(Job.NumBytes))
+		{
+			Jobs.Add(Job);
+			continue;
+		}
+
+		if (bIsOverdue)
+		{
+			FrameBytes += Job.NumBytes;
+			INC_DWORD_STAT_BY(STAT_CEFBudgetedBytesUploaded, Job.NumBytes);
+			INC_DWORD_STAT(STAT_CEFDeferredUploadsForced);
+		}
+		Target->FlushDeferredUpload(Job.PaintType);
+		INC_DWORD_STAT(STAT_CEFDeferredUploadsDrained);
+	}
+	DrainJobs.Reset();
+
+	SET_DWORD_STAT(STAT_CEFUploadQueueLength, Jobs.Num());
+}
+
+void FCEFTextureUploadScheduler::Reset()
+{
+	Jobs.Reset();
+	SET_DWORD_STAT(STAT_CEFUploadQueueLength, 0);
+}
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+#include "CEFLibCefIncludes.h"
+
+/**
+ * Order in which deferred uploads are drained, most urgent first.
+ */
+enum class ECEFUploadPriority : uint8
+{
+	/** The browser has keyboard focus. */
+	Focused = 0,
+
+	/** The browser is shown. */
+	Visible = 1,
+
+	/** The browser is hidden or occluded, but still painting. */
+	Background = 2,
+};
+
+/**
+ * Keeps the paints FCEFTextureUploadScheduler deferred until it drains them. Implemented by FCEFWebBrowserWindow.
+ */
+class ICEFDeferredUploadTarget
+{
+public:
+	virtual ~ICEFDeferredUploadTarget() = default;
+
+	/** Uploads the paints of the element deferred since the last flush. */
+	virtual void FlushDeferredUpload(CefRenderHandler::PaintElementType Type) = 0;
+};
+
+/**
+ * Limits the bytes uploaded to browser textures per frame, across all browser windows.
+ *
+ * A paint is uploaded right away while it fits in the budget of the current frame, set with webbrowser.Upload.BudgetBytesPerFrame.
+ * Otherwise the window keeps a copy of the frame and submits an upload job, which is drained on a later frame by priority,
+ * then by age. Later paints of the same window are merged into its pending job rather than queued behind it. Jobs waiting for
+ * more than webbrowser.Upload.MaxDeferFrames frames are uploaded regardless of the budget. All methods are called on the game thread.
+ */
+class FCEFTextureUploadScheduler
+	: public TSharedFromThis<FCEFTextureUploadScheduler, ESPMode::ThreadSafe>
+{
+public:
+	FCEFTextureUploadScheduler();
+
+	/** @return whether uploads are budgeted. When they are not, windows upload every paint right away. */
+	static bool IsEnabled();
+
+	/**
+	 * Consumes part of the budget of the current frame for an upload done right away.
+	 * The first upload of a frame always fits, so frames larger than the budget are not deferred forever.
+	 *
+	 * @param NumBytes The bytes the upload will transfer.
+	 * @return whether the upload fits in the budget. If not, the paint should be deferred with Submit.
+	 */
+	bool TryReserve(uint64 NumBytes);
+
+	/**
+	 * Queues the deferred upload of a window paint, or updates the job already queued for it.
+	 *
+	 * @param Target The window holding the deferred frame, uploaded with FlushDeferredUpload.
+	 * @param PaintType The paint element the frame belongs to.
+	 * @param Priority The priority of the upload. A merged job keeps the highest priority it was submitted with.
+	 * @param NumBytes The bytes the upload will transfer.
+	 */
+	void Submit(const TSharedRef<ICEFDeferredUploadTarget>& Target, CefRenderHandler::PaintElementType PaintType, ECEFUploadPriority Priority, uint64 NumBytes);
+
+	/** Starts a new frame, draining the queued uploads that fit in its budget. Called once per engine tick, before CEF paints. */
+	void BeginFrame();
+
+	/** Drops every queued upload. The windows keep their deferred frames until their next paint. */
+	void Reset();
+
+	/** @return the number of uploads waiting for budget. */
+	int32 GetNumQueued() const
+	{
+		return Jobs.Num();
+	}
+
+private:
+	struct FJob
+	{
+		TWeakPtr<ICEFDeferredUploadTarget> Target;
+		CefRenderHandler::PaintElementType PaintType;
+		ECEFUploadPriority Priority;
+		uint64 NumBytes;
+
+		/** Frame the job was first queued on. Merged paints don't move it, so a window repainting every frame still ages. */
+		uint64 QueuedFrame;
+	};
+
+	/** Queued uploads, in submission order. */
+	TArray<FJob> Jobs;
+
+	/** Scratch array the jobs are sorted into while draining. */
+	TArray<FJob> DrainJobs;
+
+	/** Number of frames started. */
+	uint64 FrameNumber;
+
+	/** Bytes uploaded during the current frame. */
+	uint64 FrameBytes;
+};
+
+#endif
@@ -18,8 +18,17 @@
 #include "CEFJSScripting.h"
 #include "CEFImeHandler.h"
 #include "CEFWebBrowserWindowRHIHelper.h"
+#include "CEFWebBrowserWindowRegistry.h"
+#include "CEFMessagePumpScheduler.h"
 #include "CEF3Utils.h"
 #include "Async/Async.h"
+#include "WebBrowserStats.h"
+
+#if WITH_ENGINE
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "Slate/SlateTextures.h"
+#endif
 
 #if PLATFORM_MAC
 // Needed for character code definitions
@@ -236,13 +245,6 @@ enum KeyboardCode {
 
 #endif
 
-#if PLATFORM_MAC
-// enable buffered video so we don't DoS the OpenGL API with texture uploads causing a downstream crash on macOS
-#define USE_BUFFERED_VIDEO 1
-#else
-#define USE_BUFFERED_VIDEO 0
-#endif
-
 #define UE_CEF_HAS_RESIZE_BUG (CEF_VERSION_MAJOR >= 128)
 
 namespace {
@@ -267,19 +269,71 @@ namespace {
 }
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Buffered Video Dropped Frames"), STAT_CEFBufferedVideoDroppedFrames, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Buffered Video Late Frames"), STAT_CEFBufferedVideoLateFrames, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Buffered Video Duplicate Frames"), STAT_CEFBufferedVideoDuplicateFrames, STATGROUP_WebBrowser);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CEF Idle Frame Rate Windows"), STAT_CEFIdleFrameRateWindows, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Frame Rate Changes"), STAT_CEFFrameRateChanges, STATGROUP_WebBrowser);
+
+static float CEFIdleFrameRateDelaySeconds = 5.0f;
+static FAutoConsoleVariableRef CVarCEFIdleFrameRateDelaySeconds(
+	TEXT("webbrowser.IdleFrameRateDelaySeconds"),
+	CEFIdleFrameRateDelaySeconds,
+	TEXT("Visible browsers without keyboard focus drop to their idle frame rate after this long without input\n"),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Occlusion Hides"), STAT_CEFOcclusionHides, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Occlusion Throttles"), STAT_CEFOcclusionThrottles, STATGROUP_WebBrowser);
+
+static float CEFOcclusionDelaySeconds = 0.5f;
+static FAutoConsoleVariableRef CVarCEFOcclusionDelaySeconds(
+	TEXT("webbrowser.Occlusion.DelaySeconds"),
+	CEFOcclusionDelaySeconds,
+	TEXT("How long a widget must stay painted fully transparent before its browser is hidden or throttled, according to its occlusion policy. Browsers are shown again as soon as the widget is visible\n"),
+	ECVF_Default);
+
+static int32 CEFOcclusionThrottleFrameRate = 5;
+static FAutoConsoleVariableRef CVarCEFOcclusionThrottleFrameRate(
+	TEXT("webbrowser.Occlusion.ThrottleFrameRate"),
+	CEFOcclusionThrottleFrameRate,
+	TEXT("Highest frame rate of occluded browsers using the ThrottleWhenOccluded policy\n"),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Popups Composited"), STAT_CEFPopupsComposited, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Popup Texture Reuses"), STAT_CEFPopupTextureReuses, STATGROUP_WebBrowser);
+
+static int32 CEFPopupCompositeMaxPixels = 256 * 1024;
+static FAutoConsoleVariableRef CVarCEFPopupCompositeMaxPixels(
+	TEXT("webbrowser.Popup.CompositeMaxPixels"),
+	CEFPopupCompositeMaxPixels,
+	TEXT("Popups like select dropdowns of up to this many pixels, that fit in the view, are drawn into the view texture on the CPU instead of being shown by Slate with a texture of their own. 0 disables compositing\n"),
+	ECVF_Default);
+
+static int32 CEFPopupTexturePoolSize = 2;
+static FAutoConsoleVariableRef CVarCEFPopupTexturePoolSize(
+	TEXT("webbrowser.Popup.TexturePoolSize"),
+	CEFPopupTexturePoolSize,
+	TEXT("Number of popup textures of previously shown sizes each browser keeps, so showing a popup of one of those sizes again doesn't reallocate a texture\n"),
+	ECVF_Default);
+
 // Private helper class to smooth out video buffering, using a ringbuffer
 // (cef sometimes submits multiple frames per engine frame)
+// Frame buffers are recycled: a slot keeps its allocation as long as the frame dimensions don't change,
+// and is only replaced if the render thread is still reading from it when the ring wraps around.
 class FBrowserBufferedVideo
 {
 public:
+	typedef TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> FFrameBufferRef;
+
 	FBrowserBufferedVideo(uint32 NumFrames) 
 		: FrameWriteIndex(0)
 		, FrameReadIndex(0)
 		, FrameCountThisEngineTick(0)
 		, FrameCount(0)
-		, FrameNumberOfLastRender(-1)
+		, bHasPresentedFrame(false)
+		, PresentedSize(FIntPoint::ZeroValue)
 	{
-		Frames.SetNum(NumFrames);
+		Frames.SetNum(FMath::Max<uint32>(NumFrames, 1));
 	}
 
 	~FBrowserBufferedVideo()
@@ -302,69 +356,121 @@ public:
 		const uint32 NumBytesPerPixel = 4;
 		FFrame& Frame = Frames[FrameWriteIndex];
 
-		// If the write buffer catches up to the read buffer, we need to release the read buffer and increment its index
+		// If the write buffer catches up to the read buffer, we need to drop the oldest frame and increment the read index
 		if (FrameWriteIndex == FrameReadIndex && FrameCount > 0)
 		{
-			Frame.ReleaseTextureData();
 			FrameReadIndex = (FrameReadIndex + 1) % Frames.Num();
+			FrameCount--;
+			Stats.NumDropped++;
+			INC_DWORD_STAT(STAT_CEFBufferedVideoDroppedFrames);
 		}
 
-		check(Frame.SlateTextureData == nullptr);
-		Frame.SlateTextureData = new FSlateTextureData((uint8*)Buffer, InWidth, InHeight, NumBytesPerPixel);
+		// The render thread may still be uploading from this slot, in which case it keeps the old allocation alive
+		if (Frame.Data.GetSharedReferenceCount() > 1)
+		{
+			Frame.Data = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+			Stats.NumPoolMisses++;
+		}
+
+		const int32 NumBytes = InWidth * InHeight * NumBytesPerPixel;
+		Frame.Data->SetNumUninitialized(NumBytes, EAllowShrinking::No);
+		FMemory::Memcpy(Frame.Data->GetData(), Buffer, NumBytes);
+		Frame.Size = FIntPoint(InWidth, InHeight);
+		Frame.SubmittedFrameNumber = GFrameCounter;
 
 		FrameWriteIndex = (FrameWriteIndex + 1) % Frames.Num();
 		FrameCount = FMath::Min(Frames.Num(), FrameCount + 1);
 		FrameCountThisEngineTick++;
+		Stats.NumSubmitted++;
 
 		return FrameCountThisEngineTick == 1;
 	}
 
-    /**
-     * Called once per frame to get the next frame's texturedata
-     * @return The texture data. Can be nullptr if no frame is available
-     */
-	FSlateTextureData* GetNextFrameTextureData()
+	/**
+	 * Called once per frame to upload the next frame into the texture
+	 * @return true if a frame was uploaded
+	 */
+	bool PresentNextFrame(FSlateUpdatableTexture* Texture)
 	{
 		// Grab the next available frame if available. Ensure we don't grab more than one frame per engine tick
 		check(IsInGameThread());
-		FSlateTextureData* SlateTextureData = nullptr;
-		if ( FrameCount > 0 )
+		FrameCountThisEngineTick = 0;
+
+		if (FrameCount == 0)
 		{
-			// Grab the first frame we haven't submitted yet 
-			FFrame& Frame = Frames[FrameReadIndex];
-			SlateTextureData = Frame.SlateTextureData;
-			
-			// Set this to NULL because the renderthread is taking ownership
-			Frame.SlateTextureData = nullptr; 
-			FrameReadIndex = (FrameReadIndex + 1) % Frames.Num();
-			FrameCount--;
+			// Nothing new was submitted, the previous frame is presented again
+			if (bHasPresentedFrame)
+			{
+				Stats.NumDuplicated++;
+				INC_DWORD_STAT(STAT_CEFBufferedVideoDuplicateFrames);
+			}
+			return false;
 		}
-		FrameCountThisEngineTick = 0;
-		return SlateTextureData;
+
+		// Grab the first frame we haven't submitted yet 
+		FFrame& Frame = Frames[FrameReadIndex];
+		FrameReadIndex = (FrameReadIndex + 1) % Frames.Num();
+		FrameCount--;
+
+		// Frames that waited in the ring for more than one engine tick are late
+		if (GFrameCounter > Frame.SubmittedFrameNumber + 1)
+		{
+			Stats.NumLate++;
+			INC_DWORD_STAT(STAT_CEFBufferedVideoLateFrames);
+		}
+
+#if WITH_ENGINE
+		FSlateTexture2DRHIRef* SlateTexture = FCEFPaintRegionUploader::GetRHITexture(Texture);
+		if (PresentedSize == Frame.Size && SlateTexture != nullptr)
+		{
+			// Upload straight from the pooled buffer. The render command holds a reference to it so it isn't recycled before the copy is done.
+			ENQUEUE_RENDER_COMMAND(CEFPresentBufferedVideoFrame)(
+				[SlateTexture, Data = Frame.Data, Size = Frame.Size](FRHICommandListImmediate& RHICmdList)
+				{
+					FTextureRHIRef TextureRHI = SlateTexture->GetRHIRef();
+					if (TextureRHI.IsValid() && TextureRHI->GetSizeXY() == Size)
+					{
+						RHICmdList.UpdateTexture2D(TextureRHI, 0, FUpdateTextureRegion2D(0, 0, 0, 0, Size.X, Size.Y), Size.X * 4, Data->GetData());
+					}
+				});
+		}
+		else
+#endif
+		{
+			// The texture needs resizing, or isn't an RHI texture, which the regular Slate path takes care of
+			Texture->UpdateTextureThreadSafeRaw(Frame.Size.X, Frame.Size.Y, Frame.Data->GetData());
+			PresentedSize = Frame.Size;
+		}
+
+		bHasPresentedFrame = true;
+		Stats.NumPresented++;
+		return true;
+	}
+
+	/** Forgets the presented frame, so the next one goes through the resizing path. Call when the texture is recreated. */
+	void ResetPresentedSize()
+	{
+		PresentedSize = FIntPoint::ZeroValue;
+		bHasPresentedFrame = false;
+	}
+
+	const FCEFBufferedVideoStats& GetStats() const
+	{
+		return Stats;
 	}
 
 private:
 	struct FFrame
 	{
 		FFrame()
-			: SlateTextureData(nullptr) 
+			: Data(MakeShared<TArray<uint8>, ESPMode::ThreadSafe>())
+			, Size(FIntPoint::ZeroValue)
+			, SubmittedFrameNumber(0)
 		{}
-		
-		~FFrame()
-		{
-			ReleaseTextureData();
-		}
-
-		void ReleaseTextureData()
-		{
-			if (SlateTextureData)
-			{
-				delete SlateTextureData;
-			}
-			SlateTextureData = nullptr;
-		}
 
-		FSlateTextureData* SlateTextureData;
+		FFrameBufferRef Data;
+		FIntPoint Size;
+		uint64 SubmittedFrameNumber;
 	};
 
 	TArray<FFrame> Frames;
@@ -375,12 +481,19 @@ private:
 
 	int32 FrameCountThisEngineTick;
 	int32 FrameCount;
-	int32 FrameNumberOfLastRender;
+
+	/** Whether the texture holds a presented frame, which every engine tick without a new frame presents again */
+	bool bHasPresentedFrame;
+
+	/** Size of the last frame uploaded through the resizing path */
+	FIntPoint PresentedSize;
+
+	FCEFBufferedVideoStats Stats;
 };
 
 
 
-FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefRefPtr<FCEFBrowserHandler> InHandler, FString InUrl, TOptional<FString> InContentsToLoad, bool bInShowErrorMessage, bool bInThumbMouseButtonNavigation, bool bInUseTransparency, bool bInJSBindingToLoweringEnabled, bool bInUsingAcceleratedPaint)
+FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefRefPtr<FCEFBrowserHandler> InHandler, FString InUrl, TOptional<FString> InContentsToLoad, bool bInShowErrorMessage, bool bInThumbMouseButtonNavigation, bool bInUseTransparency, bool bInJSBindingToLoweringEnabled, ECEFAcceleratedPaintBackend InAcceleratedPaintBackend, int32 InBufferedVideoFrames)
 	: DocumentState(EWebBrowserDocumentState::NoDocument)
 	, InternalCefBrowser(InBrowser)
 	, WebBrowserHandler(InHandler)
@@ -393,7 +506,8 @@ FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefR
 	, bShowErrorMessage(bInShowErrorMessage)
 	, bThumbMouseButtonNavigation(bInThumbMouseButtonNavigation)
 	, bUseTransparency(bInUseTransparency)
-	, bUsingAcceleratedPaint(bInUsingAcceleratedPaint)
+	, bUsingAcceleratedPaint(InAcceleratedPaintBackend != ECEFAcceleratedPaintBackend::None)
+	, AcceleratedPaintBackend(InAcceleratedPaintBackend)
 	, Cursor(EMouseCursor::Default)
 	, bIsDisabled(false)
 	, bIsHidden(false)
@@ -412,6 +526,8 @@ FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefR
 	, bRecoverFromRenderProcessCrash(false)
 	, ErrorCode(0)
 	, bDeferNavigations(false)
+	, BufferedVideoFrames(InBufferedVideoFrames)
+	, UnpresentedPaintTime(-1.0)
 #if PLATFORM_MAC
 	, LastPaintedSharedHandle(nullptr)
 #endif
@@ -425,7 +541,6 @@ FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefR
 #endif
 {
 	check(InBrowser.get() != nullptr);
-	check(!bUsingAcceleratedPaint || CanSupportAcceleratedPaint()); // make sure if accelerated paint is selected we can support it
 
 	UpdatableTextures[PET_VIEW] = nullptr;
 	UpdatableTextures[PET_POPUP] = nullptr;
@@ -442,20 +557,53 @@ FCEFWebBrowserWindow::FCEFWebBrowserWindow(CefRefPtr<CefBrowser> InBrowser, CefR
 	}
 #endif
 
-#if USE_BUFFERED_VIDEO
-	BufferedVideo = TUniquePtr<FBrowserBufferedVideo>(new FBrowserBufferedVideo(4));
-#endif
+	if (InBufferedVideoFrames > 0)
+	{
+		BufferedVideo = TUniquePtr<FBrowserBufferedVideo>(new FBrowserBufferedVideo(InBufferedVideoFrames));
+	}
+
+	CreationFrameRate = InternalCefBrowser->GetHost()->GetWindowlessFrameRate();
+	ActiveFrameRate = CreationFrameRate;
+	AppliedFrameRate = CreationFrameRate;
+	LastInteractionTime = FPlatformTime::Seconds();
 }
 
 void FCEFWebBrowserWindow::ReleaseTextures()
 {
+	TArray<FSlateUpdatableTexture*, TInlineAllocator<6>> TexturesToRelease(PooledPopupTextures);
+	PooledPopupTextures.Reset();
+
 	for (int Type : { PET_VIEW, PET_POPUP })
 	{
 		if (UpdatableTextures[Type] != nullptr)
 		{
-			FSlateUpdatableTexture* TextureToRelease = UpdatableTextures[Type];
+			TexturesToRelease.Add(UpdatableTextures[Type]);
+			UpdatableTextures[Type] = nullptr;
+		}
 
-			if (IsInGameThread())
+		PaintRegionUploaders[Type].Reset();
+		PaintRegionUploaders[Type].DiscardDeferred();
+	}
+
+	for (FSlateUpdatableTexture* TextureToRelease : TexturesToRelease)
+	{
+		if (IsInGameThread())
+		{
+			if (FSlateApplication::IsInitialized())
+			{
+				if (RHIRenderHelper)
+				{
+					RHIRenderHelper->ReleaseSlateUpdatableTexture(TextureToRelease);
+				}
+				else if (FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer())
+				{
+					Renderer->ReleaseUpdatableTexture(TextureToRelease);
+				}
+			}
+		}
+		else if (FTaskGraphInterface::IsRunning())
+		{
+			AsyncTask(ENamedThreads::GameThread, [this, TextureToRelease]()
 			{
 				if (FSlateApplication::IsInitialized())
 				{
@@ -468,28 +616,14 @@ void FCEFWebBrowserWindow::ReleaseTextures()
 						Renderer->ReleaseUpdatableTexture(TextureToRelease);
 					}
 				}
-			}
-			else if (FTaskGraphInterface::IsRunning())
-			{
-				AsyncTask(ENamedThreads::GameThread, [this, TextureToRelease]()
-				{
-					if (FSlateApplication::IsInitialized())
-					{
-						if (RHIRenderHelper)
-						{
-							RHIRenderHelper->ReleaseSlateUpdatableTexture(TextureToRelease);
-						}
-						else if (FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer())
-						{
-							Renderer->ReleaseUpdatableTexture(TextureToRelease);
-						}
-					}
-				});
-			}
-
-			UpdatableTextures[Type] = nullptr;
+			});
 		}
 	}
+
+	if (BufferedVideo.IsValid())
+	{
+		BufferedVideo->ResetPresentedSize();
+	}
 }
 
 bool FCEFWebBrowserWindow::CreateInitialTextures()
@@ -505,9 +639,13 @@ bool FCEFWebBrowserWindow::CreateInitialTextures()
 
 			if (bUsingAcceleratedPaint)
 			{
-				if (FCEFWebBrowserWindowRHIHelper::BUseSupportedRHIRenderer() && !RHIRenderHelper)
+				if (AcceleratedPaintBackend != ECEFAcceleratedPaintBackend::None)
 				{
-					RHIRenderHelper.Reset(new FCEFWebBrowserWindowRHIHelper);
+					// Pooled windows recreate their textures when reused, keeping their helper
+					if (!RHIRenderHelper)
+					{
+						RHIRenderHelper.Reset(new FCEFWebBrowserWindowRHIHelper(AcceleratedPaintBackend));
+					}
 
 					// Render a transparent texture until we receive the first update from CEF
 					UpdatableTextures[PET_VIEW] = RHIRenderHelper->CreateSlateUpdatableTexture({ 1, 1 });
@@ -565,6 +703,14 @@ FCEFWebBrowserWindow::~FCEFWebBrowserWindow()
 	WebBrowserHandler->OnBeforeResourceLoad().Unbind();
 	WebBrowserHandler->OnResourceLoadComplete().Unbind();
 	WebBrowserHandler->OnConsoleMessage().Unbind();
+	if (TSharedPtr<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe> PinnedWindowRegistry = WindowRegistry.Pin())
+	{
+		PinnedWindowRegistry->Remove(RegisteredBrowserId);
+	}
+	if (bIdleFrameRateApplied)
+	{
+		DEC_DWORD_STAT(STAT_CEFIdleFrameRateWindows);
+	}
 	if (IsValid())
 	{
 		UE_LOG(LogWebBrowser, Log, TEXT("Closing browser during destruction, this may cause a later crash."), *CurrentUrl);
@@ -617,7 +763,8 @@ bool FCEFWebBrowserWindow::BlockInputInDirectHwndMode() const
 void FCEFWebBrowserWindow::SetViewportSize(FIntPoint WindowSize, FIntPoint WindowPos)
 {
 	// SetViewportSize is called from the browser viewport tick method, which means that since we are receiving ticks, we can mark the browser as visible.
-	if (! bIsDisabled)
+	// A browser hidden because of occlusion stays hidden until its widget is visible again.
+	if (! bIsDisabled && !bHiddenByOcclusion)
 	{
 		SetIsHidden(false);
 	}
@@ -632,8 +779,40 @@ void FCEFWebBrowserWindow::SetViewportSize(FIntPoint WindowSize, FIntPoint Windo
 	ViewportPos = WindowPos;
 
 	// Ignore sizes that can't be seen as it forces CEF to re-render whole image
-	if ((WindowSize.X > 0 && WindowSize.Y > 0 && ViewportSize != WindowSize) || WindowDPIScaleFactor != ViewportDPIScaleFactor)
+	const bool bIsVisibleSize = WindowSize.X > 0 && WindowSize.Y > 0;
+	if (bIsVisibleSize)
+	{
+		RequestedViewportSize = WindowSize;
+	}
+
+	// DPI changes are rare and applied right away. Size changes come in bursts while a window is dragged or a panel animates,
+	// so the resize policy decides which of them reach CEF. Native child windows are always resized along with the widget.
+	TOptional<FIntPoint> NewViewportSize;
+	if (WindowDPIScaleFactor != ViewportDPIScaleFactor)
+	{
+		ResizePolicy.Reset();
+		NewViewportSize = WindowSize;
+	}
+	else if (bIsVisibleSize)
+	{
+#if PLATFORM_WINDOWS || PLATFORM_MAC
+		if (bInDirectHwndMode)
+		{
+			if (ViewportSize != WindowSize)
+			{
+				NewViewportSize = WindowSize;
+			}
+		}
+		else
+#endif
+		{
+			NewViewportSize = ResizePolicy.Update(WindowSize, ViewportSize, FPlatformTime::Seconds());
+		}
+	}
+
+	if (NewViewportSize.IsSet())
 	{
+		WindowSize = NewViewportSize.GetValue();
 		bool bFirstSize = ViewportSize == FIntPoint::ZeroValue;
 		ViewportSize = WindowSize;
 		ViewportDPIScaleFactor = WindowDPIScaleFactor;
@@ -687,8 +866,252 @@ void FCEFWebBrowserWindow::SetViewportSize(FIntPoint WindowSize, FIntPoint Windo
 	}
 }
 
+void FCEFWebBrowserWindow::RecordPaint(CefRenderHandler::PaintElementType Type, const CefRenderHandler::RectList& DirtyRects, uint64 UploadedBytes)
+{
+	PerfStats.NumPaints++;
+	PerfStats.UploadedBytes += UploadedBytes;
+	for (const CefRect& Rect : DirtyRects)
+	{
+		PerfStats.DirtyBytes += uint64(Rect.width) * Rect.height * 4;
+	}
+	if (Type == PET_VIEW && UnpresentedPaintTime < 0.0)
+	{
+		UnpresentedPaintTime = FPlatformTime::Seconds();
+	}
+}
+
+void FCEFWebBrowserWindow::FlushDeferredUpload(CefRenderHandler::PaintElementType Type)
+{
+	FCEFPaintRegionUploader& Uploader = PaintRegionUploaders[Type];
+	if (UpdatableTextures[Type] == nullptr)
+	{
+		// The textures were released since the paint, the next one uploads a full frame anyway
+		Uploader.DiscardDeferred();
+		return;
+	}
+
+	if (Uploader.FlushDeferred(UpdatableTextures[Type]))
+	{
+		if (Type == PET_VIEW)
+		{
+			RedrawCompositedPopup(CefRenderHandler::RectList());
+		}
+		HandleRenderingError();
+		PerfStats.UploadedBytes += Uploader.GetLastStats().BytesUploaded;
+		NeedsRedrawEvent.Broadcast();
+	}
+}
+
+ECEFUploadPriority FCEFWebBrowserWindow::GetUploadPriority() const
+{
+	if (bMainHasFocus || bPopupHasFocus)
+	{
+		return ECEFUploadPriority::Focused;
+	}
+	return (bIsHidden || bIsOccluded) ? ECEFUploadPriority::Background : ECEFUploadPriority::Visible;
+}
+
+FWebBrowserWindowPerfStats FCEFWebBrowserWindow::GetPerfStats() const
+{
+	FWebBrowserWindowPerfStats Stats = PerfStats;
+	Stats.NumAppliedResizes = ResizePolicy.GetStats().NumAppliedResizes;
+	Stats.NumSuppressedResizes = ResizePolicy.GetStats().NumSuppressedResizes;
+	if (RHIRenderHelper)
+	{
+		const FCEFAcceleratedPaintStats& AcceleratedPaintStats = RHIRenderHelper->GetStats();
+		Stats.AcceleratedPaintBackend = FName(FCEFWebBrowserWindowRHIHelper::GetBackendName(RHIRenderHelper->GetBackendType()));
+		Stats.NumAcceleratedPaintCopies = AcceleratedPaintStats.NumCopies;
+		Stats.NumFailedAcceleratedPaintCopies = AcceleratedPaintStats.NumFailedCopies;
+		Stats.TotalAcceleratedPaintCopySeconds = AcceleratedPaintStats.TotalCopySeconds;
+		Stats.MaxAcceleratedPaintCopySeconds = AcceleratedPaintStats.MaxCopySeconds;
+	}
+	return Stats;
+}
+
+void FCEFWebBrowserWindow::SetFrameRate(int32 FrameRate)
+{
+	ActiveFrameRate = FMath::Clamp(FrameRate, 1, 60);
+	ApplyFrameRate(IsIdle(FPlatformTime::Seconds()));
+}
+
+int32 FCEFWebBrowserWindow::GetFrameRate() const
+{
+	return ActiveFrameRate;
+}
+
+void FCEFWebBrowserWindow::SetIdleFrameRate(int32 InIdleFrameRate)
+{
+	IdleFrameRate = InIdleFrameRate > 0 ? FMath::Clamp(InIdleFrameRate, 1, 60) : 0;
+	ApplyFrameRate(IsIdle(FPlatformTime::Seconds()));
+}
+
+int32 FCEFWebBrowserWindow::GetIdleFrameRate() const
+{
+	return IdleFrameRate;
+}
+
+void FCEFWebBrowserWindow::UpdateFrameRate(bool bAppIsFocused)
+{
+	bAppHasFocus = bAppIsFocused;
+	if (IdleFrameRate > 0 || bThrottledByOcclusion)
+	{
+		ApplyFrameRate(IsIdle(FPlatformTime::Seconds()));
+	}
+}
+
+bool FCEFWebBrowserWindow::IsIdle(double Now) const
+{
+	if (bThrottledByOcclusion)
+	{
+		return true;
+	}
+
+	if (IdleFrameRate <= 0)
+	{
+		return false;
+	}
+
+	if (bIsHidden || !bAppHasFocus)
+	{
+		return true;
+	}
+
+	TSharedPtr<SWindow> PinnedParentWindow = ParentWindow.Pin();
+	if (PinnedParentWindow.IsValid() && PinnedParentWindow->IsWindowMinimized())
+	{
+		return true;
+	}
+
+	// Focused browsers are being read or typed into, even if no input is arriving
+	return !bMainHasFocus && !bPopupHasFocus && Now - LastInteractionTime >= CEFIdleFrameRateDelaySeconds;
+}
+
+void FCEFWebBrowserWindow::NotifyInteraction()
+{
+	LastInteractionTime = FPlatformTime::Seconds();
+	if (bIdleFrameRateApplied && !bIsHidden)
+	{
+		// Restore the rate right away so the response to the input isn't delayed until the next engine tick
+		ApplyFrameRate(false);
+	}
+}
+
+void FCEFWebBrowserWindow::ApplyFrameRate(bool bIdle)
+{
+	if (bIdle != bIdleFrameRateApplied)
+	{
+		bIdleFrameRateApplied = bIdle;
+		if (bIdle)
+		{
+			INC_DWORD_STAT(STAT_CEFIdleFrameRateWindows);
+		}
+		else
+		{
+			DEC_DWORD_STAT(STAT_CEFIdleFrameRateWindows);
+		}
+	}
+
+	int32 FrameRate = ActiveFrameRate;
+	if (bIdle)
+	{
+		FrameRate = IdleFrameRate > 0 ? IdleFrameRate : ActiveFrameRate;
+		if (bThrottledByOcclusion)
+		{
+			FrameRate = FMath::Min(FrameRate, FMath::Clamp(CEFOcclusionThrottleFrameRate, 1, 60));
+		}
+	}
+	if (FrameRate != AppliedFrameRate && IsValid())
+	{
+		INC_DWORD_STAT(STAT_CEFFrameRateChanges);
+		AppliedFrameRate = FrameRate;
+		InternalCefBrowser->GetHost()->SetWindowlessFrameRate(FrameRate);
+	}
+}
+
+void FCEFWebBrowserWindow::SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy)
+{
+	if (OcclusionPolicy != Policy)
+	{
+		EndOcclusion();
+		OcclusionPolicy = Policy;
+	}
+}
+
+void FCEFWebBrowserWindow::SetIsOccluded(bool bInIsOccluded)
+{
+	if (bIsOccluded == bInIsOccluded)
+	{
+		return;
+	}
+	bIsOccluded = bInIsOccluded;
+	if (bIsOccluded)
+	{
+		OccludedSinceTime = FPlatformTime::Seconds();
+	}
+	else
+	{
+		// Show the page right away, the delay only applies to hiding it
+		EndOcclusion();
+	}
+}
+
+void FCEFWebBrowserWindow::UpdateOcclusion()
+{
+	if (!bIsOccluded || OcclusionPolicy == EWebBrowserOcclusionPolicy::NeverHide || bHiddenByOcclusion || bThrottledByOcclusion)
+	{
+		return;
+	}
+
+	// Widgets that are only covered for a moment, like during a transition, keep rendering
+	if (FPlatformTime::Seconds() - OccludedSinceTime < CEFOcclusionDelaySeconds)
+	{
+		return;
+	}
+
+	if (OcclusionPolicy == EWebBrowserOcclusionPolicy::HideWhenOccluded)
+	{
+		INC_DWORD_STAT(STAT_CEFOcclusionHides);
+		bHiddenByOcclusion = true;
+		SetIsHidden(true);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_CEFOcclusionThrottles);
+		bThrottledByOcclusion = true;
+		ApplyFrameRate(true);
+	}
+}
+
+void FCEFWebBrowserWindow::EndOcclusion()
+{
+	if (bHiddenByOcclusion)
+	{
+		bHiddenByOcclusion = false;
+		// A widget that stopped ticking in the meantime stays hidden, SetViewportSize shows it once it ticks again
+		if (!bIsDisabled && bTickedLastFrame)
+		{
+			SetIsHidden(false);
+		}
+	}
+	if (bThrottledByOcclusion)
+	{
+		bThrottledByOcclusion = false;
+		ApplyFrameRate(IsIdle(FPlatformTime::Seconds()));
+	}
+}
+
 FSlateShaderResource* FCEFWebBrowserWindow::GetTexture(bool bIsPopup)
 {
+	if (!bIsPopup && UnpresentedPaintTime >= 0.0)
+	{
+		// The texture is requested when the widget draws, which is when the paint reaches the screen
+		const double PaintToPresentSeconds = FPlatformTime::Seconds() - UnpresentedPaintTime;
+		PerfStats.NumPresentedPaints++;
+		PerfStats.TotalPaintToPresentSeconds += PaintToPresentSeconds;
+		PerfStats.MaxPaintToPresentSeconds = FMath::Max(PerfStats.MaxPaintToPresentSeconds, PaintToPresentSeconds);
+		UnpresentedPaintTime = -1.0;
+	}
+
 	if (UpdatableTextures[bIsPopup? PET_POPUP : PET_VIEW] != nullptr)
 	{
 		return UpdatableTextures[bIsPopup? PET_POPUP : PET_VIEW]->GetSlateResource();
@@ -1181,6 +1604,8 @@ bool FCEFWebBrowserWindow::OnKeyDown(const FKeyEvent& InKeyEvent)
 {
 	if (IsValid() && !BlockInputInDirectHwndMode() && !bIgnoreKeyDownEvent)
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 #if PLATFORM_MAC
 		if(FilterSystemKeyChord(InKeyEvent))
 			return false;
@@ -1199,6 +1624,8 @@ bool FCEFWebBrowserWindow::OnKeyUp(const FKeyEvent& InKeyEvent)
 {
 	if (IsValid() && !BlockInputInDirectHwndMode() && !bIgnoreKeyUpEvent)
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 #if PLATFORM_MAC
 		if(FilterSystemKeyChord(InKeyEvent))
 			return false;
@@ -1217,6 +1644,8 @@ bool FCEFWebBrowserWindow::OnKeyChar(const FCharacterEvent& InCharacterEvent)
 {
 	if (IsValid() && !BlockInputInDirectHwndMode() && !bIgnoreCharacterEvent)
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		PreviousCharacterEvent = InCharacterEvent;
 		CefKeyEvent KeyEvent;
 #if PLATFORM_MAC || PLATFORM_LINUX
@@ -1454,6 +1883,9 @@ void FCEFWebBrowserWindow::OnResetDialogState()
 
 void FCEFWebBrowserWindow::OnRenderProcessTerminated(CefRequestHandler::TerminationStatus Status)
 {
+	// The new render process has to send a batch of its own before it is sent batched results
+	Scripting->ResetBatchedTransport();
+
 	if(bRecoverFromRenderProcessCrash)
 	{
 		bRecoverFromRenderProcessCrash = false;
@@ -1464,11 +1896,18 @@ void FCEFWebBrowserWindow::OnRenderProcessTerminated(CefRequestHandler::Terminat
 	Reload();
 }
 
+void FCEFWebBrowserWindow::OnMainFrameLoadStart()
+{
+	Scripting->ResetBatchedTransport();
+}
+
 FReply FCEFWebBrowserWindow::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent, bool bIsPopup)
 {
 	FReply Reply = FReply::Unhandled();
 	if (IsValid() && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		FKey Button = MouseEvent.GetEffectingButton();
 		// CEF only supports left, right, and middle mouse buttons
 		bool bIsCefSupportedButton = (Button == EKeys::LeftMouseButton || Button == EKeys::RightMouseButton || Button == EKeys::MiddleMouseButton);
@@ -1499,6 +1938,8 @@ FReply FCEFWebBrowserWindow::OnMouseButtonUp(const FGeometry& MyGeometry, const
 	FReply Reply = FReply::Unhandled();
 	if (IsValid() && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		FKey Button = MouseEvent.GetEffectingButton();
 		// CEF only supports left, right, and middle mouse buttons
 		bool bIsCefSupportedButton = (Button == EKeys::LeftMouseButton || Button == EKeys::RightMouseButton || Button == EKeys::MiddleMouseButton);
@@ -1545,6 +1986,8 @@ FReply FCEFWebBrowserWindow::OnMouseButtonDoubleClick(const FGeometry& MyGeometr
 	FReply Reply = FReply::Unhandled();
 	if (IsValid() && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		FKey Button = MouseEvent.GetEffectingButton();
 		// CEF only supports left, right, and middle mouse buttons
 		bool bIsCefSupportedButton = (Button == EKeys::LeftMouseButton || Button == EKeys::RightMouseButton || Button == EKeys::MiddleMouseButton);
@@ -1568,6 +2011,8 @@ FReply FCEFWebBrowserWindow::OnMouseMove(const FGeometry& MyGeometry, const FPoi
 	FReply Reply = FReply::Unhandled();
 	if (IsValid() && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		CefMouseEvent Event = GetCefMouseEvent(MyGeometry, MouseEvent, bIsPopup);
 
 		bool bEventConsumedByDragCallback = false;
@@ -1622,6 +2067,8 @@ FReply FCEFWebBrowserWindow::OnTouchGesture(const FGeometry& MyGeometry, const F
 	FReply Reply = FReply::Unhandled();
 	if(IsValid() && bSupportsMouseWheel && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 		const EGestureEvent GestureType = GestureEvent.GetGestureType();
 		const FVector2D& GestureDelta = GestureEvent.GetGestureDelta();
 		if ( GestureType == EGestureEvent::Scroll )
@@ -1640,6 +2087,8 @@ FReply FCEFWebBrowserWindow::OnMouseWheel(const FGeometry& MyGeometry, const FPo
 	FReply Reply = FReply::Unhandled();
 	if(IsValid() && bSupportsMouseWheel && !BlockInputInDirectHwndMode())
 	{
+		FCEFMessagePumpScheduler::NotifyActivity();
+		NotifyInteraction();
 #if PLATFORM_WINDOWS
 		// The original delta is reduced so this should bring it back to what CEF expects
 		// see WindowsApplication.cpp , case WM_MOUSEWHEEL:
@@ -1672,6 +2121,10 @@ void FCEFWebBrowserWindow::OnFocus(bool SetFocus, bool bIsPopup)
 	{
 		bMainHasFocus = SetFocus;
 	}
+	if (SetFocus)
+	{
+		NotifyInteraction();
+	}
 
 #if !PLATFORM_LINUX
 	Ime->SetFocus(!bPopupHasFocus && bMainHasFocus);
@@ -1971,6 +2424,9 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 		return;
 	}
 
+	// Keep the message pump boosted while the page is animating
+	FCEFMessagePumpScheduler::NotifyActivity();
+
 
 #if UE_CEF_HAS_RESIZE_BUG
 	const FIntPoint PaintedBufferSize(Width / ViewportDPIScaleFactor, Height / ViewportDPIScaleFactor);
@@ -1981,15 +2437,22 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 		// size to end up being captured, but also may not be captured if it fails another test (which we skip if we know we have the correct CEF
 		// buffer.) See code.
 
-		CapturedCefBuffer->SetBufferAsB8G8R8A8(Buffer, Width, Height, ViewportDPIScaleFactor, bHasCorrectNativeCefBuffer);
+		TArray<FIntRect, TInlineAllocator<4>> CapturedDirtyRects;
+		for (const CefRect& Rect : DirtyRects)
+		{
+			CapturedDirtyRects.Emplace(Rect.x, Rect.y, Rect.x + Rect.width, Rect.y + Rect.height);
+		}
+		CapturedCefBuffer->SetBufferAsB8G8R8A8(Buffer, Width, Height, ViewportDPIScaleFactor, bHasCorrectNativeCefBuffer, CapturedDirtyRects);
 	}
 #endif
 
 	
 	bool bNeedsRedraw = false;
+	uint64 UploadedBytes = 0;
 	if (bUsingAcceleratedPaint)
 	{
 		UE_LOG(LogWebBrowser, Error, TEXT("Accelerated CEF rendering selected but OnPaint called. Disabling accelerated rendering for this browser window."));
+		ReleasePopupTexturePool();
 		bUsingAcceleratedPaint = false;
 		if (UpdatableTextures[Type] != nullptr)
 		{
@@ -2001,19 +2464,49 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 		}
 	}
 
+	if (Type == PET_POPUP)
+	{
+		// Whether a popup is composited is decided when it is shown. It goes back to Slate if it outgrows the view or the size limit.
+		const bool bIsCompositingPopup = !CompositedPopupRect.IsEmpty();
+		if ((bShowPopupRequested || bIsCompositingPopup) && ShouldCompositePopup(Width, Height))
+		{
+			bShowPopupRequested = false;
+			bPopupHasFocus = true;
+			CompositePopup(Buffer, Width, Height);
+			HandleRenderingError();
+			RecordPaint(Type, DirtyRects, static_cast<uint64>(Width) * Height * 4);
+
+			bIsInitialized = true;
+			NeedsRedrawEvent.Broadcast();
+			return;
+		}
+
+		if (bIsCompositingPopup)
+		{
+			EndPopupCompositing();
+			bShowPopupRequested = true;
+		}
+		AcquirePopupTexture(FIntPoint(Width, Height));
+	}
+
 	if (UpdatableTextures[Type] == nullptr)
 	{
 		if (FSlateRenderer* const Renderer = GetRenderer())
 		{
 			UpdatableTextures[Type] = Renderer->CreateUpdatableTexture(Width, Height);
+			PaintRegionUploaders[Type].Reset();
+			if (Type == PET_VIEW && BufferedVideo.IsValid())
+			{
+				BufferedVideo->ResetPresentedSize();
+			}
 			HandleRenderingError();
 		}
 	}
 
 	if (UpdatableTextures[Type] != nullptr)
 	{
-		// Note that with more recent versions of CEF, the DirtyRects will always contain a single element, as it merges all dirty areas into a single rectangle before calling OnPaint
-		// In case that should change in the future, we'll simply update the entire area if DirtyRects is not a single element.
+		// Recent versions of CEF usually merge all dirty areas into a single rectangle before calling OnPaint.
+		// When several rects are reported, PaintRegionUploaders coalesces them and uploads only the dirty regions.
 		FIntRect Dirty = (DirtyRects.size() == 1) ? FIntRect(DirtyRects[0].x, DirtyRects[0].y, DirtyRects[0].x + DirtyRects[0].width, DirtyRects[0].y + DirtyRects[0].height) : FIntRect();
 
 		if (Type == PET_VIEW && BufferedVideo.IsValid() )
@@ -2037,9 +2530,26 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 			else
 #endif
 			{
-				UpdatableTextures[Type]->UpdateTextureThreadSafeRaw(Width, Height, Buffer, Dirty);
-				HandleRenderingError();
-				bNeedsRedraw = true;
+				// Views over the frame's upload budget are kept until the scheduler drains them, merged with their later paints.
+				// Popups are small and shown as soon as they are uploaded, so they are never deferred.
+				FCEFPaintRegionUploader& Uploader = PaintRegionUploaders[Type];
+				TSharedPtr<FCEFTextureUploadScheduler, ESPMode::ThreadSafe> Scheduler = (Type == PET_VIEW && FCEFTextureUploadScheduler::IsEnabled()) ? UploadScheduler.Pin() : nullptr;
+				if (Scheduler.IsValid() && (Uploader.HasDeferred() || !Scheduler->TryReserve(Uploader.EstimateUploadBytes(Width, Height, DirtyRects))))
+				{
+					Uploader.Defer(Buffer, Width, Height, DirtyRects);
+					Scheduler->Submit(AsShared(), Type, GetUploadPriority(), Uploader.GetDeferredBytes());
+				}
+				else
+				{
+					Uploader.Upload(UpdatableTextures[Type], Buffer, Width, Height, DirtyRects);
+					if (Type == PET_VIEW)
+					{
+						RedrawCompositedPopup(DirtyRects);
+					}
+					HandleRenderingError();
+					bNeedsRedraw = true;
+					UploadedBytes = Uploader.GetLastStats().BytesUploaded;
+				}
 			}
 
 			if (Type == PET_POPUP && bShowPopupRequested)
@@ -2056,6 +2566,8 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 		}
 	}
 
+	RecordPaint(Type, DirtyRects, UploadedBytes);
+
 	bIsInitialized = true;
 	if (bNeedsRedraw)
 	{
@@ -2063,6 +2575,152 @@ void FCEFWebBrowserWindow::OnPaint(CefRenderHandler::PaintElementType Type, cons
 	}
 }
 
+void FCEFWebBrowserWindow::AcquirePopupTexture(const FIntPoint& Size)
+{
+	FSlateUpdatableTexture*& PopupTexture = UpdatableTextures[PET_POPUP];
+	auto HasSize = [&Size](FSlateUpdatableTexture* Texture)
+	{
+		return Texture->GetSlateResource()->GetWidth() == Size.X && Texture->GetSlateResource()->GetHeight() == Size.Y;
+	};
+
+	if (PopupTexture == nullptr || Size.X <= 0 || Size.Y <= 0 || CEFPopupTexturePoolSize <= 0 || HasSize(PopupTexture))
+	{
+		return;
+	}
+
+	// Keep the current texture for the next popup of its size, and switch to one of the new size, or else to the least recently used one
+	FSlateUpdatableTexture* NewTexture = nullptr;
+	const int32 PooledIndex = PooledPopupTextures.IndexOfByPredicate(HasSize);
+	if (PooledIndex != INDEX_NONE)
+	{
+		INC_DWORD_STAT(STAT_CEFPopupTextureReuses);
+		NewTexture = PooledPopupTextures[PooledIndex];
+		PooledPopupTextures.RemoveAt(PooledIndex, EAllowShrinking::No);
+	}
+	else if (PooledPopupTextures.Num() >= CEFPopupTexturePoolSize)
+	{
+		// The upload resizes it
+		NewTexture = PooledPopupTextures[0];
+		PooledPopupTextures.RemoveAt(0, EAllowShrinking::No);
+	}
+	else if (bUsingAcceleratedPaint)
+	{
+		NewTexture = RHIRenderHelper ? RHIRenderHelper->CreateSlateUpdatableTexture(FUintPoint(Size.X, Size.Y)) : nullptr;
+	}
+	else if (FSlateRenderer* const Renderer = GetRenderer())
+	{
+		NewTexture = Renderer->CreateUpdatableTexture(Size.X, Size.Y);
+		HandleRenderingError();
+	}
+
+	if (NewTexture != nullptr)
+	{
+		PooledPopupTextures.Add(PopupTexture);
+		PopupTexture = NewTexture;
+		PaintRegionUploaders[PET_POPUP].Reset();
+	}
+}
+
+void FCEFWebBrowserWindow::ReleasePopupTexturePool()
+{
+	for (FSlateUpdatableTexture* Texture : PooledPopupTextures)
+	{
+		if (bUsingAcceleratedPaint && RHIRenderHelper)
+		{
+			RHIRenderHelper->ReleaseSlateUpdatableTexture(Texture);
+		}
+		else if (FSlateRenderer* const Renderer = GetRenderer())
+		{
+			Renderer->ReleaseUpdatableTexture(Texture);
+		}
+	}
+	PooledPopupTextures.Reset();
+}
+
+FIntRect FCEFWebBrowserWindow::GetPopupRectInView(int32 Width, int32 Height) const
+{
+	// The popup position is in view coordinates, the buffers are in pixels
+	const FIntPoint Position(FMath::RoundToInt(PopupPosition.X * ViewportDPIScaleFactor), FMath::RoundToInt(PopupPosition.Y * ViewportDPIScaleFactor));
+	return FIntRect(Position, Position + FIntPoint(Width, Height));
+}
+
+bool FCEFWebBrowserWindow::ShouldCompositePopup(int32 Width, int32 Height) const
+{
+	if (bUsingAcceleratedPaint || BufferedVideo.IsValid() || FCEFPaintRegionUploader::GetRHITexture(UpdatableTextures[PET_VIEW]) == nullptr
+		|| Width <= 0 || Height <= 0 || static_cast<int64>(Width) * Height > CEFPopupCompositeMaxPixels)
+	{
+		return false;
+	}
+
+#if UE_CEF_HAS_RESIZE_BUG
+	// The captured buffer shown instead of the view doesn't include the popup
+	if (CapturedCefBuffer.IsValid())
+	{
+		return false;
+	}
+#endif
+
+	// Popups reaching outside the view can only be shown by Slate
+	const FIntRect ViewRect(0, 0, UpdatableTextures[PET_VIEW]->GetSlateResource()->GetWidth(), UpdatableTextures[PET_VIEW]->GetSlateResource()->GetHeight());
+	const FIntRect PopupRect = GetPopupRectInView(Width, Height);
+	return PopupRect.Min.X >= 0 && PopupRect.Min.Y >= 0 && PopupRect.Max.X <= ViewRect.Max.X && PopupRect.Max.Y <= ViewRect.Max.Y;
+}
+
+void FCEFWebBrowserWindow::CompositePopup(const void* Buffer, int32 Width, int32 Height)
+{
+	const FIntRect PopupRect = GetPopupRectInView(Width, Height);
+	if (!CompositedPopupRect.IsEmpty() && CompositedPopupRect != PopupRect)
+	{
+		// The popup moved or was resized, have CEF repaint the view where it was
+		InternalCefBrowser->GetHost()->Invalidate(PET_VIEW);
+	}
+	CompositedPopupRect = PopupRect;
+
+	// Keep a copy to draw over later view paints, popups are small enough for the copy to be cheaper than a texture of their own
+	const int32 NumBytes = Width * Height * 4;
+	CompositedPopupPixels.SetNumUninitialized(NumBytes, EAllowShrinking::No);
+	FMemory::Memcpy(CompositedPopupPixels.GetData(), Buffer, NumBytes);
+
+	if (PaintRegionUploaders[PET_VIEW].UploadOverlay(UpdatableTextures[PET_VIEW], CompositedPopupPixels.GetData(), CompositedPopupRect))
+	{
+		INC_DWORD_STAT(STAT_CEFPopupsComposited);
+	}
+}
+
+void FCEFWebBrowserWindow::RedrawCompositedPopup(const CefRenderHandler::RectList& DirtyRects)
+{
+	if (CompositedPopupRect.IsEmpty())
+	{
+		return;
+	}
+
+	// Draw the popup again over the parts of the view that were just uploaded
+	bool bCoversPopup = DirtyRects.empty();
+	for (const CefRect& Rect : DirtyRects)
+	{
+		bCoversPopup |= FIntRect(Rect.x, Rect.y, Rect.x + Rect.width, Rect.y + Rect.height).Intersect(CompositedPopupRect);
+	}
+	if (bCoversPopup)
+	{
+		PaintRegionUploaders[PET_VIEW].UploadOverlay(UpdatableTextures[PET_VIEW], CompositedPopupPixels.GetData(), CompositedPopupRect);
+	}
+}
+
+void FCEFWebBrowserWindow::EndPopupCompositing()
+{
+	if (CompositedPopupRect.IsEmpty())
+	{
+		return;
+	}
+
+	CompositedPopupRect = FIntRect();
+	CompositedPopupPixels.Reset();
+	if (IsValid())
+	{
+		InternalCefBrowser->GetHost()->Invalidate(PET_VIEW);
+	}
+}
+
 void FCEFWebBrowserWindow::OnAcceleratedPaint(CefRenderHandler::PaintElementType Type, const CefRenderHandler::RectList& DirtyRects,
 #if CEF_VERSION_MAJOR < 128
 	void* SharedHandle)
@@ -2071,10 +2729,18 @@ void FCEFWebBrowserWindow::OnAcceleratedPaint(CefRenderHandler::PaintElementType
 #endif
 {
 	bool bNeedsRedraw = false;
+	FCEFMessagePumpScheduler::NotifyActivity();
+
 	if (!bUsingAcceleratedPaint)
 	{
 		UE_LOG(LogWebBrowser, Error, TEXT("Accelerated CEF rendering NOT selected but OnAcceleratedPaint called. Enabling accelerated rendering for this browser window."));
+		ReleasePopupTexturePool();
+		EndPopupCompositing();
 		bUsingAcceleratedPaint = true;
+		if (AcceleratedPaintBackend == ECEFAcceleratedPaintBackend::None)
+		{
+			AcceleratedPaintBackend = SelectAcceleratedPaintBackend();
+		}
 		if (UpdatableTextures[Type] != nullptr)
 		{
 			if (FSlateRenderer* const Renderer = GetRenderer())
@@ -2115,16 +2781,77 @@ void FCEFWebBrowserWindow::OnAcceleratedPaint(CefRenderHandler::PaintElementType
 		return;
 	}
 
-	if (RHIRenderHelper && RHIRenderHelper->CopySharedTextureSync(UpdatableTextures[Type], SharedHandle, DirtyRect))
+#if CEF_VERSION_MAJOR >= 128
+	// The backends copy BGRA frames only
+	if (Info.format != CEF_COLOR_TYPE_BGRA_8888)
+	{
+		static bool bLoggedUnsupportedFormat = false;
+		if (!bLoggedUnsupportedFormat)
+		{
+			UE_LOG(LogWebBrowser, Warning, TEXT("Ignoring accelerated paints of unsupported color type %d."), static_cast<int32>(Info.format));
+			bLoggedUnsupportedFormat = true;
+		}
+		return;
+	}
+#endif
+
+	FCEFAcceleratedPaintInfo Paint;
+	Paint.SharedHandle = SharedHandle;
+	// The dirty rect can cover less than the frame, so the frame is sized from the paint info or the painted view
+#if CEF_VERSION_MAJOR >= 134
+	if (Info.extra.visible_rect.width > 0 && Info.extra.visible_rect.height > 0)
+	{
+		Paint.Size = FIntPoint(Info.extra.visible_rect.width, Info.extra.visible_rect.height);
+	}
+	else if (Info.extra.coded_size.width > 0 && Info.extra.coded_size.height > 0)
+	{
+		Paint.Size = FIntPoint(Info.extra.coded_size.width, Info.extra.coded_size.height);
+	}
+	else
+#endif
+	{
+		Paint.Size = (Type == PET_POPUP) ? PopupPixelSize : ViewportRect.Max;
+	}
+	if (Paint.Size.X <= 0 || Paint.Size.Y <= 0)
+	{
+		return;
+	}
+	Paint.DirtyRect = DirtyRect;
+#if CEF_VERSION_MAJOR >= 128 && PLATFORM_LINUX
+	if (Info.plane_count > 0)
+	{
+		Paint.Plane.Fd = Info.planes[0].fd;
+		Paint.Plane.Stride = Info.planes[0].stride;
+		Paint.Plane.Offset = Info.planes[0].offset;
+		Paint.Plane.Size = Info.planes[0].size;
+	}
+	// DRM_FORMAT_MOD_LINEAR
+	Paint.bIsLinear = (Info.modifier == 0);
+#endif
+
+	if (Type == PET_POPUP)
+	{
+		AcquirePopupTexture(Paint.Size);
+	}
+
+	if (RHIRenderHelper && RHIRenderHelper->CopyAcceleratedPaint(UpdatableTextures[Type], Paint))
 	{
 		bNeedsRedraw = true;
+		RecordPaint(Type, DirtyRects, uint64(DirtyRect.Area()) * 4);
 		if (Type == PET_POPUP && bShowPopupRequested)
 		{
 			bShowPopupRequested = false;
 			bPopupHasFocus = true;
 
+			// The null backend has no texture to measure
+			FIntPoint TextureSize = Paint.Size;
+			if (UpdatableTextures[Type] != nullptr)
+			{
+				TextureSize = FIntPoint(UpdatableTextures[Type]->GetSlateResource()->GetWidth(), UpdatableTextures[Type]->GetSlateResource()->GetHeight());
+			}
+
 			const float DPIScale = FPlatformApplicationMisc::GetDPIScaleFactorAtPoint(PopupPosition.X, PopupPosition.Y);
-			FIntPoint PopupSize = FIntPoint(UpdatableTextures[Type]->GetSlateResource()->GetWidth() / DPIScale, UpdatableTextures[Type]->GetSlateResource()->GetHeight() / DPIScale);
+			FIntPoint PopupSize = FIntPoint(TextureSize.X / DPIScale, TextureSize.Y / DPIScale);
 
 			FIntRect PopupRect = FIntRect(PopupPosition, PopupPosition + PopupSize);
 			OnShowPopup().Broadcast(PopupRect);
@@ -2143,15 +2870,94 @@ void FCEFWebBrowserWindow::UpdateVideoBuffering()
 {
 	if (BufferedVideo.IsValid() && UpdatableTextures[PET_VIEW] != nullptr )
 	{
-		FSlateTextureData* SlateTextureData = BufferedVideo->GetNextFrameTextureData();
-		if (SlateTextureData != nullptr )
+		if (BufferedVideo->PresentNextFrame(UpdatableTextures[PET_VIEW]))
 		{
-			UpdatableTextures[PET_VIEW]->UpdateTextureThreadSafeWithTextureData(SlateTextureData);
 			HandleRenderingError();
 		}
 	}
 }
 
+void FCEFWebBrowserWindow::SetResourceRules(const FWebBrowserResourceRules& Rules)
+{
+	TSharedPtr<const FCEFResourceRuleSet, ESPMode::ThreadSafe> CompiledRules;
+	if (Rules.Rules.Num() > 0 || Rules.UnmatchedAction != EWebBrowserResourceRuleAction::Delegate)
+	{
+		CompiledRules = MakeShared<const FCEFResourceRuleSet, ESPMode::ThreadSafe>(Rules);
+	}
+	WebBrowserHandler->SetResourceRules(CompiledRules);
+}
+
+void FCEFWebBrowserWindow::FlushBatchedScriptResults()
+{
+	Scripting->FlushBatchedResults();
+}
+
+void FCEFWebBrowserWindow::ResetForReuse()
+{
+	// Drop everything the previous owner attached to the window
+	DocumentStateChangedEvent.Clear();
+	TitleChangedEvent.Clear();
+	UrlChangedEvent.Clear();
+	ToolTipEvent.Clear();
+	NeedsRedrawEvent.Clear();
+	ShowPopupEvent.Clear();
+	DismissPopupEvent.Clear();
+	BeforeBrowseDelegate.Unbind();
+	LoadUrlDelegate.Unbind();
+	CloseWindowDelegate.Unbind();
+	FloatingCloseButtonPressedDelegate.Unbind();
+	BeforeResourceLoadDelegate.Unbind();
+	ResourceLoadCompleteDelegate.Unbind();
+	BeforeResourceRequestDelegate.Unbind();
+	ResourceRequestCompleteDelegate.Unbind();
+	ConsoleMessageDelegate.Unbind();
+	ShowDialogDelegate.Unbind();
+	DismissAllDialogsDelegate.Unbind();
+	SuppressContextMenuDelgate.Unbind();
+	DragWindowDelegate.Unbind();
+	UnhandledKeyDownDelegate.Unbind();
+	UnhandledKeyUpDelegate.Unbind();
+	UnhandledKeyCharDelegate.Unbind();
+	WebBrowserHandler->OnCreateWindow().Unbind();
+	WebBrowserHandler->OnBeforePopup().Unbind();
+	WebBrowserHandler->OnBeforeResourceLoad().Unbind();
+	WebBrowserHandler->OnResourceLoadComplete().Unbind();
+	WebBrowserHandler->OnConsoleMessage().Unbind();
+	WebBrowserHandler->SetResourceRules(nullptr);
+
+	Scripting->UnbindAll();
+
+	if (IsValid())
+	{
+		OnFocus(false, false);
+	}
+	SetParentWindow(nullptr);
+	SetIsHidden(true);
+	ResizePolicy.Reset();
+	bIsOccluded = false;
+	bHiddenByOcclusion = false;
+	bThrottledByOcclusion = false;
+	OcclusionPolicy = EWebBrowserOcclusionPolicy::NeverHide;
+	IdleFrameRate = 0;
+	SetFrameRate(CreationFrameRate);
+
+	// Hidden browsers don't paint, so the textures still hold the previous owner's page. Start over from transparent ones.
+	EndPopupCompositing();
+	ReleasePopupTexturePool();
+	ReleaseTextures();
+	if (!CreateInitialTextures())
+	{
+		ReleaseTextures();
+	}
+#if PLATFORM_MAC
+	LastPaintedSharedHandle = nullptr;
+#endif
+	bIsInitialized = false;
+
+	// Unload the page so it stops running while the window is idle
+	LoadURL(TEXT("about:blank"));
+}
+
 #if PLATFORM_WINDOWS
 bool FCEFWebBrowserWindow::LoadCustomCEF3Cursor(cef_cursor_type_t Type)
 {
@@ -2400,47 +3206,47 @@ bool FCEFWebBrowserWindow::OnBeforeBrowse( CefRefPtr<CefBrowser> Browser, CefRef
 
 
 
-FString URLRequestSTatusToString(const CefResourceRequestHandler::URLRequestStatus& Status)
+FName URLRequestStatusToName(const CefResourceRequestHandler::URLRequestStatus& Status)
 {
-	const static FString URLRequestStatus_Success(TEXT("SUCCESS"));
-	const static FString URLRequestStatus_IoPending(TEXT("IO_PENDING"));
-	const static FString URLRequestStatus_Canceled(TEXT("CANCELED"));
-	const static FString URLRequestStatus_Failed(TEXT("FAILED"));
-	const static FString URLRequestStatus_Unknown(TEXT("UNKNOWN"));
+	const static FName URLRequestStatus_Success(TEXT("SUCCESS"));
+	const static FName URLRequestStatus_IoPending(TEXT("IO_PENDING"));
+	const static FName URLRequestStatus_Canceled(TEXT("CANCELED"));
+	const static FName URLRequestStatus_Failed(TEXT("FAILED"));
+	const static FName URLRequestStatus_Unknown(TEXT("UNKNOWN"));
 
-	FString StatusStr;
 	switch (Status)
 	{
 	case CefResourceRequestHandler::URLRequestStatus::UR_SUCCESS:
-		StatusStr = URLRequestStatus_Success;
-		break;
+		return URLRequestStatus_Success;
 	case CefResourceRequestHandler::URLRequestStatus::UR_IO_PENDING:
-		StatusStr = URLRequestStatus_IoPending;
-		break;
+		return URLRequestStatus_IoPending;
 	case CefResourceRequestHandler::URLRequestStatus::UR_CANCELED:
-		StatusStr = URLRequestStatus_Canceled;
-		break;
+		return URLRequestStatus_Canceled;
 	case CefResourceRequestHandler::URLRequestStatus::UR_FAILED:
-		StatusStr = URLRequestStatus_Failed;
-		break;
-	case CefResourceRequestHandler::URLRequestStatus::UR_UNKNOWN:
-		StatusStr = URLRequestStatus_Unknown;
-		break;
+		return URLRequestStatus_Failed;
 	default:
-		StatusStr = URLRequestStatus_Unknown;
-		break;
+		return URLRequestStatus_Unknown;
 	}
-	return StatusStr;
 }
 
-void FCEFWebBrowserWindow::HandleOnBeforeResourceLoad(const CefString& URL, CefRequest::ResourceType Type, FRequestHeaders& AdditionalHeaders, const bool AllowUserCredentials)
+void FCEFWebBrowserWindow::HandleOnBeforeResourceLoad(CefRefPtr<CefRequest> Request, CefRequest::ResourceType Type, FRequestHeaders& AdditionalHeaders, const bool AllowUserCredentials)
 {
-	BeforeResourceLoadDelegate.ExecuteIfBound(WCHAR_TO_TCHAR(URL.ToWString().c_str()), ResourceTypeToString(Type), AdditionalHeaders, AllowUserCredentials);
+	const FCEFResourceRequest ResourceRequest(Request, Type, AllowUserCredentials);
+	if (BeforeResourceLoadDelegate.IsBound())
+	{
+		BeforeResourceLoadDelegate.Execute(ResourceRequest.GetUrl(), ResourceRequest.GetResourceType().ToString(), AdditionalHeaders, AllowUserCredentials);
+	}
+	BeforeResourceRequestDelegate.ExecuteIfBound(ResourceRequest, AdditionalHeaders);
 }
 
-void FCEFWebBrowserWindow::HandleOnResourceLoadComplete(const CefString& URL, CefRequest::ResourceType Type, CefResourceRequestHandler::URLRequestStatus Status, int64 ContentLength)
+void FCEFWebBrowserWindow::HandleOnResourceLoadComplete(CefRefPtr<CefRequest> Request, CefRequest::ResourceType Type, CefResourceRequestHandler::URLRequestStatus Status, int64 ContentLength)
 {
-	ResourceLoadCompleteDelegate.ExecuteIfBound(WCHAR_TO_TCHAR(URL.ToWString().c_str()), ResourceTypeToString(Type), URLRequestSTatusToString(Status), ContentLength);
+	const FCEFResourceRequest ResourceRequest(Request, Type, false);
+	if (ResourceLoadCompleteDelegate.IsBound())
+	{
+		ResourceLoadCompleteDelegate.Execute(ResourceRequest.GetUrl(), ResourceRequest.GetResourceType().ToString(), URLRequestStatusToName(Status).ToString(), ContentLength);
+	}
+	ResourceRequestCompleteDelegate.ExecuteIfBound(ResourceRequest, URLRequestStatusToName(Status), ContentLength);
 }
 
 EWebBrowserConsoleLogSeverity CefLogSeverityToWebBrowser(cef_log_severity_t Level)
@@ -2561,6 +3367,11 @@ CefMouseEvent FCEFWebBrowserWindow::GetCefMouseEvent(const FGeometry& MyGeometry
 
 
 	FVector2D LocalPos = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()) * DPIScale;
+	if (!bIsPopup && ResizePolicy.HasPendingResize() && ViewportSize != FIntPoint::ZeroValue)
+	{
+		// While a resize is held back the last frame is stretched to the widget, so map the position back onto the size CEF renders at
+		LocalPos *= FVector2D(ViewportSize) / FVector2D(RequestedViewportSize);
+	}
 	if (bIsPopup)
 	{
 		LocalPos += PopupPosition;
@@ -2610,22 +3421,27 @@ int32 FCEFWebBrowserWindow::GetCefInputModifiers(const FInputEvent& InputEvent)
 }
 
 bool FCEFWebBrowserWindow::CanSupportAcceleratedPaint()
+{
+	return SelectAcceleratedPaintBackend() != ECEFAcceleratedPaintBackend::None;
+}
+
+ECEFAcceleratedPaintBackend FCEFWebBrowserWindow::SelectAcceleratedPaintBackend()
 {
 	static bool DisableAcceleratedPaint = FParse::Param(FCommandLine::Get(), TEXT("nocefaccelpaint"));
 	if (DisableAcceleratedPaint)
 	{
-		return false;
+		return ECEFAcceleratedPaintBackend::None;
 	}
 
 	// Use off screen rendering so we can integrate with our windows
 #if PLATFORM_LINUX
-	return false;
+	return FCEFWebBrowserWindowRHIHelper::GetSelectedBackend();
 #elif PLATFORM_WINDOWS
-	return FCEFWebBrowserWindowRHIHelper::BUseSupportedRHIRenderer();
+	return FCEFWebBrowserWindowRHIHelper::GetSelectedBackend();
 #elif PLATFORM_MAC
-	return false; // Needs RHI support for the CreateSharedHandleTexture call
+	return ECEFAcceleratedPaintBackend::None; // Needs RHI support for the CreateSharedHandleTexture call
 #else
-	return false;
+	return ECEFAcceleratedPaintBackend::None;
 #endif
 
 }
@@ -2671,6 +3487,12 @@ void FCEFWebBrowserWindow::CheckTickActivity()
 #endif
 	}
 
+	// Ticking widgets can still be fully transparent, see SWebBrowserView::OnPaint
+	if (bTickedLastFrame)
+	{
+		UpdateOcclusion();
+	}
+
 	bTickedLastFrame = false;
 }
 
@@ -2735,6 +3557,15 @@ void FCEFWebBrowserWindow::SetIsHidden(bool bValue)
 		return;
 	}
 	bIsHidden = bValue;
+	if (IdleFrameRate > 0)
+	{
+		// A browser coming into view gets the full rate for the idle delay, as if it had just been interacted with
+		if (!bIsHidden)
+		{
+			LastInteractionTime = FPlatformTime::Seconds();
+		}
+		ApplyFrameRate(IsIdle(FPlatformTime::Seconds()));
+	}
 	if ( IsValid() )
 	{
 		CefRefPtr<CefBrowserHost> BrowserHost = InternalCefBrowser->GetHost();
@@ -2847,6 +3678,8 @@ CefRefPtr<CefDictionaryValue> FCEFWebBrowserWindow::GetProcessInfo()
 		Retval = CefDictionaryValue::Create();
 		Retval->SetInt("browser", InternalCefBrowser->GetIdentifier());
 		Retval->SetDictionary("bindings", Scripting->GetPermanentBindings());
+		// Lets the render process know that bound objects carry handles and calls may be batched
+		Retval->SetBool("batchedTransport", FCEFJSScripting::IsBatchedTransportEnabled());
 	}
 	return Retval;
 }
@@ -2898,6 +3731,21 @@ void FCEFWebBrowserWindow::SetNeedsResize(const bool bInValue)
 	bNeedsResize = bInValue;
 }
 
+const FCEFPaintUploadStats& FCEFWebBrowserWindow::GetLastPaintUploadStats(bool bIsPopup) const
+{
+	return PaintRegionUploaders[bIsPopup ? PET_POPUP : PET_VIEW].GetLastStats();
+}
+
+int32 FCEFWebBrowserWindow::GetBufferedVideoFrames() const
+{
+	return BufferedVideoFrames;
+}
+
+const FCEFBufferedVideoStats* FCEFWebBrowserWindow::GetBufferedVideoStats() const
+{
+	return BufferedVideo.IsValid() ? &BufferedVideo->GetStats() : nullptr;
+}
+
 bool FCEFWebBrowserWindow::OnProcessMessageReceived(CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> frame, CefProcessId SourceProcess, CefRefPtr<CefProcessMessage> Message)
 {
 	if (IsClosing())
@@ -2980,8 +3828,9 @@ void FCEFWebBrowserWindow::OnBrowserClosed()
 
 void FCEFWebBrowserWindow::SetPopupMenuPosition(CefRect CefPopupSize)
 {
-	// We only store the position, as the size will be provided ib the OnPaint call.
+	// OnPaint provides the size, OnAcceleratedPaint may only provide the dirty part of the popup
 	PopupPosition = FIntPoint(CefPopupSize.x, CefPopupSize.y);
+	PopupPixelSize = (FVector2D(CefPopupSize.width, CefPopupSize.height) * ViewportDPIScaleFactor).IntPoint();
 }
 
 void FCEFWebBrowserWindow:: ShowPopupMenu(bool bShow)
@@ -2994,6 +3843,7 @@ void FCEFWebBrowserWindow:: ShowPopupMenu(bool bShow)
 	{
 		bPopupHasFocus = false;
 		bShowPopupRequested = false;
+		EndPopupCompositing();
 		OnDismissPopup().Broadcast();
 	}
 }
@@ -17,6 +17,10 @@
 #include "CEFLibCefIncludes.h"
 
 #include "CapturedCefBuffer.h"
+#include "CEFAcceleratedPaintBackend.h"
+#include "CEFPaintRegionUploader.h"
+#include "CEFResizePolicy.h"
+#include "CEFTextureUploadScheduler.h"
 
 #endif
 
@@ -37,6 +41,7 @@ class FWebJSScripting;
 class FCEFImeHandler;
 class ITextInputMethodSystem;
 class FCEFWebBrowserWindowRHIHelper;
+class FCEFWebBrowserWindowRegistry;
 
 #if WITH_CEF3
 
@@ -67,11 +72,36 @@ struct FWebBrowserDragRegion
 	bool bDraggable;
 };
 
+/**
+ * Frame accounting for the buffered video path.
+ */
+struct FCEFBufferedVideoStats
+{
+	/** Frames received from CEF. */
+	uint64 NumSubmitted = 0;
+
+	/** Frames uploaded to the view texture. */
+	uint64 NumPresented = 0;
+
+	/** Frames overwritten in the ring before they could be presented. */
+	uint64 NumDropped = 0;
+
+	/** Frames presented more than one engine tick after they were received. */
+	uint64 NumLate = 0;
+
+	/** Engine ticks that repeated the previous frame because none was ready. */
+	uint64 NumDuplicated = 0;
+
+	/** Submissions that had to allocate because the render thread was still reading the recycled buffer. */
+	uint64 NumPoolMisses = 0;
+};
+
 /**
  * Implementation of interface for dealing with a Web Browser window.
  */
 class FCEFWebBrowserWindow
 	: public IWebBrowserWindow
+	, public ICEFDeferredUploadTarget
 	, public TSharedFromThis<FCEFWebBrowserWindow>
 {
 	// Allow the Handler to access functions only it needs
@@ -95,8 +125,10 @@ private:
 	 * @param bThumbMouseButtonNavigation Whether to allow forward and back navigation via the mouse thumb buttons.
 	 * @param bUseTransparency Whether to enable transparency.
 	 * @param bJSBindingToLoweringEnabled Whether we ToLower all JavaScript member names.
+	 * @param AcceleratedPaintBackend The backend copying accelerated paints, None if the accelerated paint path is not used.
+	 * @param BufferedVideoFrames Depth of the buffered video ring, or 0 to upload frames as soon as they are painted.
 	 */
-	FCEFWebBrowserWindow(CefRefPtr<CefBrowser> Browser, CefRefPtr<FCEFBrowserHandler> Handler, FString Url, TOptional<FString> ContentsToLoad, bool bShowErrorMessage, bool bThumbMouseButtonNavigation, bool bUseTransparency, bool bJSBindingToLoweringEnabled, bool bUsingAcceleratedPaint);
+	FCEFWebBrowserWindow(CefRefPtr<CefBrowser> Browser, CefRefPtr<FCEFBrowserHandler> Handler, FString Url, TOptional<FString> ContentsToLoad, bool bShowErrorMessage, bool bThumbMouseButtonNavigation, bool bUseTransparency, bool bJSBindingToLoweringEnabled, ECEFAcceleratedPaintBackend AcceleratedPaintBackend, int32 BufferedVideoFrames);
 
 	/**
 	 * Create the SWidget for this WebBrowserWindow
@@ -111,6 +143,7 @@ public:
 	bool IsThumbMouseButtonNavigationEnabled() const { return bThumbMouseButtonNavigation; }
 	bool UseTransparency() const { return bUseTransparency; }
 	bool UsingAcceleratedPaint() const { return bUsingAcceleratedPaint; }
+	ECEFAcceleratedPaintBackend GetAcceleratedPaintBackend() const { return AcceleratedPaintBackend; }
 	
 public:
 
@@ -248,6 +281,26 @@ public:
 		return ResourceLoadCompleteDelegate;
 	}
 
+	virtual FOnBeforeResourceRequestDelegate& OnBeforeResourceRequest() override
+	{
+		if (!WebBrowserHandler->OnBeforeResourceLoad().IsBoundToObject(this))
+		{
+			WebBrowserHandler->OnBeforeResourceLoad().BindSP(this, &FCEFWebBrowserWindow::HandleOnBeforeResourceLoad);
+		}
+
+		return BeforeResourceRequestDelegate;
+	}
+
+	virtual FOnResourceRequestCompleteDelegate& OnResourceRequestComplete() override
+	{
+		if (!WebBrowserHandler->OnResourceLoadComplete().IsBoundToObject(this))
+		{
+			WebBrowserHandler->OnResourceLoadComplete().BindSP(this, &FCEFWebBrowserWindow::HandleOnResourceLoadComplete);
+		}
+
+		return ResourceRequestCompleteDelegate;
+	}
+
 	virtual FOnConsoleMessageDelegate& OnConsoleMessage() override
 	{
 		if (!WebBrowserHandler->OnConsoleMessage().IsBoundToObject(this))
@@ -381,6 +434,15 @@ private:
 		const CefAcceleratedPaintInfo& Info);
 #endif
 
+	/**
+	 * Updates the performance counters for a paint.
+	 *
+	 * @param Type Paint type.
+	 * @param DirtyRects List of image areas that have been changed.
+	 * @param UploadedBytes Bytes copied to the texture for the paint.
+	 */
+	void RecordPaint(CefRenderHandler::PaintElementType Type, const CefRenderHandler::RectList& DirtyRects, uint64 UploadedBytes);
+
 	/**
 	 * Called when cursor would change due to web browser interaction.
 	 *
@@ -410,8 +472,8 @@ private:
 	 */
 	bool OnBeforeBrowse(CefRefPtr<CefBrowser> Browser, CefRefPtr<CefFrame> Frame, CefRefPtr<CefRequest> Request, bool user_gesture, bool bIsRedirect);
 
-	void HandleOnBeforeResourceLoad(const CefString& URL, CefRequest::ResourceType Type, FRequestHeaders& AdditionalHeaders, const bool AllowUserCredentials);
-	void HandleOnResourceLoadComplete(const CefString& URL, CefRequest::ResourceType Type, CefResourceRequestHandler::URLRequestStatus Status, int64 ContentLength);
+	void HandleOnBeforeResourceLoad(CefRefPtr<CefRequest> Request, CefRequest::ResourceType Type, FRequestHeaders& AdditionalHeaders, const bool AllowUserCredentials);
+	void HandleOnResourceLoadComplete(CefRefPtr<CefRequest> Request, CefRequest::ResourceType Type, CefResourceRequestHandler::URLRequestStatus Status, int64 ContentLength);
 	void HandleOnConsoleMessage(CefRefPtr<CefBrowser> Browser, cef_log_severity_t Level, const CefString& Message, const CefString& Source, int32 Line);
 
 	/**
@@ -463,6 +525,11 @@ private:
 	 */
 	void OnRenderProcessTerminated(CefRequestHandler::TerminationStatus Status);
 
+	/**
+	 * Called when the main frame starts loading a new document.
+	 */
+	void OnMainFrameLoadStart();
+
 
 	/** Called when the browser requests a new UI window
 	 *
@@ -547,6 +614,13 @@ public:
 	 * @return true if supported AND enabled on this platform, false otherwise.
 	 */
 	static bool CanSupportAcceleratedPaint();
+
+	/**
+	 * Selects the backend new browser windows copy accelerated paints with. Windows keep the backend they were created with.
+	 *
+	 * @return The selected backend, None if accelerated paint is not supported or disabled.
+	 */
+	static ECEFAcceleratedPaintBackend SelectAcceleratedPaintBackend();
 public:
 
 	/**
@@ -560,11 +634,72 @@ public:
 	 */
 	void CheckTickActivity() override;
 
+	/** @return whether the browser is currently hidden, because the widget stopped ticking or the browser is disabled. */
+	bool IsHidden() const
+	{
+		return bIsHidden;
+	}
+
+	virtual void SetResourceRules(const FWebBrowserResourceRules& Rules) override;
+	virtual FWebBrowserWindowPerfStats GetPerfStats() const override;
+	virtual void SetFrameRate(int32 FrameRate) override;
+	virtual int32 GetFrameRate() const override;
+	virtual void SetIdleFrameRate(int32 IdleFrameRate) override;
+	virtual int32 GetIdleFrameRate() const override;
+	virtual void SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy) override;
+	virtual void SetIsOccluded(bool bInIsOccluded) override;
+
 	/**
 	* Called from the engine tick.
 	*/
 	void UpdateVideoBuffering();
 
+	/**
+	 * Called from the engine tick. Drops the browser to its idle frame rate, or restores its active rate, as its visibility and focus change.
+	 *
+	 * @param bAppIsFocused Whether the application is the foreground OS app.
+	 */
+	void UpdateFrameRate(bool bAppIsFocused);
+
+	/**
+	 * Called from the engine tick, after the message pump. Sends the JS results queued by the batched transport.
+	 */
+	void FlushBatchedScriptResults();
+
+	/**
+	 * Called when the window is returned to the browser pool. Unbinds all delegates and script bindings, hides the browser, clears its textures and navigates to about:blank.
+	 */
+	void ResetForReuse();
+
+	/** Sets the key of the browser pool this window can be returned to. Empty if the window can't be pooled. */
+	void SetBrowserPoolKey(const FString& InBrowserPoolKey)
+	{
+		BrowserPoolKey = InBrowserPoolKey;
+	}
+
+	/** @return the key of the browser pool this window can be returned to. */
+	const FString& GetBrowserPoolKey() const
+	{
+		return BrowserPoolKey;
+	}
+
+	/** Called by the registry tracking this window, which the window is removed from when it is destroyed. */
+	void SetWindowRegistry(const TSharedRef<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe>& InWindowRegistry, int32 InRegisteredBrowserId)
+	{
+		WindowRegistry = InWindowRegistry;
+		RegisteredBrowserId = InRegisteredBrowserId;
+	}
+
+	/** Sets the scheduler budgeting the texture uploads of this window. Paints are uploaded right away without one. */
+	void SetUploadScheduler(const TSharedRef<FCEFTextureUploadScheduler, ESPMode::ThreadSafe>& InUploadScheduler)
+	{
+		UploadScheduler = InUploadScheduler;
+	}
+
+	// ICEFDeferredUploadTarget Interface
+	/** Called by the upload scheduler to upload the paints it deferred. */
+	virtual void FlushDeferredUpload(CefRenderHandler::PaintElementType Type) override;
+
 	/**
 	 * Called on every browser window when CEF launches a new render process.
 	 * Used to ensure global JS objects are registered as soon as possible.
@@ -601,6 +736,27 @@ public:
 	 * Set if a resize is needed.
 	 */
 	WEBBROWSER_API void SetNeedsResize(const bool bInValue);
+
+	/**
+	 * Gets the upload counters of the most recent paint.
+	 *
+	 * @param bIsPopup Whether to get the counters of the popup texture rather than the view.
+	 */
+	WEBBROWSER_API const FCEFPaintUploadStats& GetLastPaintUploadStats(bool bIsPopup = false) const;
+
+	/**
+	 * Gets the depth of the buffered video ring.
+	 *
+	 * @return The number of buffered frames, or 0 if paints are uploaded directly.
+	 */
+	int32 GetBufferedVideoFrames() const;
+
+	/**
+	 * Gets the frame accounting of the buffered video path.
+	 *
+	 * @return The stats, or nullptr if this window doesn't buffer video.
+	 */
+	WEBBROWSER_API const FCEFBufferedVideoStats* GetBufferedVideoStats() const;
 	
 private:
 
@@ -616,6 +772,30 @@ private:
 	/** Creates the initial updatable textures */
 	bool CreateInitialTextures();
 
+	/** Makes UpdatableTextures[PET_POPUP] a texture of the given size, taken from or returned to the popup texture pool. */
+	void AcquirePopupTexture(const FIntPoint& Size);
+
+	/** Releases the pooled popup textures, while they are still of the current paint mode. */
+	void ReleasePopupTexturePool();
+
+	/** @return where a popup of the given size in pixels is drawn in the view texture. */
+	FIntRect GetPopupRectInView(int32 Width, int32 Height) const;
+
+	/** @return whether a popup of the given size in pixels should be composited into the view. */
+	bool ShouldCompositePopup(int32 Width, int32 Height) const;
+
+	/** Copies the popup buffer and draws it over the view texture. */
+	void CompositePopup(const void* Buffer, int32 Width, int32 Height);
+
+	/** Stops compositing the popup, and has CEF repaint the part of the view it covered. */
+	void EndPopupCompositing();
+
+	/** Draws the composited popup over the view texture again, if any of the dirty rects uploaded to the view covers it. An empty list covers it. */
+	void RedrawCompositedPopup(const CefRenderHandler::RectList& DirtyRects);
+
+	/** @return the priority of this window's deferred texture uploads. */
+	ECEFUploadPriority GetUploadPriority() const;
+
 	/** Executes or defers a LoadUrl navigation */
 	void RequestNavigationInternal(FString Url, FString Contents);
 
@@ -628,6 +808,21 @@ private:
 	/** Helper that calls WasHidden on the CEF host object when the value changes */
 	void SetIsHidden(bool bValue);
 
+	/** @return whether the browser should render at its idle frame rate. */
+	bool IsIdle(double Now) const;
+
+	/** Called by the input handlers. Restores the active frame rate if the browser was idle. */
+	void NotifyInteraction();
+
+	/** Sets the CEF frame rate to the idle or active rate, if it changed. */
+	void ApplyFrameRate(bool bIdle);
+
+	/** Called from CheckTickActivity. Hides or throttles the browser once its widget has been occluded for long enough. */
+	void UpdateOcclusion();
+
+	/** Shows or restores the frame rate of a browser that was hidden or throttled because of occlusion. */
+	void EndOcclusion();
+
 	/** Used by the key down and up handlers to convert Slate key events to the CEF equivalent. */
 	void PopulateCefKeyEvent(const FKeyEvent& InKeyEvent, CefKeyEvent& OutKeyEvent);
 
@@ -651,6 +846,16 @@ private:
 	/** Interface to the texture we are rendering to. */
 	FSlateUpdatableTexture* UpdatableTextures[2];
 
+	/** Uploads the dirty regions of OnPaint buffers into UpdatableTextures. */
+	FCEFPaintRegionUploader PaintRegionUploaders[2];
+
+	/** Popup textures of recently shown sizes not currently in use, the most recently used last. */
+	TArray<FSlateUpdatableTexture*, TInlineAllocator<4>> PooledPopupTextures;
+
+	/** Copy of the popup being composited into the view, and where it is drawn in view pixels. Empty while popups are drawn by Slate. */
+	TArray<uint8> CompositedPopupPixels;
+	FIntRect CompositedPopupRect;
+
 	/** Pointer to the CEF Browser for this window. */
 	CefRefPtr<CefBrowser> InternalCefBrowser;
 
@@ -699,6 +904,9 @@ private:
 	/** Whether the accelerated paint path is enabled (i.e shared texture handles) */
 	bool bUsingAcceleratedPaint;
 
+	/** Backend copying accelerated paints, selected when the window was created */
+	ECEFAcceleratedPaintBackend AcceleratedPaintBackend;
+
 	/** Delegate for broadcasting title changes. */
 	FOnTitleChanged TitleChangedEvent;
 
@@ -729,6 +937,10 @@ private:
 	/** Delegate that allows for responses to resource loads */
 	FOnResourceLoadCompleteDelegate ResourceLoadCompleteDelegate;
 
+	/** Delegates for the same, passing the request details unconverted */
+	FOnBeforeResourceRequestDelegate BeforeResourceRequestDelegate;
+	FOnResourceRequestCompleteDelegate ResourceRequestCompleteDelegate;
+
 	/** Delegate that allows for response to console logs.  Typically used to capture and mirror web logs in client application logs. */
 	FOnConsoleMessageDelegate ConsoleMessageDelegate;
 
@@ -792,6 +1004,8 @@ private:
 	bool bSupportsMouseWheel;
 
 	FIntPoint PopupPosition;
+	/** Size of the popup in pixels, as CEF paints it */
+	FIntPoint PopupPixelSize;
 	bool bShowPopupRequested;
 
 	/** This is set to true when reloading after render process crash. */
@@ -808,6 +1022,51 @@ private:
 	/** Used to store the url of pending navigation requests while we need to defer navigations. */
 	FString PendingLoadUrl;
 
+	/** Depth of the buffered video ring, 0 when disabled. */
+	int32 BufferedVideoFrames;
+
+	/** Key of the browser pool this window can be returned to, empty if it can't be pooled. */
+	FString BrowserPoolKey;
+
+	/** The registry tracking this window, and the CEF browser id it is tracked under. */
+	TWeakPtr<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe> WindowRegistry;
+	int32 RegisteredBrowserId = INDEX_NONE;
+
+	/** The scheduler budgeting texture uploads across windows. */
+	TWeakPtr<FCEFTextureUploadScheduler, ESPMode::ThreadSafe> UploadScheduler;
+
+	/** Frame rate the browser was created with, restored when it returns to the pool. */
+	int32 CreationFrameRate = 0;
+
+	/** Frame rates while active and idle (0 to never drop to an idle rate), and the rate last passed to CEF. */
+	int32 ActiveFrameRate = 0;
+	int32 IdleFrameRate = 0;
+	int32 AppliedFrameRate = 0;
+	bool bIdleFrameRateApplied = false;
+
+	/** Time of the last input or focus change, and whether the application was in the foreground on the last engine tick. */
+	double LastInteractionTime = 0.0;
+	bool bAppHasFocus = true;
+
+	/** What to do while the widget is occluded. */
+	EWebBrowserOcclusionPolicy OcclusionPolicy = EWebBrowserOcclusionPolicy::NeverHide;
+
+	/** Whether the widget was occluded when it last painted, and since when. */
+	bool bIsOccluded = false;
+	double OccludedSinceTime = 0.0;
+
+	/** Whether the browser is currently hidden or throttled because of occlusion. */
+	bool bHiddenByOcclusion = false;
+	bool bThrottledByOcclusion = false;
+
+	/** Decides which widget sizes are passed on to CEF, and the latest size of the widget. */
+	FCEFResizePolicy ResizePolicy;
+	FIntPoint RequestedViewportSize = FIntPoint::ZeroValue;
+
+	/** Performance counters, and the time of the oldest view paint not yet presented (negative when there is none). */
+	FWebBrowserWindowPerfStats PerfStats;
+	double UnpresentedPaintTime;
+
 	TUniquePtr<FBrowserBufferedVideo> BufferedVideo;
 #if PLATFORM_MAC
 	void *LastPaintedSharedHandle;
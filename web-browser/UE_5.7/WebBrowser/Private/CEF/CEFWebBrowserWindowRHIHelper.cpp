@@ -6,6 +6,8 @@
 #if WITH_CEF3
 
 #include "CEF/CEFWebBrowserWindow.h"
+#include "HAL/IConsoleManager.h"
+#include "WebBrowserStats.h"
 #if WITH_ENGINE
 #include "RHI.h"
 #if PLATFORM_WINDOWS
@@ -14,7 +16,24 @@
 #endif
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("CEF Accelerated Paint Copy (D3D)"), STAT_CEFAcceleratedPaintCopyD3D, STATGROUP_WebBrowser);
+DECLARE_CYCLE_STAT(TEXT("CEF Accelerated Paint Copy (SharedMemory)"), STAT_CEFAcceleratedPaintCopySharedMemory, STATGROUP_WebBrowser);
+DECLARE_CYCLE_STAT(TEXT("CEF Accelerated Paint Copy (Null)"), STAT_CEFAcceleratedPaintCopyNull, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Accelerated Paint Copies"), STAT_CEFAcceleratedPaintCopies, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Accelerated Paint Failed Copies"), STAT_CEFAcceleratedPaintFailedCopies, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Accelerated Paint Bytes Copied"), STAT_CEFAcceleratedPaintBytesCopied, STATGROUP_WebBrowser);
+
+static int32 CEFAcceleratedPaintBackend = static_cast<int32>(ECEFAcceleratedPaintBackend::None);
+static FAutoConsoleVariableRef CVarCEFAcceleratedPaintBackend(
+	TEXT("webbrowser.AcceleratedPaint.Backend"),
+	CEFAcceleratedPaintBackend,
+	TEXT("How frames CEF paints on the GPU reach Slate, applied to browsers created afterwards. 0: automatic (D3D shared textures on Windows, CPU paint elsewhere), 1: D3D shared textures, 2: shared memory (Linux), 3: null, which copies frames without rendering them, for tests. Unsupported choices fall back to CPU paint\n"),
+	ECVF_Default);
+
 #if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#include "Microsoft/COMPointer.h"
+
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "d3d11_1.h"
 #include "d3d12.h"
@@ -61,8 +80,48 @@ static TComPtr<IDXGIAdapter> GetDXGIAdapterFromRHI()
 }
 #endif // PLATFORM_WINDOWS
 
+static TStatId GetCopyStatId(ECEFAcceleratedPaintBackend BackendType)
+{
+	switch (BackendType)
+	{
+	case ECEFAcceleratedPaintBackend::D3DSharedTexture:
+		return GET_STATID(STAT_CEFAcceleratedPaintCopyD3D);
+	case ECEFAcceleratedPaintBackend::SharedMemory:
+		return GET_STATID(STAT_CEFAcceleratedPaintCopySharedMemory);
+	default:
+		return GET_STATID(STAT_CEFAcceleratedPaintCopyNull);
+	}
+}
+
+/**
+ * Copies the frames CEF paints into shared D3D11 textures to shared Slate textures, using a D3D11 device created on the adapter of the RHI.
+ */
+class FCEFD3DSharedTextureBackend : public ICEFAcceleratedPaintBackend
+{
+public:
+	FCEFD3DSharedTextureBackend();
 
-FCEFWebBrowserWindowRHIHelper::FCEFWebBrowserWindowRHIHelper()
+	virtual ECEFAcceleratedPaintBackend GetType() const override
+	{
+		return ECEFAcceleratedPaintBackend::D3DSharedTexture;
+	}
+
+	virtual FSlateUpdatableTexture* CreateTexture(const FUintPoint& TextureSize) override;
+	virtual void ReleaseTexture(FSlateUpdatableTexture* SlateTexture) override;
+	virtual bool CopyPaint(FSlateUpdatableTexture* SlateTexture, const FCEFAcceleratedPaintInfo& Paint, uint64& OutBytesCopied) override;
+
+private:
+	bool EnsureShareable(FSlateUpdatableTexture* SlateTexture);
+
+	TMap<FSlateUpdatableTexture*, TSharedPtr<void>> SlateTextureHandles;
+
+#if PLATFORM_WINDOWS
+	TComPtr<ID3D11Device> D3D11Device;
+	TComPtr<ID3D11DeviceContext> D3D11DeviceContext;
+#endif // PLATFORM_WINDOWS
+};
+
+FCEFD3DSharedTextureBackend::FCEFD3DSharedTextureBackend()
 {
 #if WITH_ENGINE
 #if PLATFORM_WINDOWS
@@ -78,60 +137,16 @@ FCEFWebBrowserWindowRHIHelper::FCEFWebBrowserWindowRHIHelper()
 	if (HRESULT Hr = D3D11CreateDevice(DXGIAdapter.Get(), DXGIAdapter.Get() ? D3D_DRIVER_TYPE_UNKNOWN : D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, FeatureLevels, UE_ARRAY_COUNT(FeatureLevels), D3D11_SDK_VERSION,
 		&D3D11Device, nullptr, &D3D11DeviceContext); FAILED(Hr))
 	{
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::FCEFWebBrowserWindowRHIHelper() - - D3D11CreateDevice 0x%x"), Hr);
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::FCEFD3DSharedTextureBackend() - - D3D11CreateDevice 0x%x"), Hr);
 		return;
 	}
 #endif // PLATFORM_WINDOWS
 #endif // WITH_ENGINE
 }
 
-bool FCEFWebBrowserWindowRHIHelper::BUseSupportedRHIRenderer()
-{
-#if WITH_ENGINE
-	const ERHIInterfaceType RHIType = RHIGetInterfaceType();
-	// We only support D3D RHIs as we rely on the OpenSharedResource1 interface
-	return (RHIType == ERHIInterfaceType::D3D11 || RHIType == ERHIInterfaceType::D3D12)
-		// Disable during automation as the GPU process often fails to initialize on build machines
-		&& !GIsAutomationTesting && !GIsBuildMachine;
-#else
-	return false;
-#endif // WITH_ENGINE
-}
-
-uint64_t FCEFWebBrowserWindowRHIHelper::GetRHIAdapterLuid()
-{
-	uint64_t AdapterLuid = 0;
-
-#if WITH_ENGINE
-#if PLATFORM_WINDOWS
-	LUID Luid = {};
-
-	const ERHIInterfaceType RHIType = RHIGetInterfaceType();
-	if (RHIType == ERHIInterfaceType::D3D11)
-	{
-		TComPtr<IDXGIAdapter> DXGIAdapter = GetDXGIAdapterFromRHI();
-		DXGI_ADAPTER_DESC Desc = {};
-		if (SUCCEEDED(DXGIAdapter->GetDesc(&Desc)))
-		{
-			Luid = Desc.AdapterLuid;
-		}
-	}
-	else if (RHIType == ERHIInterfaceType::D3D12)
-	{
-		Luid = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice())->GetAdapterLuid();
-	}
-
-	AdapterLuid = (static_cast<uint64_t>(Luid.HighPart) << 32) | static_cast<uint64_t>(Luid.LowPart);
-#endif // PLATFORM_WINDOWS
-#endif // WITH_ENGINE
-
-	return AdapterLuid;
-}
-
-FSlateUpdatableTexture* FCEFWebBrowserWindowRHIHelper::CreateSlateUpdatableTexture(const FUintPoint& TextureSize)
+FSlateUpdatableTexture* FCEFD3DSharedTextureBackend::CreateTexture(const FUintPoint& TextureSize)
 {
 #if WITH_ENGINE
-	check(BUseSupportedRHIRenderer());
 #if PLATFORM_WINDOWS
 	// On Windows we need the slate texture to be shared so we can access it from the D3D device that lives in the OnAcceleratedPaint thread
 	FSlateTexture2DRHIRef* SlateTexture = new FSlateTexture2DRHIRef(TextureSize.X, TextureSize.Y, PF_B8G8R8A8, nullptr, ETextureCreateFlags::Shared | ETextureCreateFlags::RenderTargetable, true);
@@ -145,10 +160,9 @@ FSlateUpdatableTexture* FCEFWebBrowserWindowRHIHelper::CreateSlateUpdatableTextu
 #endif // WITH_ENGINE
 }
 
-void FCEFWebBrowserWindowRHIHelper::ReleaseSlateUpdatableTexture(FSlateUpdatableTexture* SlateTexture)
+void FCEFD3DSharedTextureBackend::ReleaseTexture(FSlateUpdatableTexture* SlateTexture)
 {
 #if WITH_ENGINE
-	check(BUseSupportedRHIRenderer());
 #if PLATFORM_WINDOWS
 	if (!SlateTexture)
 	{
@@ -165,12 +179,12 @@ void FCEFWebBrowserWindowRHIHelper::ReleaseSlateUpdatableTexture(FSlateUpdatable
 #endif // WITH_ENGINE
 }
 
-bool FCEFWebBrowserWindowRHIHelper::EnsureShareable(FSlateUpdatableTexture* SlateTexture)
+bool FCEFD3DSharedTextureBackend::EnsureShareable(FSlateUpdatableTexture* SlateTexture)
 {
 #if WITH_ENGINE
 	if (!SlateTexture)
 	{
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::EnsureShareable() - Invalid SlateTexture"));
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::EnsureShareable() - Invalid SlateTexture"));
 		return false;
 	}
 
@@ -185,7 +199,7 @@ bool FCEFWebBrowserWindowRHIHelper::EnsureShareable(FSlateUpdatableTexture* Slat
 	if (!Slate2DRef.IsValid() || !Slate2DRef->GetNativeResource())
 	{
 		// If this happens frequently then we need to make the resource creation sync in CreateSlateUpdatableTexture
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::EnsureShareable() - SlateTexture is not ready!"));
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::EnsureShareable() - SlateTexture is not ready!"));
 		return false;
 	}
 
@@ -198,11 +212,11 @@ bool FCEFWebBrowserWindowRHIHelper::EnsureShareable(FSlateUpdatableTexture* Slat
 		TComPtr<IDXGIResource> DXGIResource;
 		if (HRESULT Hr = static_cast<ID3D11Texture2D*>(Slate2DRef->GetNativeResource())->QueryInterface(IID_PPV_ARGS(&DXGIResource)); FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::EnsureShareable() - - ID3D11Texture2D::QueryInterface 0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::EnsureShareable() - - ID3D11Texture2D::QueryInterface 0x%x"), Hr);
 		}
 		else if (Hr = DXGIResource->GetSharedHandle(&SharedHandle); FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::EnsureShareable() - - IDXGIResource::GetSharedHandle 0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::EnsureShareable() - - IDXGIResource::GetSharedHandle 0x%x"), Hr);
 		}
 
 		// GetSharedHandle returns a legacy non-NT handle, which must NOT be closed when we're done with it
@@ -212,7 +226,7 @@ bool FCEFWebBrowserWindowRHIHelper::EnsureShareable(FSlateUpdatableTexture* Slat
 	{
 		if (HRESULT Hr = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice())->CreateSharedHandle(static_cast<ID3D12Resource*>(Slate2DRef->GetNativeResource()), NULL, GENERIC_ALL, NULL, &SharedHandle); FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::EnsureShareable() - - ID3D12Device::CreateSharedHandle 0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::EnsureShareable() - - ID3D12Device::CreateSharedHandle 0x%x"), Hr);
 		}
 
 		// CreateSharedHandle returns a NT handle,. which must be closed when we're done with it
@@ -235,11 +249,12 @@ bool FCEFWebBrowserWindowRHIHelper::EnsureShareable(FSlateUpdatableTexture* Slat
 
 }
 
-bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture* SlateTexture, void* SharedHandle, const FIntRect& DirtyIn)
+bool FCEFD3DSharedTextureBackend::CopyPaint(FSlateUpdatableTexture* SlateTexture, const FCEFAcceleratedPaintInfo& Paint, uint64& OutBytesCopied)
 {
+	OutBytesCopied = 0;
 #if WITH_ENGINE
-	check(BUseSupportedRHIRenderer());
-	FIntRect Dirty = DirtyIn;
+	void* SharedHandle = Paint.SharedHandle;
+	FIntRect Dirty = Paint.DirtyRect;
 
 	if (!EnsureShareable(SlateTexture))
 	{
@@ -250,14 +265,14 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 	TComPtr<ID3D11Device1> D3D11Device1;
 	if (HRESULT Hr = D3D11Device->QueryInterface(IID_PPV_ARGS(&D3D11Device1)); FAILED(Hr))
 	{
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - - ID3D11Device::QueryInterface 0x%x"), Hr);
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - - ID3D11Device::QueryInterface 0x%x"), Hr);
 		return false;
 	}
 
 	TComPtr<ID3D11Texture2D> SourceTexture;
 	if (HRESULT Hr = D3D11Device1->OpenSharedResource1((HANDLE)SharedHandle, IID_PPV_ARGS(&SourceTexture)); FAILED(Hr))
 	{
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - - ID3D11Device1::OpenSharedResource1 0x%x"), Hr);
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - - ID3D11Device1::OpenSharedResource1 0x%x"), Hr);
 		return false;
 	}
 
@@ -281,7 +296,7 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 	{
 		if (HRESULT Hr = D3D11Device->OpenSharedResource((HANDLE)SlateTextureHandles.FindRef(SlateTexture).Get(), IID_PPV_ARGS(&DestTexture)); FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - - ID3D11Device::OpenSharedResource 0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - - ID3D11Device::OpenSharedResource 0x%x"), Hr);
 			return false;
 		}
 	}
@@ -289,7 +304,7 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 	{
 		if (HRESULT Hr = D3D11Device1->OpenSharedResource1((HANDLE)SlateTextureHandles.FindRef(SlateTexture).Get(), IID_PPV_ARGS(&DestTexture)); FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - - ID3D11Device1::OpenSharedResource1 0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - - ID3D11Device1::OpenSharedResource1 0x%x"), Hr);
 			return false;
 		}
 	}
@@ -308,7 +323,7 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 	TComPtr<ID3D11Query> Query;
 	if (HRESULT Hr = D3D11Device1->CreateQuery(&QueryDesc, &Query); FAILED(Hr))
 	{
-		UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - ID3D11Device1::CreateQuery 0x%x"), Hr);
+		UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - ID3D11Device1::CreateQuery 0x%x"), Hr);
 		return false;
 	}
 	D3D11DeviceContext->End(Query.Get());
@@ -319,7 +334,7 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 		Hr = D3D11DeviceContext->GetData(Query.Get(), &bIsDone, sizeof(bIsDone), 0);
 		if (FAILED(Hr))
 		{
-			UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - ID3D11DeviceContext::GetData  0x%x"), Hr);
+			UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - ID3D11DeviceContext::GetData  0x%x"), Hr);
 			break;
 		}
 
@@ -338,13 +353,169 @@ bool FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync(FSlateUpdatableTexture
 
 	return true;
 #else
-	UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - missing implementation"));
+	UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - missing implementation"));
 	return false;
 #endif // PLATFORM_WINDOWS
 #else
-	UE_LOG(LogWebBrowser, Error, TEXT("FCEFWebBrowserWindowRHIHelper::CopySharedTextureSync() - unsupported usage, RHI renderer but missing engine"));
+	UE_LOG(LogWebBrowser, Error, TEXT("FCEFD3DSharedTextureBackend::CopyPaint() - unsupported usage, RHI renderer but missing engine"));
 	return false;
 #endif // WITH_ENGINE
 }
 
+FCEFWebBrowserWindowRHIHelper::FCEFWebBrowserWindowRHIHelper()
+	: FCEFWebBrowserWindowRHIHelper(GetSelectedBackend())
+{
+}
+
+FCEFWebBrowserWindowRHIHelper::FCEFWebBrowserWindowRHIHelper(ECEFAcceleratedPaintBackend BackendType)
+{
+	switch (BackendType)
+	{
+	case ECEFAcceleratedPaintBackend::D3DSharedTexture:
+		Backend = MakeUnique<FCEFD3DSharedTextureBackend>();
+		break;
+	case ECEFAcceleratedPaintBackend::SharedMemory:
+	case ECEFAcceleratedPaintBackend::Null:
+		Backend = MakeUnique<FCEFMappedPaintBackend>(BackendType, StagingPool);
+		break;
+	default:
+		break;
+	}
+
+	UE_LOG(LogWebBrowser, Verbose, TEXT("Using the %s accelerated paint backend"), GetBackendName(BackendType));
+}
+
+FCEFWebBrowserWindowRHIHelper::~FCEFWebBrowserWindowRHIHelper()
+{
+}
+
+bool FCEFWebBrowserWindowRHIHelper::BUseSupportedRHIRenderer()
+{
+	return GetSelectedBackend() != ECEFAcceleratedPaintBackend::None;
+}
+
+ECEFAcceleratedPaintBackend FCEFWebBrowserWindowRHIHelper::GetSelectedBackend()
+{
+	const ECEFAcceleratedPaintBackend Requested = static_cast<ECEFAcceleratedPaintBackend>(FMath::Clamp(CEFAcceleratedPaintBackend, 0, 3));
+#if WITH_ENGINE
+	const ERHIInterfaceType RHIType = RHIGetInterfaceType();
+	// We only support D3D RHIs as we rely on the OpenSharedResource1 interface
+	const bool bHasD3DRHI = (RHIType == ERHIInterfaceType::D3D11 || RHIType == ERHIInterfaceType::D3D12);
+	// Disable during automation as the GPU process often fails to initialize on build machines
+	const bool bIsGpuProcessReliable = !GIsAutomationTesting && !GIsBuildMachine;
+	return SelectBackend(Requested, bHasD3DRHI, FCEFMappedPaintBackend::CanMapBuffers(), bIsGpuProcessReliable);
+#else
+	return SelectBackend(Requested, false, false, false);
+#endif // WITH_ENGINE
+}
+
+ECEFAcceleratedPaintBackend FCEFWebBrowserWindowRHIHelper::SelectBackend(ECEFAcceleratedPaintBackend Requested, bool bHasD3DRHI, bool bCanMapBuffers, bool bIsGpuProcessReliable)
+{
+	switch (Requested)
+	{
+	case ECEFAcceleratedPaintBackend::SharedMemory:
+		return bCanMapBuffers && bIsGpuProcessReliable ? ECEFAcceleratedPaintBackend::SharedMemory : ECEFAcceleratedPaintBackend::None;
+	case ECEFAcceleratedPaintBackend::Null:
+		// The null backend never touches the RHI, but its frames still come from the CEF GPU process
+		return bCanMapBuffers && bIsGpuProcessReliable ? ECEFAcceleratedPaintBackend::Null : ECEFAcceleratedPaintBackend::None;
+	default:
+		// Mapping buffers costs a CPU copy, so Linux keeps the regular OnPaint path unless shared memory is requested
+		return bHasD3DRHI && bIsGpuProcessReliable ? ECEFAcceleratedPaintBackend::D3DSharedTexture : ECEFAcceleratedPaintBackend::None;
+	}
+}
+
+const TCHAR* FCEFWebBrowserWindowRHIHelper::GetBackendName(ECEFAcceleratedPaintBackend BackendType)
+{
+	switch (BackendType)
+	{
+	case ECEFAcceleratedPaintBackend::D3DSharedTexture:
+		return TEXT("D3D");
+	case ECEFAcceleratedPaintBackend::SharedMemory:
+		return TEXT("SharedMemory");
+	case ECEFAcceleratedPaintBackend::Null:
+		return TEXT("Null");
+	default:
+		return TEXT("None");
+	}
+}
+
+uint64_t FCEFWebBrowserWindowRHIHelper::GetRHIAdapterLuid()
+{
+	uint64_t AdapterLuid = 0;
+
+#if WITH_ENGINE
+#if PLATFORM_WINDOWS
+	LUID Luid = {};
+
+	const ERHIInterfaceType RHIType = RHIGetInterfaceType();
+	if (RHIType == ERHIInterfaceType::D3D11)
+	{
+		TComPtr<IDXGIAdapter> DXGIAdapter = GetDXGIAdapterFromRHI();
+		DXGI_ADAPTER_DESC Desc = {};
+		if (SUCCEEDED(DXGIAdapter->GetDesc(&Desc)))
+		{
+			Luid = Desc.AdapterLuid;
+		}
+	}
+	else if (RHIType == ERHIInterfaceType::D3D12)
+	{
+		Luid = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice())->GetAdapterLuid();
+	}
+
+	AdapterLuid = (static_cast<uint64_t>(Luid.HighPart) << 32) | static_cast<uint64_t>(Luid.LowPart);
+#endif // PLATFORM_WINDOWS
+#endif // WITH_ENGINE
+
+	return AdapterLuid;
+}
+
+FSlateUpdatableTexture* FCEFWebBrowserWindowRHIHelper::CreateSlateUpdatableTexture(const FUintPoint& TextureSize)
+{
+	return Backend.IsValid() ? Backend->CreateTexture(TextureSize) : nullptr;
+}
+
+void FCEFWebBrowserWindowRHIHelper::ReleaseSlateUpdatableTexture(FSlateUpdatableTexture* SlateTexture)
+{
+	if (Backend.IsValid())
+	{
+		Backend->ReleaseTexture(SlateTexture);
+	}
+}
+
+bool FCEFWebBrowserWindowRHIHelper::CopyAcceleratedPaint(FSlateUpdatableTexture* SlateTexture, const FCEFAcceleratedPaintInfo& Paint)
+{
+	if (!Backend.IsValid())
+	{
+		return false;
+	}
+
+	FScopeCycleCounter CycleCounter(GetCopyStatId(Backend->GetType()));
+	const double StartTime = FPlatformTime::Seconds();
+	uint64 BytesCopied = 0;
+	const bool bCopied = Backend->CopyPaint(SlateTexture, Paint, BytesCopied);
+	const double CopySeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (bCopied)
+	{
+		Stats.NumCopies++;
+		INC_DWORD_STAT(STAT_CEFAcceleratedPaintCopies);
+	}
+	else
+	{
+		Stats.NumFailedCopies++;
+		INC_DWORD_STAT(STAT_CEFAcceleratedPaintFailedCopies);
+	}
+	Stats.BytesCopied += BytesCopied;
+	Stats.TotalCopySeconds += CopySeconds;
+	Stats.MaxCopySeconds = FMath::Max(Stats.MaxCopySeconds, CopySeconds);
+	INC_DWORD_STAT_BY(STAT_CEFAcceleratedPaintBytesCopied, BytesCopied);
+
+	return bCopied;
+}
+
+ECEFAcceleratedPaintBackend FCEFWebBrowserWindowRHIHelper::GetBackendType() const
+{
+	return Backend.IsValid() ? Backend->GetType() : ECEFAcceleratedPaintBackend::None;
+}
+
 #endif
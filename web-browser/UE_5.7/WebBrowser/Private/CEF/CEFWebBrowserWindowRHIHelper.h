@@ -7,45 +7,73 @@
 #if WITH_CEF3
 
 #include "Layout/Geometry.h"
+#include "CEF/CEFAcceleratedPaintBackend.h"
+#include "CEF/CEFPaintRegionUploader.h"
 
 class FSlateUpdatableTexture;
 
-#if PLATFORM_WINDOWS
-#include "Windows/WindowsHWrapper.h"
-#include "Microsoft/COMPointer.h"
-
-#include "Windows/AllowWindowsPlatformTypes.h"
-#include "d3d11.h"
-#include "Windows/HideWindowsPlatformTypes.h"
-#endif // PLATFORM_WINDOWS
-
 /**
- * Implementation of RHI renderer details for the CEF accelerated rendering path
+ * Implementation of RHI renderer details for the CEF accelerated rendering path.
+ * Frames are copied by the backend selected with webbrowser.AcceleratedPaint.Backend, see ECEFAcceleratedPaintBackend.
  */
 class FCEFWebBrowserWindowRHIHelper
 {
 public:
+	/** Creates the helper with the backend returned by GetSelectedBackend. */
 	FCEFWebBrowserWindowRHIHelper();
-	virtual ~FCEFWebBrowserWindowRHIHelper() = default;
+
+	/** Creates the helper with the given backend, which must be supported on this machine or Null. */
+	explicit FCEFWebBrowserWindowRHIHelper(ECEFAcceleratedPaintBackend BackendType);
+
+	virtual ~FCEFWebBrowserWindowRHIHelper();
 
 	static bool BUseSupportedRHIRenderer();
 	static uint64_t GetRHIAdapterLuid();
 
+	/** @return the backend new browsers use, None if they paint through the CPU. */
+	static ECEFAcceleratedPaintBackend GetSelectedBackend();
+
+	/**
+	 * Picks the backend to use. Doesn't touch the RHI, so the decision can be checked on machines without a GPU.
+	 *
+	 * @param Requested The backend requested with webbrowser.AcceleratedPaint.Backend, None standing for automatic selection.
+	 * @param bHasD3DRHI Whether the RHI is D3D11 or D3D12.
+	 * @param bCanMapBuffers Whether the buffers CEF paints into can be mapped by the CPU.
+	 * @param bIsGpuProcessReliable Whether the CEF GPU process can be relied on, which is not the case during automation or on build machines.
+	 * @return the backend to use, None for CPU paint.
+	 */
+	static ECEFAcceleratedPaintBackend SelectBackend(ECEFAcceleratedPaintBackend Requested, bool bHasD3DRHI, bool bCanMapBuffers, bool bIsGpuProcessReliable);
+
+	/** @return the name of the backend, for logs and stats. */
+	static const TCHAR* GetBackendName(ECEFAcceleratedPaintBackend BackendType);
+
 public:
 	FSlateUpdatableTexture* CreateSlateUpdatableTexture(const FUintPoint& TextureSize);
 	void ReleaseSlateUpdatableTexture(FSlateUpdatableTexture* SlateTexture);
 
-	bool CopySharedTextureSync(FSlateUpdatableTexture* SlateTexture, void* SharedHandle, const FIntRect& DirtyIn);
+	/**
+	 * Copies a frame CEF painted on the GPU into a texture created by CreateSlateUpdatableTexture. Blocks until the copy is done.
+	 *
+	 * @return whether the texture holds the frame.
+	 */
+	bool CopyAcceleratedPaint(FSlateUpdatableTexture* SlateTexture, const FCEFAcceleratedPaintInfo& Paint);
+
+	/** @return the backend frames are copied with. */
+	ECEFAcceleratedPaintBackend GetBackendType() const;
+
+	/** @return the counters accumulated since the helper was created. */
+	const FCEFAcceleratedPaintStats& GetStats() const
+	{
+		return Stats;
+	}
 
 private:
-	bool EnsureShareable(FSlateUpdatableTexture* SlateTexture);
+	/** Staging buffers of the backends mapping the painted buffers. Declared before Backend, which references it. */
+	FCEFStagingBufferPool StagingPool;
 
-	TMap<FSlateUpdatableTexture*, TSharedPtr<void>> SlateTextureHandles;
+	TUniquePtr<ICEFAcceleratedPaintBackend> Backend;
 
-#if PLATFORM_WINDOWS
-	TComPtr<ID3D11Device> D3D11Device;
-	TComPtr<ID3D11DeviceContext> D3D11DeviceContext;
-#endif // PLATFORM_WINDOWS
+	FCEFAcceleratedPaintStats Stats;
 };
 
 #endif
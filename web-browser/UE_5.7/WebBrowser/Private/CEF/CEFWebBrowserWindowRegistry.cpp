@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CEF/CEFWebBrowserWindowRegistry.h"
+
+#if WITH_CEF3
+
+#include "CEF/CEFWebBrowserWindow.h"
+#include "Misc/ScopeRWLock.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CEF Registered Windows"), STAT_CEFRegisteredWindows, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CEF Window Snapshot Rebuilds"), STAT_CEFWindowSnapshotRebuilds, STATGROUP_WebBrowser);
+
+FCEFWebBrowserWindowRegistry::FCEFWebBrowserWindowRegistry()
+	: Snapshot(MakeShared<const FSnapshot, ESPMode::ThreadSafe>())
+{
+}
+
+void FCEFWebBrowserWindowRegistry::Add(const TSharedRef<FCEFWebBrowserWindow>& Window, const FString& ContextId)
+{
+	const int32 BrowserId = Window->GetCefBrowser()->GetIdentifier();
+	Window->SetWindowRegistry(AsShared(), BrowserId);
+
+	FWriteScopeLock ContextsScopeLock(ContextsLock);
+	{
+		FShard& Shard = GetShard(BrowserId);
+		FWriteScopeLock ShardScopeLock(Shard.Lock);
+		Shard.Entries.Add(BrowserId, FEntry{ Window, ContextId });
+	}
+	ContextBrowserIds.FindOrAdd(ContextId).Add(BrowserId);
+	INC_DWORD_STAT(STAT_CEFRegisteredWindows);
+
+	RebuildSnapshot();
+}
+
+void FCEFWebBrowserWindowRegistry::Remove(int32 BrowserId)
+{
+	FWriteScopeLock ContextsScopeLock(ContextsLock);
+	FEntry Entry;
+	{
+		FShard& Shard = GetShard(BrowserId);
+		FWriteScopeLock ShardScopeLock(Shard.Lock);
+		if (!Shard.Entries.RemoveAndCopyValue(BrowserId, Entry))
+		{
+			return;
+		}
+	}
+	if (TArray<int32>* BrowserIds = ContextBrowserIds.Find(Entry.ContextId))
+	{
+		BrowserIds->RemoveSwap(BrowserId);
+		if (BrowserIds->Num() == 0)
+		{
+			ContextBrowserIds.Remove(Entry.ContextId);
+		}
+	}
+	DEC_DWORD_STAT(STAT_CEFRegisteredWindows);
+
+	RebuildSnapshot();
+}
+
+void FCEFWebBrowserWindowRegistry::Reset()
+{
+	FWriteScopeLock ContextsScopeLock(ContextsLock);
+	for (FShard& Shard : Shards)
+	{
+		FWriteScopeLock ShardScopeLock(Shard.Lock);
+		DEC_DWORD_STAT_BY(STAT_CEFRegisteredWindows, Shard.Entries.Num());
+		Shard.Entries.Reset();
+	}
+	ContextBrowserIds.Reset();
+
+	RebuildSnapshot();
+}
+
+TSharedPtr<FCEFWebBrowserWindow> FCEFWebBrowserWindowRegistry::Find(int32 BrowserId) const
+{
+	const FShard& Shard = GetShard(BrowserId);
+	FReadScopeLock ShardScopeLock(Shard.Lock);
+	const FEntry* Entry = Shard.Entries.Find(BrowserId);
+	return Entry != nullptr ? Entry->Window.Pin() : nullptr;
+}
+
+FString FCEFWebBrowserWindowRegistry::FindContextId(int32 BrowserId) const
+{
+	const FShard& Shard = GetShard(BrowserId);
+	FReadScopeLock ShardScopeLock(Shard.Lock);
+	const FEntry* Entry = Shard.Entries.Find(BrowserId);
+	return Entry != nullptr ? Entry->ContextId : FString();
+}
+
+TArray<TSharedPtr<FCEFWebBrowserWindow>> FCEFWebBrowserWindowRegistry::GetContextWindows(const FString& ContextId) const
+{
+	TArray<TSharedPtr<FCEFWebBrowserWindow>> Windows;
+
+	FReadScopeLock ContextsScopeLock(ContextsLock);
+	if (const TArray<int32>* BrowserIds = ContextBrowserIds.Find(ContextId))
+	{
+		Windows.Reserve(BrowserIds->Num());
+		for (int32 BrowserId : *BrowserIds)
+		{
+			if (TSharedPtr<FCEFWebBrowserWindow> Window = Find(BrowserId))
+			{
+				Windows.Add(MoveTemp(Window));
+			}
+		}
+	}
+	return Windows;
+}
+
+TSharedRef<const FCEFWebBrowserWindowRegistry::FSnapshot, ESPMode::ThreadSafe> FCEFWebBrowserWindowRegistry::GetSnapshot() const
+{
+	FScopeLock Lock(&SnapshotCS);
+	return Snapshot;
+}
+
+void FCEFWebBrowserWindowRegistry::RebuildSnapshot()
+{
+	INC_DWORD_STAT(STAT_CEFWindowSnapshotRebuilds);
+
+	TSharedRef<FSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ShardScopeLock(Shard.Lock);
+		for (const TPair<int32, FEntry>& Entry : Shard.Entries)
+		{
+			NewSnapshot->Add(Entry.Value.Window);
+		}
+	}
+
+	FScopeLock Lock(&SnapshotCS);
+	Snapshot = NewSnapshot;
+}
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_CEF3
+
+class FCEFWebBrowserWindow;
+
+/**
+ * Tracks the live CEF browser windows, indexed by CEF browser id and by request context id.
+ *
+ * Lookups by browser id only lock the shard the id falls in. Iterating every window goes through an immutable snapshot, rebuilt
+ * when a window is added or removed, so the engine tick never holds a lock while calling into the windows. Windows remove
+ * themselves when they are destroyed, so entries never expire in place.
+ */
+class FCEFWebBrowserWindowRegistry
+	: public TSharedFromThis<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe>
+{
+public:
+	typedef TArray<TWeakPtr<FCEFWebBrowserWindow>> FSnapshot;
+
+	FCEFWebBrowserWindowRegistry();
+
+	/**
+	 * Starts tracking a window, which removes itself from the registry when it is destroyed.
+	 *
+	 * @param Window The window, which must have a CEF browser.
+	 * @param ContextId The request context the browser was created in, empty for the global context.
+	 */
+	void Add(const TSharedRef<FCEFWebBrowserWindow>& Window, const FString& ContextId);
+
+	/** Stops tracking the window with the given CEF browser id. */
+	void Remove(int32 BrowserId);
+
+	/** Stops tracking every window. */
+	void Reset();
+
+	/** @return the window with the given CEF browser id, if it is alive. */
+	TSharedPtr<FCEFWebBrowserWindow> Find(int32 BrowserId) const;
+
+	/** @return the request context id the window with the given CEF browser id was created in, empty if unknown. */
+	FString FindContextId(int32 BrowserId) const;
+
+	/** @return the windows created in a request context. */
+	TArray<TSharedPtr<FCEFWebBrowserWindow>> GetContextWindows(const FString& ContextId) const;
+
+	/** @return every tracked window. The snapshot is immutable and can be iterated without locking. */
+	TSharedRef<const FSnapshot, ESPMode::ThreadSafe> GetSnapshot() const;
+
+private:
+	/** Rebuilds the snapshot from the shards. Called with ContextsLock held for writing. */
+	void RebuildSnapshot();
+
+	struct FEntry
+	{
+		TWeakPtr<FCEFWebBrowserWindow> Window;
+		FString ContextId;
+	};
+
+	struct FShard
+	{
+		TMap<int32, FEntry> Entries;
+		mutable FRWLock Lock;
+	};
+
+	static constexpr int32 NumShards = 8;
+
+	FShard& GetShard(int32 BrowserId)
+	{
+		return Shards[static_cast<uint32>(BrowserId) % NumShards];
+	}
+
+	const FShard& GetShard(int32 BrowserId) const
+	{
+		return Shards[static_cast<uint32>(BrowserId) % NumShards];
+	}
+
+	FShard Shards[NumShards];
+
+	/** Browser ids by request context id. Also serializes adds and removes, so the snapshot is rebuilt in order. */
+	TMap<FString, TArray<int32>> ContextBrowserIds;
+	mutable FRWLock ContextsLock;
+
+	TSharedRef<const FSnapshot, ESPMode::ThreadSafe> Snapshot;
+	mutable FCriticalSection SnapshotCS;
+};
+
+#endif
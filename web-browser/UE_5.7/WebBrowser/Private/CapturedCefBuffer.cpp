@@ -8,10 +8,32 @@
 #include "Runtime/Engine/Public/TextureResource.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Styling/StyleColors.h"
+#include "CEF/CEFPaintRegionUploader.h"
+#include "WebBrowserStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Captured CEF Buffer Texture Allocations"), STAT_CapturedCefBufferTextureAllocations, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Captured CEF Buffer Bytes Uploaded"), STAT_CapturedCefBufferBytesUploaded, STATGROUP_WebBrowser);
+
+namespace
+{
+	constexpr int32 CapturedBufferBytesPerPixel = 4; // PF_B8G8R8A8
+
+	// Dirty rects are coalesced like the regular paint path does, so a busy page doesn't issue a texture update per rect
+	constexpr float CapturedBufferMergeAreaRatio = 0.5f;
+	constexpr int32 CapturedBufferMaxDirtyRects = 8;
+
+	/** @return the size of the paint texture to allocate for a buffer, with headroom so a growing buffer doesn't reallocate on every resize. */
+	FIntPoint CalculatePaintTextureCapacity(const FIntPoint& BufferDimensions)
+	{
+		return FIntPoint(
+			Align(BufferDimensions.X + BufferDimensions.X / 4, 64),
+			Align(BufferDimensions.Y + BufferDimensions.Y / 4, 64));
+	}
+}
 #endif
 
 
-bool FCapturedCefBuffer::SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const int32 InBufferWidth, const int32 InBufferHeight, const float InViewportDPIScaleFactor, const bool bDoSkipBadBufferTest)
+bool FCapturedCefBuffer::SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const int32 InBufferWidth, const int32 InBufferHeight, const float InViewportDPIScaleFactor, const bool bDoSkipBadBufferTest, TConstArrayView<FIntRect> InDirtyRects)
 {
 #if UE_WITH_CAPTURED_CEF_BUFFER
 	
@@ -36,11 +58,13 @@ bool FCapturedCefBuffer::SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const
 	// comes along where the web browser image is actually completely filled and not stretched or compressed, which is the case when there's no
 	// transparent margin.
 	//
-	// We also don't capture the buffer if the dimensions have not changed, to avoid captures on every frame.
+	// We also don't capture the buffer if the dimensions have not changed, to avoid captures on every frame, unless the captured buffer
+	// is currently being painted. Then only the dirty rects are copied, so the captured page keeps animating at the cost of what changed.
 	//
 	// But we allow the caller to skip this test and force capture, especially if the caller knows they have a correct buffer.
 
-	if (InBufferWidth == BufferDimensions.X && InBufferHeight == BufferDimensions.Y && InViewportDPIScaleFactor == ViewportDPIScaleFactor)
+	const bool bIsSameBuffer = (InBufferWidth == BufferDimensions.X && InBufferHeight == BufferDimensions.Y && InViewportDPIScaleFactor == ViewportDPIScaleFactor);
+	if (bIsSameBuffer && (!bHasPaintObjects || !IsBufferValid()))
 	{
 		return false;
 	}
@@ -48,20 +72,48 @@ bool FCapturedCefBuffer::SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const
 	if (const bool bDoesBufferHaveTransparentMargin = (static_cast<const uint8*>(InBufferB8G8R8A8)[3] == 0x0); 
 		bDoSkipBadBufferTest || (!bDoSkipBadBufferTest && !bDoesBufferHaveTransparentMargin))
 	{
-		BufferDimensions = FIntPoint(InBufferWidth, InBufferHeight);
-		
-		const TArray<uint8>::SizeType NumBytes = CalculateBufferNumBytes();
-		if (BufferData.Num() != NumBytes)
+		const uint8* const SourceData = static_cast<const uint8*>(InBufferB8G8R8A8);
+
+		if (bIsSameBuffer && !InDirtyRects.IsEmpty())
 		{
-			BufferData.SetNum(NumBytes);
+			const FIntRect BufferRect(FIntPoint::ZeroValue, BufferDimensions);
+			const int32 Pitch = BufferDimensions.X * CapturedBufferBytesPerPixel;
+			for (FIntRect DirtyRect : InDirtyRects)
+			{
+				DirtyRect.Clip(BufferRect);
+				if (DirtyRect.IsEmpty())
+				{
+					continue;
+				}
+
+				const int32 RowBytes = DirtyRect.Width() * CapturedBufferBytesPerPixel;
+				for (int32 Row = DirtyRect.Min.Y; Row < DirtyRect.Max.Y; ++Row)
+				{
+					const int32 Offset = Row * Pitch + DirtyRect.Min.X * CapturedBufferBytesPerPixel;
+					FMemory::Memcpy(BufferData.GetData() + Offset, SourceData + Offset, RowBytes);
+				}
+				DirtyRects.Add(DirtyRect);
+			}
+			FCEFPaintRegionUploader::CoalesceRects(DirtyRects, BufferDimensions, CapturedBufferMergeAreaRatio, CapturedBufferMaxDirtyRects);
 		}
-		FMemory::Memcpy(BufferData.GetData(), InBufferB8G8R8A8, NumBytes);
+		else
+		{
+			BufferDimensions = FIntPoint(InBufferWidth, InBufferHeight);
+			
+			// Keep the allocation when the buffer shrinks, resizes tend to go back and forth
+			const TArray<uint8>::SizeType NumBytes = CalculateBufferNumBytes();
+			BufferData.SetNumUninitialized(NumBytes, EAllowShrinking::No);
+			FMemory::Memcpy(BufferData.GetData(), SourceData, NumBytes);
 
+			DirtyRects.Reset();
+			DirtyRects.Add(FIntRect(FIntPoint::ZeroValue, BufferDimensions));
 
-		ViewportDPIScaleFactor = InViewportDPIScaleFactor;
 
+			ViewportDPIScaleFactor = InViewportDPIScaleFactor;
+		}
 
-		bDoesNeedNewPaintObjects = true;
+
+		bDoesNeedNewPaintObjects = !DirtyRects.IsEmpty();
 
 		
 		return true;
@@ -84,6 +136,7 @@ bool FCapturedCefBuffer::ClearBuffer()
 	{
 		BufferData.Empty();
 	}
+	DirtyRects.Empty();
 	BufferDimensions = FIntPoint::ZeroValue;
 	ViewportDPIScaleFactor = 1.0f;
 	
@@ -122,26 +175,48 @@ bool FCapturedCefBuffer::MaybeUpdatePaintObjects()
 
 	if (bDoesNeedNewPaintObjects)
 	{
-		if (PaintTexture.Get() && (PaintTexture->GetSizeX() != BufferDimensions.X || PaintTexture->GetSizeY() != BufferDimensions.Y))
+		// The texture is only reallocated when the buffer outgrows it, or when it would waste more than three quarters of its memory
+		if (PaintTexture.Get())
 		{
-			PaintTexture.Reset(); // ..uses GC
+			const int64 TextureArea = static_cast<int64>(PaintTexture->GetSizeX()) * PaintTexture->GetSizeY();
+			const int64 BufferArea = static_cast<int64>(BufferDimensions.X) * BufferDimensions.Y;
+			if (PaintTexture->GetSizeX() < BufferDimensions.X || PaintTexture->GetSizeY() < BufferDimensions.Y || BufferArea * 4 < TextureArea)
+			{
+				if (FSlateApplication::Get().GetRenderer()/*becomes null on shutdown*/ && PaintSlateBrush.GetResourceObject())
+				{
+					FSlateApplication::Get().GetRenderer()->ReleaseDynamicResource(PaintSlateBrush);
+				}
+				PaintTexture.Reset(); // ..uses GC
+			}
 		}
 
 		if (!PaintTexture.IsValid())
 		{
-			PaintTexture = TStrongObjectPtr(UTexture2D::CreateTransient(BufferDimensions.X, BufferDimensions.Y, PF_B8G8R8A8));
+			const FIntPoint Capacity = CalculatePaintTextureCapacity(BufferDimensions);
+			PaintTexture = TStrongObjectPtr(UTexture2D::CreateTransient(Capacity.X, Capacity.Y, PF_B8G8R8A8));
 			PaintTexture->SRGB = true;
 			PaintTexture->LODGroup = TEXTUREGROUP_UI;
+
+			// The margin past the buffer is never uploaded, clear it once so filtering at the edge of the buffer doesn't pick up garbage
+			FTexture2DMipMap& Mip = PaintTexture->GetPlatformData()->Mips[0];
+			FMemory::Memzero(Mip.BulkData.Lock(LOCK_READ_WRITE), static_cast<int64>(Capacity.X) * Capacity.Y * CapturedBufferBytesPerPixel);
+			Mip.BulkData.Unlock();
+			PaintTexture->UpdateResource();
+			INC_DWORD_STAT(STAT_CapturedCefBufferTextureAllocations);
+
+			DirtyRects.Reset();
+			DirtyRects.Add(FIntRect(FIntPoint::ZeroValue, BufferDimensions));
 		}
 		
-		void* TextureData = PaintTexture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-		FMemory::Memcpy(TextureData, BufferData.GetData(), CalculateBufferNumBytes());
-		PaintTexture->GetPlatformData()->Mips[0].BulkData.Unlock();
-		PaintTexture->UpdateResource();
+		UploadDirtyRects();
 	
 	
+		// Only the part of the texture covered by the buffer is painted
 		PaintSlateBrush.SetResourceObject(PaintTexture.Get());
 		PaintSlateBrush.ImageSize = FVector2D(BufferDimensions.X, BufferDimensions.Y);
+		PaintSlateBrush.SetUVRegion(FBox2f(FVector2f::ZeroVector, FVector2f(
+			static_cast<float>(BufferDimensions.X) / PaintTexture->GetSizeX(),
+			static_cast<float>(BufferDimensions.Y) / PaintTexture->GetSizeY())));
 		PaintSlateBrush.DrawAs = ESlateBrushDrawType::Type::Image;
 
 		
@@ -205,6 +280,46 @@ bool FCapturedCefBuffer::ClearPaintObjects()
 }
 
 
+bool FCapturedCefBuffer::ReleasePaintBrush()
+{
+#if UE_WITH_CAPTURED_CEF_BUFFER
+	
+	
+	if (!bHasPaintObjects)
+	{
+		return false;
+	}
+	
+	if (!FSlateApplication::IsInitialized()) // ..safety check
+	{
+		return false;
+	}
+
+	
+	bHasPaintObjects = false;
+	
+	if (FSlateApplication::Get().GetRenderer()/*becomes null on shutdown*/ && PaintSlateBrush.GetResourceObject())
+	{
+		FSlateApplication::Get().GetRenderer()->ReleaseDynamicResource(PaintSlateBrush);
+	}
+
+	// The brush is set up again the next time the buffer is painted, the texture already holds the buffer
+	bDoesNeedNewPaintObjects = IsBufferValid();
+
+
+	return true;
+
+
+#else
+
+	
+	return false;
+
+
+#endif
+}
+
+
 int32 FCapturedCefBuffer::PaintCentered(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const
 {
 #if UE_WITH_CAPTURED_CEF_BUFFER
@@ -269,3 +384,48 @@ uint32 FCapturedCefBuffer::CalculateBufferNumBytes() const
 }
 #endif
 
+
+#if UE_WITH_CAPTURED_CEF_BUFFER
+void FCapturedCefBuffer::UploadDirtyRects()
+{
+	int32 TotalBytes = 0;
+	for (const FIntRect& DirtyRect : DirtyRects)
+	{
+		TotalBytes += DirtyRect.Width() * DirtyRect.Height() * CapturedBufferBytesPerPixel;
+	}
+	if (TotalBytes == 0)
+	{
+		DirtyRects.Reset();
+		return;
+	}
+
+	// Pack the rects tightly into one staging buffer, which the render thread releases once every region is uploaded.
+	// The buffer data itself can't be handed over, the next paint may write to it before the upload runs.
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Staging = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	Staging->SetNumUninitialized(TotalBytes);
+
+	uint8* Dest = Staging->GetData();
+	const int32 SourcePitch = BufferDimensions.X * CapturedBufferBytesPerPixel;
+	for (const FIntRect& DirtyRect : DirtyRects)
+	{
+		uint8* const RegionData = Dest;
+		const int32 RowBytes = DirtyRect.Width() * CapturedBufferBytesPerPixel;
+		for (int32 Row = DirtyRect.Min.Y; Row < DirtyRect.Max.Y; ++Row)
+		{
+			FMemory::Memcpy(Dest, BufferData.GetData() + Row * SourcePitch + DirtyRect.Min.X * CapturedBufferBytesPerPixel, RowBytes);
+			Dest += RowBytes;
+		}
+
+		FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(DirtyRect.Min.X, DirtyRect.Min.Y, 0, 0, DirtyRect.Width(), DirtyRect.Height());
+		PaintTexture->UpdateTextureRegions(0, 1, Region, RowBytes, CapturedBufferBytesPerPixel, RegionData,
+			[Staging](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+			{
+				delete Regions;
+			});
+	}
+
+	INC_DWORD_STAT_BY(STAT_CapturedCefBufferBytesUploaded, TotalBytes);
+	DirtyRects.Reset();
+}
+#endif
+
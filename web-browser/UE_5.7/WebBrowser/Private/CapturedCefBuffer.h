@@ -28,11 +28,20 @@ struct FCapturedCefBuffer
 public:
 
 
-	bool SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const int32 InBufferWidth, const int32 InBufferHeight, const float InViewportDPIScaleFactor, const bool bDoSkipBadBufferTest);
+	/**
+	 * Captures a CEF paint buffer. A buffer of a new size is copied whole, while a buffer of the captured size only has its dirty rects
+	 * copied, and only while the captured buffer is being painted.
+	 *
+	 * @param InDirtyRects The rects CEF reported as changed, or empty if the whole buffer changed.
+	 */
+	bool SetBufferAsB8G8R8A8(const void* InBufferB8G8R8A8, const int32 InBufferWidth, const int32 InBufferHeight, const float InViewportDPIScaleFactor, const bool bDoSkipBadBufferTest, TConstArrayView<FIntRect> InDirtyRects = TConstArrayView<FIntRect>());
 	bool ClearBuffer();
 	
 	bool MaybeUpdatePaintObjects();
 	bool ClearPaintObjects();
+
+	/** Stops painting the captured buffer, releasing the brush but keeping the paint texture for when it is painted again. */
+	bool ReleasePaintBrush();
 	int32 PaintCentered(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const;
 
 	bool HasPaintObjects() const;
@@ -46,15 +55,23 @@ private:
 	
 	bool IsBufferValid() const; 
 	uint32 CalculateBufferNumBytes() const;
+
+	/** Copies the dirty rects of the buffer into the paint texture. */
+	void UploadDirtyRects();
 	
 
+	/** Buffer data, which keeps its allocation when the buffer shrinks. */
 	TArray<uint8> BufferData;
 	FIntPoint BufferDimensions = FIntPoint::ZeroValue;
 
+	/** Rects of the buffer that changed since the paint texture was last updated. */
+	TArray<FIntRect> DirtyRects;
+
 	float ViewportDPIScaleFactor = 1.0f;
 	
 	bool bDoesNeedNewPaintObjects = false;
 	bool bHasPaintObjects = false;
+	/** Texture sized to a capacity at least as large as the buffer, so it is only reallocated when the buffer outgrows it. */
 	TStrongObjectPtr<UTexture2D> PaintTexture;
 	FSlateBrush PaintSlateBrush;
 
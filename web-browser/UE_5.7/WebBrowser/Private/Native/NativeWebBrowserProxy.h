@@ -145,6 +145,16 @@ public:
 		return ResourceLoadCompleteDelegate;
 	}
 
+	virtual FOnBeforeResourceRequestDelegate& OnBeforeResourceRequest() override
+	{
+		return BeforeResourceRequestDelegate;
+	}
+
+	virtual FOnResourceRequestCompleteDelegate& OnResourceRequestComplete() override
+	{
+		return ResourceRequestCompleteDelegate;
+	}
+
 	virtual FOnConsoleMessageDelegate& OnConsoleMessage() override
 	{
 		return ConsoleMessageDelegate;
@@ -224,6 +234,10 @@ private:
 	/** Delegate that is invoked on completion of browser resource loads. Its primary purpose is to allow response to failures. */
 	FOnResourceLoadCompleteDelegate ResourceLoadCompleteDelegate;
 
+	/** Delegates for the same, passing the request details unconverted. Not executed on this platform. */
+	FOnBeforeResourceRequestDelegate BeforeResourceRequestDelegate;
+	FOnResourceRequestCompleteDelegate ResourceRequestCompleteDelegate;
+
 	/** Delegate that is invoked for each console message */
 	FOnConsoleMessageDelegate ConsoleMessageDelegate;
 
@@ -115,8 +115,8 @@ static FWebBrowserSingleton& GetWebBrowserSingletonChecked()
 			{
 				if (CefWebBrowserWindow->HasCorrectNativeCefBuffer())
 				{
-					// The CEF web browser can display the correct texture itself. So clean-up the captured CEF buffer's paint objects, if it has any.
-					// But do this on the next tick to avoid a white flash.
+					// The CEF web browser can display the correct texture itself. So release the captured CEF buffer's brush, if it has one,
+					// keeping its texture for the next resize. But do this on the next tick to avoid a white flash.
 
 					if (CapturedCefBuffer->HasPaintObjects())
 					{
@@ -124,7 +124,7 @@ static FWebBrowserSingleton& GetWebBrowserSingletonChecked()
 							{
 								if (CapturedCefBuffer.IsValid())
 								{
-									CapturedCefBuffer->ClearPaintObjects();
+									CapturedCefBuffer->ReleasePaintBrush();
 								}
 							});
 					}
@@ -153,6 +153,19 @@ static FWebBrowserSingleton& GetWebBrowserSingletonChecked()
 	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
 }
 
+FCreateBrowserWindowSettings SWebBrowser::MakeBrowserWindowSettings(const FArguments& InArgs)
+{
+	// Only the arguments Construct forwards to the view, the others keep the view's defaults
+	return SWebBrowserView::MakeBrowserWindowSettings(SWebBrowserView::FArguments()
+		.InitialURL(InArgs._InitialURL)
+		.ContentsToLoad(InArgs._ContentsToLoad)
+		.ShowErrorMessage(InArgs._ShowErrorMessage)
+		.SupportsTransparency(InArgs._SupportsTransparency)
+		.SupportsThumbMouseButtonNavigation(InArgs._SupportsThumbMouseButtonNavigation)
+		.BackgroundColor(InArgs._BackgroundColor)
+		.BrowserFrameRate(InArgs._BrowserFrameRate));
+}
+
 void SWebBrowser::Construct(const FArguments& InArgs, const TSharedPtr<IWebBrowserWindow>& InWebBrowserWindow)
 {
 	OnLoadCompleted = InArgs._OnLoadCompleted;
@@ -552,5 +565,38 @@ void SWebBrowser::SetParentWindow(TSharedPtr<SWindow> Window)
 	}
 }
 
+void SWebBrowser::SetFrameRate(int32 FrameRate)
+{
+	if (BrowserView.IsValid())
+	{
+		BrowserView->SetFrameRate(FrameRate);
+	}
+}
+
+int32 SWebBrowser::GetFrameRate() const
+{
+	if (BrowserView.IsValid())
+	{
+		return BrowserView->GetFrameRate();
+	}
+	return 0;
+}
+
+void SWebBrowser::SetIdleFrameRate(int32 IdleFrameRate)
+{
+	if (BrowserView.IsValid())
+	{
+		BrowserView->SetIdleFrameRate(IdleFrameRate);
+	}
+}
+
+void SWebBrowser::SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy)
+{
+	if (BrowserView.IsValid())
+	{
+		BrowserView->SetOcclusionPolicy(Policy);
+	}
+}
+
 
 #undef LOCTEXT_NAMESPACE
@@ -29,6 +29,7 @@
 #define LOCTEXT_NAMESPACE "WebBrowser"
 
 SWebBrowserView::SWebBrowserView()
+	: bCreatedBrowserWindow(false)
 {
 }
 
@@ -66,6 +67,12 @@ SWebBrowserView::~SWebBrowserView()
 		{
 			BrowserWindow->OnBeforePopup().Unbind();
 		}
+
+		// Hand browsers we created back to the singleton, which keeps them warm if they came from a prewarmed pool
+		if (bCreatedBrowserWindow && IWebBrowserModule::IsAvailable() && IWebBrowserModule::Get().IsWebModuleAvailable())
+		{
+			IWebBrowserModule::Get().GetSingleton()->ReleaseBrowserWindow(BrowserWindow);
+		}
 	}
 
 	TSharedPtr<SWindow> SlateParentWindow = SlateParentWindowPtr.Pin();
@@ -80,6 +87,22 @@ SWebBrowserView::~SWebBrowserView()
 	}
 }
 
+FCreateBrowserWindowSettings SWebBrowserView::MakeBrowserWindowSettings(const FArguments& InArgs)
+{
+	FCreateBrowserWindowSettings Settings;
+	Settings.InitialURL = InArgs._InitialURL;
+	Settings.bUseTransparency = InArgs._SupportsTransparency;
+	Settings.bInterceptLoadRequests = InArgs._InterceptLoadRequests;
+	Settings.bThumbMouseButtonNavigation = InArgs._SupportsThumbMouseButtonNavigation;
+	Settings.ContentsToLoad = InArgs._ContentsToLoad;
+	Settings.bShowErrorMessage = InArgs._ShowErrorMessage;
+	Settings.BackgroundColor = InArgs._BackgroundColor;
+	Settings.BrowserFrameRate = InArgs._BrowserFrameRate;
+	Settings.Context = InArgs._ContextSettings;
+	Settings.AltRetryDomains = InArgs._AltRetryDomains;
+	return Settings;
+}
+
 void SWebBrowserView::Construct(const FArguments& InArgs, const TSharedPtr<IWebBrowserWindow>& InWebBrowserWindow)
 {
 	OnLoadCompleted = InArgs._OnLoadCompleted;
@@ -111,22 +134,13 @@ void SWebBrowserView::Construct(const FArguments& InArgs, const TSharedPtr<IWebB
 		GConfig->GetBool(TEXT("Browser"), TEXT("bEnabled"), bBrowserEnabled, GEngineIni);
 		if (AllowCEF && bBrowserEnabled)
 		{
-			FCreateBrowserWindowSettings Settings;
-			Settings.InitialURL = InArgs._InitialURL;
-			Settings.bUseTransparency = InArgs._SupportsTransparency;
-			Settings.bInterceptLoadRequests = InArgs._InterceptLoadRequests;
-			Settings.bThumbMouseButtonNavigation = InArgs._SupportsThumbMouseButtonNavigation;
-			Settings.ContentsToLoad = InArgs._ContentsToLoad;
-			Settings.bShowErrorMessage = InArgs._ShowErrorMessage;
-			Settings.BackgroundColor = InArgs._BackgroundColor;
-			Settings.BrowserFrameRate = InArgs._BrowserFrameRate;
-			Settings.Context = InArgs._ContextSettings;
-			Settings.AltRetryDomains = InArgs._AltRetryDomains;
+			FCreateBrowserWindowSettings Settings = MakeBrowserWindowSettings(InArgs);
 
 			// IWebBrowserModule::Get() was already callled in WebBrowserWidgetModule.cpp so we don't need to force the load again here
 			if (IWebBrowserModule::IsAvailable() && IWebBrowserModule::Get().IsWebModuleAvailable())
 			{
 				BrowserWindow = IWebBrowserModule::Get().GetSingleton()->CreateBrowserWindow(Settings);
+				bCreatedBrowserWindow = BrowserWindow.IsValid();
 			}
 		}
 	}
@@ -264,6 +278,13 @@ int32 SWebBrowserView::OnPaint(const FPaintArgs& Args, const FGeometry& Allotted
 		}
 	}
 
+	if (BrowserWindow.IsValid())
+	{
+		// Slate has no notion of being covered by other widgets, but a browser painted fully transparent can't be seen either.
+		// Widgets culled away, like at the edge of a scroll box, aren't painted at all and stop ticking, which hides the browser.
+		BrowserWindow->SetIsOccluded(InWidgetStyle.GetColorAndOpacityTint().A <= 0.0f);
+	}
+
 	return Layer;
 }
 
@@ -798,6 +819,39 @@ void SWebBrowserView::SetParentWindow(TSharedPtr<SWindow> Window)
 	}
 }
 
+void SWebBrowserView::SetFrameRate(int32 FrameRate)
+{
+	if (BrowserWindow.IsValid())
+	{
+		BrowserWindow->SetFrameRate(FrameRate);
+	}
+}
+
+int32 SWebBrowserView::GetFrameRate() const
+{
+	if (BrowserWindow.IsValid())
+	{
+		return BrowserWindow->GetFrameRate();
+	}
+	return 0;
+}
+
+void SWebBrowserView::SetIdleFrameRate(int32 IdleFrameRate)
+{
+	if (BrowserWindow.IsValid())
+	{
+		BrowserWindow->SetIdleFrameRate(IdleFrameRate);
+	}
+}
+
+void SWebBrowserView::SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy)
+{
+	if (BrowserWindow.IsValid())
+	{
+		BrowserWindow->SetOcclusionPolicy(Policy);
+	}
+}
+
 void SWebBrowserView::SetBrowserKeyboardFocus()
 {
 	BrowserWindow->OnFocus(HasAnyUserFocusOrFocusedDescendants(), false);
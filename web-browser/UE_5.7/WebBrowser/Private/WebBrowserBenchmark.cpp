@@ -0,0 +1,581 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WebBrowserBenchmark.h"
+
+#if WITH_CEF3
+#include "CEF/CEFJSScripting.h"
+#include "CEF/CEFJSBatchedTransport.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+#include <atomic>
+#include "CEF/CEFAcceleratedPaintBackend.h"
+#include "CEF/CEFPaintRegionUploader.h"
+#include "CEF/CEFTextureUploadScheduler.h"
+#include "CEF/CEFWebBrowserWindowRHIHelper.h"
+
+#if PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+bool FWebBrowserBenchmark::RunJSBridgeTransport(UObject* Object, const FString& MethodName, int32 NumCalls, bool bBatched, int32 CallsPerBatch, FWebBrowserJSBridgeTransportStats& OutStats)
+{
+	OutStats = FWebBrowserJSBridgeTransportStats();
+#if WITH_CEF3
+	IConsoleVariable* BatchedTransportCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("webbrowser.JSBatchedTransport"));
+	if (Object == nullptr || BatchedTransportCVar == nullptr)
+	{
+		return false;
+	}
+
+	// Objects only carry handles when converted with the batched transport enabled
+	TSharedRef<FCEFJSScripting> Scripting = MakeShared<FCEFJSScripting>(nullptr, false);
+	const bool bWasBatched = BatchedTransportCVar->GetBool();
+	BatchedTransportCVar->Set(bBatched, ECVF_SetByCode);
+	CefRefPtr<CefDictionaryValue> ConvertedObject = Scripting->ConvertObject(Object);
+	BatchedTransportCVar->Set(bWasBatched, ECVF_SetByCode);
+
+	const CefString ObjectId = ConvertedObject->GetString("$id");
+	const CefString CefMethodName = TCHAR_TO_WCHAR(*MethodName);
+	CefRefPtr<CefListValue> Methods = ConvertedObject->GetList("$methods");
+	int32 ObjectHandle = INDEX_NONE;
+	int32 MethodHandle = INDEX_NONE;
+	bool bFoundMethod = false;
+	for (size_t MethodIndex = 0; MethodIndex < Methods->GetSize(); ++MethodIndex)
+	{
+		if (Methods->GetString(MethodIndex) == CefMethodName)
+		{
+			bFoundMethod = !bBatched || FCEFJSBatchedCallQueue::GetHandles(ConvertedObject, MethodIndex, ObjectHandle, MethodHandle);
+			break;
+		}
+	}
+	if (!bFoundMethod)
+	{
+		Scripting->UnbindAll();
+		return false;
+	}
+
+	// Results are decoded as the render process does, the callbacks only being counted
+	Scripting->SetMessageSink([&OutStats](CefRefPtr<CefProcessMessage> Message)
+	{
+		OutStats.NumMessagesReceived++;
+		const FString MessageName = WCHAR_TO_TCHAR(Message->GetName().ToWString().c_str());
+		if (MessageName == FCEFJSBatchedTransport::ResultsMessageName)
+		{
+			FCEFJSBatchedCallQueue::DispatchResults(Message, [&OutStats](const FGuid& CallbackId, CefRefPtr<CefListValue> Arguments, bool bIsError)
+			{
+				OutStats.NumCompletedCalls += bIsError ? 0 : 1;
+			});
+		}
+		else if (MessageName == TEXT("UE::ExecuteJSFunction"))
+		{
+			OutStats.NumCompletedCalls += Message->GetArgumentList()->GetBool(2) ? 0 : 1;
+		}
+	});
+
+	TSharedRef<FCEFJSBatchedCallQueue, ESPMode::ThreadSafe> CallQueue = MakeShared<FCEFJSBatchedCallQueue, ESPMode::ThreadSafe>(nullptr);
+	CallsPerBatch = FMath::Max(CallsPerBatch, 1);
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 CallIndex = 0; CallIndex < NumCalls; ++CallIndex)
+	{
+		CefRefPtr<CefListValue> Arguments = CefListValue::Create();
+		Arguments->SetInt(0, CallIndex);
+
+		CefRefPtr<CefProcessMessage> Message;
+		if (bBatched)
+		{
+			CallQueue->Enqueue(ObjectHandle, MethodHandle, FGuid::NewGuid(), Arguments);
+			if (CallQueue->GetNumQueued() == CallsPerBatch || CallIndex == NumCalls - 1)
+			{
+				Message = CallQueue->TakeMessage();
+			}
+		}
+		else
+		{
+			Message = CefProcessMessage::Create(TCHAR_TO_WCHAR(TEXT("UE::ExecuteUObjectMethod")));
+			CefRefPtr<CefListValue> MessageArguments = Message->GetArgumentList();
+			MessageArguments->SetString(0, ObjectId);
+			MessageArguments->SetString(1, CefMethodName);
+			MessageArguments->SetString(2, TCHAR_TO_WCHAR(*FGuid::NewGuid().ToString(EGuidFormats::Digits)));
+			MessageArguments->SetList(3, Arguments);
+		}
+
+		if (Message.get() != nullptr)
+		{
+			OutStats.NumMessagesSent++;
+			Scripting->OnProcessMessageReceived(nullptr, PID_RENDERER, Message);
+		}
+	}
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	Scripting->SetMessageSink(nullptr);
+	Scripting->UnbindAll();
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if WITH_CEF3
+namespace
+{
+	/** Forwards to the allocator it replaces while installed, counting the allocations made by the thread that installed it */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FCountingMalloc()
+			: InnerMalloc(GMalloc)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+			GMalloc = this;
+		}
+
+		virtual ~FCountingMalloc()
+		{
+			GMalloc = InnerMalloc;
+		}
+
+		int64 GetNumAllocations() const
+		{
+			return NumAllocations.load(std::memory_order_relaxed);
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return InnerMalloc->GetDescriptiveName();
+		}
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* InnerMalloc;
+		uint32 ThreadId;
+		std::atomic<int64> NumAllocations{ 0 };
+	};
+}
+#endif
+
+bool FWebBrowserBenchmark::RunJSStructSerialization(int32 NumFields, int32 NumSerializations, FWebBrowserJSStructSerializationStats& OutStats)
+{
+	OutStats = FWebBrowserJSStructSerializationStats();
+#if WITH_CEF3
+	UScriptStruct* Struct = NewObject<UScriptStruct>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UScriptStruct::StaticClass(), TEXT("WebBrowserBenchmarkStruct")), RF_Transient);
+	// Properties are added to the front of the struct, so they are added last to first
+	for (int32 FieldIndex = NumFields - 1; FieldIndex >= 0; --FieldIndex)
+	{
+		const FName FieldName(*FString::Printf(TEXT("Field%d"), FieldIndex));
+		switch (FieldIndex % 3)
+		{
+			case 0:
+				Struct->AddCppProperty(new FIntProperty(Struct, FieldName, RF_Public));
+				break;
+			case 1:
+				Struct->AddCppProperty(new FDoubleProperty(Struct, FieldName, RF_Public));
+				break;
+			default:
+				Struct->AddCppProperty(new FStrProperty(Struct, FieldName, RF_Public));
+				break;
+		}
+	}
+	Struct->Bind();
+	Struct->StaticLink(true);
+
+	uint8* StructData = static_cast<uint8*>(FMemory::Malloc(FMath::Max(Struct->GetStructureSize(), 1), Struct->GetMinAlignment()));
+	Struct->InitializeStruct(StructData);
+	for (TFieldIterator<FStrProperty> It(Struct); It; ++It)
+	{
+		It->SetPropertyValue_InContainer(StructData, It->GetName());
+	}
+
+	TSharedRef<FCEFJSScripting> Scripting = MakeShared<FCEFJSScripting>(nullptr, false);
+	{
+		// Counting slows the allocations down a little, which is the same for every struct size
+		FCountingMalloc CountingMalloc;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumSerializations; ++Index)
+		{
+			Scripting->ConvertStruct(Struct, StructData);
+			OutStats.NumSerializations++;
+			if (Index == 0)
+			{
+				OutStats.FirstSeconds = FPlatformTime::Seconds() - StartTime;
+				OutStats.FirstAllocations = CountingMalloc.GetNumAllocations();
+			}
+		}
+		OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+		OutStats.NumAllocations = CountingMalloc.GetNumAllocations();
+	}
+
+	Struct->DestroyStruct(StructData);
+	FMemory::Free(StructData);
+	Struct->MarkAsGarbage();
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FWebBrowserBenchmark::RunPaintRegionCoalescing(FWebBrowserPaintCoalescingStats& OutStats)
+{
+	OutStats = FWebBrowserPaintCoalescingStats();
+#if WITH_CEF3
+	struct FCoalescingCase
+	{
+		TArray<FIntRect> Rects;
+		int32 MaxRegions;
+		TArray<FIntRect> ExpectedRegions;
+		uint64 ExpectedBytes;
+	};
+
+	const FIntPoint FrameSize(1000, 1000);
+	const float MergeAreaRatio = 0.5f;
+	const FCoalescingCase Cases[] =
+	{
+		// Overlapping rects become their union
+		{ { FIntRect(0, 0, 100, 100), FIntRect(50, 0, 150, 100) }, 8, { FIntRect(0, 0, 150, 100) }, 150 * 100 * 4 },
+		// Adjacent strips become a single region
+		{ { FIntRect(0, 0, 100, 50), FIntRect(0, 50, 100, 100) }, 8, { FIntRect(0, 0, 100, 100) }, 100 * 100 * 4 },
+		// A caret and a clock far apart stay separate
+		{ { FIntRect(10, 10, 12, 30), FIntRect(900, 900, 960, 920) }, 8, { FIntRect(10, 10, 12, 30), FIntRect(900, 900, 960, 920) }, (2 * 20 + 60 * 20) * 4 },
+		// Rects are clipped to the frame, and dropped when outside of it
+		{ { FIntRect(-50, -50, 50, 50), FIntRect(990, 990, 1100, 1100), FIntRect(2000, 2000, 2100, 2100) }, 8, { FIntRect(0, 0, 50, 50), FIntRect(990, 990, 1000, 1000) }, (50 * 50 + 10 * 10) * 4 },
+		// Over the region limit, the pair wasting the least area is merged even though it fails the ratio
+		{ { FIntRect(0, 0, 10, 10), FIntRect(500, 0, 510, 10), FIntRect(0, 500, 10, 510) }, 2, { FIntRect(0, 0, 510, 10), FIntRect(0, 500, 10, 510) }, (510 * 10 + 10 * 10) * 4 },
+	};
+
+	const uint64 FrameBytes = static_cast<uint64>(FrameSize.X) * FrameSize.Y * 4;
+	for (const FCoalescingCase& Case : Cases)
+	{
+		OutStats.NumCases++;
+
+		TArray<FIntRect> Regions = Case.Rects;
+		FCEFPaintRegionUploader::CoalesceRects(Regions, FrameSize, MergeAreaRatio, Case.MaxRegions);
+
+		// The merges reorder the regions
+		bool bRegionsMatch = Regions.Num() == Case.ExpectedRegions.Num();
+		for (const FIntRect& Expected : Case.ExpectedRegions)
+		{
+			bRegionsMatch &= Regions.Contains(Expected);
+		}
+		OutStats.NumRegionMismatches += bRegionsMatch ? 0 : 1;
+
+		uint64 RegionBytes = 0;
+		for (const FIntRect& Region : Regions)
+		{
+			RegionBytes += static_cast<uint64>(Region.Area()) * 4;
+		}
+		OutStats.NumByteMismatches += RegionBytes == Case.ExpectedBytes ? 0 : 1;
+
+		// Nothing was uploaded yet, so the first paint has to upload the whole frame whatever its dirty rects
+		CefRenderHandler::RectList DirtyRects;
+		for (const FIntRect& Rect : Case.Rects)
+		{
+			DirtyRects.push_back(CefRect(Rect.Min.X, Rect.Min.Y, Rect.Width(), Rect.Height()));
+		}
+		FCEFPaintRegionUploader Uploader;
+		OutStats.NumEstimateMismatches += Uploader.EstimateUploadBytes(FrameSize.X, FrameSize.Y, DirtyRects) == FrameBytes ? 0 : 1;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FWebBrowserBenchmark::RunAcceleratedPaintBackends(int32 Width, int32 Height, int32 NumFrames, FWebBrowserAcceleratedPaintStats& OutStats)
+{
+	OutStats = FWebBrowserAcceleratedPaintStats();
+#if WITH_CEF3
+	struct FSelectionCase
+	{
+		ECEFAcceleratedPaintBackend Requested;
+		bool bHasD3DRHI;
+		bool bCanMapBuffers;
+		bool bIsGpuProcessReliable;
+		ECEFAcceleratedPaintBackend Expected;
+	};
+
+	using EBackend = ECEFAcceleratedPaintBackend;
+	const FSelectionCase Cases[] =
+	{
+		// Automatic: Windows D3D11 shares textures, everything else keeps the regular OnPaint path
+		{ EBackend::None, true, false, true, EBackend::D3DSharedTexture },
+		{ EBackend::None, true, false, false, EBackend::None },
+		{ EBackend::None, false, false, true, EBackend::None },
+		{ EBackend::None, false, true, true, EBackend::None },
+		// D3D: needs a D3D RHI and a reliable GPU process, mapping buffers doesn't help
+		{ EBackend::D3DSharedTexture, true, false, true, EBackend::D3DSharedTexture },
+		{ EBackend::D3DSharedTexture, true, false, false, EBackend::None },
+		{ EBackend::D3DSharedTexture, false, true, true, EBackend::None },
+		// Shared memory: Linux with mappable buffers and a reliable GPU process, never on D3D alone
+		{ EBackend::SharedMemory, false, true, true, EBackend::SharedMemory },
+		{ EBackend::SharedMemory, false, true, false, EBackend::None },
+		{ EBackend::SharedMemory, true, false, true, EBackend::None },
+		{ EBackend::SharedMemory, false, false, true, EBackend::None },
+		// Null: the same requirements as shared memory, even though it never touches the RHI
+		{ EBackend::Null, false, true, true, EBackend::Null },
+		{ EBackend::Null, false, true, false, EBackend::None },
+		{ EBackend::Null, true, false, true, EBackend::None },
+	};
+
+	for (const FSelectionCase& Case : Cases)
+	{
+		OutStats.NumSelectionCases++;
+		OutStats.NumSelectionMismatches += FCEFWebBrowserWindowRHIHelper::SelectBackend(Case.Requested, Case.bHasD3DRHI, Case.bCanMapBuffers, Case.bIsGpuProcessReliable) == Case.Expected ? 0 : 1;
+	}
+
+	OutStats.bCanMapBuffers = FCEFMappedPaintBackend::CanMapBuffers();
+	if (!OutStats.bCanMapBuffers)
+	{
+		return true;
+	}
+
+#if PLATFORM_LINUX && defined(SYS_memfd_create)
+	// Rows are padded the way GPU buffers usually are, so the copy has to go row by row
+	Width = FMath::Max(Width, 1);
+	Height = FMath::Max(Height, 1);
+	const uint32 Stride = Align(static_cast<uint32>(Width) * 4, 256) + 256;
+	const uint64 PlaneSize = static_cast<uint64>(Stride) * Height;
+	const int32 Fd = static_cast<int32>(syscall(SYS_memfd_create, "WebBrowserBenchmark", 0));
+	if (Fd < 0)
+	{
+		return false;
+	}
+
+	bool bFilled = ftruncate(Fd, static_cast<off_t>(PlaneSize)) == 0;
+	if (bFilled)
+	{
+		void* Mapped = mmap(nullptr, PlaneSize, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+		bFilled = Mapped != MAP_FAILED;
+		if (bFilled)
+		{
+			FMemory::Memset(Mapped, 0x7f, PlaneSize);
+			munmap(Mapped, PlaneSize);
+		}
+	}
+	if (!bFilled)
+	{
+		close(Fd);
+		return false;
+	}
+
+	FCEFAcceleratedPaintInfo Paint;
+	Paint.Plane.Fd = Fd;
+	Paint.Plane.Stride = Stride;
+	Paint.Plane.Size = PlaneSize;
+	Paint.Size = FIntPoint(Width, Height);
+	Paint.DirtyRect = FIntRect(FIntPoint::ZeroValue, Paint.Size);
+
+	FCEFStagingBufferPool StagingPool;
+	FCEFMappedPaintBackend Backend(ECEFAcceleratedPaintBackend::Null, StagingPool);
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		uint64 BytesCopied = 0;
+		if (Backend.CopyPaint(nullptr, Paint, BytesCopied))
+		{
+			OutStats.NumFramesCopied++;
+			OutStats.BytesCopied += BytesCopied;
+		}
+	}
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	close(Fd);
+	return true;
+#else
+	return false;
+#endif
+#else
+	return false;
+#endif
+}
+
+#if WITH_CEF3
+namespace
+{
+	/** A browser of RunUploadBudget, which counts its deferred paints instead of keeping them */
+	class FBenchmarkUploadTarget : public ICEFDeferredUploadTarget
+	{
+	public:
+		FBenchmarkUploadTarget(FWebBrowserUploadBudgetStats& InStats, const uint64& InFrameNumber, uint64& InFrameBytes)
+			: Stats(InStats)
+			, FrameNumber(InFrameNumber)
+			, FrameBytes(InFrameBytes)
+		{
+		}
+
+		/** Defers a paint, merging it with the paints deferred since the last flush */
+		void Defer(uint64 NumBytes, uint64 MaxBytes)
+		{
+			if (DeferredBytes == 0)
+			{
+				FirstDeferredFrame = FrameNumber;
+			}
+			DeferredBytes = FMath::Min(DeferredBytes + NumBytes, MaxBytes);
+		}
+
+		bool HasDeferred() const { return DeferredBytes > 0; }
+		uint64 GetDeferredBytes() const { return DeferredBytes; }
+
+		virtual void FlushDeferredUpload(CefRenderHandler::PaintElementType Type) override
+		{
+			Stats.NumDeferredUploads++;
+			Stats.BytesUploaded += DeferredBytes;
+			Stats.MaxDeferredFrames = FMath::Max(Stats.MaxDeferredFrames, static_cast<int32>(FrameNumber - FirstDeferredFrame));
+			FrameBytes += DeferredBytes;
+			DeferredBytes = 0;
+		}
+
+	private:
+		FWebBrowserUploadBudgetStats& Stats;
+		const uint64& FrameNumber;
+		uint64& FrameBytes;
+		uint64 DeferredBytes = 0;
+		uint64 FirstDeferredFrame = 0;
+	};
+}
+#endif
+
+bool FWebBrowserBenchmark::RunUploadBudget(int32 NumHuds, int32 Width, int32 Height, int32 NumFrames, int32 NumSpikeFrames, int32 BudgetBytesPerFrame, FWebBrowserUploadBudgetStats& OutStats)
+{
+	OutStats = FWebBrowserUploadBudgetStats();
+#if WITH_CEF3
+	IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("webbrowser.Upload.BudgetBytesPerFrame"));
+	IConsoleVariable* MaxDeferFramesCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("webbrowser.Upload.MaxDeferFrames"));
+	if (BudgetCVar == nullptr || MaxDeferFramesCVar == nullptr)
+	{
+		return false;
+	}
+
+	const int32 PreviousBudget = BudgetCVar->GetInt();
+	BudgetCVar->Set(FMath::Max(BudgetBytesPerFrame, 0), ECVF_SetByCode);
+	OutStats.MaxDeferFrames = MaxDeferFramesCVar->GetInt();
+
+	const uint64 ViewBytes = static_cast<uint64>(FMath::Max(Width, 1)) * FMath::Max(Height, 1) * 4;
+	const uint64 StripBytes = FMath::Max<uint64>(ViewBytes / 16, 4);
+	const int32 SpikeStart = NumFrames / 4;
+
+	uint64 FrameNumber = 0;
+	uint64 FrameBytes = 0;
+	TSharedRef<FCEFTextureUploadScheduler, ESPMode::ThreadSafe> Scheduler = MakeShared<FCEFTextureUploadScheduler, ESPMode::ThreadSafe>();
+	TArray<TSharedRef<FBenchmarkUploadTarget>> Huds;
+	for (int32 HudIndex = 0; HudIndex < NumHuds; ++HudIndex)
+	{
+		Huds.Add(MakeShared<FBenchmarkUploadTarget>(OutStats, FrameNumber, FrameBytes));
+	}
+
+	// The frames after the last paint drain what the spike left queued, the scheduler forcing anything past its deadline
+	const int32 MaxDrainFrames = OutStats.MaxDeferFrames + 2;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames + MaxDrainFrames; ++Frame)
+	{
+		if (Frame >= NumFrames && Scheduler->GetNumQueued() == 0)
+		{
+			break;
+		}
+
+		++FrameNumber;
+		FrameBytes = 0;
+		Scheduler->BeginFrame();
+
+		if (Frame < NumFrames)
+		{
+			const bool bIsSpike = Frame >= SpikeStart && Frame < SpikeStart + NumSpikeFrames;
+			for (int32 HudIndex = 0; HudIndex < NumHuds; ++HudIndex)
+			{
+				// Same decision as FCEFWebBrowserWindow::OnPaint for views
+				FBenchmarkUploadTarget& Hud = Huds[HudIndex].Get();
+				const uint64 PaintBytes = bIsSpike ? ViewBytes : StripBytes;
+				OutStats.NumPaints++;
+				if (FCEFTextureUploadScheduler::IsEnabled() && (Hud.HasDeferred() || !Scheduler->TryReserve(PaintBytes)))
+				{
+					Hud.Defer(PaintBytes, ViewBytes);
+					Scheduler->Submit(Huds[HudIndex], PET_VIEW, HudIndex == 0 ? ECEFUploadPriority::Focused : ECEFUploadPriority::Visible, Hud.GetDeferredBytes());
+					OutStats.NumPaintsDeferred++;
+				}
+				else
+				{
+					OutStats.BytesUploaded += PaintBytes;
+					FrameBytes += PaintBytes;
+				}
+			}
+		}
+		else
+		{
+			OutStats.NumDrainFrames++;
+		}
+
+		OutStats.MaxQueued = FMath::Max(OutStats.MaxQueued, Scheduler->GetNumQueued());
+		OutStats.MaxFrameBytes = FMath::Max(OutStats.MaxFrameBytes, FrameBytes);
+		OutStats.NumFramesOverBudget += (BudgetBytesPerFrame > 0 && FrameBytes > static_cast<uint64>(BudgetBytesPerFrame)) ? 1 : 0;
+	}
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	Scheduler->Reset();
+	BudgetCVar->Set(PreviousBudget, ECVF_SetByCode);
+	return true;
+#else
+	return false;
+#endif
+}
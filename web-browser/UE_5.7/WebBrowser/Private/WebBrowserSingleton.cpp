@@ -23,6 +23,7 @@
 #include "CEF/CEFSchemeHandler.h"
 #include "CEF/CEFResourceContextHandler.h"
 #include "CEF/CEFBrowserClosureTask.h"
+#include "WebBrowserStats.h"
 #	if PLATFORM_WINDOWS
 #		include "Windows/AllowWindowsPlatformTypes.h"
 #	endif
@@ -93,6 +94,67 @@ THIRD_PARTY_INCLUDES_END
 #	endif
 #endif
 
+#if WITH_CEF3
+DECLARE_DWORD_COUNTER_STAT(TEXT("Browser Pool Checkouts"), STAT_WebBrowserPoolCheckouts, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Browser Pool Misses"), STAT_WebBrowserPoolMisses, STATGROUP_WebBrowser);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Browser Pool Checkins"), STAT_WebBrowserPoolCheckins, STATGROUP_WebBrowser);
+
+namespace
+{
+	/** Fills in the CEF window info and browser settings for a new browser, off-screen browsers using the given accelerated paint backend. */
+	void SetupCefBrowserSettings(const FCreateBrowserWindowSettings& WindowSettings, ECEFAcceleratedPaintBackend AcceleratedPaintBackend, CefWindowInfo& WindowInfo, CefBrowserSettings& BrowserSettings)
+	{
+		// The color to paint before a document is loaded
+		// if using a windowed(native) browser window AND bUseTransparency is true then the background actually uses Settings.background_color from above
+		// if using a OSR window and bUseTransparency is true then you get a transparency channel in your BGRA OnPaint
+		// if bUseTransparency is false then you get the background color defined by your RGB setting here
+		BrowserSettings.background_color = CefColorSetARGB(WindowSettings.bUseTransparency ? 0 : WindowSettings.BackgroundColor.A, WindowSettings.BackgroundColor.R, WindowSettings.BackgroundColor.G, WindowSettings.BackgroundColor.B);
+
+#if CEF_VERSION_MAJOR < 128
+		// Disable plugins
+		BrowserSettings.plugins = STATE_DISABLED;
+#endif
+
+
+#if PLATFORM_WINDOWS
+		// Create the widget as a child window on windows when passing in a parent window
+		if (WindowSettings.OSWindowHandle != nullptr)
+		{
+			RECT ClientRect = { 0, 0, 0, 0 };
+			if (!GetClientRect((HWND)WindowSettings.OSWindowHandle, &ClientRect))
+			{
+				UE_LOG(LogWebBrowser, Error, TEXT("Failed to get client rect"));
+			}
+#if CEF_VERSION_MAJOR < 128
+			WindowInfo.SetAsChild((CefWindowHandle)WindowSettings.OSWindowHandle, ClientRect);
+#else
+			WindowInfo.SetAsChild((CefWindowHandle)WindowSettings.OSWindowHandle, { ClientRect.left, ClientRect.top, ClientRect.right - ClientRect.left, ClientRect.bottom - ClientRect.top });
+#endif
+		}
+		else
+#endif
+		{
+			// Use off screen rendering so we can integrate with our windows
+			WindowInfo.SetAsWindowless(kNullWindowHandle);
+			WindowInfo.shared_texture_enabled = (AcceleratedPaintBackend != ECEFAcceleratedPaintBackend::None) ? 1 : 0;
+			int BrowserFrameRate = WindowSettings.BrowserFrameRate;
+			if (AcceleratedPaintBackend != ECEFAcceleratedPaintBackend::None && BrowserFrameRate == 24)
+			{
+				// Use 60 fps if the accelerated renderer is enabled and the default framerate was otherwise selected
+				BrowserFrameRate = 60;
+			}
+			BrowserSettings.windowless_frame_rate = BrowserFrameRate;
+		}
+	}
+
+	/** Creates the handler implementing the browser-level callbacks of a new browser. */
+	CefRefPtr<FCEFBrowserHandler> CreateCefBrowserHandler(const FCreateBrowserWindowSettings& WindowSettings, const TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe>& AuthorizationHeaderAllowList)
+	{
+		return new FCEFBrowserHandler(WindowSettings.bUseTransparency, WindowSettings.bInterceptLoadRequests, WindowSettings.AltRetryDomains, AuthorizationHeaderAllowList);
+	}
+}
+#endif
+
 FString FWebBrowserSingleton::ApplicationCacheDir() const
 {
 #if PLATFORM_MAC
@@ -237,7 +299,9 @@ private:
 
 FWebBrowserSingleton::FWebBrowserSingleton(const FWebBrowserInitSettings& WebBrowserInitSettings)
 #if WITH_CEF3
-	: WebBrowserWindowFactory(MakeShareable(new FWebBrowserWindowFactory()))
+	: WindowRegistry(MakeShared<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe>())
+	, UploadScheduler(MakeShared<FCEFTextureUploadScheduler, ESPMode::ThreadSafe>())
+	, WebBrowserWindowFactory(MakeShareable(new FWebBrowserWindowFactory()))
 #else
 	: WebBrowserWindowFactory(MakeShareable(new FNoWebBrowserWindowFactory()))
 #if PLATFORM_IOS || PLATFORM_MAC || (PLATFORM_ANDROID && USE_ANDROID_JNI)
@@ -385,6 +449,10 @@ FWebBrowserSingleton::FWebBrowserSingleton(const FWebBrowserInitSettings& WebBro
 		FPlatformProcess::SetThreadName(*FName(NAME_GameThread).GetPlainNameString());
 
 		DefaultCookieManager = FCefWebBrowserCookieManagerFactory::Create(CefCookieManager::GetGlobalManager(nullptr));
+
+		// Accept-Language is computed once per culture rather than per request
+		DefaultRequestHeaders = MakeShared<FCEFRequestHeaders, ESPMode::ThreadSafe>(TMap<FString, FString>());
+		FInternationalization::Get().OnCultureChanged().AddRaw(this, &FWebBrowserSingleton::HandleCultureChanged);
 	}
 #elif (PLATFORM_MAC || PLATFORM_IOS) && !BUILD_EMBEDDED_APP
 	DefaultCookieManager = MakeShareable(new FAppleCookieManager());
@@ -433,12 +501,20 @@ FWebBrowserSingleton::~FWebBrowserSingleton()
 
 	if (bAllowCEF)
 	{
+		if (FInternationalization::IsAvailable())
+		{
+			FInternationalization::Get().OnCultureChanged().RemoveAll(this);
+		}
+
+		// Close the idle pooled browsers along with the others below
+		ClearBrowserWindowPool();
+
 		{
-			FScopeLock Lock(&WindowInterfacesCS);
 			// Force all existing browsers to close in case any haven't been deleted
-			for (int32 Index = 0; Index < WindowInterfaces.Num(); ++Index)
+			TSharedRef<const FCEFWebBrowserWindowRegistry::FSnapshot, ESPMode::ThreadSafe> WindowSnapshot = WindowRegistry->GetSnapshot();
+			for (const TWeakPtr<FCEFWebBrowserWindow>& WeakBrowserWindow : *WindowSnapshot)
 			{
-				auto BrowserWindow = WindowInterfaces[Index].Pin();
+				TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WeakBrowserWindow.Pin();
 				if (BrowserWindow.IsValid() && BrowserWindow->IsValid())
 				{
 					// Call CloseBrowser directly on the Host object as FWebBrowserWindow::CloseBrowser is delayed
@@ -446,22 +522,27 @@ FWebBrowserSingleton::~FWebBrowserSingleton()
 				}
 			}
 			// Clear this before CefShutdown() below
-			WindowInterfaces.Reset();
+			WindowRegistry->Reset();
+			UploadScheduler->Reset();
 		}
 
 		// Remove references to the scheme handler factories
-		CefClearSchemeHandlerFactories();
-		for (const TPair<FString, CefRefPtr<CefRequestContext>>& RequestContextPair : RequestContexts)
-		{
-			RequestContextPair.Value->ClearSchemeHandlerFactories();
-		}
+		SchemeHandlerFactories.Reset();
 		// Clear this before CefShutdown() below
 		RequestContexts.Reset();
+		for (const TPair<FString, TSharedPtr<IWebBrowserCookieManager>>& CookieManagerPair : ContextCookieManagers)
+		{
+			FCefWebBrowserCookieManagerFactory::Detach(CookieManagerPair.Value);
+		}
+		ContextCookieManagers.Reset();
+		// The default manager flushes its store and posts its pending completions when destroyed, which needs CEF running
+		FCefWebBrowserCookieManagerFactory::Detach(DefaultCookieManager);
+		DefaultCookieManager.Reset();
 
 		// make sure any handler before load delegates are unbound
 		for (const TPair <FString,CefRefPtr<FCEFResourceContextHandler>>& HandlerPair : RequestResourceHandlers)
 		{
-			HandlerPair.Value->OnBeforeLoad().Unbind();
+			HandlerPair.Value->UnbindOnBeforeLoad();
 		}
 		// Clear this before CefShutdown() below
 		RequestResourceHandlers.Reset();
@@ -510,15 +591,16 @@ TSharedPtr<IWebBrowserWindow> FWebBrowserSingleton::CreateBrowserWindow(
 		bool bShowErrorMessage = BrowserWindowParent->IsShowingErrorMessages();
 		bool bThumbMouseButtonNavigation = BrowserWindowParent->IsThumbMouseButtonNavigationEnabled();
 		bool bUseTransparency = BrowserWindowParent->UseTransparency();
-		bool bUsingAcceleratedPaint = BrowserWindowParent->UsingAcceleratedPaint();
+		ECEFAcceleratedPaintBackend AcceleratedPaintBackend = BrowserWindowParent->GetAcceleratedPaintBackend();
 		FString InitialURL = WCHAR_TO_TCHAR(BrowserWindowInfo->Browser->GetMainFrame()->GetURL().ToWString().c_str());
-		TSharedPtr<FCEFWebBrowserWindow> NewBrowserWindow(new FCEFWebBrowserWindow(BrowserWindowInfo->Browser, BrowserWindowInfo->Handler, InitialURL, ContentsToLoad, bShowErrorMessage, bThumbMouseButtonNavigation, bUseTransparency, bJSBindingsToLoweringEnabled, bUsingAcceleratedPaint));
+		int32 BufferedVideoFrames = BrowserWindowParent->GetBufferedVideoFrames();
+		TSharedPtr<FCEFWebBrowserWindow> NewBrowserWindow(new FCEFWebBrowserWindow(BrowserWindowInfo->Browser, BrowserWindowInfo->Handler, InitialURL, ContentsToLoad, bShowErrorMessage, bThumbMouseButtonNavigation, bUseTransparency, bJSBindingsToLoweringEnabled, AcceleratedPaintBackend, BufferedVideoFrames));
 		BrowserWindowInfo->Handler->SetBrowserWindow(NewBrowserWindow);
-		{
-			FScopeLock Lock(&WindowInterfacesCS);
-			WindowInterfaces.Add(NewBrowserWindow);
-		}
-		NewBrowserWindow->GetCefBrowser()->GetHost()->SetWindowlessFrameRate(BrowserWindowParent->GetCefBrowser()->GetHost()->GetWindowlessFrameRate());
+		// Popups share the request context of the browser that opened them
+		WindowRegistry->Add(NewBrowserWindow.ToSharedRef(), WindowRegistry->FindContextId(BrowserWindowParent->GetCefBrowser()->GetIdentifier()));
+		NewBrowserWindow->SetUploadScheduler(UploadScheduler);
+		NewBrowserWindow->SetFrameRate(BrowserWindowParent->GetFrameRate());
+		NewBrowserWindow->SetIdleFrameRate(BrowserWindowParent->GetIdleFrameRate());
 		return NewBrowserWindow;
 	}
 #endif
@@ -537,119 +619,35 @@ TSharedPtr<IWebBrowserWindow> FWebBrowserSingleton::CreateBrowserWindow(const FC
 #if WITH_CEF3
 	if (bAllowCEF)
 	{
+		// The backend is selected once, so the browser, its window and its pool agree on it if the selection changes later
+		const ECEFAcceleratedPaintBackend AcceleratedPaintBackend = FCEFWebBrowserWindow::SelectAcceleratedPaintBackend();
+
+		// Check a warm browser out of the pool if one was prewarmed with compatible settings
+		const FString PoolKey = GetBrowserPoolKey(WindowSettings, AcceleratedPaintBackend);
+		if (TSharedPtr<FCEFWebBrowserWindow> PooledBrowserWindow = CheckoutPooledBrowserWindow(PoolKey, WindowSettings))
+		{
+			return PooledBrowserWindow;
+		}
+
 		// Information used when creating the native window.
 		CefWindowInfo WindowInfo;
 
 		// Specify CEF browser settings here.
 		CefBrowserSettings BrowserSettings;
 
-		// The color to paint before a document is loaded
-		// if using a windowed(native) browser window AND bUseTransparency is true then the background actually uses Settings.background_color from above
-		// if using a OSR window and bUseTransparency is true then you get a transparency channel in your BGRA OnPaint
-		// if bUseTransparency is false then you get the background color defined by your RGB setting here
-		BrowserSettings.background_color = CefColorSetARGB(WindowSettings.bUseTransparency ? 0 : WindowSettings.BackgroundColor.A, WindowSettings.BackgroundColor.R, WindowSettings.BackgroundColor.G, WindowSettings.BackgroundColor.B);
-
-#if CEF_VERSION_MAJOR < 128
-		// Disable plugins
-		BrowserSettings.plugins = STATE_DISABLED;
-#endif
-
-
-#if PLATFORM_WINDOWS
-		// Create the widget as a child window on windows when passing in a parent window
-		if (WindowSettings.OSWindowHandle != nullptr)
-		{
-			RECT ClientRect = { 0, 0, 0, 0 };
-			if (!GetClientRect((HWND)WindowSettings.OSWindowHandle, &ClientRect))
-			{
-				UE_LOG(LogWebBrowser, Error, TEXT("Failed to get client rect"));
-			}
-#if CEF_VERSION_MAJOR < 128
-			WindowInfo.SetAsChild((CefWindowHandle)WindowSettings.OSWindowHandle, ClientRect);
-#else
-			WindowInfo.SetAsChild((CefWindowHandle)WindowSettings.OSWindowHandle, { ClientRect.left, ClientRect.top, ClientRect.right - ClientRect.left, ClientRect.bottom - ClientRect.top });
-#endif
-		}
-		else
-#endif
-		{
-			// Use off screen rendering so we can integrate with our windows
-			WindowInfo.SetAsWindowless(kNullWindowHandle);
-			WindowInfo.shared_texture_enabled = FCEFWebBrowserWindow::CanSupportAcceleratedPaint() ? 1 : 0;
-			int BrowserFrameRate = WindowSettings.BrowserFrameRate;
-			if (FCEFWebBrowserWindow::CanSupportAcceleratedPaint() && BrowserFrameRate == 24)
-			{
-				// Use 60 fps if the accelerated renderer is enabled and the default framerate was otherwise selected
-				BrowserFrameRate = 60;
-			}
-			BrowserSettings.windowless_frame_rate = BrowserFrameRate;
-		}
-
-		TArray<FString> AuthorizationHeaderAllowListURLS;
-		GConfig->GetArray(TEXT("Browser"), TEXT("AuthorizationHeaderAllowListURLS"), AuthorizationHeaderAllowListURLS, GEngineIni);
+		SetupCefBrowserSettings(WindowSettings, AcceleratedPaintBackend, WindowInfo, BrowserSettings);
 
 		// WebBrowserHandler implements browser-level callbacks.
-		CefRefPtr<FCEFBrowserHandler> NewHandler(new FCEFBrowserHandler(WindowSettings.bUseTransparency, WindowSettings.bInterceptLoadRequests ,WindowSettings.AltRetryDomains, AuthorizationHeaderAllowListURLS));
-
-		CefRefPtr<CefRequestContext> RequestContext = nullptr;
-		if (WindowSettings.Context.IsSet())
-		{
-			const FBrowserContextSettings Context = WindowSettings.Context.GetValue();
-			const CefRefPtr<CefRequestContext>* ExistingRequestContext = RequestContexts.Find(Context.Id);
-
-			if (ExistingRequestContext == nullptr)
-			{
-				CefRequestContextSettings RequestContextSettings;
-				CefString(&RequestContextSettings.accept_language_list) = Context.AcceptLanguageList.IsEmpty() ? TCHAR_TO_WCHAR(*GetCurrentLocaleCode()) : TCHAR_TO_WCHAR(*Context.AcceptLanguageList);
-				CefString(&RequestContextSettings.cache_path) = TCHAR_TO_WCHAR(*GenerateWebCacheFolderName(Context.CookieStorageLocation));
-				RequestContextSettings.persist_session_cookies = Context.bPersistSessionCookies;
-#if CEF_VERSION_MAJOR < 128
-				RequestContextSettings.ignore_certificate_errors = Context.bIgnoreCertificateErrors;
-#endif
-
-				CefRefPtr<FCEFResourceContextHandler> ResourceContextHandler = new FCEFResourceContextHandler(this);
-				ResourceContextHandler->OnBeforeLoad() = Context.OnBeforeContextResourceLoad;
-				RequestResourceHandlers.Add(Context.Id, ResourceContextHandler);
+		CefRefPtr<FCEFBrowserHandler> NewHandler = CreateCefBrowserHandler(WindowSettings, GetAuthorizationHeaderAllowList());
 
-				//Create a new one
-				RequestContext = CefRequestContext::CreateContext(RequestContextSettings, ResourceContextHandler);
-				RequestContexts.Add(Context.Id, RequestContext);
-			}
-			else
-			{
-				RequestContext = *ExistingRequestContext;
-			}
-			SchemeHandlerFactories.RegisterFactoriesWith(RequestContext);
-			UE_LOG(LogWebBrowser, Log, TEXT("Creating browser for ContextId=%s."), *WindowSettings.Context.GetValue().Id);
-		}
-		if (RequestContext == nullptr)
-		{
-			// As of CEF drop 4430 the CreateBrowserSync call requires a non-null request context, so fall back to the default one if needed
-			RequestContext = CefRequestContext::GetGlobalContext();
-		}
+		CefRefPtr<CefRequestContext> RequestContext = GetOrCreateRequestContext(WindowSettings);
+		NewHandler->SetRequestHeaders(GetRequestHeaders(WindowSettings));
 
 		// Create the CEF browser window.
 		CefRefPtr<CefBrowser> Browser = CefBrowserHost::CreateBrowserSync(WindowInfo, NewHandler.get(), TCHAR_TO_WCHAR(*WindowSettings.InitialURL), BrowserSettings, nullptr, RequestContext);
 		if (Browser.get())
 		{
-			// Create new window
-			TSharedPtr<FCEFWebBrowserWindow> NewBrowserWindow = MakeShareable(new FCEFWebBrowserWindow(
-				Browser,
-				NewHandler,
-				WindowSettings.InitialURL,
-				WindowSettings.ContentsToLoad,
-				WindowSettings.bShowErrorMessage,
-				WindowSettings.bThumbMouseButtonNavigation,
-				WindowSettings.bUseTransparency,
-				bJSBindingsToLoweringEnabled,
-				WindowInfo.shared_texture_enabled == 1 ? true : false));
-			NewHandler->SetBrowserWindow(NewBrowserWindow);
-			{
-				FScopeLock Lock(&WindowInterfacesCS);
-				WindowInterfaces.Add(NewBrowserWindow);
-			}
-
-			return NewBrowserWindow;
+			return CreateCefBrowserWindow(Browser, NewHandler, WindowSettings, WindowInfo.shared_texture_enabled == 1 ? AcceleratedPaintBackend : ECEFAcceleratedPaintBackend::None, PoolKey);
 		}
 	}
 #elif PLATFORM_ANDROID && USE_ANDROID_JNI
@@ -704,6 +702,301 @@ TSharedPtr<IWebBrowserWindow> FWebBrowserSingleton::CreateBrowserWindow(const FC
 	return nullptr;
 }
 
+#if WITH_CEF3
+CefRefPtr<CefRequestContext> FWebBrowserSingleton::GetOrCreateRequestContext(const FCreateBrowserWindowSettings& WindowSettings)
+{
+	CefRefPtr<CefRequestContext> RequestContext = nullptr;
+	if (WindowSettings.Context.IsSet())
+	{
+		const FBrowserContextSettings Context = WindowSettings.Context.GetValue();
+		const CefRefPtr<CefRequestContext>* ExistingRequestContext = RequestContexts.Find(Context.Id);
+
+		if (ExistingRequestContext == nullptr)
+		{
+			CefRequestContextSettings RequestContextSettings;
+			CefString(&RequestContextSettings.accept_language_list) = Context.AcceptLanguageList.IsEmpty() ? TCHAR_TO_WCHAR(*GetCurrentLocaleCode()) : TCHAR_TO_WCHAR(*Context.AcceptLanguageList);
+			CefString(&RequestContextSettings.cache_path) = TCHAR_TO_WCHAR(*GenerateWebCacheFolderName(Context.CookieStorageLocation));
+			RequestContextSettings.persist_session_cookies = Context.bPersistSessionCookies;
+#if CEF_VERSION_MAJOR < 128
+			RequestContextSettings.ignore_certificate_errors = Context.bIgnoreCertificateErrors;
+#endif
+
+			CefRefPtr<FCEFResourceContextHandler> ResourceContextHandler = new FCEFResourceContextHandler(this, Context.Id, Context.RequestHeaders);
+			ResourceContextHandler->SetOnBeforeLoad(Context.OnBeforeContextResourceLoad, Context.OnBeforeContextResourceRequest);
+			RequestResourceHandlers.Add(Context.Id, ResourceContextHandler);
+
+			//Create a new one
+			RequestContext = CefRequestContext::CreateContext(RequestContextSettings, ResourceContextHandler);
+			RequestContexts.Add(Context.Id, RequestContext);
+		}
+		else
+		{
+			RequestContext = *ExistingRequestContext;
+		}
+		SchemeHandlerFactories.RegisterFactoriesWith(RequestContext);
+		UE_LOG(LogWebBrowser, Log, TEXT("Creating browser for ContextId=%s."), *WindowSettings.Context.GetValue().Id);
+	}
+	if (RequestContext == nullptr)
+	{
+		// As of CEF drop 4430 the CreateBrowserSync call requires a non-null request context, so fall back to the default one if needed
+		RequestContext = CefRequestContext::GetGlobalContext();
+	}
+	return RequestContext;
+}
+
+TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe> FWebBrowserSingleton::GetAuthorizationHeaderAllowList()
+{
+	TArray<FString> AuthorizationHeaderAllowListURLS;
+	GConfig->GetArray(TEXT("Browser"), TEXT("AuthorizationHeaderAllowListURLS"), AuthorizationHeaderAllowListURLS, GEngineIni);
+
+	// Compiled once and shared by every browser, until the config changes
+	if (!AuthorizationHeaderAllowList.IsValid() || AuthorizationHeaderAllowList->GetPatterns() != AuthorizationHeaderAllowListURLS)
+	{
+		AuthorizationHeaderAllowList = MakeShared<const FCEFDomainMatcher, ESPMode::ThreadSafe>(AuthorizationHeaderAllowListURLS);
+	}
+	return AuthorizationHeaderAllowList;
+}
+
+TSharedPtr<const FCEFRequestHeaders, ESPMode::ThreadSafe> FWebBrowserSingleton::GetRequestHeaders(const FCreateBrowserWindowSettings& WindowSettings) const
+{
+	if (WindowSettings.Context.IsSet())
+	{
+		if (const CefRefPtr<FCEFResourceContextHandler>* ResourceHandler = RequestResourceHandlers.Find(WindowSettings.Context->Id))
+		{
+			return (*ResourceHandler)->GetRequestHeaders();
+		}
+	}
+	return DefaultRequestHeaders;
+}
+
+void FWebBrowserSingleton::HandleCultureChanged()
+{
+	DefaultRequestHeaders->OnCultureChanged();
+	for (const TPair<FString, CefRefPtr<FCEFResourceContextHandler>>& HandlerPair : RequestResourceHandlers)
+	{
+		HandlerPair.Value->GetRequestHeaders()->OnCultureChanged();
+	}
+}
+
+TSharedPtr<FCEFWebBrowserWindow> FWebBrowserSingleton::CreateCefBrowserWindow(CefRefPtr<CefBrowser> Browser, CefRefPtr<FCEFBrowserHandler> Handler, const FCreateBrowserWindowSettings& WindowSettings, ECEFAcceleratedPaintBackend AcceleratedPaintBackend, const FString& PoolKey)
+{
+	// Create new window
+	TSharedPtr<FCEFWebBrowserWindow> NewBrowserWindow = MakeShareable(new FCEFWebBrowserWindow(
+		Browser,
+		Handler,
+		WindowSettings.InitialURL,
+		WindowSettings.ContentsToLoad,
+		WindowSettings.bShowErrorMessage,
+		WindowSettings.bThumbMouseButtonNavigation,
+		WindowSettings.bUseTransparency,
+		bJSBindingsToLoweringEnabled,
+		AcceleratedPaintBackend,
+		WindowSettings.bUseBufferedVideo ? FMath::Max(WindowSettings.BufferedVideoFrames, 1) : 0));
+	Handler->SetBrowserWindow(NewBrowserWindow);
+	NewBrowserWindow->SetBrowserPoolKey(PoolKey);
+	WindowRegistry->Add(NewBrowserWindow.ToSharedRef(), WindowSettings.Context.IsSet() ? WindowSettings.Context->Id : FString());
+	NewBrowserWindow->SetUploadScheduler(UploadScheduler);
+
+	return NewBrowserWindow;
+}
+
+FString FWebBrowserSingleton::GetBrowserPoolKey(const FCreateBrowserWindowSettings& WindowSettings, ECEFAcceleratedPaintBackend AcceleratedPaintBackend) const
+{
+	// Only off-screen browsers can be pooled, as native child windows are created for a given parent
+	if (WindowSettings.OSWindowHandle != nullptr)
+	{
+		return FString();
+	}
+
+	// Everything that is baked into the CEF browser or its handler at creation time must match
+	return FString::Printf(TEXT("%s|%d|%d|%d|%08x|%d|%d|%d|%s"),
+		WindowSettings.Context.IsSet() ? *WindowSettings.Context.GetValue().Id : TEXT(""),
+		WindowSettings.bUseTransparency ? 1 : 0,
+		WindowSettings.bInterceptLoadRequests ? 1 : 0,
+		bJSBindingsToLoweringEnabled ? 1 : 0,
+		WindowSettings.BackgroundColor.ToPackedARGB(),
+		WindowSettings.BrowserFrameRate,
+		WindowSettings.bUseBufferedVideo ? FMath::Max(WindowSettings.BufferedVideoFrames, 1) : 0,
+		static_cast<int32>(AcceleratedPaintBackend),
+		*FString::Join(WindowSettings.AltRetryDomains, TEXT(",")));
+}
+
+TSharedPtr<FCEFWebBrowserWindow> FWebBrowserSingleton::CheckoutPooledBrowserWindow(const FString& PoolKey, const FCreateBrowserWindowSettings& WindowSettings)
+{
+	FBrowserWindowPool* Pool = PoolKey.IsEmpty() ? nullptr : BrowserWindowPools.Find(PoolKey);
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FCEFWebBrowserWindow> BrowserWindow;
+	while (!BrowserWindow.IsValid() && Pool->IdleWindows.Num() > 0)
+	{
+		TSharedPtr<FCEFWebBrowserWindow> IdleWindow = Pool->IdleWindows.Pop(EAllowShrinking::No);
+		if (IdleWindow.IsValid() && IdleWindow->IsValid() && !IdleWindow->IsClosing())
+		{
+			BrowserWindow = IdleWindow;
+		}
+	}
+
+	// Start warming a replacement in the background
+	RefillBrowserWindowPool(PoolKey);
+
+	if (!BrowserWindow.IsValid())
+	{
+		INC_DWORD_STAT(STAT_WebBrowserPoolMisses);
+		UE_LOG(LogWebBrowser, Verbose, TEXT("No warm browser available for pool %s."), *PoolKey);
+		return nullptr;
+	}
+
+	INC_DWORD_STAT(STAT_WebBrowserPoolCheckouts);
+	BrowserWindow->bShowErrorMessage = WindowSettings.bShowErrorMessage;
+	BrowserWindow->bThumbMouseButtonNavigation = WindowSettings.bThumbMouseButtonNavigation;
+	if (WindowSettings.ContentsToLoad.IsSet())
+	{
+		BrowserWindow->LoadString(WindowSettings.ContentsToLoad.GetValue(), WindowSettings.InitialURL);
+	}
+	else
+	{
+		BrowserWindow->LoadURL(WindowSettings.InitialURL);
+	}
+	return BrowserWindow;
+}
+
+void FWebBrowserSingleton::RefillBrowserWindowPool(const FString& PoolKey)
+{
+	FBrowserWindowPool* Pool = BrowserWindowPools.Find(PoolKey);
+	while (Pool != nullptr && Pool->IdleWindows.Num() + Pool->NumPending < Pool->TargetSize)
+	{
+		CefWindowInfo WindowInfo;
+		CefBrowserSettings BrowserSettings;
+		SetupCefBrowserSettings(Pool->Settings, Pool->AcceleratedPaintBackend, WindowInfo, BrowserSettings);
+
+		CefRefPtr<FCEFBrowserHandler> NewHandler = CreateCefBrowserHandler(Pool->Settings, GetAuthorizationHeaderAllowList());
+		NewHandler->OnBrowserCreated().BindRaw(this, &FWebBrowserSingleton::HandlePooledBrowserCreated, PoolKey, Pool->Generation);
+
+		CefRefPtr<CefRequestContext> RequestContext = GetOrCreateRequestContext(Pool->Settings);
+		NewHandler->SetRequestHeaders(GetRequestHeaders(Pool->Settings));
+
+		// Unlike CreateBrowserSync this returns immediately, the browser is delivered to HandlePooledBrowserCreated once its renderer is up
+		if (!CefBrowserHost::CreateBrowser(WindowInfo, NewHandler.get(), "about:blank", BrowserSettings, nullptr, RequestContext))
+		{
+			UE_LOG(LogWebBrowser, Warning, TEXT("Failed to prewarm a browser for pool %s."), *PoolKey);
+			NewHandler->OnBrowserCreated().Unbind();
+			break;
+		}
+		Pool->NumPending++;
+	}
+}
+
+void FWebBrowserSingleton::HandlePooledBrowserCreated(CefRefPtr<CefBrowser> Browser, FString PoolKey, uint32 Generation)
+{
+	FBrowserWindowPool* Pool = BrowserWindowPools.Find(PoolKey);
+	if (Pool == nullptr || Pool->Generation != Generation)
+	{
+		// The pool was cleared while this browser was being created
+		Browser->GetHost()->CloseBrowser(true);
+		return;
+	}
+	Pool->NumPending--;
+
+	CefRefPtr<FCEFBrowserHandler> Handler = static_cast<FCEFBrowserHandler*>(Browser->GetHost()->GetClient().get());
+	TSharedPtr<FCEFWebBrowserWindow> NewBrowserWindow = CreateCefBrowserWindow(Browser, Handler, Pool->Settings, Pool->AcceleratedPaintBackend, PoolKey);
+	NewBrowserWindow->SetIsHidden(true);
+	Pool->IdleWindows.Add(NewBrowserWindow);
+}
+#endif
+
+void FWebBrowserSingleton::PrewarmBrowserWindows(const FCreateBrowserWindowSettings& Settings, int32 NumBrowsers)
+{
+#if WITH_CEF3
+	bool bBrowserEnabled = true;
+	GConfig->GetBool(TEXT("Browser"), TEXT("bEnabled"), bBrowserEnabled, GEngineIni);
+	if (!bAllowCEF || !bBrowserEnabled || !FApp::CanEverRender())
+	{
+		return;
+	}
+
+	const ECEFAcceleratedPaintBackend AcceleratedPaintBackend = FCEFWebBrowserWindow::SelectAcceleratedPaintBackend();
+	const FString PoolKey = GetBrowserPoolKey(Settings, AcceleratedPaintBackend);
+	if (PoolKey.IsEmpty())
+	{
+		UE_LOG(LogWebBrowser, Warning, TEXT("Only off-screen browsers can be prewarmed."));
+		return;
+	}
+
+	FBrowserWindowPool& Pool = BrowserWindowPools.FindOrAdd(PoolKey);
+	if (Pool.Generation == 0)
+	{
+		Pool.Generation = ++LastBrowserWindowPoolGeneration;
+		Pool.Settings = Settings;
+		Pool.AcceleratedPaintBackend = AcceleratedPaintBackend;
+		Pool.Settings.InitialURL = TEXT("about:blank");
+		Pool.Settings.ContentsToLoad.Reset();
+	}
+	Pool.TargetSize = FMath::Max(NumBrowsers, 0);
+
+	// Close idle browsers beyond the new size
+	while (Pool.IdleWindows.Num() > Pool.TargetSize)
+	{
+		Pool.IdleWindows.Pop()->CloseBrowser(true, false);
+	}
+
+	RefillBrowserWindowPool(PoolKey);
+#endif
+}
+
+bool FWebBrowserSingleton::ReleaseBrowserWindow(const TSharedPtr<IWebBrowserWindow>& BrowserWindow)
+{
+#if WITH_CEF3
+	if (!bAllowCEF || !BrowserWindow.IsValid())
+	{
+		return false;
+	}
+
+	TSharedPtr<FCEFWebBrowserWindow> CefBrowserWindow = StaticCastSharedPtr<FCEFWebBrowserWindow>(BrowserWindow);
+	FBrowserWindowPool* Pool = CefBrowserWindow->GetBrowserPoolKey().IsEmpty() ? nullptr : BrowserWindowPools.Find(CefBrowserWindow->GetBrowserPoolKey());
+	if (Pool == nullptr || !CefBrowserWindow->IsValid() || CefBrowserWindow->IsClosing())
+	{
+		return false;
+	}
+	if (Pool->IdleWindows.Contains(CefBrowserWindow))
+	{
+		return true;
+	}
+	if (Pool->IdleWindows.Num() + Pool->NumPending >= Pool->TargetSize)
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_WebBrowserPoolCheckins);
+	CefBrowserWindow->ResetForReuse();
+	Pool->IdleWindows.Add(CefBrowserWindow);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FWebBrowserSingleton::ClearBrowserWindowPool(TOptional<FString> ContextId)
+{
+#if WITH_CEF3
+	for (auto It = BrowserWindowPools.CreateIterator(); It; ++It)
+	{
+		const FCreateBrowserWindowSettings& PoolSettings = It.Value().Settings;
+		if (!ContextId.IsSet() || (PoolSettings.Context.IsSet() && PoolSettings.Context.GetValue().Id == ContextId.GetValue()))
+		{
+			// Browsers still being created are closed by HandlePooledBrowserCreated once the pool is gone
+			for (const TSharedPtr<FCEFWebBrowserWindow>& IdleWindow : It.Value().IdleWindows)
+			{
+				IdleWindow->CloseBrowser(true, false);
+			}
+			It.RemoveCurrent();
+		}
+	}
+#endif
+}
+
 #if BUILD_EMBEDDED_APP
 TSharedPtr<IWebBrowserWindow> FWebBrowserSingleton::CreateNativeBrowserProxy()
 {
@@ -724,118 +1017,85 @@ bool FWebBrowserSingleton::Tick(float DeltaTime)
 #if WITH_CEF3
 	if (bAllowCEF)
 	{
+		// Windows remove themselves from the registry when destroyed, so the snapshot only needs to be walked, not pruned
+		TSharedRef<const FCEFWebBrowserWindowRegistry::FSnapshot, ESPMode::ThreadSafe> WindowSnapshot = WindowRegistry->GetSnapshot();
+		bool bIsSlateAwake = FSlateApplication::IsInitialized() && !FSlateApplication::Get().IsSlateAsleep();
+		// Check whether each window is currently visible
+		if (bIsSlateAwake) // only check for Tick activity if Slate is currently ticking
 		{
-			FScopeLock Lock(&WindowInterfacesCS);
-			bool bIsSlateAwake = FSlateApplication::IsInitialized() && !FSlateApplication::Get().IsSlateAsleep();
-			// Remove any windows that have been deleted and check whether it's currently visible
-			for (int32 Index = WindowInterfaces.Num() - 1; Index >= 0; --Index)
+			for (const TWeakPtr<FCEFWebBrowserWindow>& WeakBrowserWindow : *WindowSnapshot)
 			{
-				if (!WindowInterfaces[Index].IsValid())
+				TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WeakBrowserWindow.Pin();
+				if(BrowserWindow.IsValid())
 				{
-					WindowInterfaces.RemoveAt(Index);
-				}
-				else if (bIsSlateAwake) // only check for Tick activity if Slate is currently ticking
-				{
-					TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WindowInterfaces[Index].Pin();
-					if(BrowserWindow.IsValid())
-					{
-						// Test if we've ticked recently. If not assume the browser window has become hidden.
-						BrowserWindow->CheckTickActivity();
-					}
+					// Test if we've ticked recently. If not assume the browser window has become hidden.
+					BrowserWindow->CheckTickActivity();
 				}
 			}
 		}
 
+		// Upload the paints deferred by earlier frames before CEF paints again below
+		UploadScheduler->BeginFrame();
+
 	if (CEFBrowserApp != nullptr)
 	{
-		bool bForceMessageLoop = false;
-		GConfig->GetBool(TEXT("Browser"), TEXT("bForceMessageLoop"), bForceMessageLoop, GEngineIni);
-
-		// Get the configured minimum hertz and make sure the value is within a reasonable range
-		static const int MaxFrameRateClamp = 60;
-		int32 MinMessageLoopHz = 1;
-		GConfig->GetInt(TEXT("Browser"), TEXT("MinMessageLoopHertz"), MinMessageLoopHz, GEngineIni);
-		MinMessageLoopHz = FMath::Clamp(MinMessageLoopHz, 1, 60);
-
-		// Get the configured forced maximum hertz and make sure the value is within a reasonable range
-		int32 MaxForcedMessageLoopHz = 15;
-		GConfig->GetInt(TEXT("Browser"), TEXT("MaxForcedMessageLoopHertz"), MaxForcedMessageLoopHz, GEngineIni);
-		MaxForcedMessageLoopHz = FMath::Clamp(MaxForcedMessageLoopHz, MinMessageLoopHz, 60);
+		const double Now = PreviousTickTimeSeconds;
+		static constexpr double AppFocusCheckSeconds = 1.0;
 
-		// @todo: Hack: We rely on OnScheduleMessagePumpWork() which tells us to drive the CEF message pump, 
-		//  there appear to be some edge cases where we might not be getting a signal from it so for the time being 
-		//  we force a minimum rates here and let it run at a configurable maximum rate when we have any WindowInterfaces.
-
-		// Convert to seconds which we'll use to compare against the time we accumulated since last pump / left till next pump
-		float MinMessageLoopSeconds = 1.0f / MinMessageLoopHz;
-		float MaxForcedMessageLoopSeconds = 1.0f / MaxForcedMessageLoopHz;
-
-		// Set the external tick-call wait time to be in the acceptable range, but leaning heavily toward the longer time. That way, the ticker in
-		// this class is likely to tick itself first, whenever possible. If the ticker is suspended (see where this is used outside of this class),
-		// then this should be an acceptable wait time.
-		static constexpr float ExternalTickCallWaitSecondsScale = 0.95f; 
-		ExternalTickCallWaitSeconds = ExternalTickCallWaitSecondsScale * MaxForcedMessageLoopSeconds;
-		
-		static float SecondsSinceLastPump = 0;
-		static float SecondsSinceLastAppFocusCheck = MaxForcedMessageLoopSeconds;
-		static float SecondsToNextForcedPump = MaxForcedMessageLoopSeconds;
-
-		// Accumulate time since last pump by adding DeltaTime which gives us the amount of time that has passed since last tick in seconds
-		SecondsSinceLastPump += DeltaTime;
-		SecondsSinceLastAppFocusCheck += DeltaTime;
-		// Time left till next pump
-		SecondsToNextForcedPump -= DeltaTime;
-
-		bool bWantForce = bForceMessageLoop;								  // True if we wish to force message pump
-		bool bCanForce = SecondsToNextForcedPump <= 0;                        // But can we?
-		bool bMustForce = SecondsSinceLastPump >= MinMessageLoopSeconds;      // Absolutely must force (Min frequency rate hit)
-		if (SecondsSinceLastAppFocusCheck > MinMessageLoopSeconds && WindowInterfaces.Num() > 0)
+		FCEFMessagePumpActivity Activity;
+		Activity.NumWindows = WindowSnapshot->Num();
+		if (Activity.NumWindows > 0 && Now - LastAppFocusCheckSeconds >= AppFocusCheckSeconds)
 		{
-			SecondsSinceLastAppFocusCheck = 0;
-			// only check app being foreground at the min message loop rate (1hz) and if we have a browser window to save CPU
-			bAppIsFocused = FPlatformApplicationMisc::IsThisApplicationForeground(); 
+			LastAppFocusCheckSeconds = Now;
+			// only check app being foreground at 1hz and if we have a browser window to save CPU
+			bAppIsFocused = FPlatformApplicationMisc::IsThisApplicationForeground();
 		}
-		// NOTE - bAppIsFocused could be stale if WindowInterfaces.Num() == 0
-		bool bAppIsFocusedAndWebWindows = WindowInterfaces.Num() > 0 && bAppIsFocused;
+		// NOTE - bAppIsFocused could be stale if there are no windows
+		Activity.bAppIsFocused = bAppIsFocused;
 
-		// if we won't force AND are the foreground OS app AND we have windows created see if any are visible (not minimized) right now
-		if (bWantForce == false && bMustForce  == false && bAppIsFocusedAndWebWindows == true )
+		// if we are the foreground OS app, count the windows that are visible (not hidden or minimized) right now
+		if (Activity.bAppIsFocused)
 		{
-			for (int32 Index = 0; Index < WindowInterfaces.Num(); Index++)
+			for (const TWeakPtr<FCEFWebBrowserWindow>& WeakBrowserWindow : *WindowSnapshot)
 			{
-				if (WindowInterfaces[Index].IsValid())
+				TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WeakBrowserWindow.Pin();
+				if (BrowserWindow.IsValid() && !BrowserWindow->IsHidden())
 				{
-					TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WindowInterfaces[Index].Pin();
-					if (BrowserWindow->GetParentWindow().IsValid())
+					TSharedPtr<SWindow> BrowserParentWindow = BrowserWindow->GetParentWindow();
+					if (BrowserParentWindow.IsValid() && !BrowserParentWindow->IsWindowMinimized())
 					{
-						TSharedPtr<SWindow> BrowserParentWindow = BrowserWindow->GetParentWindow();
-						if (!BrowserParentWindow->IsWindowMinimized())
-						{
-							bWantForce = true;
-						}
+						Activity.NumVisibleWindows++;
 					}
 				}
 			}
 		}
 
 		// tick the CEF app to determine when to run CefDoMessageLoopWork
-		if (CEFBrowserApp->TickMessagePump(DeltaTime, (bWantForce && bCanForce) || bMustForce))
+		CEFBrowserApp->TickMessagePump(Activity);
+
+		// Set the external tick-call wait time to be in the acceptable range, but leaning heavily toward the longer time. That way, the ticker in
+		// this class is likely to tick itself first, whenever possible. If the ticker is suspended (see where this is used outside of this class),
+		// then this should be an acceptable wait time.
+		static constexpr float ExternalTickCallWaitSecondsScale = 0.95f;
+		ExternalTickCallWaitSeconds = ExternalTickCallWaitSecondsScale * static_cast<float>(FCEFMessagePumpScheduler::GetVisibleForcedIntervalSeconds());
+	}
+
+		// Run the cookie completions reported since the last tick, and flush cookie writes
+		FCefWebBrowserCookieManagerFactory::Tick(DefaultCookieManager);
+		for (const TPair<FString, TSharedPtr<IWebBrowserCookieManager>>& CookieManagerPair : ContextCookieManagers)
 		{
-			SecondsSinceLastPump = 0;
-			SecondsToNextForcedPump = MaxForcedMessageLoopSeconds;
+			FCefWebBrowserCookieManagerFactory::Tick(CookieManagerPair.Value);
 		}
-	}
 
-		// Update video buffering for any windows that need it
-		for (int32 Index = 0; Index < WindowInterfaces.Num(); Index++)
+		// Update video buffering and frame rates, and send batched JS results for any windows that need it
+		for (const TWeakPtr<FCEFWebBrowserWindow>& WeakBrowserWindow : *WindowSnapshot)
 		{
-			if (WindowInterfaces[Index].IsValid())
+			TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WeakBrowserWindow.Pin();
+			if (BrowserWindow.IsValid())
 			{
-				TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WindowInterfaces[Index].Pin();
-				if (BrowserWindow.IsValid())
-				{
-					BrowserWindow->UpdateVideoBuffering();
-				}
+				BrowserWindow->UpdateVideoBuffering();
+				BrowserWindow->UpdateFrameRate(bAppIsFocused);
+				BrowserWindow->FlushBatchedScriptResults();
 			}
 		}
 	}
@@ -899,12 +1159,19 @@ TSharedPtr<IWebBrowserCookieManager> FWebBrowserSingleton::GetCookieManager(TOpt
 #if WITH_CEF3
 		if (bAllowCEF)
 		{
+			if (const TSharedPtr<IWebBrowserCookieManager>* ExistingCookieManager = ContextCookieManagers.Find(ContextId.GetValue()))
+			{
+				return *ExistingCookieManager;
+			}
+
 			const CefRefPtr<CefRequestContext>* ExistingContext = RequestContexts.Find(ContextId.GetValue());
 
 			if (ExistingContext && ExistingContext->get())
 			{
-				// Cache these cookie managers?
-				return FCefWebBrowserCookieManagerFactory::Create((*ExistingContext)->GetCookieManager(nullptr));
+				// Keep the manager for the lifetime of the context, so its cookie cache and pending flushes are shared by every caller
+				TSharedPtr<IWebBrowserCookieManager> CookieManager = FCefWebBrowserCookieManagerFactory::Create((*ExistingContext)->GetCookieManager(nullptr));
+				ContextCookieManagers.Add(ContextId.GetValue(), CookieManager);
+				return CookieManager;
 			}
 			else
 			{
@@ -918,15 +1185,21 @@ TSharedPtr<IWebBrowserCookieManager> FWebBrowserSingleton::GetCookieManager(TOpt
 }
 
 #if WITH_CEF3
-bool FWebBrowserSingleton::URLRequestAllowsCredentials(const FString& URL)
+bool FWebBrowserSingleton::URLRequestAllowsCredentials(const FString& URL, int32 BrowserId, const FString& ContextId) const
 {
-	FScopeLock Lock(&WindowInterfacesCS);
-	// The FCEFResourceContextHandler::OnBeforeResourceLoad call doesn't get the browser/frame associated with the load
-	// (because bugs) so just look at each browser and see if it thinks it knows about this URL
-	for (int32 Index = WindowInterfaces.Num() - 1; Index >= 0; --Index)
+	if (BrowserId != INDEX_NONE)
+	{
+		if (TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WindowRegistry->Find(BrowserId))
+		{
+			return BrowserWindow->URLRequestAllowsCredentials(URL);
+		}
+	}
+
+	// Requests not made by a known browser (e.g. from service workers) don't say which browser they belong to, so ask
+	// each browser of the context whether it thinks it knows about this URL
+	for (const TSharedPtr<FCEFWebBrowserWindow>& BrowserWindow : WindowRegistry->GetContextWindows(ContextId))
 	{
-		TSharedPtr<FCEFWebBrowserWindow> BrowserWindow = WindowInterfaces[Index].Pin();
-		if (BrowserWindow.IsValid() && BrowserWindow->URLRequestAllowsCredentials(URL))
+		if (BrowserWindow->URLRequestAllowsCredentials(URL))
 		{
 			return true;
 		}
@@ -1037,8 +1310,8 @@ bool FWebBrowserSingleton::RegisterContext(const FBrowserContextSettings& Settin
 #endif
 
 		//Create a new one
-		CefRefPtr<FCEFResourceContextHandler> ResourceContextHandler = new FCEFResourceContextHandler(this);
-		ResourceContextHandler->OnBeforeLoad() = Settings.OnBeforeContextResourceLoad;
+		CefRefPtr<FCEFResourceContextHandler> ResourceContextHandler = new FCEFResourceContextHandler(this, Settings.Id, Settings.RequestHeaders);
+		ResourceContextHandler->SetOnBeforeLoad(Settings.OnBeforeContextResourceLoad, Settings.OnBeforeContextResourceRequest);
 		RequestResourceHandlers.Add(Settings.Id, ResourceContextHandler);
 		CefRefPtr<CefRequestContext> RequestContext = CefRequestContext::CreateContext(RequestContextSettings, ResourceContextHandler);
 		RequestContexts.Add(Settings.Id, RequestContext);
@@ -1058,19 +1331,28 @@ bool FWebBrowserSingleton::UnregisterContext(const FString& ContextId)
 	{
 		UE_LOG(LogWebBrowser, Log, TEXT("Unregistering ContextId=%s."), *ContextId);
 
+		ClearBrowserWindowPool(ContextId);
+
 		WaitForTaskQueueFlush();
 	
 		CefRefPtr<CefRequestContext> Context;
 		if (RequestContexts.RemoveAndCopyValue(ContextId, Context))
 		{
 			bFoundContext = true;
-			Context->ClearSchemeHandlerFactories();
+			SchemeHandlerFactories.UnregisterFactoriesWith(Context);
+		}
+
+		// The manager may outlive the context, but it is no longer ticked to run its completions
+		TSharedPtr<IWebBrowserCookieManager> CookieManager;
+		if (ContextCookieManagers.RemoveAndCopyValue(ContextId, CookieManager))
+		{
+			FCefWebBrowserCookieManagerFactory::Detach(CookieManager);
 		}
 
 		CefRefPtr<FCEFResourceContextHandler> ResourceHandler;
 		if (RequestResourceHandlers.RemoveAndCopyValue(ContextId, ResourceHandler))
 		{
-			ResourceHandler->OnBeforeLoad().Unbind();
+			ResourceHandler->UnbindOnBeforeLoad();
 		}
 	}
 	return bFoundContext;
@@ -1079,6 +1361,27 @@ bool FWebBrowserSingleton::UnregisterContext(const FString& ContextId)
 #endif
 }
 
+bool FWebBrowserSingleton::SetContextRequestHeaders(TOptional<FString> ContextId, const TMap<FString, FString>& Headers)
+{
+#if WITH_CEF3
+	if (bAllowCEF)
+	{
+		if (!ContextId.IsSet())
+		{
+			DefaultRequestHeaders->SetHeaders(Headers);
+			return true;
+		}
+
+		if (const CefRefPtr<FCEFResourceContextHandler>* ResourceHandler = RequestResourceHandlers.Find(ContextId.GetValue()))
+		{
+			(*ResourceHandler)->GetRequestHeaders()->SetHeaders(Headers);
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
 bool FWebBrowserSingleton::RegisterSchemeHandlerFactory(FString Scheme, FString Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
 {
 #if WITH_CEF3
@@ -1091,6 +1394,18 @@ bool FWebBrowserSingleton::RegisterSchemeHandlerFactory(FString Scheme, FString
 	return false;
 }
 
+bool FWebBrowserSingleton::RegisterSchemeHandlerFactories(FString Scheme, const TArray<FString>& Domains, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
+{
+#if WITH_CEF3
+	if (bAllowCEF)
+	{
+		SchemeHandlerFactories.AddSchemeHandlerFactories(MoveTemp(Scheme), Domains, WebBrowserSchemeHandlerFactory);
+		return true;
+	}
+#endif
+	return false;
+}
+
 bool FWebBrowserSingleton::UnregisterSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
 {
 #if WITH_CEF3
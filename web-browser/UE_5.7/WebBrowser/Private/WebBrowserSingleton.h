@@ -28,10 +28,16 @@ THIRD_PARTY_INCLUDES_END
 	#include "Windows/HideWindowsPlatformAtomics.h"
 	#include "Windows/HideWindowsPlatformTypes.h"
 #endif
+#include "CEF/CEFAcceleratedPaintBackend.h"
 #include "CEF/CEFSchemeHandler.h"
 #include "CEF/CEFResourceContextHandler.h"
+#include "CEF/CEFWebBrowserWindowRegistry.h"
+#include "CEF/CEFTextureUploadScheduler.h"
+#include "CEF/CEFDomainMatcher.h"
+class CefBrowser;
 class CefListValue;
 class FCEFBrowserApp;
+class FCEFBrowserHandler;
 class FCEFWebBrowserWindow;
 #endif
 
@@ -86,6 +92,12 @@ public:
 	TSharedPtr<IWebBrowserWindow> CreateNativeBrowserProxy() override;
 #endif
 
+	virtual void PrewarmBrowserWindows(const FCreateBrowserWindowSettings& Settings, int32 NumBrowsers) override;
+
+	virtual bool ReleaseBrowserWindow(const TSharedPtr<IWebBrowserWindow>& BrowserWindow) override;
+
+	virtual void ClearBrowserWindowPool(TOptional<FString> ContextId = TOptional<FString>()) override;
+
 	virtual TSharedPtr<IWebBrowserCookieManager> GetCookieManager() const override
 	{
 		return DefaultCookieManager;
@@ -97,8 +109,12 @@ public:
 
 	virtual bool UnregisterContext(const FString& ContextId) override;
 
+	virtual bool SetContextRequestHeaders(TOptional<FString> ContextId, const TMap<FString, FString>& Headers) override;
+
 	virtual bool RegisterSchemeHandlerFactory(FString Scheme, FString Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory) override;
 
+	virtual bool RegisterSchemeHandlerFactories(FString Scheme, const TArray<FString>& Domains, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory) override;
+
 	virtual bool UnregisterSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory) override;
 
 	virtual bool IsDevToolsShortcutEnabled() override
@@ -155,8 +171,14 @@ public:
 	/** Returns the time of the most recent call to Tick(). */
 	WEBBROWSER_API double GetPreviousTickTimeSeconds() const;
 
-	/** Return true if this URL will support adding an Authorization header to it */
-	bool URLRequestAllowsCredentials(const FString& URL);
+	/**
+	 * Return true if this URL will support adding an Authorization header to it
+	 *
+	 * @param URL The requested URL.
+	 * @param BrowserId The CEF browser making the request, INDEX_NONE if the request isn't associated with one.
+	 * @param ContextId The request context of the request, whose browsers are asked when the browser is unknown.
+	 */
+	bool URLRequestAllowsCredentials(const FString& URL, int32 BrowserId, const FString& ContextId) const;
 #endif
 private:
 
@@ -168,25 +190,74 @@ private:
 	/** Helper function that blocks until the CEF task queue has processed a posted task, flushing the queue */
 	void WaitForTaskQueueFlush();
 
+	/** Returns the request context for the settings, creating it the first time a context id is used */
+	CefRefPtr<CefRequestContext> GetOrCreateRequestContext(const FCreateBrowserWindowSettings& WindowSettings);
+	/** Returns the static headers of the request context of the settings, which must have been created */
+	TSharedPtr<const FCEFRequestHeaders, ESPMode::ThreadSafe> GetRequestHeaders(const FCreateBrowserWindowSettings& WindowSettings) const;
+	/** Returns the compiled authorization header allowlist from the engine config, recompiling it if the config changed */
+	TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe> GetAuthorizationHeaderAllowList();
+	/** Recomputes the Accept-Language header of every request context when the culture changes */
+	void HandleCultureChanged();
+	/** Wraps a CEF browser in a new browser window and starts tracking it */
+	TSharedPtr<FCEFWebBrowserWindow> CreateCefBrowserWindow(CefRefPtr<CefBrowser> Browser, CefRefPtr<FCEFBrowserHandler> Handler, const FCreateBrowserWindowSettings& WindowSettings, ECEFAcceleratedPaintBackend AcceleratedPaintBackend, const FString& PoolKey);
+
+	/** Returns the key of the pool browsers created with these settings and backend belong to, or an empty string if they can't be pooled */
+	FString GetBrowserPoolKey(const FCreateBrowserWindowSettings& WindowSettings, ECEFAcceleratedPaintBackend AcceleratedPaintBackend) const;
+	/** Takes an idle browser out of the pool and navigates it to the initial URL of the settings, or returns null if none is available */
+	TSharedPtr<FCEFWebBrowserWindow> CheckoutPooledBrowserWindow(const FString& PoolKey, const FCreateBrowserWindowSettings& WindowSettings);
+	/** Starts creating browsers in the background until the pool reaches its target size */
+	void RefillBrowserWindowPool(const FString& PoolKey);
+	/** Called when a browser created by RefillBrowserWindowPool is ready */
+	void HandlePooledBrowserCreated(CefRefPtr<CefBrowser> Browser, FString PoolKey, uint32 Generation);
+
 	/** Pointer to the CEF App implementation */
 	CefRefPtr<FCEFBrowserApp>			CEFBrowserApp;
 
 	TMap<FString, CefRefPtr<CefRequestContext>> RequestContexts;
 	TMap<FString, CefRefPtr<FCEFResourceContextHandler>> RequestResourceHandlers;
+	/** Cookie managers of the registered contexts, created on first use. */
+	mutable TMap<FString, TSharedPtr<IWebBrowserCookieManager>> ContextCookieManagers;
 	FCefSchemeHandlerFactories SchemeHandlerFactories;
+	/** The allowlist browsers are created with */
+	TSharedPtr<const FCEFDomainMatcher, ESPMode::ThreadSafe> AuthorizationHeaderAllowList;
+	/** Static headers of the browsers created without a request context */
+	TSharedPtr<FCEFRequestHeaders, ESPMode::ThreadSafe> DefaultRequestHeaders;
+
+	/** Idle browsers kept warm for one set of creation settings */
+	struct FBrowserWindowPool
+	{
+		FCreateBrowserWindowSettings Settings;
+		/** Accelerated paint backend of the browsers, selected when the pool was created */
+		ECEFAcceleratedPaintBackend AcceleratedPaintBackend = ECEFAcceleratedPaintBackend::None;
+		/** Number of idle browsers to keep */
+		int32 TargetSize = 0;
+		/** Number of browsers being created in the background */
+		int32 NumPending = 0;
+		/** Identifies the pool, so browsers whose creation started before the pool was cleared are discarded */
+		uint32 Generation = 0;
+		TArray<TSharedPtr<FCEFWebBrowserWindow>> IdleWindows;
+	};
+	TMap<FString, FBrowserWindowPool> BrowserWindowPools;
+	uint32 LastBrowserWindowPoolGeneration = 0;
+
 	bool bAllowCEF;
 	bool bTaskFinished;
 #endif
 
 	/** List of currently existing browser windows */
 #if WITH_CEF3
-	TArray<TWeakPtr<FCEFWebBrowserWindow>> WindowInterfaces;
+	TSharedRef<FCEFWebBrowserWindowRegistry, ESPMode::ThreadSafe> WindowRegistry;
+
+	/** Budgets the texture uploads of all browser windows */
+	TSharedRef<FCEFTextureUploadScheduler, ESPMode::ThreadSafe> UploadScheduler;
 #elif PLATFORM_IOS || PLATFORM_MAC || PLATFORM_SPECIFIC_WEB_BROWSER || (PLATFORM_ANDROID && USE_ANDROID_JNI)
 	TArray<TWeakPtr<IWebBrowserWindow>>	WindowInterfaces;
 #endif
 
+#if !WITH_CEF3
 	/** Critical section for thread safe modification of WindowInterfaces array. */
 	FCriticalSection WindowInterfacesCS;
+#endif
 
 	TSharedRef<IWebBrowserWindowFactory> WebBrowserWindowFactory;
 
@@ -201,6 +272,9 @@ private:
 	bool bAppIsFocused;
 
 #if WITH_CEF3
+	/** Time at which bAppIsFocused was last updated. */
+	double LastAppFocusCheckSeconds = 0.0;
+
 	/** Did CEF successfully initialize itself */
 	bool bCEFInitialized;
 #endif
@@ -229,6 +303,12 @@ class FCefWebBrowserCookieManagerFactory
 public:
 	static TSharedRef<IWebBrowserCookieManager> Create(
 		const CefRefPtr<CefCookieManager>& CookieManager);
+
+	/** Runs the completion callbacks queued by a cookie manager created by Create, and flushes its store once writes settle. */
+	static void Tick(const TSharedPtr<IWebBrowserCookieManager>& CookieManager);
+
+	/** Posts the completion callbacks of a cookie manager that is no longer ticked to the UI thread, now and from then on. */
+	static void Detach(const TSharedPtr<IWebBrowserCookieManager>& CookieManager);
 };
 
 #endif
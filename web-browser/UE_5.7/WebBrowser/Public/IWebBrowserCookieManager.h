@@ -65,4 +65,78 @@ public:
 	 * @param Completed A callback function that will be invoked asynchronously on the game thread when the deletion is complete passing in the number of deleted objects.
 	 */
 	virtual void DeleteCookies(const FString& URL = TEXT(""), const FString& CookieName = TEXT(""), TFunction<void(int)> Completed = nullptr) = 0;
+
+	/**
+	 * Sets several cookies at once.
+	 *
+	 * @param URL The URL to set the cookies for. Leave blank to set each cookie for the URL given by its Domain, Path and bSecure.
+	 * @param Cookies The cookies to set.
+	 * @param Completed A callback function that will be invoked asynchronously on the game thread once all cookies are set, passing the number of cookies that were set.
+	 */
+	virtual void SetCookies(const FString& URL, const TArray<FCookie>& Cookies, TFunction<void(int32)> Completed = nullptr)
+	{
+		if (Cookies.Num() == 0)
+		{
+			if (Completed)
+			{
+				Completed(0);
+			}
+			return;
+		}
+
+		TSharedRef<TPair<int32, int32>> Counts = MakeShared<TPair<int32, int32>>(Cookies.Num(), 0);
+		for (const FCookie& Cookie : Cookies)
+		{
+			SetCookie(URL.IsEmpty() ? GetCookieURL(Cookie) : URL, Cookie, [Counts, Completed](bool bSuccess)
+			{
+				Counts->Value += bSuccess ? 1 : 0;
+				if (--Counts->Key == 0 && Completed)
+				{
+					Completed(Counts->Value);
+				}
+			});
+		}
+	}
+
+	/**
+	 * Gets the cookies that would be sent with a request to the URL.
+	 *
+	 * Platforms that can't read cookies pass an empty list.
+	 *
+	 * @param URL The URL to match.
+	 * @param bIncludeHttpOnly Whether to include cookies marked HttpOnly.
+	 * @param Completed A callback function that will be invoked on the game thread with the cookies. It may be invoked before the function returns when the answer is cached.
+	 */
+	virtual void GetCookies(const FString& URL, bool bIncludeHttpOnly, TFunction<void(const TArray<FCookie>&)> Completed)
+	{
+		if (Completed)
+		{
+			Completed(TArray<FCookie>());
+		}
+	}
+
+	/**
+	 * Gets every cookie in the store.
+	 *
+	 * Platforms that can't read cookies pass an empty list.
+	 *
+	 * @param Completed A callback function that will be invoked on the game thread with the cookies. It may be invoked before the function returns when the answer is cached.
+	 */
+	virtual void VisitAllCookies(TFunction<void(const TArray<FCookie>&)> Completed)
+	{
+		if (Completed)
+		{
+			Completed(TArray<FCookie>());
+		}
+	}
+
+protected:
+
+	/** @return the URL a cookie applies to, built from its Domain, Path and bSecure. */
+	static FString GetCookieURL(const FCookie& Cookie)
+	{
+		FString Host = Cookie.Domain;
+		Host.RemoveFromStart(TEXT("."));
+		return FString::Printf(TEXT("%s://%s%s"), Cookie.bSecure ? TEXT("https") : TEXT("http"), *Host, Cookie.Path.IsEmpty() ? TEXT("/") : *Cookie.Path);
+	}
 };
\ No newline at end of file
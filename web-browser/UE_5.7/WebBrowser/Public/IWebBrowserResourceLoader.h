@@ -4,5 +4,95 @@
 
 #include "CoreMinimal.h"
 
+/**
+ * A resource request, as passed to the resource request delegates.
+ *
+ * Details are read from the browser when asked for, so a delegate only pays for what it uses. Resource types and
+ * statuses are interned names, e.g. "IMAGE" or "XHR". The request is only valid during the delegate call.
+ */
+class IWebBrowserResourceRequest
+{
+public:
+	virtual ~IWebBrowserResourceRequest() {}
+
+	/** The url of the request. */
+	virtual const FString& GetUrl() const = 0;
+
+	/** The type of the resource, e.g. "MAIN_FRAME", "IMAGE" or "XHR". */
+	virtual FName GetResourceType() const = 0;
+
+	/** Whether user credentials may be added to the request. */
+	virtual bool AllowsUserCredentials() const = 0;
+
+	/**
+	 * Gets the value of a single request header, without copying the others.
+	 *
+	 * @param Name The header name.
+	 * @return The header value, or an empty string if the request has no such header.
+	 */
+	virtual FString GetHeader(const FString& Name) const = 0;
+
+	/** Gets all the request headers. They are copied out of the browser the first time this is called. */
+	virtual const TMap<FString, FString>& GetHeaders() const = 0;
+};
+
 typedef TMap<FString, FString> FContextRequestHeaders;
 DECLARE_DELEGATE_FourParams(FOnBeforeContextResourceLoadDelegate, FString /*Url*/, FString /*ResourceType*/, FContextRequestHeaders& /*AdditionalHeaders*/, const bool /*AllowUserCredentials*/);
+DECLARE_DELEGATE_TwoParams(FOnBeforeContextResourceRequestDelegate, const IWebBrowserResourceRequest& /*Request*/, FContextRequestHeaders& /*AdditionalHeaders*/);
+
+/** How a request matching a resource rule is handled. */
+enum class EWebBrowserResourceRuleAction : uint8
+{
+	/** Let the request through, after applying the rule's header rewrites. */
+	Continue,
+	/** Reply with the rule's static response instead of performing the request. */
+	Respond,
+	/** Cancel the request. */
+	Block,
+	/** Pass the request on to the game thread delegates (OnBeforeResourceLoad, OnLoadUrl). */
+	Delegate,
+};
+
+/**
+ * A declarative resource interception rule.
+ *
+ * Rules are evaluated on the browser's IO thread, so requests they handle don't wait on the game thread.
+ */
+struct FWebBrowserResourceRule
+{
+	/** The URL must start with this prefix. Empty matches any URL. */
+	FString UrlPrefix;
+
+	/** The URL must match this regular expression. Empty matches any URL. */
+	FString UrlPattern;
+
+	/** Resource types the rule applies to, as passed to OnBeforeResourceLoad (e.g. "IMAGE", "XHR"). Empty matches all types. */
+	TArray<FString> ResourceTypes;
+
+	/** What to do with a matching request. */
+	EWebBrowserResourceRuleAction Action = EWebBrowserResourceRuleAction::Continue;
+
+	/** Headers added to, or replaced in, matching requests. */
+	TMap<FString, FString> SetHeaders;
+
+	/** Headers removed from matching requests. */
+	TArray<FString> RemoveHeaders;
+
+	/** Mime type of the static response. */
+	FString ResponseMimeType = TEXT("text/html");
+
+	/** Body of the static response. */
+	FString ResponseBody;
+
+	/** File served as the static response instead of ResponseBody, e.g. a local script bundle. It is memory mapped where supported and supports range requests. */
+	FString ResponseFile;
+};
+
+/** An ordered set of resource rules. The first matching rule wins. */
+struct FWebBrowserResourceRules
+{
+	TArray<FWebBrowserResourceRule> Rules;
+
+	/** What to do with requests that match no rule. Respond is treated as Continue. */
+	EWebBrowserResourceRuleAction UnmatchedAction = EWebBrowserResourceRuleAction::Continue;
+};
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
 
 /**
  * This is the interface that needs to be implemented to handle a request made via a custom scheme.
@@ -49,7 +50,13 @@ public:
 	};
 
 public:
-	virtual ~IWebBrowserSchemeHandler() {}
+	/** Delegate executed once an asynchronous read completed, with the number of bytes read, zero at the end of the response or negative on failure. */
+	DECLARE_DELEGATE_OneParam(FOnResponseRead, int32 /*BytesRead*/);
+
+	virtual ~IWebBrowserSchemeHandler()
+	{
+		InvalidatePendingRead();
+	}
 
 	/**
 	 * Process an incoming request.
@@ -79,10 +86,90 @@ public:
 	 */
 	virtual bool ReadResponse(uint8* OutBytes, int32 BytesToRead, int32& BytesRead, const FSimpleDelegate& OnMoreDataReady) = 0;
 
+	/**
+	 * Reads the response, without blocking the thread when the data is not available yet. Override this to serve data in chunks
+	 * as it streams in, e.g. from disk or from a pak file. The default implementation reads through ReadResponse.
+	 * @param   OutBytes            Copy up to BytesToRead of data to this ptr. When the read completes later, it remains valid until OnResponseRead is executed.
+	 * @param   BytesToRead         The maximum number of bytes that can be copied to OutBytes.
+	 * @param   BytesRead           Set this to the number of bytes copied right away. Set it to zero and return true to complete the read
+	 *                                later, by copying the data to OutBytes and executing OnResponseRead from any thread.
+	 * @param   OnResponseRead      The delegate to execute when a read that did not complete right away has.
+	 * @return You should return true if data was read or will be, otherwise false if this is the end of the response data.
+	 */
+	virtual bool ReadResponseAsync(uint8* OutBytes, int32 BytesToRead, int32& BytesRead, const FOnResponseRead& OnResponseRead)
+	{
+		// Once a handler that is waiting for data has more, read it into the same buffer, unless the request was canceled or done by then
+		TSharedRef<FPendingRead, ESPMode::ThreadSafe> Read = MakeShared<FPendingRead, ESPMode::ThreadSafe>(this, OutBytes, BytesToRead);
+		InvalidateRead(SwapPendingRead(Read));
+		return ReadResponse(OutBytes, BytesToRead, BytesRead, FSimpleDelegate::CreateLambda([Read, OnResponseRead]()
+		{
+			FScopeLock Lock(&Read->CriticalSection);
+			if (Read->Handler == nullptr)
+			{
+				return;
+			}
+
+			int32 MoreBytesRead = 0;
+			const bool bMoreData = Read->Handler->ReadResponseAsync(Read->OutBytes, Read->BytesToRead, MoreBytesRead, OnResponseRead);
+			if (!bMoreData || MoreBytesRead > 0)
+			{
+				OnResponseRead.ExecuteIfBound(bMoreData ? MoreBytesRead : 0);
+			}
+		}));
+	}
+
+	/**
+	 * Drops the read the default ReadResponseAsync is waiting to complete, so it neither reads from the handler nor writes to the
+	 * buffer once they are gone. Called by the browser when the request is canceled, and before the handler is recycled.
+	 */
+	void InvalidatePendingRead()
+	{
+		InvalidateRead(SwapPendingRead(nullptr));
+	}
+
 	/**
 	 * Called if the request should be canceled.
 	 */
 	virtual void Cancel() = 0;
+
+private:
+	/** A read of the default ReadResponseAsync waiting for data. Its handler is cleared once the read may no longer complete. */
+	struct FPendingRead
+	{
+		FPendingRead(IWebBrowserSchemeHandler* InHandler, uint8* InOutBytes, int32 InBytesToRead)
+			: Handler(InHandler)
+			, OutBytes(InOutBytes)
+			, BytesToRead(InBytesToRead)
+		{}
+
+		FCriticalSection CriticalSection;
+		IWebBrowserSchemeHandler* Handler;
+		uint8* OutBytes;
+		int32 BytesToRead;
+	};
+
+	/** Replaces the pending read, which the browser and the threads completing reads access concurrently, returning the previous one. */
+	TSharedPtr<FPendingRead, ESPMode::ThreadSafe> SwapPendingRead(const TSharedPtr<FPendingRead, ESPMode::ThreadSafe>& NewRead)
+	{
+		FScopeLock Lock(&PendingReadCriticalSection);
+		TSharedPtr<FPendingRead, ESPMode::ThreadSafe> OldRead = PendingRead;
+		PendingRead = NewRead;
+		return OldRead;
+	}
+
+	/** Stops a read from completing. Takes its lock only once the pending read lock is released, so the two are never nested. */
+	static void InvalidateRead(const TSharedPtr<FPendingRead, ESPMode::ThreadSafe>& Read)
+	{
+		if (Read.IsValid())
+		{
+			FScopeLock Lock(&Read->CriticalSection);
+			Read->Handler = nullptr;
+			Read->OutBytes = nullptr;
+		}
+	}
+
+	FCriticalSection PendingReadCriticalSection;
+	TSharedPtr<FPendingRead, ESPMode::ThreadSafe> PendingRead;
 };
 
 /**
@@ -99,4 +186,12 @@ public:
 	 * @param   Url             This is the full url for the request being made.
 	 */
 	virtual TUniquePtr<IWebBrowserSchemeHandler> Create(FString Verb, FString Url) = 0;
+
+	/**
+	 * Hands back a handler created by this factory once its request is done, so it can be reused by a later Create instead of
+	 * allocating a new one. The handler may have been canceled, reset it before reusing it. Called from any thread, but never after
+	 * the factory was unregistered. The default implementation destroys the handler.
+	 * @param   Handler         The handler that is no longer used.
+	 */
+	virtual void RecycleHandler(TUniquePtr<IWebBrowserSchemeHandler>&& Handler) {}
 };
@@ -50,6 +50,13 @@ struct FBrowserContextSettings
 	bool bIgnoreCertificateErrors;
 	bool bEnableNetSecurityExpiration;
 	FOnBeforeContextResourceLoadDelegate OnBeforeContextResourceLoad;
+	/** Like OnBeforeContextResourceLoad, without converting the request details to strings up front. */
+	FOnBeforeContextResourceRequestDelegate OnBeforeContextResourceRequest;
+	/**
+	 * Headers set on every request made in the context (CEF only). They are set without a trip to the game thread, and an
+	 * Accept-Language header here replaces the one following the current culture.
+	 */
+	TMap<FString, FString> RequestHeaders;
 };
 
 
@@ -69,6 +76,8 @@ struct FCreateBrowserWindowSettings
 		, Context()
 		, AltRetryDomains()
 		, bMobileJSReturnInDict(true)
+		, bUseBufferedVideo(PLATFORM_MAC != 0)
+		, BufferedVideoFrames(4)
 	{ }
 
 	void* OSWindowHandle;
@@ -83,6 +92,13 @@ struct FCreateBrowserWindowSettings
 	TOptional<FBrowserContextSettings> Context;
 	TArray<FString> AltRetryDomains;
 	bool bMobileJSReturnInDict;
+	/**
+	 * Whether OSR paints are buffered and uploaded at most once per engine tick (CEF only).
+	 * Enabled by default on Mac so we don't DoS the OpenGL API with texture uploads.
+	 */
+	bool bUseBufferedVideo;
+	/** Number of frames kept in the buffered video ring. */
+	int32 BufferedVideoFrames;
 };
 
 /**
@@ -127,6 +143,31 @@ public:
 	virtual TSharedPtr<IWebBrowserWindow> CreateNativeBrowserProxy() = 0;
 #endif
 
+	/**
+	 * Creates browsers in the background and keeps them idle, so that a later CreateBrowserWindow call with compatible settings
+	 * checks one out instead of blocking while a new browser and its renderer process start up.
+	 *
+	 * @param Settings The settings the pooled browsers are created with. InitialURL and ContentsToLoad are ignored, and only off-screen browsers can be pooled.
+	 * @param NumBrowsers The number of idle browsers to keep for these settings. Checked out browsers are replaced in the background.
+	 */
+	virtual void PrewarmBrowserWindows(const FCreateBrowserWindowSettings& Settings, int32 NumBrowsers) {}
+
+	/**
+	 * Returns a browser window created by CreateBrowserWindow to its pool. The window is reset, i.e. its delegates and script bindings
+	 * are cleared and it navigates to about:blank, and will be handed out by a later CreateBrowserWindow call.
+	 *
+	 * @param BrowserWindow The window to return.
+	 * @return true if the window was pooled, false if no pool has room for it, in which case it should be released as usual.
+	 */
+	virtual bool ReleaseBrowserWindow(const TSharedPtr<IWebBrowserWindow>& BrowserWindow) { return false; }
+
+	/**
+	 * Closes the idle pooled browsers and stops prewarming.
+	 *
+	 * @param ContextId Only clear the pools of this request context, or every pool if unset.
+	 */
+	virtual void ClearBrowserWindowPool(TOptional<FString> ContextId = TOptional<FString>()) {}
+
 	virtual TSharedPtr<class IWebBrowserCookieManager> GetCookieManager() const = 0;
 
 	virtual TSharedPtr<class IWebBrowserCookieManager> GetCookieManager(TOptional<FString> ContextId) const = 0;
@@ -135,6 +176,18 @@ public:
 
 	virtual bool UnregisterContext(const FString& ContextId) = 0;
 
+	/**
+	 * Replaces the headers set on every request made in a request context (CEF only).
+	 *
+	 * @param ContextId The registered context, or unset for browsers created without one.
+	 * @param Headers The headers. An Accept-Language header replaces the one following the current culture.
+	 * @return true if the context was found, always false unless overridden.
+	 */
+	virtual bool SetContextRequestHeaders(TOptional<FString> ContextId, const TMap<FString, FString>& Headers)
+	{
+		return false;
+	}
+
 	// @return the application cache dir where the cookies are stored
 	virtual FString ApplicationCacheDir() const = 0;
 	/**
@@ -147,7 +200,26 @@ public:
 	virtual bool RegisterSchemeHandlerFactory(FString Scheme, FString Domain, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory) = 0;
 
 	/**
-	 * Unregister a custom scheme handler factory. The factory may still be used by existing open browser windows, but will no longer be provided for new ones.
+	 * Registers a custom scheme handler factory for many domains of a scheme in one call, e.g. one domain per content pack.
+	 * "*.example.com" matches every subdomain of example.com, an empty domain or "*" matches every domain.
+	 * The default implementation registers each domain in turn through RegisterSchemeHandlerFactory.
+	 * @param Scheme                            The scheme name to handle.
+	 * @param Domains                           The domain names to handle.
+	 * @param WebBrowserSchemeHandlerFactory    The factory implementation for creating request handlers for this scheme.
+	 */
+	virtual bool RegisterSchemeHandlerFactories(FString Scheme, const TArray<FString>& Domains, IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory)
+	{
+		bool bRegistered = true;
+		for (const FString& Domain : Domains)
+		{
+			bRegistered &= RegisterSchemeHandlerFactory(Scheme, Domain, WebBrowserSchemeHandlerFactory);
+		}
+		return bRegistered;
+	}
+
+	/**
+	 * Unregister a custom scheme handler factory, for all the domains it was registered with. Requests it already created a handler for complete,
+	 * the factory is not used for any new request once this returns.
 	 * @param WebBrowserSchemeHandlerFactory    The factory implementation to remove.
 	 */
 	virtual bool UnregisterSchemeHandlerFactory(IWebBrowserSchemeHandlerFactory* WebBrowserSchemeHandlerFactory) = 0;
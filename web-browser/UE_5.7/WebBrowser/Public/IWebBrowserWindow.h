@@ -7,6 +7,7 @@
 #include "Input/Reply.h"
 #include "Widgets/SWindow.h"
 #include "SWebBrowser.h"
+#include "IWebBrowserResourceLoader.h"
 
 class Error;
 class FSlateShaderResource;
@@ -78,6 +79,52 @@ struct FWebNavigationRequest
 	EWebTransitionSourceQualifier TransitionSourceQualifier;
 };
 
+/** What a browser window does while its widget is painted but can't be seen, because it is fully transparent. */
+enum class EWebBrowserOcclusionPolicy : uint8
+{
+	/** Keep rendering at the active frame rate. */
+	NeverHide,
+	/** Hide the browser, as if its widget had stopped ticking. */
+	HideWhenOccluded,
+	/** Keep the browser running at a reduced frame rate, so it is up to date when it shows again. */
+	ThrottleWhenOccluded
+};
+
+/** Performance counters of a browser window, accumulated since the window was created. */
+struct FWebBrowserWindowPerfStats
+{
+	/** Number of frames painted by the browser. */
+	uint64 NumPaints = 0;
+
+	/** Bytes of the painted frames the browser reported as dirty. */
+	uint64 DirtyBytes = 0;
+
+	/** Bytes copied to the browser textures. */
+	uint64 UploadedBytes = 0;
+
+	/** Number of painted frames whose texture was requested for drawing. Frames replaced before being drawn are not counted. */
+	uint64 NumPresentedPaints = 0;
+
+	/** Total and largest delay between a paint and the first request of its texture for drawing, in seconds. */
+	double TotalPaintToPresentSeconds = 0.0;
+	double MaxPaintToPresentSeconds = 0.0;
+
+	/** Number of widget size changes passed on to the browser, and number held back and replaced by a later size. */
+	uint64 NumAppliedResizes = 0;
+	uint64 NumSuppressedResizes = 0;
+
+	/** Backend copying the frames the browser paints on the GPU, NAME_None if the browser paints through the CPU. */
+	FName AcceleratedPaintBackend;
+
+	/** Number of GPU painted frames copied to the browser textures, and number that could not be copied. */
+	uint64 NumAcceleratedPaintCopies = 0;
+	uint64 NumFailedAcceleratedPaintCopies = 0;
+
+	/** Total and longest time spent copying a GPU painted frame, in seconds. */
+	double TotalAcceleratedPaintCopySeconds = 0.0;
+	double MaxAcceleratedPaintCopySeconds = 0.0;
+};
+
 /**
  * Interface for dealing with a Web Browser window
  */
@@ -377,6 +424,66 @@ public:
 	
 	virtual void SetParentDockTab(TSharedPtr<class SDockTab> DockTab) {};
 
+	/**
+	 * Sets declarative rules for intercepting resource loads, where supported by the platform.
+	 * Requests handled by a rule don't wait for the game thread. Only requests handed to the Delegate action,
+	 * and frame loads, are passed on to OnBeforeResourceLoad and OnLoadUrl.
+	 *
+	 * @param Rules The rules. Pass an empty set whose UnmatchedAction is Delegate to restore the default behavior.
+	 */
+	virtual void SetResourceRules(const FWebBrowserResourceRules& Rules) {};
+
+	/**
+	 * Gets the performance counters of the window, where supported by the platform.
+	 *
+	 * @return The counters accumulated since the window was created.
+	 */
+	virtual FWebBrowserWindowPerfStats GetPerfStats() const { return FWebBrowserWindowPerfStats(); }
+
+	/**
+	 * Sets the rate the browser renders at while it is active, where supported by the platform.
+	 *
+	 * @param FrameRate The frame rate, clamped to [1, 60].
+	 */
+	virtual void SetFrameRate(int32 FrameRate) {};
+
+	/**
+	 * Gets the rate the browser renders at while it is active.
+	 *
+	 * @return The frame rate, or 0 if the platform doesn't support changing it.
+	 */
+	virtual int32 GetFrameRate() const { return 0; }
+
+	/**
+	 * Sets the rate the browser drops to while it is hidden, unfocused, or hasn't received input for a while, where supported
+	 * by the platform. The active rate is restored as soon as the browser is shown or receives input.
+	 *
+	 * @param IdleFrameRate The idle frame rate, or 0 to always render at the active rate.
+	 */
+	virtual void SetIdleFrameRate(int32 IdleFrameRate) {};
+
+	/**
+	 * Gets the rate the browser drops to while it is idle.
+	 *
+	 * @return The idle frame rate, or 0 if the browser always renders at the active rate.
+	 */
+	virtual int32 GetIdleFrameRate() const { return 0; }
+
+	/**
+	 * Sets what the browser does while its widget can't be seen, where supported by the platform.
+	 * The browser only reacts once the widget has been occluded for a short while, so briefly covered widgets don't thrash.
+	 *
+	 * @param Policy The occlusion policy. Browsers default to NeverHide.
+	 */
+	virtual void SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy) {};
+
+	/**
+	 * Called by the widget showing the browser every time it paints.
+	 *
+	 * @param bIsOccluded Whether the widget is fully transparent.
+	 */
+	virtual void SetIsOccluded(bool bIsOccluded) {};
+
 public:
 
 	/** A delegate that is invoked when the loading state of a document changed. */
@@ -420,6 +527,14 @@ public:
 	DECLARE_DELEGATE_FourParams(FOnResourceLoadCompleteDelegate, FString /*Url*/, FString /*ResourceType*/, FString /*RequestStatus*/, int64 /*ContentLength*/);
 	virtual FOnResourceLoadCompleteDelegate& OnResourceLoadComplete() = 0;
 
+	/** Like OnBeforeResourceLoad, without converting the request details to strings up front. Executed after OnBeforeResourceLoad where both are bound. */
+	DECLARE_DELEGATE_TwoParams(FOnBeforeResourceRequestDelegate, const IWebBrowserResourceRequest& /*Request*/, FRequestHeaders& /*AdditionalHeaders*/);
+	virtual FOnBeforeResourceRequestDelegate& OnBeforeResourceRequest() = 0;
+
+	/** Like OnResourceLoadComplete, without converting the request details to strings up front. The status is e.g. "SUCCESS" or "FAILED". */
+	DECLARE_DELEGATE_ThreeParams(FOnResourceRequestCompleteDelegate, const IWebBrowserResourceRequest& /*Request*/, FName /*RequestStatus*/, int64 /*ContentLength*/);
+	virtual FOnResourceRequestCompleteDelegate& OnResourceRequestComplete() = 0;
+
 	/** A delegate that is invoked for each console message */
 	DECLARE_DELEGATE_FourParams(FOnConsoleMessageDelegate, const FString& /*Message*/, const FString& /*Source*/, int32 /*Line*/, EWebBrowserConsoleLogSeverity /*severity*/);
 	virtual FOnConsoleMessageDelegate& OnConsoleMessage() = 0;
@@ -148,6 +148,13 @@ public:
 	 */
 	WEBBROWSER_API void Construct(const FArguments& InArgs, const TSharedPtr<IWebBrowserWindow>& InWebBrowserWindow = nullptr);
 
+	/**
+	 * Get the settings the widget creates its browser window with, e.g. to prewarm browser windows it will check out.
+	 *
+	 * @param InArgs  Declaration the widget will be constructed from.
+	 */
+	static WEBBROWSER_API FCreateBrowserWindowSettings MakeBrowserWindowSettings(const FArguments& InArgs);
+
 	/**
 	 * Load the specified URL.
 	 *
@@ -247,6 +254,18 @@ public:
 	/** Set parent SWindow for this browser. */
 	WEBBROWSER_API void SetParentWindow(TSharedPtr<SWindow> Window);
 
+	/** Set the rate the browser renders at while active. */
+	WEBBROWSER_API void SetFrameRate(int32 FrameRate);
+
+	/** Get the rate the browser renders at while active, 0 if the platform can't change it. */
+	WEBBROWSER_API int32 GetFrameRate() const;
+
+	/** Set the rate the browser drops to while hidden, unfocused or not interacted with, 0 to always render at the active rate. */
+	WEBBROWSER_API void SetIdleFrameRate(int32 IdleFrameRate);
+
+	/** Set what the browser does while this widget is painted fully transparent. */
+	WEBBROWSER_API void SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy);
+
 private:
 
 	/** Navigate backwards. */
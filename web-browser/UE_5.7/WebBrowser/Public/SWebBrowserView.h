@@ -19,6 +19,7 @@ class IWebBrowserWindow;
 struct FWebNavigationRequest;
 enum class EWebBrowserDialogEventResponse;
 enum class EWebBrowserDocumentState;
+enum class EWebBrowserOcclusionPolicy : uint8;
 enum class EWebBrowserConsoleLogSeverity;
 
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FOnBeforePopupDelegate, FString, FString);
@@ -180,6 +181,13 @@ public:
 	 */
 	WEBBROWSER_API void Construct(const FArguments& InArgs, const TSharedPtr<IWebBrowserWindow>& InWebBrowserWindow = nullptr);
 
+	/**
+	 * Get the settings the widget creates its browser window with, e.g. to prewarm browser windows it will check out.
+	 *
+	 * @param InArgs  Declaration the widget will be constructed from.
+	 */
+	static WEBBROWSER_API FCreateBrowserWindowSettings MakeBrowserWindowSettings(const FArguments& InArgs);
+
 	WEBBROWSER_API virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	/**
@@ -284,6 +292,18 @@ public:
 	/** Set parent SWindow for this browser. */
 	WEBBROWSER_API void SetParentWindow(TSharedPtr<SWindow> Window);
 
+	/** Set the rate the browser renders at while active. */
+	WEBBROWSER_API void SetFrameRate(int32 FrameRate);
+
+	/** Get the rate the browser renders at while active, 0 if the platform can't change it. */
+	WEBBROWSER_API int32 GetFrameRate() const;
+
+	/** Set the rate the browser drops to while hidden, unfocused or not interacted with, 0 to always render at the active rate. */
+	WEBBROWSER_API void SetIdleFrameRate(int32 IdleFrameRate);
+
+	/** Set what the browser does while this widget is painted fully transparent. */
+	WEBBROWSER_API void SetOcclusionPolicy(EWebBrowserOcclusionPolicy Policy);
+
 	/** Update the underlying browser widget to match the KB focus in slate.
 		This is used to work around a CEF bug that loses focus state on navigations*/
 	WEBBROWSER_API void SetBrowserKeyboardFocus();
@@ -383,6 +403,8 @@ private:
 
 	/** Interface for dealing with a web browser window. */
 	TSharedPtr<IWebBrowserWindow> BrowserWindow;
+	/** Whether BrowserWindow was created by this widget, rather than passed in, and should be released to the singleton on destruction. */
+	bool bCreatedBrowserWindow;
 	/** The slate window that contains this widget. This must be stored weak otherwise we create a circular reference. */
 	mutable TWeakPtr<SWindow> SlateParentWindowPtr;
 	/** Viewport interface for rendering the web page. */
@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+
+/**
+ * Measurements of a run of FWebBrowserBenchmark::RunJSBridgeTransport.
+ */
+struct FWebBrowserJSBridgeTransportStats
+{
+	/** Number of calls that got their result. */
+	int32 NumCompletedCalls = 0;
+
+	/** Number of messages the render process would have sent, and received back. */
+	int32 NumMessagesSent = 0;
+	int32 NumMessagesReceived = 0;
+
+	/** Time taken to make every call and handle its result, in seconds. */
+	double Seconds = 0.0;
+};
+
+/**
+ * Measurements of a run of FWebBrowserBenchmark::RunJSStructSerialization.
+ */
+struct FWebBrowserJSStructSerializationStats
+{
+	/** Number of structs serialized. */
+	int32 NumSerializations = 0;
+
+	/** Time taken by the first serialization, which fills the binding name cache, in seconds. */
+	double FirstSeconds = 0.0;
+
+	/** Time taken by every serialization, in seconds. */
+	double Seconds = 0.0;
+
+	/** Allocations made through FMemory by the first serialization, and by every serialization. Values CEF allocates itself are not counted. */
+	int64 FirstAllocations = 0;
+	int64 NumAllocations = 0;
+};
+
+/**
+ * Measurements of a run of FWebBrowserBenchmark::RunAcceleratedPaintBackends.
+ */
+struct FWebBrowserAcceleratedPaintStats
+{
+	/** Number of backend selection cases checked, and number of them that selected an unexpected backend. */
+	int32 NumSelectionCases = 0;
+	int32 NumSelectionMismatches = 0;
+
+	/** Whether the platform can map the buffers CEF paints into. Frames are only copied when it can. */
+	bool bCanMapBuffers = false;
+
+	/** Number of frames copied by the null backend, and bytes it copied. */
+	int32 NumFramesCopied = 0;
+	uint64 BytesCopied = 0;
+
+	/** Time taken to copy the frames, in seconds. */
+	double Seconds = 0.0;
+};
+
+/**
+ * Measurements of a run of FWebBrowserBenchmark::RunUploadBudget.
+ */
+struct FWebBrowserUploadBudgetStats
+{
+	/** Number of paints, and number of them deferred to a later frame. */
+	int32 NumPaints = 0;
+	int32 NumPaintsDeferred = 0;
+
+	/** Number of deferred uploads drained by the scheduler. */
+	int32 NumDeferredUploads = 0;
+
+	/** Bytes uploaded in total, and during the frame that uploaded the most. */
+	uint64 BytesUploaded = 0;
+	uint64 MaxFrameBytes = 0;
+
+	/** Number of frames that uploaded more than the budget. */
+	int32 NumFramesOverBudget = 0;
+
+	/** Most uploads waiting for budget at once, and most frames a deferred paint waited before being uploaded. */
+	int32 MaxQueued = 0;
+	int32 MaxDeferredFrames = 0;
+
+	/** Value of webbrowser.Upload.MaxDeferFrames during the run. */
+	int32 MaxDeferFrames = 0;
+
+	/** Number of frames run after the last one painting, until no upload was waiting. */
+	int32 NumDrainFrames = 0;
+
+	/** Time taken by the run, in seconds. */
+	double Seconds = 0.0;
+};
+
+/**
+ * Results of FWebBrowserBenchmark::RunPaintRegionCoalescing.
+ */
+struct FWebBrowserPaintCoalescingStats
+{
+	/** Number of rect sets coalesced. */
+	int32 NumCases = 0;
+
+	/** Number of sets that did not coalesce into the expected regions, or whose regions did not add up to the expected bytes. */
+	int32 NumRegionMismatches = 0;
+	int32 NumByteMismatches = 0;
+
+	/** Number of sets for which the first paint of a browser was not estimated as a full frame upload. */
+	int32 NumEstimateMismatches = 0;
+};
+
+/**
+ * Runs parts of the browser that can't be isolated through the public API, for benchmark commandlets.
+ * Only implemented where the browser is CEF, the other platforms return false.
+ */
+class WEBBROWSER_API FWebBrowserBenchmark
+{
+public:
+	/**
+	 * Drives the JS bridge without a render process. Calls to a method of a bound object are encoded the way the render process
+	 * sends them, handled by the browser side of the bridge, and their results decoded the way the render process receives them.
+	 *
+	 * @param Object The object to call, which has to stay alive during the run.
+	 * @param MethodName The binding name of a method of the object taking a single integer, set to the index of the call.
+	 * @param NumCalls The number of calls to make.
+	 * @param bBatched Whether to use the batched transport rather than a message per call and per result.
+	 * @param CallsPerBatch The number of calls sent in each batch with the batched transport.
+	 * @param OutStats Receives the measurements.
+	 * @return false if the bridge is not available or the method was not found.
+	 */
+	static bool RunJSBridgeTransport(UObject* Object, const FString& MethodName, int32 NumCalls, bool bBatched, int32 CallsPerBatch, FWebBrowserJSBridgeTransportStats& OutStats);
+
+	/**
+	 * Serializes a struct the way the JS bridge passes structs to the page, repeatedly. The struct is created for the run, with
+	 * integer, floating point and string fields in turn. GMalloc is wrapped during the run to count the allocations of the calling thread.
+	 *
+	 * @param NumFields The number of fields of the struct.
+	 * @param NumSerializations The number of times to serialize it.
+	 * @param OutStats Receives the measurements.
+	 * @return false if the bridge is not available.
+	 */
+	static bool RunJSStructSerialization(int32 NumFields, int32 NumSerializations, FWebBrowserJSStructSerializationStats& OutStats);
+
+	/**
+	 * Coalesces fixed sets of dirty rects the way paints are before their upload, and compares the regions and their bytes with the
+	 * expected ones. Covers overlapping, adjacent and distant rects, rects outside the frame and the region limit. Needs no renderer.
+	 *
+	 * @param OutStats Receives the results.
+	 * @return false if paint regions are not available.
+	 */
+	static bool RunPaintRegionCoalescing(FWebBrowserPaintCoalescingStats& OutStats);
+
+	/**
+	 * Checks which accelerated paint backend is selected for every combination of requested backend, RHI, platform and GPU process
+	 * reliability, then copies frames from a shared memory buffer with the null backend, the way frames CEF painted into a dmabuf
+	 * are copied. Needs neither a GPU nor a browser.
+	 *
+	 * @param Width The width of the frames, in pixels.
+	 * @param Height The height of the frames, in pixels.
+	 * @param NumFrames The number of frames to copy.
+	 * @param OutStats Receives the measurements.
+	 * @return false if accelerated paint is not available, or the shared memory buffer could not be created.
+	 */
+	static bool RunAcceleratedPaintBackends(int32 Width, int32 Height, int32 NumFrames, FWebBrowserAcceleratedPaintStats& OutStats);
+
+	/**
+	 * Paints several HUD browsers every frame through the texture upload scheduler, with webbrowser.Upload.BudgetBytesPerFrame set for
+	 * the run. The HUDs repaint a strip each frame, then all repaint their whole view at once for a few frames, then go back to strips.
+	 * The browsers are simulated, paints are counted rather than copied, so the run measures the scheduling alone.
+	 *
+	 * @param NumHuds The number of browsers. The first one has focus, the others are visible.
+	 * @param Width The width of each browser, in pixels.
+	 * @param Height The height of each browser, in pixels.
+	 * @param NumFrames The number of frames the browsers paint.
+	 * @param NumSpikeFrames The number of frames, starting a quarter into the run, during which every browser repaints its whole view.
+	 * @param BudgetBytesPerFrame The budget to run with, 0 for unlimited.
+	 * @param OutStats Receives the measurements.
+	 * @return false if the scheduler is not available.
+	 */
+	static bool RunUploadBudget(int32 NumHuds, int32 Width, int32 Height, int32 NumFrames, int32 NumSpikeFrames, int32 BudgetBytesPerFrame, FWebBrowserUploadBudgetStats& OutStats);
+};
@@ -65,7 +65,8 @@ public class WebBrowser : ModuleRules
 			PrivateDependencyModuleNames.AddRange(
 				new string[]
 				{
-					"Engine"
+					"Engine",
+					"RenderCore"
 				}
 			);
 		}